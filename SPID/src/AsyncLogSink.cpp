@@ -0,0 +1,140 @@
+#include "AsyncLogSink.h"
+
+namespace Log
+{
+	AsyncFileSink::AsyncFileSink(const std::filesystem::path& a_path, bool a_truncate, std::chrono::milliseconds a_flushInterval, std::size_t a_capacity) :
+		capacity(std::max<std::size_t>(a_capacity, 1)),
+		flushInterval(a_flushInterval)
+	{
+		file.open(a_path.string(), a_truncate);
+		queue.reserve(capacity);
+		batch.reserve(capacity);
+		writer = std::thread(&AsyncFileSink::run, this);
+	}
+
+	AsyncFileSink::~AsyncFileSink()
+	{
+		{
+			std::lock_guard lock(queueLock);
+			stopping = true;
+		}
+		queueReady.notify_one();
+
+		if (writer.joinable()) {
+			writer.join();
+		}
+
+		// Writer might've been terminated without finishing, e.g. when the game exits.
+		Drain();
+	}
+
+	void AsyncFileSink::log(const spdlog::details::log_msg& a_msg)
+	{
+		std::unique_lock lock(queueLock);
+		// Writer empties the whole queue at once and wakes everyone who waits for space.
+		while (queue.size() >= capacity) {
+			queueFree.wait_for(lock, flushInterval);
+		}
+
+		const bool wasEmpty = queue.empty();
+		queue.emplace_back(a_msg);
+
+		// Writer only waits for an empty queue to get a message.
+		if (wasEmpty) {
+			lock.unlock();
+			queueReady.notify_one();
+		}
+	}
+
+	void AsyncFileSink::flush()
+	{
+		Drain();
+	}
+
+	void AsyncFileSink::set_pattern(const std::string& a_pattern)
+	{
+		set_formatter(std::make_unique<spdlog::pattern_formatter>(a_pattern));
+	}
+
+	void AsyncFileSink::set_formatter(std::unique_ptr<spdlog::formatter> a_formatter)
+	{
+		std::lock_guard lock(writeLock);
+		formatter = std::move(a_formatter);
+	}
+
+	bool AsyncFileSink::Drain(std::chrono::milliseconds a_timeout)
+	{
+		const auto deadline = std::chrono::steady_clock::now() + a_timeout;
+
+		std::unique_lock lock(writeLock, std::defer_lock);
+		if (!lock.try_lock_until(deadline)) {
+			return false;
+		}
+
+		std::unique_lock queueLocker(queueLock, std::defer_lock);
+		if (!queueLocker.try_lock_until(deadline)) {
+			return false;
+		}
+		take_queued(queueLocker);
+
+		write_batch();
+		file.flush();
+		return true;
+	}
+
+	void AsyncFileSink::run()
+	{
+		using clock = std::chrono::steady_clock;
+
+		auto lastFlush = clock::now();
+		bool unflushed = false;
+
+		while (true) {
+			bool stop;
+			{
+				std::unique_lock lock(queueLock);
+				queueReady.wait_for(lock, flushInterval, [&] { return stopping || !queue.empty(); });
+				stop = stopping;
+			}
+
+			std::lock_guard lock(writeLock);
+			{
+				std::unique_lock queueLocker(queueLock);
+				take_queued(queueLocker);
+			}
+			if (write_batch() > 0) {
+				unflushed = true;
+			}
+
+			if (unflushed && (stop || clock::now() - lastFlush >= flushInterval)) {
+				file.flush();
+				lastFlush = clock::now();
+				unflushed = false;
+			}
+
+			if (stop) {
+				return;
+			}
+		}
+	}
+
+	void AsyncFileSink::take_queued(std::unique_lock<std::timed_mutex>& a_queueLock)
+	{
+		batch.swap(queue);
+		a_queueLock.unlock();
+		queueFree.notify_all();
+	}
+
+	std::size_t AsyncFileSink::write_batch()
+	{
+		for (const auto& msg : batch) {
+			buffer.clear();
+			formatter->format(msg, buffer);
+			file.write(buffer);
+		}
+
+		const auto written = batch.size();
+		batch.clear();
+		return written;
+	}
+}
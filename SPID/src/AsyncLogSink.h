@@ -0,0 +1,71 @@
+#pragma once
+
+#include <spdlog/details/file_helper.h>
+#include <spdlog/details/log_msg_buffer.h>
+#include <spdlog/pattern_formatter.h>
+#include <spdlog/sinks/sink.h>
+
+namespace Log
+{
+	/// <summary>
+	/// File sink that doesn't write on the thread that logs.
+	///
+	/// Messages are copied into a bounded queue, and a background thread formats and writes them in batches, flushing the file at most once per flush interval.
+	/// When the queue is full, logging threads wait for the writer, so no message is ever lost.
+	/// Drain writes and flushes everything that is queued on the calling thread, so messages can't be lost on exit or crash even if the writer is stuck or gone.
+	/// </summary>
+	class AsyncFileSink final : public spdlog::sinks::sink
+	{
+	public:
+		AsyncFileSink(const std::filesystem::path& a_path, bool a_truncate, std::chrono::milliseconds a_flushInterval, std::size_t a_capacity = 8192);
+		~AsyncFileSink() override;
+
+		AsyncFileSink(const AsyncFileSink&) = delete;
+		AsyncFileSink& operator=(const AsyncFileSink&) = delete;
+
+		void log(const spdlog::details::log_msg& a_msg) override;
+
+		/// Same as Drain.
+		void flush() override;
+
+		void set_pattern(const std::string& a_pattern) override;
+		void set_formatter(std::unique_ptr<spdlog::formatter> a_formatter) override;
+
+		/// <summary>
+		/// Writes and flushes all queued messages on the calling thread.
+		/// Gives up if the queue or the file is busy for longer than a_timeout, e.g. when called from a crash handler
+		/// while the writer is stuck or the crashed thread was in the middle of logging.
+		/// </summary>
+		/// <returns>Whether the queue was drained.</returns>
+		bool Drain(std::chrono::milliseconds a_timeout = std::chrono::seconds(1));
+
+	private:
+		using Batch = std::vector<spdlog::details::log_msg_buffer>;
+
+		void run();
+
+		/// Takes messages that are queued by now into batch and wakes threads that wait for space. Must be called with writeLock and a_queueLock held.
+		void take_queued(std::unique_lock<std::timed_mutex>& a_queueLock);
+
+		/// Writes the batch taken by take_queued and returns number of written messages. Must be called with writeLock held.
+		std::size_t write_batch();
+
+		// Queue that logging threads push into. Its lock is timed, so that Drain can't hang on a thread that crashed while holding it.
+		std::timed_mutex            queueLock;
+		std::condition_variable_any queueReady;  // signaled when messages are queued, or when writer should stop
+		std::condition_variable_any queueFree;   // signaled when writer takes messages out of the queue
+		Batch                       queue{};
+		const std::size_t           capacity;
+		bool                        stopping{ false };
+
+		// File and formatter, only used by whoever drains the queue.
+		std::timed_mutex                   writeLock;
+		spdlog::details::file_helper       file{};
+		std::unique_ptr<spdlog::formatter> formatter{ std::make_unique<spdlog::pattern_formatter>() };
+		Batch                              batch{};
+		spdlog::memory_buf_t               buffer{};
+
+		const std::chrono::milliseconds flushInterval;
+		std::thread                     writer{};
+	};
+}
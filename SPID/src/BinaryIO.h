@@ -0,0 +1,306 @@
+#pragma once
+
+// Minimal binary serialization used by on-disk caches.
+// This header is intentionally self-contained (it doesn't rely on PCH), so that it can be tested and benchmarked outside of the game.
+//
+// Values are stored in native byte order without padding. Caches are only ever read by the same build that wrote them,
+// so they are not meant to be portable between platforms.
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace Binary
+{
+	template <class T>
+	concept scalar = std::is_arithmetic_v<T> || std::is_enum_v<T>;
+
+	/// <summary>
+	/// Fast non-cryptographic 64-bit hash of a byte range. Reads 8 bytes at a time.
+	///
+	/// It is used to detect changed or corrupted files, not to defend against deliberate collisions.
+	/// </summary>
+	inline std::uint64_t hash(std::span<const std::byte> a_bytes, std::uint64_t a_seed = 0)
+	{
+		constexpr std::uint64_t multiplier = 0x9E3779B97F4A7C15;
+
+		const auto mix = [](std::uint64_t a_value) {
+			a_value ^= a_value >> 30;
+			a_value *= 0xBF58476D1CE4E5B9;
+			a_value ^= a_value >> 27;
+			a_value *= 0x94D049BB133111EB;
+			return a_value ^ (a_value >> 31);
+		};
+
+		auto       result = a_seed ^ (a_bytes.size() * multiplier);
+		const auto data = a_bytes.data();
+		const auto size = a_bytes.size();
+
+		std::size_t i = 0;
+		for (; i + 8 <= size; i += 8) {
+			std::uint64_t word;
+			std::memcpy(&word, data + i, sizeof(word));
+			result = std::rotl(result ^ mix(word), 29) * multiplier;
+		}
+
+		if (i < size) {
+			std::uint64_t word = 0;
+			std::memcpy(&word, data + i, size - i);
+			result = std::rotl(result ^ mix(word), 29) * multiplier;
+		}
+
+		return mix(result);
+	}
+
+	inline std::uint64_t hash(std::string_view a_str, std::uint64_t a_seed = 0)
+	{
+		return hash(std::as_bytes(std::span(a_str.data(), a_str.size())), a_seed);
+	}
+
+	/// Appends values to a growing byte buffer.
+	class Writer
+	{
+	public:
+		template <scalar T>
+		void write(T a_value)
+		{
+			const auto offset = buffer.size();
+			buffer.resize(offset + sizeof(T));
+			std::memcpy(buffer.data() + offset, &a_value, sizeof(T));
+		}
+
+		/// Strings are prefixed with their length.
+		void write(std::string_view a_str)
+		{
+			write(static_cast<std::uint32_t>(a_str.size()));
+			write_bytes(std::as_bytes(std::span(a_str.data(), a_str.size())));
+		}
+
+		void write(const std::string& a_str) { write(std::string_view(a_str)); }
+		void write(const char* a_str) { write(std::string_view(a_str)); }
+
+		void write_bytes(std::span<const std::byte> a_bytes)
+		{
+			buffer.insert(buffer.end(), a_bytes.begin(), a_bytes.end());
+		}
+
+		/// <summary>
+		/// Reserves space for a size of the block that follows, so that readers can skip the block without decoding it.
+		/// </summary>
+		/// <returns>Offset that must be passed to end_block once the block is written.</returns>
+		[[nodiscard]] std::size_t begin_block()
+		{
+			const auto offset = buffer.size();
+			write(std::uint64_t{ 0 });
+			return offset;
+		}
+
+		void end_block(std::size_t a_offset)
+		{
+			const std::uint64_t blockSize = buffer.size() - a_offset - sizeof(std::uint64_t);
+			std::memcpy(buffer.data() + a_offset, &blockSize, sizeof(blockSize));
+		}
+
+		[[nodiscard]] std::size_t                size() const { return buffer.size(); }
+		[[nodiscard]] std::span<const std::byte> bytes() const { return buffer; }
+		[[nodiscard]] std::span<std::byte>       bytes() { return buffer; }
+
+	private:
+		std::vector<std::byte> buffer{};
+	};
+
+	/// Thrown by Reader when data is truncated or otherwise doesn't make sense.
+	struct ReadError : std::runtime_error
+	{
+		using std::runtime_error::runtime_error;
+	};
+
+	/// <summary>
+	/// Reads values written by Writer from a byte range, typically a MappedFile.
+	///
+	/// Every read is bounds-checked, so that truncated or corrupted data results in ReadError instead of reading past the end.
+	/// Strings are returned as views into the underlying bytes.
+	/// </summary>
+	class Reader
+	{
+	public:
+		explicit Reader(std::span<const std::byte> a_bytes) :
+			data(a_bytes)
+		{}
+
+		template <scalar T>
+		T read()
+		{
+			T value;
+			std::memcpy(&value, take(sizeof(T)).data(), sizeof(T));
+			return value;
+		}
+
+		/// Reads a value of enum T and makes sure that it is below a_end.
+		template <class T>
+			requires std::is_enum_v<T>
+		T read_enum(T a_end)
+		{
+			const auto value = read<T>();
+			if (static_cast<std::underlying_type_t<T>>(value) >= static_cast<std::underlying_type_t<T>>(a_end)) {
+				throw ReadError("enum value out of range");
+			}
+			return value;
+		}
+
+		std::string_view read_string()
+		{
+			const auto size = read<std::uint32_t>();
+			const auto bytes = take(size);
+			return { reinterpret_cast<const char*>(bytes.data()), bytes.size() };
+		}
+
+		/// Reads a count of elements that follow, making sure that it is plausible given the remaining data.
+		std::size_t read_count(std::size_t a_minElementSize = 1)
+		{
+			const auto count = read<std::uint32_t>();
+			if (a_minElementSize && count > remaining() / a_minElementSize) {
+				throw ReadError("element count exceeds remaining data");
+			}
+			return count;
+		}
+
+		std::span<const std::byte> read_bytes(std::size_t a_size) { return take(a_size); }
+
+		/// Reads a block written between Writer::begin_block and Writer::end_block.
+		std::span<const std::byte> read_block() { return take(read<std::uint64_t>()); }
+
+		[[nodiscard]] std::size_t remaining() const { return data.size() - position; }
+		[[nodiscard]] bool        empty() const { return remaining() == 0; }
+
+	private:
+		std::span<const std::byte> take(std::uint64_t a_size)
+		{
+			if (a_size > remaining()) {
+				throw ReadError("unexpected end of data");
+			}
+			const auto result = data.subspan(position, static_cast<std::size_t>(a_size));
+			position += static_cast<std::size_t>(a_size);
+			return result;
+		}
+
+		std::span<const std::byte> data;
+		std::size_t                position{ 0 };
+	};
+
+	/// <summary>
+	/// Identification of a cache file. A cache is only used when all of these match exactly.
+	/// </summary>
+	struct FileHeader
+	{
+		std::uint64_t    magic{ 0 };
+		std::uint32_t    formatVersion{ 0 };
+		std::string_view build{};  // version of the program that wrote the file
+	};
+
+	enum class FileError : std::uint8_t
+	{
+		kNotFound = 0,
+		kWrongMagic,
+		kWrongVersion,
+		kCorrupted,
+		kWriteFailed
+	};
+
+	inline std::string_view describe(FileError a_error)
+	{
+		switch (a_error) {
+		case FileError::kNotFound:
+			return "not found";
+		case FileError::kWrongMagic:
+			return "has unknown format";
+		case FileError::kWrongVersion:
+			return "was written by a different version";
+		case FileError::kCorrupted:
+			return "is corrupted";
+		default:
+			return "couldn't be written";
+		}
+	}
+
+	/// <summary>
+	/// Writes a_header followed by a_payload and its hash to a_path.
+	///
+	/// Data is written to a temporary file first, which is then renamed over a_path, so a_path is never left half-written.
+	/// </summary>
+	inline std::expected<void, FileError> save_file(const std::filesystem::path& a_path, const FileHeader& a_header, const Writer& a_payload)
+	{
+		Writer header{};
+		header.write(a_header.magic);
+		header.write(a_header.formatVersion);
+		header.write(a_header.build);
+		header.write(hash(a_payload.bytes()));
+		header.write(static_cast<std::uint64_t>(a_payload.size()));  // payload is read back as a block
+
+		auto tempPath = a_path;
+		tempPath += ".tmp";
+
+		std::error_code ec;
+		{
+			std::ofstream output(tempPath, std::ios::binary | std::ios::trunc);
+			if (!output) {
+				return std::unexpected(FileError::kWriteFailed);
+			}
+
+			output.write(reinterpret_cast<const char*>(header.bytes().data()), static_cast<std::streamsize>(header.size()));
+			output.write(reinterpret_cast<const char*>(a_payload.bytes().data()), static_cast<std::streamsize>(a_payload.size()));
+
+			if (!output.flush()) {
+				output.close();
+				std::filesystem::remove(tempPath, ec);
+				return std::unexpected(FileError::kWriteFailed);
+			}
+		}
+
+		std::filesystem::rename(tempPath, a_path, ec);
+		if (ec) {
+			std::filesystem::remove(tempPath, ec);
+			return std::unexpected(FileError::kWriteFailed);
+		}
+
+		return {};
+	}
+
+	/// <summary>
+	/// Validates contents of a file written by save_file and returns its payload.
+	/// </summary>
+	inline std::expected<std::span<const std::byte>, FileError> open_payload(std::span<const std::byte> a_file, const FileHeader& a_header)
+	{
+		try {
+			Reader reader(a_file);
+
+			if (reader.read<std::uint64_t>() != a_header.magic) {
+				return std::unexpected(FileError::kWrongMagic);
+			}
+
+			if (reader.read<std::uint32_t>() != a_header.formatVersion || reader.read_string() != a_header.build) {
+				return std::unexpected(FileError::kWrongVersion);
+			}
+
+			const auto payloadHash = reader.read<std::uint64_t>();
+			const auto payload = reader.read_block();
+			if (!reader.empty() || hash(payload) != payloadHash) {
+				return std::unexpected(FileError::kCorrupted);
+			}
+
+			return payload;
+		} catch (const ReadError&) {
+			return std::unexpected(FileError::kCorrupted);
+		}
+	}
+}
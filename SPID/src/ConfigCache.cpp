@@ -0,0 +1,587 @@
+#include "ConfigCache.h"
+#include "BinaryIO.h"
+#include "MappedFile.h"
+#include "Settings.h"
+
+namespace Distribution::INI::Cache
+{
+	namespace detail
+	{
+		using Binary::Reader;
+		using Binary::ReadError;
+		using Binary::Writer;
+
+		/// formatVersion must be bumped whenever layout of the cache or of any cached struct changes.
+		inline constexpr Binary::FileHeader header{
+			.magic = 0x3147464344495053,  // "SPIDCFG1"
+			.formatVersion = 2,
+			.build = Version::NAME
+		};
+
+		/// <summary>
+		/// Settings that change what parsing a file produces, so the cache is only valid for the settings that it was written with.
+		///
+		/// Files are cached with entries that use old format when sanitizing is disabled, and they must be parsed again to be rewritten once it's enabled.
+		/// Cached logs only contain messages that passed the log level, so lowering it must bring back messages that were left out.
+		/// </summary>
+		struct ParseSettings
+		{
+			bool                      sanitizeConfigs{ true };
+			spdlog::level::level_enum logLevel{ spdlog::level::info };
+
+			bool operator==(const ParseSettings&) const = default;
+		};
+
+		ParseSettings current_settings()
+		{
+			return { Settings::GetSingleton()->sanitizeConfigs, spdlog::default_logger()->level() };
+		}
+
+		// Element types of cached vectors must be declared before the vector overloads, since argument-dependent lookup won't find them here.
+		void save(Writer& a_out, const std::string& a_str);
+		void save(Writer& a_out, const SkillLevel& a_skill);
+		void save(Writer& a_out, const Data& a_data);
+		void save(Writer& a_out, const LinkedDistribution::INI::RawLinkedForm& a_data);
+		void save(Writer& a_out, const ExclusiveGroups::INI::RawExclusiveGroup& a_group);
+
+		void load(Reader& a_in, std::string& a_str);
+		void load(Reader& a_in, FormOrEditorID& a_rawForm);
+		void load(Reader& a_in, SkillLevel& a_skill);
+		void load(Reader& a_in, Data& a_data);
+		void load(Reader& a_in, LinkedDistribution::INI::RawLinkedForm& a_data);
+		void load(Reader& a_in, ExclusiveGroups::INI::RawExclusiveGroup& a_group);
+
+#pragma region Save
+		void save(Writer& a_out, const FormOrEditorID& a_rawForm)
+		{
+			a_out.write(static_cast<std::uint8_t>(a_rawForm.index()));
+			std::visit(overload{
+						   [&](const FormModPair& a_formMod) {
+							   const auto& [formID, modName] = a_formMod;
+							   a_out.write(formID.has_value());
+							   if (formID) {
+								   a_out.write(*formID);
+							   }
+							   a_out.write(modName.has_value());
+							   if (modName) {
+								   a_out.write(*modName);
+							   }
+						   },
+						   [&](const std::string& a_editorID) {
+							   a_out.write(a_editorID);
+						   } },
+				a_rawForm);
+		}
+
+		template <class T>
+		void save(Writer& a_out, const std::vector<T>& a_values)
+		{
+			a_out.write(static_cast<std::uint32_t>(a_values.size()));
+			for (const auto& value : a_values) {
+				save(a_out, value);
+			}
+		}
+
+		void save(Writer& a_out, const std::string& a_str)
+		{
+			a_out.write(a_str);
+		}
+
+		void save(Writer& a_out, const StringFilters& a_filters)
+		{
+			save(a_out, a_filters.ALL);
+			save(a_out, a_filters.NOT);
+			save(a_out, a_filters.MATCH);
+			save(a_out, a_filters.ANY);
+		}
+
+		void save(Writer& a_out, const RawFormFilters& a_filters)
+		{
+			save(a_out, a_filters.ALL);
+			save(a_out, a_filters.NOT);
+			save(a_out, a_filters.MATCH);
+		}
+
+		template <class T>
+		void save(Writer& a_out, const Range<T>& a_range)
+		{
+			a_out.write(a_range.min);
+			a_out.write(a_range.max);
+		}
+
+		void save(Writer& a_out, const SkillLevel& a_skill)
+		{
+			a_out.write(a_skill.type);
+			save(a_out, a_skill.range);
+		}
+
+		void save(Writer& a_out, const LevelFilters& a_filters)
+		{
+			save(a_out, a_filters.actorLevel);
+			save(a_out, a_filters.skillLevels);
+			save(a_out, a_filters.skillWeights);
+		}
+
+		void save(Writer& a_out, const Traits& a_traits)
+		{
+			a_out.write(a_traits.mask);
+			a_out.write(a_traits.value);
+		}
+
+		void save(Writer& a_out, const IndexOrCount& a_idxOrCount)
+		{
+			a_out.write(static_cast<std::uint8_t>(a_idxOrCount.index()));
+			std::visit(overload{
+						   [&](Index a_index) { a_out.write(a_index); },
+						   [&](const RandomCount& a_count) { save(a_out, a_count); } },
+				a_idxOrCount);
+		}
+
+		void save(Writer& a_out, const Chance& a_chance)
+		{
+			a_out.write(a_chance.value);
+			a_out.write(a_chance.deterministic);
+			a_out.write(a_chance.lineSeed);
+		}
+
+		void save(Writer& a_out, const Data& a_data)
+		{
+			a_out.write(a_data.recordTraits);
+			a_out.write(a_data.type);
+			save(a_out, a_data.rawForm);
+			save(a_out, a_data.stringFilters);
+			save(a_out, a_data.formFilters);
+			save(a_out, a_data.levelFilters);
+			save(a_out, a_data.traits);
+			save(a_out, a_data.idxOrCount);
+			save(a_out, a_data.chance);
+			save(a_out, a_data.path);
+		}
+
+		void save(Writer& a_out, const LinkedDistribution::INI::RawLinkedForm& a_data)
+		{
+			save(a_out, a_data.rawForm);
+			a_out.write(a_data.recordTraits);
+			a_out.write(a_data.type);
+			a_out.write(a_data.scope);
+			a_out.write(a_data.distributionType);
+			save(a_out, a_data.formFilters);
+			save(a_out, a_data.idxOrCount);
+			save(a_out, a_data.chance);
+			save(a_out, a_data.path);
+		}
+
+		void save(Writer& a_out, const ExclusiveGroups::INI::RawExclusiveGroup& a_group)
+		{
+			save(a_out, a_group.name);
+			save(a_out, a_group.formFilters);
+			save(a_out, a_group.path);
+		}
+
+		/// Both Configs and LinkedFormsConfig map record types to vectors of entries.
+		template <class ConfigsMap>
+		void save_configs(Writer& a_out, const ConfigsMap& a_configs)
+		{
+			a_out.write(static_cast<std::uint32_t>(a_configs.size()));
+			for (const auto& [type, entries] : a_configs) {
+				a_out.write(type);
+				save(a_out, entries);
+			}
+		}
+
+		void save(Writer& a_out, const DeferredLog& a_log)
+		{
+			a_out.write(static_cast<std::uint32_t>(a_log.size()));
+			for (const auto& [level, message] : a_log) {
+				a_out.write(level);
+				a_out.write(message);
+			}
+		}
+
+		void save(Writer& a_out, const ConfigFile& a_file)
+		{
+			save_configs(a_out, a_file.configs);
+			save_configs(a_out, a_file.deathConfigs);
+			save_configs(a_out, a_file.linkedConfigs);
+			save(a_out, a_file.exclusiveGroups);
+			save(a_out, a_file.log);
+			a_out.write(a_file.shouldLogErrors);
+		}
+#pragma endregion
+
+#pragma region Load
+		void load(Reader& a_in, std::string& a_str)
+		{
+			a_str = a_in.read_string();
+		}
+
+		void load(Reader& a_in, FormOrEditorID& a_rawForm)
+		{
+			switch (a_in.read<std::uint8_t>()) {
+			case 0:
+				{
+					FormModPair formMod{};
+					if (a_in.read<bool>()) {
+						formMod.first = a_in.read<RE::FormID>();
+					}
+					if (a_in.read<bool>()) {
+						formMod.second = a_in.read_string();
+					}
+					a_rawForm = std::move(formMod);
+				}
+				break;
+			case 1:
+				a_rawForm = std::string(a_in.read_string());
+				break;
+			default:
+				throw ReadError("invalid form identifier");
+			}
+		}
+
+		template <class T>
+		void load(Reader& a_in, std::vector<T>& a_values)
+		{
+			a_values.resize(a_in.read_count());
+			for (auto& value : a_values) {
+				load(a_in, value);
+			}
+		}
+
+		void load(Reader& a_in, StringFilters& a_filters)
+		{
+			load(a_in, a_filters.ALL);
+			load(a_in, a_filters.NOT);
+			load(a_in, a_filters.MATCH);
+			load(a_in, a_filters.ANY);
+		}
+
+		void load(Reader& a_in, RawFormFilters& a_filters)
+		{
+			load(a_in, a_filters.ALL);
+			load(a_in, a_filters.NOT);
+			load(a_in, a_filters.MATCH);
+		}
+
+		template <class T>
+		void load(Reader& a_in, Range<T>& a_range)
+		{
+			a_range.min = a_in.read<T>();
+			a_range.max = a_in.read<T>();
+		}
+
+		void load(Reader& a_in, SkillLevel& a_skill)
+		{
+			a_skill.type = a_in.read<std::uint32_t>();
+			load(a_in, a_skill.range);
+		}
+
+		void load(Reader& a_in, LevelFilters& a_filters)
+		{
+			load(a_in, a_filters.actorLevel);
+			load(a_in, a_filters.skillLevels);
+			load(a_in, a_filters.skillWeights);
+		}
+
+		void load(Reader& a_in, Traits& a_traits)
+		{
+			a_traits.mask = a_in.read<std::uint8_t>();
+			a_traits.value = a_in.read<std::uint8_t>();
+		}
+
+		void load(Reader& a_in, IndexOrCount& a_idxOrCount)
+		{
+			switch (a_in.read<std::uint8_t>()) {
+			case 0:
+				a_idxOrCount = a_in.read<Index>();
+				break;
+			case 1:
+				{
+					RandomCount count{};
+					load(a_in, count);
+					a_idxOrCount = count;
+				}
+				break;
+			default:
+				throw ReadError("invalid index or count");
+			}
+		}
+
+		void load(Reader& a_in, Chance& a_chance)
+		{
+			a_chance.value = a_in.read<DecimalChance>();
+			a_chance.deterministic = a_in.read<bool>();
+			a_chance.lineSeed = a_in.read<std::uint64_t>();
+		}
+
+		void load(Reader& a_in, Data& a_data)
+		{
+			a_data.recordTraits = a_in.read<RECORD::TRAITS>();
+			a_data.type = a_in.read_enum(RECORD::kTotal);
+			load(a_in, a_data.rawForm);
+			load(a_in, a_data.stringFilters);
+			load(a_in, a_data.formFilters);
+			load(a_in, a_data.levelFilters);
+			load(a_in, a_data.traits);
+			load(a_in, a_data.idxOrCount);
+			load(a_in, a_data.chance);
+			load(a_in, a_data.path);
+		}
+
+		void load(Reader& a_in, LinkedDistribution::INI::RawLinkedForm& a_data)
+		{
+			using namespace LinkedDistribution;
+
+			load(a_in, a_data.rawForm);
+			a_data.recordTraits = a_in.read<RECORD::TRAITS>();
+			a_data.type = a_in.read_enum(RECORD::kTotal);
+			a_data.scope = a_in.read_enum(static_cast<Scope>(kGlobal + 1));
+			a_data.distributionType = a_in.read_enum(static_cast<DistributionType>(kDeath + 1));
+			load(a_in, a_data.formFilters);
+			load(a_in, a_data.idxOrCount);
+			load(a_in, a_data.chance);
+			load(a_in, a_data.path);
+		}
+
+		void load(Reader& a_in, ExclusiveGroups::INI::RawExclusiveGroup& a_group)
+		{
+			load(a_in, a_group.name);
+			load(a_in, a_group.formFilters);
+			load(a_in, a_group.path);
+		}
+
+		template <class ConfigsMap>
+		void load_configs(Reader& a_in, ConfigsMap& a_configs)
+		{
+			for (auto count = a_in.read_count(); count > 0; --count) {
+				const auto type = a_in.read_enum(RECORD::kTotal);
+				load(a_in, a_configs[type]);
+			}
+		}
+
+		void load(Reader& a_in, DeferredLog& a_log)
+		{
+			a_log.resize(a_in.read_count());
+			for (auto& [level, message] : a_log) {
+				level = a_in.read_enum(spdlog::level::n_levels);
+				message = a_in.read_string();
+			}
+		}
+
+		void load(Reader& a_in, ConfigFile& a_file)
+		{
+			load_configs(a_in, a_file.configs);
+			load_configs(a_in, a_file.deathConfigs);
+			load_configs(a_in, a_file.linkedConfigs);
+			load(a_in, a_file.exclusiveGroups);
+			load(a_in, a_file.log);
+			a_file.shouldLogErrors = a_in.read<bool>();
+
+			if (!a_in.empty()) {
+				throw ReadError("unexpected trailing data");
+			}
+		}
+#pragma endregion
+
+		struct FileStat
+		{
+			std::uint64_t size{ 0 };
+			std::int64_t  modifiedTime{ 0 };
+		};
+
+		std::optional<FileStat> stat(const std::string& a_path)
+		{
+			std::error_code ec;
+
+			const auto size = std::filesystem::file_size(a_path, ec);
+			if (ec) {
+				return std::nullopt;
+			}
+
+			const auto modifiedTime = std::filesystem::last_write_time(a_path, ec);
+			if (ec) {
+				return std::nullopt;
+			}
+
+			return FileStat{ size, static_cast<std::int64_t>(modifiedTime.time_since_epoch().count()) };
+		}
+
+		/// Cached file that wasn't decoded yet.
+		struct CachedFile
+		{
+			FileKey                    key{};
+			std::span<const std::byte> entries{};
+		};
+	}
+
+	std::optional<std::filesystem::path> GetDefaultPath()
+	{
+		auto path = SKSE::log::log_directory();
+		if (!path) {
+			return std::nullopt;
+		}
+
+		*path /= Version::PROJECT;
+		*path += ".cache"sv;
+		return path;
+	}
+
+	std::optional<FileKey> GetFileKey(const std::string& a_path)
+	{
+		const auto stat = detail::stat(a_path);
+		if (!stat) {
+			return std::nullopt;
+		}
+
+		const MappedFile file(a_path);
+		if (!file) {
+			return std::nullopt;
+		}
+
+		return FileKey{ stat->size, stat->modifiedTime, Binary::hash(file.bytes()) };
+	}
+
+	std::optional<FileKey> GetFileKey(const std::string& a_path, std::span<const std::byte> a_contents)
+	{
+		const auto stat = detail::stat(a_path);
+		if (!stat || stat->size != a_contents.size()) {
+			return std::nullopt;
+		}
+
+		return FileKey{ stat->size, stat->modifiedTime, Binary::hash(a_contents) };
+	}
+
+	std::uint64_t Hash(const Data& a_data)
+	{
+		detail::Writer writer{};
+		detail::save(writer, a_data);
+		return Binary::hash(writer.bytes());
+	}
+
+	LoadResult Load(const std::filesystem::path& a_cachePath, std::vector<ConfigFile>& a_files)
+	{
+		using namespace detail;
+
+		LoadResult result{};
+
+		const MappedFile cacheFile(a_cachePath);
+		if (!cacheFile) {
+			result.error = Binary::describe(Binary::FileError::kNotFound);
+			return result;
+		}
+
+		const auto payload = Binary::open_payload(cacheFile.bytes(), header);
+		if (!payload) {
+			result.error = Binary::describe(payload.error());
+			return result;
+		}
+
+		StringMap<CachedFile> cachedFiles{};
+
+		try {
+			Reader reader(*payload);
+
+			ParseSettings settings{};
+			settings.sanitizeConfigs = reader.read<bool>();
+			settings.logLevel = reader.read<spdlog::level::level_enum>();
+			if (settings != current_settings()) {
+				result.error = "was written with different settings";
+				return result;
+			}
+
+			for (auto count = reader.read_count(); count > 0; --count) {
+				const auto path = reader.read_string();
+
+				CachedFile cached{};
+				cached.key.size = reader.read<std::uint64_t>();
+				cached.key.modifiedTime = reader.read<std::int64_t>();
+				cached.key.hash = reader.read<std::uint64_t>();
+				cached.entries = reader.read_block();
+
+				cachedFiles.try_emplace(std::string(path), cached);
+			}
+		} catch (const Binary::ReadError&) {
+			result.error = Binary::describe(Binary::FileError::kCorrupted);
+			return result;
+		}
+
+		result.cached = cachedFiles.size();
+
+		std::atomic_size_t loaded{ 0 };
+		std::atomic_size_t changed{ 0 };
+
+		std::for_each(std::execution::par, a_files.begin(), a_files.end(), [&](ConfigFile& a_file) {
+			const auto it = cachedFiles.find(a_file.path);
+			if (it == cachedFiles.end()) {
+				return;
+			}
+
+			const auto& [cachedKey, entries] = it->second;
+
+			// Content is only hashed when cheaper checks pass.
+			const auto stat = detail::stat(a_file.path);
+			if (!stat || stat->size != cachedKey.size || stat->modifiedTime != cachedKey.modifiedTime) {
+				++changed;
+				return;
+			}
+
+			const auto key = GetFileKey(a_file.path);
+			if (!key || *key != cachedKey) {
+				++changed;
+				return;
+			}
+
+			try {
+				Reader reader(entries);
+				load(reader, a_file);
+
+				a_file.key = key;
+				a_file.cached = true;
+				++loaded;
+			} catch (const Binary::ReadError&) {
+				// Payload hash matched, so this can only happen if the cache was written by a buggy build. Parse the file instead.
+				a_file = ConfigFile{ .path = std::move(a_file.path) };
+				++changed;
+			}
+		});
+
+		result.loaded = loaded;
+		result.changed = changed;
+
+		return result;
+	}
+
+	std::expected<void, std::string> Save(const std::filesystem::path& a_cachePath, const std::vector<ConfigFile>& a_files)
+	{
+		using namespace detail;
+
+		Writer payload{};
+
+		const auto settings = current_settings();
+		payload.write(settings.sanitizeConfigs);
+		payload.write(settings.logLevel);
+
+		const auto cachedFiles = std::ranges::count_if(a_files, [](const auto& file) { return file.key.has_value(); });
+		payload.write(static_cast<std::uint32_t>(cachedFiles));
+
+		for (const auto& file : a_files) {
+			if (!file.key) {
+				continue;
+			}
+
+			payload.write(file.path);
+			payload.write(file.key->size);
+			payload.write(file.key->modifiedTime);
+			payload.write(file.key->hash);
+
+			const auto block = payload.begin_block();
+			save(payload, file);
+			payload.end_block(block);
+		}
+
+		if (!Binary::save_file(a_cachePath, header, payload)) {
+			return std::unexpected(fmt::format("couldn't write {}", a_cachePath.string()));
+		}
+
+		return {};
+	}
+}
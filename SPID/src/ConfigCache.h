@@ -0,0 +1,97 @@
+#pragma once
+#include "DeathDistribution.h"
+#include "ExclusiveGroups.h"
+#include "LinkedDistribution.h"
+#include "LookupConfigs.h"
+
+namespace Distribution::INI
+{
+	/// Messages logged while parsing a single file, in the order they were logged.
+	using DeferredLog = std::vector<std::pair<spdlog::level::level_enum, std::string>>;
+
+	/// <summary>
+	/// Identity of a config file's contents.
+	/// Cached entries of a file are only reused when all of these match the file on disk.
+	/// </summary>
+	struct FileKey
+	{
+		std::uint64_t size{ 0 };
+		std::int64_t  modifiedTime{ 0 };
+		std::uint64_t hash{ 0 };
+
+		bool operator==(const FileKey&) const = default;
+	};
+
+	/// Entries parsed from a single config file.
+	struct ConfigFile
+	{
+		std::string path{};
+
+		Configs                                    configs{};
+		Configs                                    deathConfigs{};
+		LinkedDistribution::INI::LinkedFormsConfig linkedConfigs{};
+		ExclusiveGroups::INI::ExclusiveGroupsVec   exclusiveGroups{};
+
+		DeferredLog log{};
+		bool        shouldLogErrors{ false };
+
+		/// Key of the file as it was after parsing. Files without a key are not cached.
+		std::optional<FileKey> key{};
+		/// Whether entries were loaded from the cache instead of being parsed.
+		bool cached{ false };
+	};
+
+	/// <summary>
+	/// Binary cache of parsed config files.
+	///
+	/// Everything that parsing a file produces (entries of all distribution types, exclusive groups and log messages) is stored per file,
+	/// along with the file's size, modification time and content hash.
+	/// On the next launch files whose key still matches are loaded from the memory-mapped cache instead of being read, sanitized and parsed again.
+	///
+	/// The cache is only valid for the exact build and settings that wrote it and is ignored entirely if it is corrupted.
+	/// </summary>
+	namespace Cache
+	{
+		struct LoadResult
+		{
+			/// Number of files whose entries were loaded from the cache.
+			std::size_t loaded{ 0 };
+			/// Number of files that were cached, but changed since then.
+			std::size_t changed{ 0 };
+			/// Number of files stored in the cache.
+			std::size_t cached{ 0 };
+			/// Reason why the cache couldn't be used at all. Empty if it was used.
+			std::string error{};
+
+			/// Whether the cache must be rewritten to match current files.
+			[[nodiscard]] bool IsStale(std::size_t a_totalFiles) const
+			{
+				return loaded != a_totalFiles || cached != a_totalFiles;
+			}
+		};
+
+		/// Default location of the cache, next to SPID's log.
+		std::optional<std::filesystem::path> GetDefaultPath();
+
+		/// Reads the current key of a file. Returns nullopt if file can't be read.
+		std::optional<FileKey> GetFileKey(const std::string& a_path);
+
+		/// Same as above, but hashes a_contents that were already read from the file instead of reading it again.
+		std::optional<FileKey> GetFileKey(const std::string& a_path, std::span<const std::byte> a_contents);
+
+		/// Hash of an entry's serialized form. Entries with equal hashes were parsed from the same text of the same file.
+		std::uint64_t Hash(const Data& a_data);
+
+		/// <summary>
+		/// Loads entries of all unchanged files from the cache at a_cachePath and marks them as cached.
+		/// Files that are not in the cache or changed since it was written are left untouched and must be parsed.
+		/// </summary>
+		LoadResult Load(const std::filesystem::path& a_cachePath, std::vector<ConfigFile>& a_files);
+
+		/// <summary>
+		/// Writes entries of all given files to the cache at a_cachePath.
+		/// The cache is written to a temporary file first and then renamed, so a cache is never left half-written.
+		/// </summary>
+		std::expected<void, std::string> Save(const std::filesystem::path& a_cachePath, const std::vector<ConfigFile>& a_files);
+	}
+}
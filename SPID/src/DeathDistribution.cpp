@@ -1,11 +1,14 @@
 #include "DeathDistribution.h"
 #include "Distribute.h"
+#include "DistributionJournal.h"
 #include "Hooking.h"
+#include "Latency.h"
 #include "LinkedDistribution.h"
 #include "LookupNPC.h"
 #include "Outfits/OutfitManager.h"
 #include "PCLevelMultManager.h"
 #include "Parser.h"
+#include "Trace.h"
 
 namespace DeathDistribution
 {
@@ -16,20 +19,18 @@ namespace DeathDistribution
 		struct DeathKeyComponentParser
 		{
 			template <Distribution::INI::concepts::typed_data Data>
-			bool operator()(const std::string& originalKey, Data& data) const
+			bool operator()(std::string_view key, Data& data) const
 			{
-				std::string key = originalKey;
-
 				if (key.starts_with("Final"sv)) {
 					data.recordTraits = RECORD::TRAITS::Final;
-					key.erase(0, 5);
+					key.remove_prefix(5);
 				}
 
 				if (!key.starts_with("Death"sv)) {
 					return false;
 				}
 
-				key.erase(0, 5);
+				key.remove_prefix(5);
 
 				auto type = RECORD::GetType(key);
 
@@ -45,9 +46,7 @@ namespace DeathDistribution
 		using DeathData = Distribution::INI::Data;
 		using DataVec = Distribution::INI::DataVec;
 
-		Map<RECORD::TYPE, DataVec> deathConfigs{};
-
-		bool TryParse(const std::string& key, const std::string& value, const Path& path)
+		bool TryParse(const std::string& key, const std::string& value, const Path& path, Distribution::INI::Configs& a_configs)
 		{
 			using namespace Distribution::INI;
 
@@ -72,7 +71,7 @@ namespace DeathDistribution
 						logger::warn("\t\t[{} = {}]", key, value);
 						logger::warn("\t\t\tFinal modifier can only be applied to Outfits.");
 					}
-					deathConfigs[data.type].emplace_back(data);
+					a_configs[data.type].emplace_back(data);
 				} else {
 					return false;
 				}
@@ -81,6 +80,13 @@ namespace DeathDistribution
 			}
 			return true;
 		}
+
+		void CollectRawForms(RawFormRefs& refs)
+		{
+			for (const auto& [type, entries] : deathConfigs) {
+				Distribution::INI::CollectRawForms(entries, refs);
+			}
+		}
 	}
 
 #pragma endregion
@@ -276,6 +282,7 @@ namespace DeathDistribution
 			});
 		}
 
+		Distribution::Journal::Append(distributedForms, data, Distribution::Journal::Phase::kDeath);
 		Distribute::LogDistribution(distributedForms, data, false, "[💀][📦] ");
 	}
 
@@ -287,6 +294,8 @@ namespace DeathDistribution
 
 		if (const auto actor = a_event->actorDying->As<RE::Actor>(); actor && !actor->IsPlayerRef()) {
 			if (const auto npc = actor->GetActorBase(); npc) {
+				TRACE_ZONE("TESDeathEvent");
+				Latency::Scope latency(Latency::Hook::kDeathDistribution);
 				logger::debug("[💀] Dying {}", *actor);
 				auto npcData = NPCData(actor, npc, true);
 				Distribute(npcData);
@@ -6,11 +6,18 @@ namespace DeathDistribution
 {
 	namespace INI
 	{
+		inline Distribution::INI::Configs deathConfigs{};
+
 		/// <summary>
 		/// Checks whether given entry is an On Death Distributable Form and attempts to parse it.
 		/// </summary>
 		/// <returns>True if given entry was an On Death Distribuatble Form. Note that returned value doesn't represent whether parsing was successful.</returns>
-		bool TryParse(const std::string& key, const std::string& value, const Path&);
+		bool TryParse(const std::string& key, const std::string& value, const Path&, Distribution::INI::Configs& a_configs = deathConfigs);
+
+		/// <summary>
+		/// Appends identifiers of all forms referenced by parsed On Death Distributable Forms.
+		/// </summary>
+		void CollectRawForms(RawFormRefs&);
 	}
 
 	using namespace Forms;
@@ -25,6 +25,7 @@ struct StringFilters : Filters<std::string>
 };
 
 using RawFormVec = std::vector<FormOrEditorID>;
+using RawFormRefs = std::vector<const FormOrEditorID*>;  // non-owning, points into config entries
 using RawFormFilters = Filters<FormOrEditorID>;
 
 using FormOrMod = std::variant<RE::TESForm*,  // form
@@ -83,15 +84,48 @@ struct LevelFilters
 	std::vector<SkillLevel> skillWeights{};  // skill weights (from Class)
 };
 
+/// Trait filters compiled into a pair of bit masks.
+///
+/// `mask` marks which traits are checked by the entry and `value` holds the expected state of each checked trait.
+/// NPC's own traits are packed into the same bits once per NPC (see NPC::Data::GetTraits),
+/// so the whole trait filter is a single (npcTraits & mask) == value test.
 struct Traits
 {
-	std::optional<RE::SEX> sex{};
-	std::optional<bool>    unique{};
-	std::optional<bool>    summonable{};
-	std::optional<bool>    child{};
-	std::optional<bool>    leveled{};
-	std::optional<bool>    teammate{};
-	std::optional<bool>    startsDead{};
+	enum Flag : std::uint8_t
+	{
+		kNone = 0,
+		kFemale = 1 << 0,
+		kUnique = 1 << 1,
+		kSummonable = 1 << 2,
+		kChild = 1 << 3,
+		kLeveled = 1 << 4,
+		kTeammate = 1 << 5,
+		kDead = 1 << 6,  // either dead or starts dead
+	};
+
+	std::uint8_t mask{ kNone };
+	std::uint8_t value{ kNone };
+
+	/// Requires given trait to be in a_state. Setting the same trait again overrides previous requirement.
+	void Set(Flag a_flag, bool a_state)
+	{
+		mask |= a_flag;
+		if (a_state) {
+			value |= a_flag;
+		} else {
+			value &= static_cast<std::uint8_t>(~a_flag);
+		}
+	}
+
+	[[nodiscard]] bool IsEmpty() const
+	{
+		return mask == kNone;
+	}
+
+	[[nodiscard]] bool Matches(std::uint8_t a_traits) const
+	{
+		return (a_traits & mask) == value;
+	}
 };
 
 using Path = std::string;
@@ -134,20 +168,6 @@ inline void hash_combine(std::size_t& seed, const T& v, Rest... rest)
 	hash_combine(seed, rest...);
 }
 
-/// A standardized way of converting any object to string.
-///
-///	<p>
-///	Overload `operator<<` to provide custom formatting for your value.
-///	Alternatively, specialize this method and provide your own implementation.
-///	</p>
-template <typename Value>
-std::string describe(Value value)
-{
-	std::ostringstream os;
-	os << value;
-	return os.str();
-}
-
 inline std::ostream& operator<<(std::ostream& os, RE::TESFile* file)
 {
 	os << file->fileName;
@@ -172,6 +192,23 @@ inline std::ostream& operator<<(std::ostream& os, RE::TESForm* form)
 	return os;
 }
 
+// Defined in FormData.h for Forms::DistributedForm.
+inline std::ostream& operator<<(std::ostream& os, std::pair<RE::TESForm*, const Path> form);
+
+/// A standardized way of converting any object to string.
+///
+///	<p>
+///	Overload `operator<<` to provide custom formatting for your value.
+///	Alternatively, specialize this method and provide your own implementation.
+///	</p>
+template <typename Value>
+std::string describe(Value value)
+{
+	std::ostringstream os;
+	os << value;
+	return os.str();
+}
+
 namespace fmt
 {
 	// Produces formatted strings for all Forms like this:
@@ -2,8 +2,11 @@
 
 #include "DeathDistribution.h"
 #include "DistributeManager.h"
+#include "DistributionJournal.h"
 #include "LinkedDistribution.h"
 #include "Outfits/OutfitManager.h"
+#include "Shadow.h"
+#include "Trace.h"
 
 namespace Distribute
 {
@@ -12,6 +15,10 @@ namespace Distribute
 		const auto npc = npcData.GetNPC();
 		const auto actor = npcData.GetActor();
 
+		if (Shadow::IsEnabled()) {
+			Shadow::Run(npcData, input, forms);
+		}
+
 		for_each_form<RE::BGSKeyword>(
 			npcData, forms.keywords, input, [&](const std::vector<RE::BGSKeyword*>& a_keywords) {
 				npc->AddKeywords(a_keywords);
@@ -59,14 +66,14 @@ namespace Distribute
 			npcData, forms.packages, input, [&](auto* a_packageOrList, [[maybe_unused]] IndexOrCount a_idx) {
 				auto packageIdx = std::get<Index>(a_idx);
 				if (a_packageOrList->Is(RE::FormType::Package)) {
-					auto package = a_packageOrList->As<RE::TESPackage>();
+					auto package = a_packageOrList->template As<RE::TESPackage>();
 
 					auto& packageList = npc->aiPackages.packages;
 					if (std::ranges::find(packageList, package) == packageList.end()) {
 						packageList.insert_at(packageIdx, package);
 					}
 				} else if (a_packageOrList->Is(RE::FormType::FormList)) {
-					auto packageList = a_packageOrList->As<RE::BGSListForm>();
+					auto packageList = a_packageOrList->template As<RE::BGSListForm>();
 
 					switch (packageIdx) {
 					case 0:
@@ -131,10 +138,16 @@ namespace Distribute
 			accumulatedForms);
 	}
 
-	void Distribute(NPCData& npcData, const PCLevelMult::Input& input)
+	std::uint32_t Distribute(NPCData& npcData, const PCLevelMult::Input& input)
 	{
+		TRACE_ZONE("Distribute");
+
 		if (input.onlyPlayerLevelEntries && PCLevelMult::Manager::GetSingleton()->HasHitLevelCap(input))
-			return;
+			return Forms::distributablesGeneration;
+
+		ReadLocker locker(Forms::distributablesLock);
+
+		const std::uint32_t generation = Forms::distributablesGeneration;
 
 		Forms::DistributionSet entries{
 			Forms::spells.GetForms(input.onlyPlayerLevelEntries),
@@ -161,14 +174,21 @@ namespace Distribute
 			});
 		}
 
+		Distribution::Journal::Append(distributedForms, npcData, input.onlyPlayerLevelEntries ? Distribution::Journal::Phase::kLevelUp : Distribution::Journal::Phase::kRegular);
 		LogDistribution(distributedForms, npcData, false, "[📦] ");
+
+		return generation;
 	}
 
 	void DistributeOutfits(NPCData& npcData, const PCLevelMult::Input& input)
 	{
+		TRACE_ZONE("DistributeOutfits");
+
 		if (input.onlyPlayerLevelEntries && PCLevelMult::Manager::GetSingleton()->HasHitLevelCap(input))
 			return;
 
+		ReadLocker locker(Forms::distributablesLock);
+
 		Forms::DistributionSet entries{
 			Forms::DistributionSet::empty<RE::SpellItem>(),
 			Forms::DistributionSet::empty<RE::BGSPerk>(),
@@ -187,16 +207,17 @@ namespace Distribute
 
 		Distribute(npcData, input, entries, &distributedForms, Outfits::SetDefaultOutfit);
 
+		Distribution::Journal::Append(distributedForms, npcData, Distribution::Journal::Phase::kOutfits);
 		LogDistribution(distributedForms, npcData, true, "[📦] ");
 	}
 
-	void Distribute(NPCData& npcData, bool onlyLeveledEntries)
+	std::uint32_t Distribute(NPCData& npcData, bool onlyLeveledEntries)
 	{
 		const auto input = PCLevelMult::Input{ npcData.GetActor(), npcData.GetNPC(), onlyLeveledEntries };
 
 		// We always do the normal distribution even for Dead NPCs,
 		// if Distributable Form is only meant to be distributed while NPC is alive, the entry must contain -D filter.
-		Distribute(npcData, input);
+		return Distribute(npcData, input);
 	}
 
 	void DistributeOutfits(NPCData& npcData, bool onlyLeveledEntries)
@@ -208,8 +229,78 @@ namespace Distribute
 		DistributeOutfits(npcData, input);
 	}
 
+	void DistributeReloaded(NPCData& npcData, std::uint32_t sinceGeneration)
+	{
+		const auto input = PCLevelMult::Input{ npcData.GetActor(), npcData.GetNPC(), false };
+
+		ReadLocker locker(Forms::distributablesLock);
+
+		// Only entries added since sinceGeneration are distributed, so they're copied with their counts reset,
+		// and whatever they were distributed to is counted on the original entries afterwards.
+		const auto reloaded = [&]<class Form>(Forms::Distributables<Form>& a_distributable) {
+			Forms::DataVec<Form> result{};
+			for (const auto& formData : a_distributable.GetForms()) {
+				if (formData.generation > sinceGeneration) {
+					result.push_back(formData);
+					result.back().npcCount = 0;
+				}
+			}
+			return result;
+		};
+
+		const auto countDistributed = [&]<class Form>(Forms::Distributables<Form>& a_distributable, const Forms::DataVec<Form>& a_reloaded) {
+			auto reloadedData = a_reloaded.begin();
+			for (auto& formData : a_distributable.GetForms()) {
+				if (formData.generation > sinceGeneration) {
+					formData.npcCount += (reloadedData++)->npcCount;
+				}
+			}
+		};
+
+		auto spells = reloaded(Forms::spells);
+		auto perks = reloaded(Forms::perks);
+		auto items = reloaded(Forms::items);
+		auto shouts = reloaded(Forms::shouts);
+		auto levSpells = reloaded(Forms::levSpells);
+		auto packages = reloaded(Forms::packages);
+		auto outfits = reloaded(Forms::outfits);
+		auto keywords = reloaded(Forms::keywords);
+		auto factions = reloaded(Forms::factions);
+		auto sleepOutfits = reloaded(Forms::sleepOutfits);
+		auto skins = reloaded(Forms::skins);
+
+		Forms::DistributionSet entries{ spells, perks, items, shouts, levSpells, packages, outfits, keywords, factions, sleepOutfits, skins };
+		if (entries.IsEmpty()) {
+			return;
+		}
+
+		DistributedForms distributedForms{};
+
+		Distribute(npcData, input, entries, &distributedForms, Outfits::SetDefaultOutfit);
+
+		countDistributed(Forms::spells, spells);
+		countDistributed(Forms::perks, perks);
+		countDistributed(Forms::items, items);
+		countDistributed(Forms::shouts, shouts);
+		countDistributed(Forms::levSpells, levSpells);
+		countDistributed(Forms::packages, packages);
+		countDistributed(Forms::outfits, outfits);
+		countDistributed(Forms::keywords, keywords);
+		countDistributed(Forms::factions, factions);
+		countDistributed(Forms::sleepOutfits, sleepOutfits);
+		countDistributed(Forms::skins, skins);
+
+		Distribution::Journal::Append(distributedForms, npcData, Distribution::Journal::Phase::kReload);
+		LogDistribution(distributedForms, npcData, false, "[🔄] ");
+	}
+
 	void LogDistribution(const DistributedForms& forms, NPCData& npcData, bool append, const char* prefix)
 	{
+		// Called for every processed NPC, so nothing is grouped unless it'll be logged.
+		if (!spdlog::should_log(spdlog::level::info)) {
+			return;
+		}
+
 		//#ifndef NDEBUG
 		std::map<std::string_view, std::vector<DistributedForm>> results;
 
@@ -3,16 +3,22 @@
 #include "FormData.h"
 #include "LookupNPC.h"
 #include "PCLevelMultManager.h"
+#include "Profiler.h"
 
 namespace Distribute
 {
 	namespace detail
 	{
+		/// <summary>
+		/// Checks filters of given entry, taking into account entries that were already rejected at current player level.
+		/// </summary>
+		/// <param name="failedStage">An optional pointer that receives the stage at which NPC was rejected.</param>
 		template <class Form>
 		bool passed_filters(
 			const NPCData&            a_npcData,
 			const PCLevelMult::Input& a_input,
-			const Forms::Data<Form>&  a_formData)
+			const Forms::Data<Form>&  a_formData,
+			Filter::Stage*            a_failedStage = nullptr)
 		{
 			const auto pcLevelMultManager = PCLevelMult::Manager::GetSingleton();
 
@@ -21,10 +27,13 @@ namespace Distribute
 			const auto index = a_formData.index;
 
 			if (hasLevelFilters && pcLevelMultManager->FindRejectedEntry(a_input, distributedFormID, index)) {
+				if (a_failedStage) {
+					*a_failedStage = Filter::Stage::kChance;
+				}
 				return false;
 			}
 
-			auto result = a_formData.filters.PassedFilters(a_npcData);
+			auto result = a_failedStage ? a_formData.filters.PassedFilters(a_npcData, *a_failedStage) : a_formData.filters.PassedFilters(a_npcData);
 
 			if (result != Filter::Result::kPass) {
 				if (hasLevelFilters && result == Filter::Result::kFailRNG) {
@@ -44,6 +53,43 @@ namespace Distribute
 			return a_formData.filters.PassedFilters(a_npcData) == Filter::Result::kPass;
 		}
 
+		/// <summary>
+		/// Same as should_distribute, but records the outcome and duration of evaluation in Profiler.
+		/// </summary>
+		template <class Form>
+		bool should_distribute_profiled(
+			const NPCData&            a_npcData,
+			const PCLevelMult::Input& a_input,
+			const Forms::Data<Form>&  a_formData)
+		{
+			const auto start = Profiler::clock::now();
+
+			std::optional<Profiler::Rejection> rejection{};
+			if (a_npcData.HasMutuallyExclusiveForm(a_formData.form)) {
+				rejection = Profiler::Rejection::kExclusive;
+			} else if (Filter::Stage stage; !passed_filters(a_npcData, a_input, a_formData, &stage)) {
+				rejection = static_cast<Profiler::Rejection>(stage);
+			}
+
+			Profiler::Record(a_formData.form, a_formData.index, a_formData.path, rejection, Profiler::clock::now() - start);
+			return !rejection;
+		}
+
+		/// <summary>
+		/// Checks whether given entry should be distributed to NPC: it must pass all filters and NPC must not have any form from the same exclusive group.
+		/// </summary>
+		template <class Form>
+		bool should_distribute(
+			const NPCData&            a_npcData,
+			const PCLevelMult::Input& a_input,
+			const Forms::Data<Form>&  a_formData)
+		{
+			if (Profiler::IsEnabled()) [[unlikely]] {
+				return should_distribute_profiled(a_npcData, a_input, a_formData);
+			}
+			return !a_npcData.HasMutuallyExclusiveForm(a_formData.form) && passed_filters(a_npcData, a_input, a_formData);
+		}
+
 		/// <summary>
 		/// Check that NPC doesn't already have the form that is about to be distributed.
 		/// </summary>
@@ -59,7 +105,7 @@ namespace Distribute
 				return actorEffects && actorEffects->GetIndex(a_form).has_value();
 			} else if constexpr (std::is_same_v<RE::TESForm, Form>) {
 				if (a_form->Is(RE::TESPackage::FORMTYPE)) {
-					auto  package = a_form->As<RE::TESPackage>();
+					auto  package = a_form->template As<RE::TESPackage>();
 					auto& packageList = a_npc->aiPackages.packages;
 					return std::ranges::find(packageList, package) != packageList.end();
 				} else {
@@ -85,7 +131,7 @@ namespace Distribute
 		DistributedForms*                        accumulatedForms = nullptr)
 	{
 		for (auto& formData : forms) {
-			if (!a_npcData.HasMutuallyExclusiveForm(formData.form) && detail::passed_filters(a_npcData, a_input, formData)) {
+			if (detail::should_distribute(a_npcData, a_input, formData)) {
 				if (accumulatedForms) {
 					accumulatedForms->insert({ formData.form, formData.path });
 				}
@@ -106,7 +152,7 @@ namespace Distribute
 		DistributedForms*                        accumulatedForms = nullptr)
 	{
 		for (auto& formData : forms) {
-			if (!a_npcData.HasMutuallyExclusiveForm(formData.form) && detail::passed_filters(a_npcData, a_input, formData) && a_callback(formData.form, formData.isFinal)) {
+			if (detail::should_distribute(a_npcData, a_input, formData) && a_callback(formData.form, formData.isFinal)) {
 				if (accumulatedForms) {
 					accumulatedForms->insert({ formData.form, formData.path });
 				}
@@ -132,9 +178,9 @@ namespace Distribute
 		std::map<Form*, Count> collectedForms{};
 
 		for (auto& formData : forms) {
-			if (!a_npcData.HasMutuallyExclusiveForm(formData.form) && detail::passed_filters(a_npcData, a_input, formData)) {
+			if (detail::should_distribute(a_npcData, a_input, formData)) {
 				auto count = std::get<RandomCount>(formData.idxOrCount).GetRandom();
-				if (auto leveledItem = formData.form->As<RE::TESLevItem>()) {
+				if (auto leveledItem = formData.form->template As<RE::TESLevItem>()) {
 					auto                                level = a_npcData.GetLevel();
 					RE::BSScrapArray<RE::CALCED_OBJECT> calcedObjects{};
 
@@ -189,7 +235,7 @@ namespace Distribute
 				continue;
 			}
 			if constexpr (std::is_same_v<RE::BGSKeyword, Form>) {
-				if (!a_npcData.HasMutuallyExclusiveForm(form) && detail::passed_filters(a_npcData, a_input, formData) && a_npcData.InsertKeyword(form->GetFormEditorID())) {
+				if (detail::should_distribute(a_npcData, a_input, formData) && a_npcData.InsertKeyword(form->GetFormEditorID())) {
 					collectedForms.emplace_back(form);
 					collectedFormIDs.emplace(formID);
 					if (formData.filters.HasLevelFilters()) {
@@ -201,7 +247,7 @@ namespace Distribute
 					++formData.npcCount;
 				}
 			} else {
-				if (!a_npcData.HasMutuallyExclusiveForm(form) && detail::passed_filters(a_npcData, a_input, formData) && !detail::has_form(npc, form) && collectedFormIDs.emplace(formID).second) {
+				if (detail::should_distribute(a_npcData, a_input, formData) && !detail::has_form(npc, form) && collectedFormIDs.emplace(formID).second) {
 					collectedForms.emplace_back(form);
 					if (formData.filters.HasLevelFilters()) {
 						collectedLeveledFormIDs.emplace(formID);
@@ -242,7 +288,8 @@ namespace Distribute
 	/// </summary>
 	/// <param name="npcData">General information about NPC that is being processed.</param>
 	/// <param name="onlyLeveledEntries"> Flag indicating that distribution is invoked by a leveling event and only entries with LevelFilters needs to be processed.</param>
-	void Distribute(NPCData& npcData, bool onlyLeveledEntries);
+	/// <returns>Generation of entries that were distributed (see Distribution::HotReload).</returns>
+	std::uint32_t Distribute(NPCData& npcData, bool onlyLeveledEntries);
 
 	/// <summary>
 	/// Performs distribution of outfits to NPC described with npcData and input.
@@ -253,5 +300,12 @@ namespace Distribute
 	/// <param name="onlyLeveledEntries"></param>
 	void DistributeOutfits(NPCData& npcData, bool onlyLeveledEntries);
 
+	/// <summary>
+	/// Performs distribution of entries that were added by hot reload after given generation (see Distribution::HotReload).
+	/// </summary>
+	/// <param name="npcData">General information about NPC that is being processed.</param>
+	/// <param name="sinceGeneration">Generation of entries that NPC already received.</param>
+	void DistributeReloaded(NPCData& npcData, std::uint32_t sinceGeneration);
+
 	void LogDistribution(const DistributedForms& forms, NPCData& npcData, bool append, const char* prefix = "");
 }
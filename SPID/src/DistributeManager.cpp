@@ -2,6 +2,10 @@
 #include "Distribute.h"
 #include "DistributePCLevelMult.h"
 #include "Hooking.h"
+#include "HotReload.h"
+#include "Latency.h"
+#include "SessionCapture.h"
+#include "Trace.h"
 
 namespace Distribute
 {
@@ -12,11 +16,17 @@ namespace Distribute
 
 	void detail::distribute_on_load(RE::Actor* actor, RE::TESNPC* npc)
 	{
-		auto npcData = NPCData(actor, npc);
 		if (should_process_NPC(npc)) {
 			if (!npc->HasKeyword(processed)) {
-				Distribute(npcData, false);
+				Latency::Scope               latency(Latency::Hook::kDistribute);
+				Distribution::Capture::Scope capture(actor, npc, false);
+				auto                         npcData = NPCData(actor, npc);
+				const auto generation = Distribute(npcData, false);
 				npc->AddKeyword(processed);
+				Distribution::HotReload::MarkDistributed(npc, generation);
+			} else if (const auto since = Distribution::HotReload::CatchUp(npc)) {
+				auto npcData = NPCData(actor, npc);
+				DistributeReloaded(npcData, *since);
 			}
 		}
 	}
@@ -34,6 +44,7 @@ namespace Distribute
 			{
 				//	logger::debug("Distribute: ShouldBackgroundClone({})", *(actor->As<RE::Actor>()));
 				if (const auto npc = actor->GetActorBase()) {
+					TRACE_ZONE("ShouldBackgroundClone");
 					detail::distribute_on_load(actor, npc);
 				}
 				return func(actor);
@@ -2,7 +2,10 @@
 #include "Distribute.h"
 #include "DistributeManager.h"
 #include "Hooking.h"
+#include "Latency.h"
 #include "PCLevelMultManager.h"
+#include "SessionCapture.h"
+#include "Trace.h"
 
 namespace Distribute::PlayerLeveledActor
 {
@@ -16,7 +19,10 @@ namespace Distribute::PlayerLeveledActor
 		static void thunk(RE::Actor* a_actor)
 		{
 			if (const auto npc = a_actor->GetActorBase(); npc && npc->HasKeyword(processed)) {
-				auto npcData = NPCData(a_actor, npc);
+				TRACE_ZONE("HandleUpdatePlayerLevel");
+				Latency::Scope latency(Latency::Hook::kLevelUp);
+				Distribution::Capture::Scope capture(a_actor, npc, true);
+				auto                         npcData = NPCData(a_actor, npc);
 				Distribute(npcData, true);
 				DistributeOutfits(npcData, true);
 			}
@@ -0,0 +1,185 @@
+#include "DistributionJournal.h"
+#include "MappedFile.h"
+#include "Settings.h"
+
+namespace Distribution::Journal
+{
+	namespace detail
+	{
+		using clock = std::chrono::steady_clock;
+
+		/// The file grows by this much whenever it runs out of space.
+		constexpr std::size_t growth = 4 << 20;
+
+		Lock              lock;
+		AppendMappedFile  file{};
+		std::atomic<bool> journaling{ false };
+
+		std::filesystem::path entriesPath{};
+		EntryTable            table{};
+		bool                  tableChanged{ false };
+		clock::time_point     start{};
+
+		/// Indices of entries by a hash of their form and path.
+		Map<std::uint64_t, std::uint32_t> entryIndices{};
+
+		std::uint32_t get_entry(const RE::TESForm* a_form, const Path& a_path)
+		{
+			const auto formID = a_form->GetFormID();
+			const auto key = Binary::hash(a_path, formID);
+
+			if (const auto it = entryIndices.find(key); it != entryIndices.end()) {
+				return it->second;
+			}
+
+			const auto index = static_cast<std::uint32_t>(table.entries.size());
+			table.entries.push_back({
+				.formID = formID,
+				.formType = std::to_underlying(a_form->GetFormType()),
+				.formTypeName = std::string(RE::FormTypeToString(a_form->GetFormType())),
+				.editorID = editorID::get_editorID(a_form),
+				.path = a_path,
+			});
+			entryIndices.emplace(key, index);
+			tableChanged = true;
+
+			return index;
+		}
+
+		void save_entries()
+		{
+			if (!tableChanged) {
+				return;
+			}
+			if (const auto result = SaveEntries(entriesPath, table); !result) {
+				logger::warn("Failed to save entries of distribution journal to {} ({})", entriesPath.string(), Binary::describe(result.error()));
+				return;
+			}
+			tableChanged = false;
+		}
+	}
+
+	std::optional<std::filesystem::path> GetDefaultPath()
+	{
+		auto path = SKSE::log::log_directory();
+		if (!path) {
+			return std::nullopt;
+		}
+
+		*path /= Version::PROJECT;
+		*path += ".journal"sv;
+		return path;
+	}
+
+	void Start()
+	{
+		if (!Settings::GetSingleton()->distributionJournal) {
+			return;
+		}
+
+		if (const auto path = GetDefaultPath(); path && Start(*path)) {
+			logger::info("Journaling distribution to {}", path->string());
+		} else {
+			logger::warn("Failed to start journaling distribution");
+		}
+	}
+
+	bool Start(const std::filesystem::path& a_path)
+	{
+		using namespace detail;
+
+		WriteLocker locker(lock);
+
+		journaling = false;
+		if (!file.Open(a_path, growth)) {
+			return false;
+		}
+
+		const auto now = std::chrono::system_clock::now().time_since_epoch();
+
+		Header header{
+			.session = Binary::hash(a_path.string(), static_cast<std::uint64_t>(now.count())),
+			.startTime = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(now).count())
+		};
+		if (!file.Append(std::as_bytes(std::span(&header, 1)))) {
+			file.Close();
+			return false;
+		}
+
+		entriesPath = GetEntriesPath(a_path);
+		table = { .session = header.session };
+		entryIndices.clear();
+		// Empty table is saved too, so that a journal never comes without one.
+		tableChanged = true;
+		save_entries();
+
+		start = clock::now();
+		journaling = true;
+
+		return true;
+	}
+
+	void Stop()
+	{
+		WriteLocker locker(detail::lock);
+
+		if (detail::file.IsOpen()) {
+			detail::save_entries();
+			detail::file.Close();
+		}
+		detail::journaling = false;
+	}
+
+	void Flush()
+	{
+		WriteLocker locker(detail::lock);
+
+		if (detail::file.IsOpen()) {
+			detail::save_entries();
+			detail::file.Flush();
+		}
+	}
+
+	bool IsJournaling()
+	{
+		return detail::journaling;
+	}
+
+	void Append(const Forms::DistributedForms& a_forms, const NPCData& a_npcData, Phase a_phase)
+	{
+		if (!IsJournaling() || a_forms.empty()) {
+			return;
+		}
+
+		const auto timestamp = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(detail::clock::now() - detail::start).count());
+		const auto actorID = a_npcData.GetActor()->GetFormID();
+		const auto baseID = a_npcData.GetNPC()->GetFormID();
+
+		std::vector<Record> records{};
+		records.reserve(a_forms.size());
+
+		WriteLocker locker(detail::lock);
+		if (!detail::file.IsOpen()) {
+			return;
+		}
+
+		for (const auto& [form, path] : a_forms) {
+			records.push_back({
+				.timestamp = timestamp,
+				.actorID = actorID,
+				.baseID = baseID,
+				.formID = form->GetFormID(),
+				.entry = detail::get_entry(form, path),
+				.formType = std::to_underlying(form->GetFormType()),
+				.phase = a_phase,
+			});
+		}
+
+		if (!detail::file.Append(std::as_bytes(std::span(records)))) {
+			logger::warn("Failed to append to distribution journal, journaling is stopped");
+			detail::save_entries();
+			detail::file.Close();
+			detail::journaling = false;
+		}
+	}
+}
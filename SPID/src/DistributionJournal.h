@@ -0,0 +1,42 @@
+#pragma once
+
+#include "FormData.h"
+#include "JournalFormat.h"
+#include "LookupNPC.h"
+
+namespace Distribution
+{
+	/// <summary>
+	/// Opt-in binary journal of distribution, as a compact and queryable alternative to per-actor distribution logs.
+	///
+	/// Every distributed form is appended as a fixed-size record (see Journal::Record) to a memory-mapped file next to the log,
+	/// so appending never waits for the disk and records reach the file even if the game crashes.
+	/// Records refer to entries (a distributed form and the file that distributed it) by their index in an entry table,
+	/// which is saved next to the journal whenever the game is saved and when the journal is stopped.
+	///
+	/// Journals are decoded by SPIDJournal from SPIDTests.
+	/// Journal is disabled unless enabled in settings (see Settings::distributionJournal).
+	/// </summary>
+	namespace Journal
+	{
+		/// Default location of the journal, next to SPID's log.
+		std::optional<std::filesystem::path> GetDefaultPath();
+
+		/// Starts writing to the default path, if the journal is enabled.
+		void Start();
+
+		/// Starts writing to a_path and its entry table (see GetEntriesPath), overwriting both.
+		bool Start(const std::filesystem::path& a_path);
+
+		/// Saves the entry table and closes the journal.
+		void Stop();
+
+		/// Saves the entry table and asks the system to write appended records to disk, e.g. before the game is saved.
+		void Flush();
+
+		[[nodiscard]] bool IsJournaling();
+
+		/// Appends a record for each distributed form. Does nothing if the journal isn't running.
+		void Append(const Forms::DistributedForms& a_forms, const NPCData& a_npcData, Phase a_phase);
+	}
+}
@@ -0,0 +1,115 @@
+#include "EditorIDIndex.h"
+#include "StringKernels.h"
+
+namespace Forms
+{
+	void EditorIDIndex::Build()
+	{
+		Timer timer;
+		timer.start();
+
+		{
+			WriteLocker locker(lock);
+
+			forms.clear();
+			keywords.clear();
+			editorIDs.clear();
+			unnamedKeywords.clear();
+
+			// Game only keeps editorIDs for some form types, unless po3_Tweaks is installed.
+			const auto& [map, mapLock] = RE::TESForm::GetAllFormsByEditorID();
+			if (map) {
+				const RE::BSReadLockGuard mapLocker{ mapLock };
+
+				forms.reserve(map->size());
+				editorIDs.reserve(map->size());
+				for (const auto& [editorID, form] : *map) {
+					if (form && !editorID.empty()) {
+						insert_form(form, editorID.c_str());
+					}
+				}
+			}
+
+			if (const auto dataHandler = RE::TESDataHandler::GetSingleton()) {
+				for (const auto& keyword : dataHandler->GetFormArray<RE::BGSKeyword>()) {
+					if (keyword) {
+						insert_keyword(keyword);
+					}
+				}
+			}
+		}
+
+		timer.end();
+
+		logger::info("Indexed {} editorIDs and {} keywords in {}μs / {}ms", forms.size(), keywords.size(), timer.duration_μs(), timer.duration_ms());
+	}
+
+	RE::TESForm* EditorIDIndex::Find(std::string_view a_editorID) const
+	{
+		const auto folded = Strings::fold(a_editorID);
+
+		ReadLocker locker(lock);
+		if (const auto it = forms.find(folded); it != forms.end()) {
+			return it->second;
+		}
+		return nullptr;
+	}
+
+	RE::BGSKeyword* EditorIDIndex::FindKeyword(std::string_view a_editorID) const
+	{
+		const auto folded = Strings::fold(a_editorID);
+
+		ReadLocker locker(lock);
+		if (const auto it = keywords.find(folded); it != keywords.end()) {
+			return it->second;
+		}
+		return nullptr;
+	}
+
+	std::string_view EditorIDIndex::GetEditorID(const RE::TESForm* a_form) const
+	{
+		ReadLocker locker(lock);
+		if (const auto it = editorIDs.find(a_form); it != editorIDs.end()) {
+			return it->second;
+		}
+		return {};
+	}
+
+	void EditorIDIndex::InsertKeyword(RE::BGSKeyword* a_keyword)
+	{
+		WriteLocker locker(lock);
+		insert_keyword(a_keyword);
+	}
+
+	const std::vector<RE::BGSKeyword*>& EditorIDIndex::GetUnnamedKeywords() const
+	{
+		return unnamedKeywords;
+	}
+
+	std::size_t EditorIDIndex::Size() const
+	{
+		ReadLocker locker(lock);
+		return forms.size() + keywords.size();
+	}
+
+	void EditorIDIndex::insert_form(RE::TESForm* a_form, const char* a_editorID)
+	{
+		forms.try_emplace(Strings::fold(a_editorID), a_form);
+		editorIDs.try_emplace(a_form, a_editorID);
+	}
+
+	void EditorIDIndex::insert_keyword(RE::BGSKeyword* a_keyword)
+	{
+		const auto editorID = a_keyword->GetFormEditorID();
+		if (string::is_empty(editorID)) {
+			unnamedKeywords.push_back(a_keyword);
+			return;
+		}
+
+		// When several keywords share the same editorID (ignoring case) the first one in the array wins.
+		// This is the keyword that find_or_create_keyword used to find with linear search, so entries and keyword dependencies agree on it.
+		// Dependency resolution used to match editorIDs case-sensitively with the last duplicate winning instead.
+		keywords.try_emplace(Strings::fold(editorID), a_keyword);
+		editorIDs.try_emplace(a_keyword, editorID);
+	}
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+namespace Forms
+{
+	/// <summary>
+	/// Casefolded index of all forms that have editorIDs.
+	///
+	/// The index is built once at kDataLoaded before lookup and is shared by everything that needs to find forms by editorID
+	/// (form lookup, keyword creation, keyword dependencies) or editorIDs of forms (NPC::Data).
+	/// Keywords created by SPID are added to the index as they are created.
+	/// </summary>
+	class EditorIDIndex : public ISingleton<EditorIDIndex>
+	{
+	public:
+		/// <summary>
+		/// Indexes all forms registered in game's editorID map and all keywords.
+		/// </summary>
+		void Build();
+
+		/// <summary>
+		/// Finds a form with given editorID ignoring case. This is equivalent to RE::TESForm::LookupByEditorID.
+		/// </summary>
+		[[nodiscard]] RE::TESForm* Find(std::string_view a_editorID) const;
+
+		/// <summary>
+		/// Finds a keyword with given editorID ignoring case.
+		///
+		/// Keywords are indexed separately, since they store their own editorIDs and dynamically created keywords are never added to game's map.
+		/// </summary>
+		[[nodiscard]] RE::BGSKeyword* FindKeyword(std::string_view a_editorID) const;
+
+		/// <summary>
+		/// Returns original editorID of the form, or an empty string if form is not indexed.
+		/// </summary>
+		[[nodiscard]] std::string_view GetEditorID(const RE::TESForm* a_form) const;
+
+		/// <summary>
+		/// Adds newly created keyword to the index.
+		/// </summary>
+		void InsertKeyword(RE::BGSKeyword* a_keyword);
+
+		/// <summary>
+		/// Iterates over all indexed keywords with their casefolded editorIDs.
+		/// </summary>
+		template <class Func>
+		void ForEachKeyword(Func&& a_func) const
+		{
+			ReadLocker locker(lock);
+			for (const auto& [editorID, keyword] : keywords) {
+				a_func(std::string_view(editorID), keyword);
+			}
+		}
+
+		/// <summary>
+		/// Keywords that have empty editorIDs and thus can't be indexed.
+		/// </summary>
+		[[nodiscard]] const std::vector<RE::BGSKeyword*>& GetUnnamedKeywords() const;
+
+		[[nodiscard]] std::size_t Size() const;
+
+	private:
+		void insert_form(RE::TESForm* a_form, const char* a_editorID);
+		void insert_keyword(RE::BGSKeyword* a_keyword);
+
+		mutable Lock                              lock;
+		StringMap<RE::TESForm*>                   forms{};     // casefolded editorID -> form
+		StringMap<RE::BGSKeyword*>                keywords{};  // casefolded editorID -> keyword
+		Map<const RE::TESForm*, std::string_view> editorIDs{};  // form -> original editorID, stored in BSFixedString's pool
+		std::vector<RE::BGSKeyword*>              unnamedKeywords{};
+	};
+}
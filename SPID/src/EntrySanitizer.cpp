@@ -0,0 +1,214 @@
+#include "EntrySanitizer.h"
+
+#include <cstring>
+
+namespace Sanitizer
+{
+	namespace detail
+	{
+		// Character classes match ECMAScript's \s and \w that were used by regex-based sanitizer.
+		constexpr bool is_space(char a_ch)
+		{
+			return a_ch == ' ' || a_ch == '\t' || a_ch == '\n' || a_ch == '\v' || a_ch == '\f' || a_ch == '\r';
+		}
+
+		constexpr bool is_word(char a_ch)
+		{
+			return (a_ch >= 'a' && a_ch <= 'z') || (a_ch >= 'A' && a_ch <= 'Z') || (a_ch >= '0' && a_ch <= '9') || a_ch == '_';
+		}
+
+		constexpr bool is_hex(char a_ch)
+		{
+			return (a_ch >= '0' && a_ch <= '9') || (a_ch >= 'a' && a_ch <= 'f') || (a_ch >= 'A' && a_ch <= 'F');
+		}
+
+		constexpr bool is_separator(char a_ch)
+		{
+			return a_ch == '|' || a_ch == ',';
+		}
+
+		// (0x0*<index>)([0-9a-f]{6}) -> 0x$2~<master>, case-insensitive.
+		// This is the only rule that makes entry longer, so it is applied separately and only allocates when something matches.
+		void swap_master(std::string& a_entry, char a_index, std::string_view a_master)
+		{
+			const auto size = a_entry.size();
+
+			std::string result{};
+			std::size_t copied = 0;
+
+			std::size_t i = 0;
+			while (i + 1 < size) {
+				if (a_entry[i] == '0' && (a_entry[i + 1] == 'x' || a_entry[i + 1] == 'X')) {
+					auto j = i + 2;
+					while (j < size && a_entry[j] == '0') {
+						++j;
+					}
+					if (j + 7 <= size && a_entry[j] == a_index) {
+						bool isHex = true;
+						for (auto k = j + 1; k < j + 7 && isHex; ++k) {
+							isHex = is_hex(a_entry[k]);
+						}
+						if (isHex) {
+							result.append(a_entry, copied, i - copied);
+							result.append("0x");
+							result.append(a_entry, j + 1, 6);
+							result.push_back('~');
+							result.append(a_master);
+
+							i = j + 7;
+							copied = i;
+							continue;
+						}
+					}
+				}
+				++i;
+			}
+
+			if (copied > 0) {
+				result.append(a_entry, copied);
+				a_entry = std::move(result);
+			}
+		}
+
+		// Writes a single word (maximal run of \w characters) at a_write, applying formID rules to it.
+		// Neither rule makes a word longer, so a_write never overtakes the word that is being read.
+		std::size_t write_word(char* a_data, std::size_t a_begin, std::size_t a_end, std::size_t a_write)
+		{
+			// \b00+([0-9a-fA-F]{1,6})\b -> 0x$1
+			// Since the match is bounded by \b on both sides, it either covers the whole word or nothing.
+			if (a_end - a_begin >= 3 && a_data[a_begin] == '0' && a_data[a_begin + 1] == '0') {
+				bool isHex = true;
+				for (auto i = a_begin + 2; i < a_end && isHex; ++i) {
+					isHex = is_hex(a_data[i]);
+				}
+
+				if (isHex) {
+					auto digits = a_begin + 2;
+					while (digits < a_end && a_data[digits] == '0') {
+						++digits;
+					}
+
+					const auto count = a_end - digits;
+					if (count >= 1 && count <= 6) {
+						a_data[a_write] = '0';
+						a_data[a_write + 1] = 'x';
+						std::memmove(a_data + a_write + 2, a_data + digits, count);
+						return a_write + 2 + count;
+					}
+					if (count == 0) {
+						// Greedy 00+ gives its last zero back to the hex group.
+						a_data[a_write] = '0';
+						a_data[a_write + 1] = 'x';
+						a_data[a_write + 2] = '0';
+						return a_write + 3;
+					}
+				}
+			}
+
+			// (0x00+)([0-9a-fA-F]+) -> 0x$2
+			// Can match anywhere inside of the word, but never spans multiple words.
+			auto i = a_begin;
+			while (i < a_end) {
+				if (i + 3 < a_end && a_data[i] == '0' && a_data[i + 1] == 'x' && a_data[i + 2] == '0' && a_data[i + 3] == '0') {
+					auto digits = i + 4;
+					while (digits < a_end && a_data[digits] == '0') {
+						++digits;
+					}
+					auto end = digits;
+					while (end < a_end && is_hex(a_data[end])) {
+						++end;
+					}
+
+					if (end > digits) {
+						a_data[a_write] = '0';
+						a_data[a_write + 1] = 'x';
+						std::memmove(a_data + a_write + 2, a_data + digits, end - digits);
+						a_write += 2 + (end - digits);
+						i = end;
+						continue;
+					}
+					if (digits - (i + 2) >= 3) {
+						a_data[a_write] = '0';
+						a_data[a_write + 1] = 'x';
+						a_data[a_write + 2] = '0';
+						a_write += 3;
+						i = digits;
+						continue;
+					}
+				}
+				a_data[a_write++] = a_data[i++];
+			}
+
+			return a_write;
+		}
+	}
+
+	void sanitize(std::string_view a_entry, std::string& a_out, bool a_swapVRMasters)
+	{
+		a_out.assign(a_entry);
+
+		//formID hypen
+		if (a_out.find('~') == std::string::npos) {
+			if (const auto pos = a_out.find(" - "); pos != std::string::npos) {
+				a_out.replace(pos, 3, "~");
+			}
+		}
+
+		// swap dawnguard and dragonborn forms
+		// VR apparently does not load masters in order so the lookup fails
+		if (a_swapVRMasters) {
+			detail::swap_master(a_out, '2', "Dawnguard.esm");
+			detail::swap_master(a_out, '4', "Dragonborn.esm");
+		}
+
+		// Everything else only removes characters, so the rest is done in place in a single pass.
+		const auto data = a_out.data();
+		const auto size = a_out.size();
+
+		std::size_t read = 0;
+		std::size_t write = 0;
+		char        prev = '\0';  // last character before read position in the original entry
+
+		while (read < size) {
+			const auto ch = data[read];
+
+			if (detail::is_space(ch)) {
+				auto end = read + 1;
+				while (end < size && detail::is_space(data[end])) {
+					++end;
+				}
+
+				//strip spaces between " | " and " , "
+				if (!detail::is_separator(prev) && !(end < size && detail::is_separator(data[end]))) {
+					std::memmove(data + write, data + read, end - read);
+					write += end - read;
+				}
+
+				prev = ch;
+				read = end;
+			} else if (detail::is_word(ch)) {
+				auto end = read + 1;
+				while (end < size && detail::is_word(data[end])) {
+					++end;
+				}
+
+				prev = data[end - 1];
+				write = detail::write_word(data, read, end, write);
+				read = end;
+			} else {
+				data[write++] = ch;
+				prev = ch;
+				++read;
+			}
+		}
+
+		a_out.resize(write);
+	}
+
+	std::string sanitize(std::string_view a_entry, bool a_swapVRMasters)
+	{
+		std::string result{};
+		sanitize(a_entry, result, a_swapVRMasters);
+		return result;
+	}
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+// Normalization of raw config entries before they're parsed.
+// This header is intentionally self-contained (it doesn't rely on PCH), so that sanitizer can be tested and benchmarked outside of the game.
+
+#include <string>
+#include <string_view>
+
+namespace Sanitizer
+{
+	/// <summary>
+	/// Normalizes a raw config entry in a single pass:
+	///  - replaces the first " - " with "~" (legacy formID~modName separator), unless entry already has a "~";
+	///  - in VR swaps Dawnguard and Dragonborn formIDs (0x2xxxxxx, 0x4xxxxxx) to explicit "0xxxxxxx~Dawnguard.esm" and "0xxxxxxx~Dragonborn.esm";
+	///  - strips whitespace around "|" and ",";
+	///  - converts "00012345" formIDs to "0x12345";
+	///  - strips leading zeros from "0x00012345" formIDs.
+	///
+	/// Output is byte-identical to applying these as separate regex replacements in the order listed above.
+	/// </summary>
+	/// <param name="a_entry">Raw entry.</param>
+	/// <param name="a_out">Buffer that receives sanitized entry. Its capacity is reused between calls.</param>
+	/// <param name="a_swapVRMasters">Whether VR-specific master formIDs should be swapped.</param>
+	void sanitize(std::string_view a_entry, std::string& a_out, bool a_swapVRMasters = false);
+
+	[[nodiscard]] std::string sanitize(std::string_view a_entry, bool a_swapVRMasters = false);
+}
@@ -24,7 +24,7 @@ namespace ExclusiveGroups
 	struct ExclusiveGroupKeyComponentParser
 	{
 		template <typename Data>
-		bool operator()(const std::string& key, Data& data) const
+		bool operator()(std::string_view key, Data& data) const
 		{
 			return key == "ExclusiveGroup";
 		}
@@ -33,13 +33,13 @@ namespace ExclusiveGroups
 	struct ExclusiveGroupNameComponentParser
 	{
 		template <named_data Data>
-		void operator()(const std::string& entry, Data& data) const
+		void operator()(std::string_view entry, Data& data) const
 		{
 			data.name = entry;
 		}
 	};
 
-	bool INI::TryParse(const std::string& key, const std::string& value, const Path& path)
+	bool INI::TryParse(const std::string& key, const std::string& value, const Path& path, ExclusiveGroupsVec& groups)
 	{
 		try {
 			if (auto optData = Parse<RawExclusiveGroup,
@@ -49,7 +49,7 @@ namespace ExclusiveGroups
 				optData) {
 				auto& data = *optData;
 				data.path = path;
-				exclusiveGroups.emplace_back(data);
+				groups.emplace_back(data);
 			} else {
 				return false;
 			}
@@ -21,7 +21,7 @@ namespace ExclusiveGroups
 		/// </summary>
 		inline ExclusiveGroupsVec exclusiveGroups{};
 
-		bool TryParse(const std::string& a_key, const std::string& a_value, const Path& a_path);
+		bool TryParse(const std::string& a_key, const std::string& a_value, const Path& a_path, ExclusiveGroupsVec& a_groups = exclusiveGroups);
 	}
 
 	using Group = std::string;
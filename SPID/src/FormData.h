@@ -1,117 +1,119 @@
 #pragma once
 
+#include "EditorIDIndex.h"
+#include "FormResolver.h"
 #include "LookupConfigs.h"
 #include "LookupFilters.h"
 
 namespace Forms
 {
 	namespace Lookup
-
 	{
-		struct UnknownPluginException : std::exception
-		{
-			const std::string modName;
-			const Path        path;
-
-			UnknownPluginException(const std::string& modName, const Path& path) :
-				modName(modName),
-				path(path)
-			{}
-		};
-
-		struct UnknownFormIDException : std::exception
+		enum class ErrorType : std::uint8_t
 		{
-			const RE::FormID                 formID;
-			const std::optional<std::string> modName;
-			const Path                       path;
-
-			UnknownFormIDException(RE::FormID formID, const Path& path, std::optional<std::string> modName = std::nullopt) :
-				formID(formID),
-				path(path),
-				modName(modName)
-			{}
+			kUnknownPlugin = 0,
+			kUnknownFormID,
+			/// Actual form's type does not match the form type excplicilty defined in the config.
+			/// E.g. Spell = 0x12345, but the 0x12345 form is actually a Perk.
+			kMismatchingFormType,
+			kInvalidKeyword,
+			kKeywordNotFound,
+			kUnknownEditorID,
+			/// Actual form's type is not in the whitelist.
+			kInvalidFormType,
+			kMalformedEditorID
 		};
 
 		/// <summary>
-		/// An exception thrown when actual form's type does not match the form type excplicilty defined in the config.
-		/// E.g. Spell = 0x12345, but the 0x12345 form is actually a Perk.
+		/// A typed lookup failure along with the data needed to report it.
+		///
+		/// Failed lookups are common (e.g. optional patches referencing missing plugins), so errors are returned rather than thrown
+		/// and only reference strings owned by the config entry or the Resolver instead of copying them.
 		/// </summary>
-		struct MismatchingFormTypeException : std::exception
+		struct Error
 		{
-			const RE::FormType   expectedFormType;
-			const RE::FormType   actualFormType;
-			const FormOrEditorID formOrEditorID;
-			const Path           path;
-
-			MismatchingFormTypeException(RE::FormType expectedFormType, RE::FormType actualFormType, const FormOrEditorID& formOrEditorID, const Path& path) :
-				expectedFormType(expectedFormType),
-				actualFormType(actualFormType),
-				formOrEditorID(formOrEditorID),
-				path(path)
-			{}
-		};
+			ErrorType type;
+			std::string_view path{};
 
-		struct InvalidKeywordException : std::exception
-		{
-			const RE::FormID                 formID;
-			const std::optional<std::string> modName;
-			const Path                       path;
-
-			InvalidKeywordException(RE::FormID formID, const Path& path, std::optional<std::string> modName = std::nullopt) :
-				formID(formID),
-				modName(modName),
-				path(path)
-			{}
-		};
+			/// Identifier of the form that failed the lookup.
+			/// Either formID (with optional modName) or editorID is set, unless the identifier is a plugin alone.
+			std::optional<RE::FormID>       formID{};
+			std::optional<std::string_view> modName{};
+			std::string_view                editorID{};
 
-		struct KeywordNotFoundException : std::exception
-		{
-			const std::string editorID;
-			const bool        isDynamic;
-			const Path        path;
-
-			KeywordNotFoundException(const std::string& editorID, bool isDynamic, const Path& path) :
-				editorID(editorID),
-				isDynamic(isDynamic),
-				path(path)
-			{}
-		};
+			/// Form types involved in kMismatchingFormType and kInvalidFormType (which only uses actualFormType).
+			RE::FormType expectedFormType{ RE::FormType::None };
+			RE::FormType actualFormType{ RE::FormType::None };
 
-		struct UnknownEditorIDException : std::exception
-		{
-			const std::string editorID;
-			const Path        path;
+			/// Whether keyword was supposed to be created for kKeywordNotFound.
+			bool isDynamic{ false };
 
-			UnknownEditorIDException(const std::string& editorID, const Path& path) :
-				editorID(editorID),
-				path(path)
-			{}
-		};
+			[[nodiscard]] bool IsEditorID() const
+			{
+				return !editorID.empty();
+			}
 
-		/// <summary>
-		/// An exception thrown when actual form's type is not in the whitelist.
-		/// </summary>
-		struct InvalidFormTypeException : std::exception
-		{
-			const RE::FormType   formType;
-			const FormOrEditorID formOrEditorID;
-			const Path           path;
-
-			InvalidFormTypeException(RE::FormType formType, const FormOrEditorID& formOrEditorID, const Path& path) :
-				formType(formType),
-				formOrEditorID(formOrEditorID),
-				path(path)
-			{}
-		};
+			static Error UnknownPlugin(std::string_view modName, std::string_view path)
+			{
+				return { .type = ErrorType::kUnknownPlugin, .path = path, .modName = modName };
+			}
 
-		struct MalformedEditorIDException : std::exception
-		{
-			const Path path;
+			static Error UnknownFormID(RE::FormID formID, std::string_view path, std::optional<std::string_view> modName = std::nullopt)
+			{
+				return { .type = ErrorType::kUnknownFormID, .path = path, .formID = formID, .modName = modName };
+			}
+
+			static Error MismatchingFormType(RE::FormType expectedFormType, RE::FormType actualFormType, RE::FormID formID, std::optional<std::string_view> modName, std::string_view path)
+			{
+				return { .type = ErrorType::kMismatchingFormType, .path = path, .formID = formID, .modName = modName, .expectedFormType = expectedFormType, .actualFormType = actualFormType };
+			}
+
+			static Error MismatchingFormType(RE::FormType expectedFormType, RE::FormType actualFormType, std::string_view editorID, std::string_view path)
+			{
+				return { .type = ErrorType::kMismatchingFormType, .path = path, .editorID = editorID, .expectedFormType = expectedFormType, .actualFormType = actualFormType };
+			}
 
-			MalformedEditorIDException(const Path& path) :
-				path(path)
-			{}
+			static Error InvalidKeyword(RE::FormID formID, std::string_view path, std::optional<std::string_view> modName = std::nullopt)
+			{
+				return { .type = ErrorType::kInvalidKeyword, .path = path, .formID = formID, .modName = modName };
+			}
+
+			static Error KeywordNotFound(std::string_view editorID, bool isDynamic, std::string_view path)
+			{
+				return { .type = ErrorType::kKeywordNotFound, .path = path, .editorID = editorID, .isDynamic = isDynamic };
+			}
+
+			static Error UnknownEditorID(std::string_view editorID, std::string_view path)
+			{
+				return { .type = ErrorType::kUnknownEditorID, .path = path, .editorID = editorID };
+			}
+
+			static Error InvalidFormType(RE::FormType formType, const FormOrEditorID& formOrEditorID, std::string_view path)
+			{
+				Error error{ .type = ErrorType::kInvalidFormType, .path = path, .actualFormType = formType };
+				std::visit(overload{
+							   [&](const FormModPair& formMod) {
+								   auto& [formID, modName] = formMod;
+								   error.formID = formID;
+								   if (modName) {
+									   error.modName = *modName;
+								   }
+							   },
+							   [&](const std::string& editorID) {
+								   error.editorID = editorID;
+							   } },
+					formOrEditorID);
+				return error;
+			}
+
+			static Error MalformedEditorID(std::string_view path)
+			{
+				return { .type = ErrorType::kMalformedEditorID, .path = path };
+			}
 		};
+
+		template <class T>
+		using Result = std::expected<T, Error>;
 	}
 
 	enum LookupOptions : std::uint8_t
@@ -126,33 +128,10 @@ namespace Forms
 	{
 		using namespace Lookup;
 
-		inline void get_merged_IDs(std::optional<RE::FormID>& a_formID, std::optional<std::string>& a_modName)
-		{
-			const auto [mergedModName, mergedFormID] = g_mergeMapperInterface->GetNewFormID(a_modName.value_or("").c_str(), a_formID.value_or(0));
-			std::string conversion_log{};
-			if (a_formID.value_or(0) && mergedFormID && a_formID.value_or(0) != mergedFormID) {
-				conversion_log = std::format("0x{:X}->0x{:X}", a_formID.value_or(0), mergedFormID);
-				a_formID.emplace(mergedFormID);
-			}
-			const std::string mergedModString{ mergedModName };
-			if (!a_modName.value_or("").empty() && !mergedModString.empty() && a_modName.value_or("") != mergedModString) {
-				if (conversion_log.empty()) {
-					conversion_log = std::format("{}->{}", a_modName.value_or(""), mergedModString);
-				} else {
-					conversion_log = std::format("{}~{}->{}", conversion_log, a_modName.value_or(""), mergedModString);
-				}
-				a_modName.emplace(mergedModName);
-			}
-			if (!conversion_log.empty()) {
-				buffered_logger::info("\t\tFound merged: {}", conversion_log);
-			}
-		}
-
 		template <class Form = RE::TESForm>
-		std::variant<Form*, const RE::TESFile*> get_form_or_mod(RE::TESDataHandler* const dataHandler, const FormOrEditorID& formOrEditorID, const Path& path, const LookupOptions options)
+		Result<std::variant<Form*, const RE::TESFile*>> get_form_or_mod(RE::TESDataHandler* const dataHandler, const FormOrEditorID& formOrEditorID, const Path& path, const LookupOptions options)
 		{
-			Form*              form = nullptr;
-			const RE::TESFile* mod = nullptr;
+			Form* form = nullptr;
 
 			constexpr auto as_form = [](RE::TESForm* anyForm) -> Form* {
 				if (!anyForm) {
@@ -167,138 +146,134 @@ namespace Forms
 				}
 			};
 
-			auto find_or_create_keyword = [&](const std::string& editorID) -> RE::BGSKeyword* {
-				auto& keywordArray = dataHandler->GetFormArray<RE::BGSKeyword>();
-
-				auto result = std::find_if(keywordArray.begin(), keywordArray.end(), [&](const auto& keyword) {
-					return keyword && keyword->formEditorID == editorID.c_str();
-				});
+			const auto index = EditorIDIndex::GetSingleton();
+			const auto resolver = Resolver::GetSingleton();
 
-				if (result != keywordArray.end()) {
-					if (const auto keyword = *result; keyword) {
-						return keyword;
-					} else {
-						throw KeywordNotFoundException(editorID, false, path);
-					}
+			auto find_or_create_keyword = [&](const std::string& editorID) -> Result<RE::BGSKeyword*> {
+				if (const auto keyword = index->FindKeyword(editorID); keyword) {
+					return keyword;
 				} else if (options & kCreateIfMissing) {
 					const auto factory = RE::IFormFactory::GetConcreteFormFactoryByType<RE::BGSKeyword>();
 					if (auto keyword = factory ? factory->Create() : nullptr; keyword) {
 						keyword->formEditorID = editorID;
-						keywordArray.push_back(keyword);
+						dataHandler->GetFormArray<RE::BGSKeyword>().push_back(keyword);
+						index->InsertKeyword(keyword);
 
 						return keyword;
 					} else {
-						throw KeywordNotFoundException(editorID, true, path);
+						return std::unexpected(Error::KeywordNotFound(editorID, true, path));
 					}
 				} else {
 					// If creating keyword from this editorID is not allowed, then we simply fail as unknown editorID
-					throw UnknownEditorIDException(editorID, path);
+					return std::unexpected(Error::UnknownEditorID(editorID, path));
 				}
 			};
 
-			std::visit(overload{
-						   [&](const FormModPair& formMod) {
-							   auto [formID, modName] = formMod;
-
-							   // Only MyPlugin.esp
-							   if (modName && !formID) {
-								   if (const RE::TESFile* filterMod = dataHandler->LookupModByName(*modName); filterMod) {
-									   mod = filterMod;
-									   return;
-								   } else {
-									   throw UnknownPluginException(*modName, path);
-								   }
-							   }
+			if (const auto formMod = std::get_if<FormModPair>(&formOrEditorID); formMod) {
+				const auto& [status, anyForm, filterMod, formID, modName, mergeLog] = resolver->Resolve(dataHandler, *formMod);
 
-							   if (formID && g_mergeMapperInterface) {
-								   get_merged_IDs(formID, modName);
-							   }
+				if (!mergeLog.empty()) {
+					buffered_logger::info("\t\tFound merged: {}", mergeLog);
+				}
 
-							   // Either 0x1235 or 0x1235~MyPlugin.esp
-							   if (formID) {
-								   RE::TESForm* anyForm;
-								   if (modName) {
-									   anyForm = dataHandler->LookupForm(*formID, *modName);
-								   } else {
-									   anyForm = RE::TESForm::LookupByID(*formID);
-								   }
+				const auto modNameView = modName ? std::optional<std::string_view>(*modName) : std::nullopt;
 
-								   if (!anyForm) {
-									   throw UnknownFormIDException(*formID, path, modName);
-								   }
+				switch (status) {
+				case Resolver::Status::kUnknownPlugin:
+					return std::unexpected(Error::UnknownPlugin(*modName, path));
+				case Resolver::Status::kUnknownFormID:
+					return std::unexpected(Error::UnknownFormID(*formID, path, modNameView));
+				default:
+					break;
+				}
 
-								   form = as_form(anyForm);
-								   if (!form) {
-									   throw MismatchingFormTypeException(Form::FORMTYPE, anyForm->GetFormType(), FormModPair{ *formID, modName }, path);
-								   }
+				// Only MyPlugin.esp
+				if (filterMod) {
+					return filterMod;
+				}
 
-								   if constexpr (std::is_same_v<Form, RE::BGSKeyword>) {
-									   if (string::is_empty(form->GetFormEditorID())) {
-										   // Keywords with empty EditorIDs cause game to crash.
-										   throw InvalidKeywordException(*formID, path, modName);
-									   }
-								   }
-							   }
-						   },
-						   [&](const std::string& editorID) {
-							   if (editorID.empty()) {
-								   throw MalformedEditorIDException(path);
-							   }
-							   if constexpr (std::is_same_v<Form, RE::BGSKeyword>) {
-								   form = find_or_create_keyword(editorID);
-							   } else {
-								   if (const auto anyForm = RE::TESForm::LookupByEditorID(editorID); anyForm) {
-									   form = as_form(anyForm);
-									   if (!form) {
-										   throw MismatchingFormTypeException(anyForm->GetFormType(), Form::FORMTYPE, editorID, path);
-									   }
-								   } else {
-									   // If template's Form is a generic TESForm, that means caller doesn't request specific form type,
-									   // as such we'll attempt to create a keyword if options allow it.
-									   if constexpr (std::is_same_v<Form, RE::TESForm>) {
-										   form = find_or_create_keyword(editorID);
-									   } else {
-										   throw UnknownEditorIDException(editorID, path);
-									   }
-								   }
-							   }
-						   } },
-				formOrEditorID);
+				// Either 0x1235 or 0x1235~MyPlugin.esp
+				if (formID) {
+					form = as_form(anyForm);
+					if (!form) {
+						return std::unexpected(Error::MismatchingFormType(Form::FORMTYPE, anyForm->GetFormType(), *formID, modNameView, path));
+					}
 
-			if (mod) {
-				return mod;
+					if constexpr (std::is_same_v<Form, RE::BGSKeyword>) {
+						if (string::is_empty(form->GetFormEditorID())) {
+							// Keywords with empty EditorIDs cause game to crash.
+							return std::unexpected(Error::InvalidKeyword(*formID, path, modNameView));
+						}
+					}
+				}
+			} else {
+				const auto& editorID = std::get<std::string>(formOrEditorID);
+
+				if (editorID.empty()) {
+					return std::unexpected(Error::MalformedEditorID(path));
+				}
+				if constexpr (std::is_same_v<Form, RE::BGSKeyword>) {
+					const auto keyword = find_or_create_keyword(editorID);
+					if (!keyword) {
+						return std::unexpected(keyword.error());
+					}
+					form = *keyword;
+				} else {
+					if (const auto anyForm = resolver->Resolve(editorID).form; anyForm) {
+						form = as_form(anyForm);
+						if (!form) {
+							return std::unexpected(Error::MismatchingFormType(anyForm->GetFormType(), Form::FORMTYPE, editorID, path));
+						}
+					} else {
+						// If template's Form is a generic TESForm, that means caller doesn't request specific form type,
+						// as such we'll attempt to create a keyword if options allow it.
+						if constexpr (std::is_same_v<Form, RE::TESForm>) {
+							const auto keyword = find_or_create_keyword(editorID);
+							if (!keyword) {
+								return std::unexpected(keyword.error());
+							}
+							form = *keyword;
+						} else {
+							return std::unexpected(Error::UnknownEditorID(editorID, path));
+						}
+					}
+				}
 			}
 
 			if (options & kWhitelistedOnly && form) {
 				const auto formType = form->GetFormType();
-				if (FormType::GetWhitelisted(formType)) {
-					return form;
-				} else {
-					throw InvalidFormTypeException(formType, formOrEditorID, path);
+				if (!FormType::GetWhitelisted(formType)) {
+					return std::unexpected(Error::InvalidFormType(formType, formOrEditorID, path));
 				}
 			}
 
 			return form;
 		}
 
-		inline const RE::TESFile* get_file(RE::TESDataHandler* const dataHandler, const FormOrEditorID& formOrEditorID, const Path& path, const LookupOptions options)
+		inline Result<const RE::TESFile*> get_file(RE::TESDataHandler* const dataHandler, const FormOrEditorID& formOrEditorID, const Path& path, const LookupOptions options)
 		{
-			auto formOrMod = get_form_or_mod(dataHandler, formOrEditorID, path, options);
+			const auto formOrMod = get_form_or_mod(dataHandler, formOrEditorID, path, options);
+			if (!formOrMod) {
+				return std::unexpected(formOrMod.error());
+			}
 
-			if (std::holds_alternative<const RE::TESFile*>(formOrMod)) {
-				return std::get<const RE::TESFile*>(formOrMod);
+			if (std::holds_alternative<const RE::TESFile*>(*formOrMod)) {
+				return std::get<const RE::TESFile*>(*formOrMod);
 			}
 
 			return nullptr;
 		}
 
 		template <class Form = RE::TESForm>
-		Form* get_form(RE::TESDataHandler* const dataHandler, const FormOrEditorID& formOrEditorID, const Path& path, const LookupOptions options)
+		Result<Form*> get_form(RE::TESDataHandler* const dataHandler, const FormOrEditorID& formOrEditorID, const Path& path, const LookupOptions options)
 		{
-			auto formOrMod = get_form_or_mod<Form>(dataHandler, formOrEditorID, path, options);
+			const auto formOrMod = get_form_or_mod<Form>(dataHandler, formOrEditorID, path, options);
+			if (!formOrMod) {
+				return std::unexpected(formOrMod.error());
+			}
 
-			if (std::holds_alternative<Form*>(formOrMod)) {
-				return std::get<Form*>(formOrMod);
+			if (std::holds_alternative<Form*>(*formOrMod)) {
+				return std::get<Form*>(*formOrMod);
 			}
 
 			return nullptr;
@@ -311,46 +286,50 @@ namespace Forms
 			}
 
 			for (auto& formOrEditorID : a_rawFormVec) {
-				try {
-					auto form = get_form_or_mod(a_dataHandler, formOrEditorID, a_path, options);
-					a_formVec.emplace_back(form);
-				} catch (const UnknownFormIDException& e) {
-					buffered_logger::error("\t\t[{}] Filter [0x{:X}] ({}) SKIP - formID doesn't exist", e.path, e.formID, e.modName.value_or(""));
-				} catch (const UnknownPluginException& e) {
-					buffered_logger::error("\t\t[{}] Filter ({}) SKIP - mod cannot be found", e.path, e.modName);
-				} catch (const InvalidKeywordException& e) {
-					buffered_logger::error("\t\t[{}] Filter [0x{:X}] ({}) SKIP - keyword does not have a valid editorID", e.path, e.formID, e.modName.value_or(""));
-				} catch (const KeywordNotFoundException& e) {
+				const auto form = get_form_or_mod(a_dataHandler, formOrEditorID, a_path, options);
+				if (form) {
+					a_formVec.emplace_back(*form);
+					continue;
+				}
+
+				const auto& e = form.error();
+				switch (e.type) {
+				case ErrorType::kUnknownFormID:
+					buffered_logger::error("\t\t[{}] Filter [0x{:X}] ({}) SKIP - formID doesn't exist", e.path, *e.formID, e.modName.value_or(""));
+					break;
+				case ErrorType::kUnknownPlugin:
+					buffered_logger::error("\t\t[{}] Filter ({}) SKIP - mod cannot be found", e.path, *e.modName);
+					break;
+				case ErrorType::kInvalidKeyword:
+					buffered_logger::error("\t\t[{}] Filter [0x{:X}] ({}) SKIP - keyword does not have a valid editorID", e.path, *e.formID, e.modName.value_or(""));
+					break;
+				case ErrorType::kKeywordNotFound:
 					if (e.isDynamic) {
 						buffered_logger::critical("\t\t[{}] {} FAIL - couldn't create keyword", e.path, e.editorID);
 					} else {
 						buffered_logger::critical("\t\t[{}] {} FAIL - couldn't get existing keyword", e.path, e.editorID);
 					}
 					return false;
-				} catch (const UnknownEditorIDException& e) {
+				case ErrorType::kUnknownEditorID:
 					buffered_logger::error("\t\t[{}] Filter ({}) SKIP - editorID doesn't exist", e.path, e.editorID);
-				} catch (const MalformedEditorIDException& e) {
+					break;
+				case ErrorType::kMalformedEditorID:
 					buffered_logger::error("\t\t[{}] Filter (\"\") SKIP - malformed editorID", e.path);
-				} catch (const Lookup::MismatchingFormTypeException& e) {
-					std::visit(overload{
-								   [&](const FormModPair& formMod) {
-									   auto& [formID, modName] = formMod;
-									   buffered_logger::error("\t\t[{}] Filter[0x{:X}] ({}) FAIL - mismatching form type (expected: {}, actual: {})", e.path, *formID, modName.value_or(""), e.expectedFormType, e.actualFormType);
-								   },
-								   [&](std::string editorID) {
-									   buffered_logger::error("\t\t[{}] Filter ({}) FAIL - mismatching form type (expected: {}, actual: {})", e.path, editorID, e.expectedFormType, e.actualFormType);
-								   } },
-						e.formOrEditorID);
-				} catch (const InvalidFormTypeException& e) {
-					std::visit(overload{
-								   [&](const FormModPair& formMod) {
-									   auto& [formID, modName] = formMod;
-									   buffered_logger::error("\t\t[{}] Filter [0x{:X}] ({}) SKIP - invalid formtype ({})", e.path, *formID, modName.value_or(""), e.formType);
-								   },
-								   [&](std::string editorID) {
-									   buffered_logger::error("\t\t[{}] Filter ({}) SKIP - invalid formtype ({})", e.path, editorID, e.formType);
-								   } },
-						e.formOrEditorID);
+					break;
+				case ErrorType::kMismatchingFormType:
+					if (e.IsEditorID()) {
+						buffered_logger::error("\t\t[{}] Filter ({}) FAIL - mismatching form type (expected: {}, actual: {})", e.path, e.editorID, e.expectedFormType, e.actualFormType);
+					} else {
+						buffered_logger::error("\t\t[{}] Filter[0x{:X}] ({}) FAIL - mismatching form type (expected: {}, actual: {})", e.path, *e.formID, e.modName.value_or(""), e.expectedFormType, e.actualFormType);
+					}
+					break;
+				case ErrorType::kInvalidFormType:
+					if (e.IsEditorID()) {
+						buffered_logger::error("\t\t[{}] Filter ({}) SKIP - invalid formtype ({})", e.path, e.editorID, e.actualFormType);
+					} else {
+						buffered_logger::error("\t\t[{}] Filter [0x{:X}] ({}) SKIP - invalid formtype ({})", e.path, *e.formID, e.modName.value_or(""), e.actualFormType);
+					}
+					break;
 				}
 			}
 
@@ -372,6 +351,11 @@ namespace Forms
 		Path          path{};
 		std::uint32_t npcCount{ 0 };
 
+		/// Identifies config entry that this data was looked up from (see Distribution::INI::GetSourceID).
+		std::uint64_t source{ 0 };
+		/// Hot reload that added this entry, or 0 if it was loaded on startup (see Distribution::HotReload).
+		std::uint32_t generation{ 0 };
+
 		bool operator==(const Data& a_rhs) const;
 	};
 
@@ -438,9 +422,9 @@ namespace Forms
 		DataVec<Form>& GetForms();
 
 		void LookupForms(RE::TESDataHandler*, std::string_view a_type, Distribution::INI::DataVec&);
-		void EmplaceForm(bool isValid, Form*, const bool& isFinal, const IndexOrCount&, const FilterData&, const Path&);
+		void EmplaceForm(bool isValid, Form*, const bool& isFinal, const IndexOrCount&, const FilterData&, const Path&, std::uint64_t a_source = 0);
 
-		// Init formsWithLevels and formsNoLevels
+		// Init formsWithLevels and formsNoLevels. Called again by hot reload once entries change.
 		void FinishLookupForms();
 
 	private:
@@ -448,6 +432,9 @@ namespace Forms
 		DataVec<Form> forms{};
 		DataVec<Form> formsWithLevels{};
 
+		/// Index of the next emplaced entry. Entries can be removed by hot reload, so indices are not necessarily equal to positions in forms.
+		std::uint32_t nextIndex{ 0 };
+
 		/// Total number of entries that were matched to this Distributable, including invalid.
 		/// This counter is used for logging purposes.
 		std::size_t lookupCount{ 0 };
@@ -467,6 +454,22 @@ namespace Forms
 	inline Distributables<RE::BGSOutfit>      sleepOutfits{ RECORD::kSleepOutfit };
 	inline Distributables<RE::TESObjectARMO>  skins{ RECORD::kSkin };
 
+	/// <summary>
+	/// Guards entries of all Distributables above once lookup is done.
+	///
+	/// Distribution reads entries from whichever thread loads an actor, while hot reload (see Distribution::HotReload) changes them on the main thread.
+	/// Distribution holds this lock for reading while it iterates entries, and hot reload holds it for writing while it changes them.
+	/// </summary>
+	inline Lock distributablesLock;
+
+	/// <summary>
+	/// Latest hot reload that added entries to Distributables above (see Data::generation), or 0 if none did.
+	///
+	/// Hot reload only changes it while holding distributablesLock for writing,
+	/// so whoever reads it while holding the lock for reading gets the generation of entries they're iterating.
+	/// </summary>
+	inline std::atomic<std::uint32_t> distributablesGeneration{ 0 };
+
 	std::size_t GetTotalEntries();
 	std::size_t GetTotalLeveledEntries();
 
@@ -555,8 +558,10 @@ Forms::DataVec<Form>& Forms::Distributables<Form>::GetForms(bool a_onlyLevelEntr
 template <class Form>
 void Forms::Distributables<Form>::LookupForm(RE::TESDataHandler* dataHandler, Distribution::INI::Data& rawForm)
 {
+	const auto source = Distribution::INI::GetSourceID(rawForm);
+
 	Forms::LookupGenericForm<Form>(dataHandler, rawForm, [&](bool isValid, Form* form, const bool& isFinal, const auto& idxOrCount, const auto& filters, const auto& path) {
-		EmplaceForm(isValid, form, isFinal, idxOrCount, filters, path);
+		EmplaceForm(isValid, form, isFinal, idxOrCount, filters, path, source);
 	});
 }
 
@@ -577,10 +582,10 @@ void Forms::Distributables<Form>::LookupForms(RE::TESDataHandler* dataHandler, s
 }
 
 template <class Form>
-void Forms::Distributables<Form>::EmplaceForm(bool isValid, Form* form, const bool& isFinal, const IndexOrCount& idxOrCount, const FilterData& filters, const Path& path)
+void Forms::Distributables<Form>::EmplaceForm(bool isValid, Form* form, const bool& isFinal, const IndexOrCount& idxOrCount, const FilterData& filters, const Path& path, std::uint64_t a_source)
 {
 	if (isValid) {
-		forms.emplace_back(forms.size(), isFinal, form, idxOrCount, filters, path);
+		forms.emplace_back(nextIndex++, isFinal, form, idxOrCount, filters, path, 0, a_source);
 	}
 	lookupCount++;
 }
@@ -588,6 +593,8 @@ void Forms::Distributables<Form>::EmplaceForm(bool isValid, Form* form, const bo
 template <class Form>
 void Forms::Distributables<Form>::FinishLookupForms()
 {
+	formsWithLevels.clear();
+
 	if (forms.empty()) {
 		return;
 	}
@@ -604,8 +611,9 @@ void Forms::LookupGenericForm(RE::TESDataHandler* const dataHandler, Distributio
 {
 	auto& [recordTraits, type, formOrEditorID, strings, filterIDs, level, traits, idxOrCount, chance, path] = rawForm;
 
-	try {
-		if (auto form = detail::get_form<Form>(dataHandler, formOrEditorID, path, LookupOptions::kCreateIfMissing); form) {
+	const auto form = detail::get_form<Form>(dataHandler, formOrEditorID, path, LookupOptions::kCreateIfMissing);
+	if (form) {
+		if (*form) {
 			FormFilters filterForms{};
 
 			bool validEntry = detail::formID_to_form(dataHandler, filterIDs.ALL, filterForms.ALL, path, LookupOptions::kRequireAll);
@@ -617,36 +625,47 @@ void Forms::LookupGenericForm(RE::TESDataHandler* const dataHandler, Distributio
 			}
 
 			FilterData filters{ strings, filterForms, level, traits, chance };
-			callback(validEntry, form, recordTraits & RECORD::TRAITS::Final, idxOrCount, filters, path);
+			callback(validEntry, *form, recordTraits & RECORD::TRAITS::Final, idxOrCount, filters, path);
 		}
-	} catch (const Lookup::UnknownFormIDException& e) {
-		buffered_logger::error("\t[{}] [0x{:X}] ({}) FAIL - formID doesn't exist", e.path, e.formID, e.modName.value_or(""));
-	} catch (const Lookup::InvalidKeywordException& e) {
-		buffered_logger::error("\t[{}] [0x{:X}] ({}) FAIL - keyword does not have a valid editorID", e.path, e.formID, e.modName.value_or(""));
-	} catch (const Lookup::KeywordNotFoundException& e) {
+		return;
+	}
+
+	using Lookup::ErrorType;
+
+	const auto& e = form.error();
+	switch (e.type) {
+	case ErrorType::kUnknownFormID:
+		buffered_logger::error("\t[{}] [0x{:X}] ({}) FAIL - formID doesn't exist", e.path, *e.formID, e.modName.value_or(""));
+		break;
+	case ErrorType::kInvalidKeyword:
+		buffered_logger::error("\t[{}] [0x{:X}] ({}) FAIL - keyword does not have a valid editorID", e.path, *e.formID, e.modName.value_or(""));
+		break;
+	case ErrorType::kKeywordNotFound:
 		if (e.isDynamic) {
 			buffered_logger::critical("\t[{}] {} FAIL - couldn't create keyword", e.path, e.editorID);
 		} else {
 			buffered_logger::critical("\t[{}] {} FAIL - couldn't get existing keyword", e.path, e.editorID);
 		}
-	} catch (const Lookup::UnknownEditorIDException& e) {
+		break;
+	case ErrorType::kUnknownEditorID:
 		buffered_logger::error("\t[{}] ({}) FAIL - editorID doesn't exist", e.path, e.editorID);
-	} catch (const Lookup::MalformedEditorIDException& e) {
+		break;
+	case ErrorType::kMalformedEditorID:
 		buffered_logger::error("\t[{}] FAIL - editorID can't be empty", e.path);
-	} catch (const Lookup::MismatchingFormTypeException& e) {
-		std::visit(overload{
-					   [&](const FormModPair& formMod) {
-						   auto& [formID, modName] = formMod;
-						   buffered_logger::error("\t\t[{}] [0x{:X}] ({}) FAIL - mismatching form type (expected: {}, actual: {})", e.path, *formID, modName.value_or(""), e.expectedFormType, e.actualFormType);
-					   },
-					   [&](std::string editorID) {
-						   buffered_logger::error("\t\t[{}] ({}) FAIL - mismatching form type (expected: {}, actual: {})", e.path, editorID, e.expectedFormType, e.actualFormType);
-					   } },
-			e.formOrEditorID);
-	} catch (const Lookup::InvalidFormTypeException&) {
+		break;
+	case ErrorType::kMismatchingFormType:
+		if (e.IsEditorID()) {
+			buffered_logger::error("\t\t[{}] ({}) FAIL - mismatching form type (expected: {}, actual: {})", e.path, e.editorID, e.expectedFormType, e.actualFormType);
+		} else {
+			buffered_logger::error("\t\t[{}] [0x{:X}] ({}) FAIL - mismatching form type (expected: {}, actual: {})", e.path, *e.formID, e.modName.value_or(""), e.expectedFormType, e.actualFormType);
+		}
+		break;
+	case ErrorType::kInvalidFormType:
 		// Whitelisting is disabled, so this should not occur
-	} catch (const Lookup::UnknownPluginException&) {
+		break;
+	case ErrorType::kUnknownPlugin:
 		// Likewise, we don't expect plugin names in distributable forms.
+		break;
 	}
 }
 
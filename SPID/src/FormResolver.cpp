@@ -0,0 +1,229 @@
+#include "FormResolver.h"
+#include "EditorIDIndex.h"
+#include "StringKernels.h"
+
+namespace Forms
+{
+	namespace detail
+	{
+		std::string get_merged_IDs(std::optional<RE::FormID>& a_formID, std::optional<std::string>& a_modName)
+		{
+			const auto [mergedModName, mergedFormID] = g_mergeMapperInterface->GetNewFormID(a_modName.value_or("").c_str(), a_formID.value_or(0));
+			std::string conversion_log{};
+			if (a_formID.value_or(0) && mergedFormID && a_formID.value_or(0) != mergedFormID) {
+				conversion_log = fmt::format("0x{:X}->0x{:X}", a_formID.value_or(0), mergedFormID);
+				a_formID.emplace(mergedFormID);
+			}
+			const std::string mergedModString{ mergedModName };
+			if (!a_modName.value_or("").empty() && !mergedModString.empty() && a_modName.value_or("") != mergedModString) {
+				if (conversion_log.empty()) {
+					conversion_log = fmt::format("{}->{}", a_modName.value_or(""), mergedModString);
+				} else {
+					conversion_log = fmt::format("{}~{}->{}", conversion_log, a_modName.value_or(""), mergedModString);
+				}
+				a_modName.emplace(mergedModName);
+			}
+			return conversion_log;
+		}
+
+		std::string get_key(const FormModPair& a_formMod)
+		{
+			const auto& [formID, modName] = a_formMod;
+			const auto  plugin = modName ? Strings::fold(*modName) : "";
+
+			// Plugin alone has no formID part, so that it isn't confused with an explicit 0x0 in that plugin.
+			return formID ? fmt::format("{:X}~{}", *formID, plugin) : fmt::format("~{}", plugin);
+		}
+	}
+
+	const Resolver::Resolution& Resolver::Resolve(RE::TESDataHandler* const a_dataHandler, const FormModPair& a_formMod)
+	{
+		return find_or_resolve(formIDs, detail::get_key(a_formMod), [&] { return resolve(a_dataHandler, a_formMod); }, Counter::kLookup);
+	}
+
+	const Resolver::Resolution& Resolver::Resolve(const std::string& a_editorID)
+	{
+		return find_or_resolve(editorIDs, Strings::fold(a_editorID), [&] { return resolve(a_editorID); }, Counter::kLookup);
+	}
+
+	void Resolver::prefetch(RE::TESDataHandler* const a_dataHandler, const FormModPair& a_formMod)
+	{
+		find_or_resolve(formIDs, detail::get_key(a_formMod), [&] { return resolve(a_dataHandler, a_formMod); }, Counter::kPrefetch);
+	}
+
+	void Resolver::prefetch(const std::string& a_editorID)
+	{
+		find_or_resolve(editorIDs, Strings::fold(a_editorID), [&] { return resolve(a_editorID); }, Counter::kPrefetch);
+	}
+
+	void Resolver::Prefetch(RE::TESDataHandler* const a_dataHandler, const RawFormRefs& a_identifiers)
+	{
+		if (a_identifiers.empty()) {
+			return;
+		}
+
+		Timer timer;
+
+		timer.start();
+
+		// MergeMapper makes no promise of being thread-safe, so identifiers that it might remap are resolved on this thread.
+		RawFormRefs parallel{};
+		parallel.reserve(a_identifiers.size());
+		for (const auto identifier : a_identifiers) {
+			const auto formMod = std::get_if<FormModPair>(identifier);
+			if (formMod && formMod->first && g_mergeMapperInterface) {
+				prefetch(a_dataHandler, *formMod);
+			} else {
+				parallel.push_back(identifier);
+			}
+		}
+
+		// TESDataHandler::LookupForm, TESForm::LookupByID and EditorIDIndex only read data, which is fully loaded at this point.
+		std::for_each(std::execution::par, parallel.begin(), parallel.end(), [&](const FormOrEditorID* a_identifier) {
+			std::visit(overload{
+						   [&](const FormModPair& a_formMod) { prefetch(a_dataHandler, a_formMod); },
+						   [&](const std::string& a_editorID) {
+							   if (!a_editorID.empty()) {
+								   prefetch(a_editorID);
+							   }
+						   } },
+				*a_identifier);
+		});
+		timer.end();
+
+		logger::info("Prefetched {} references in {}μs / {}ms", a_identifiers.size(), timer.duration_μs(), timer.duration_ms());
+	}
+
+	void Resolver::Restore(Kind a_kind, std::string a_key, Resolution a_resolution)
+	{
+		WriteLocker locker(lock);
+		auto&       cache = a_kind == Kind::kEditorID ? editorIDs : formIDs;
+		if (cache.try_emplace(std::move(a_key), std::move(a_resolution)).second) {
+			++restored;
+		}
+	}
+
+	template <class Func>
+	const Resolver::Resolution& Resolver::find_or_resolve(StringMap<Resolution>& a_cache, std::string&& a_key, Func&& a_resolve, Counter a_counter)
+	{
+		// Prefetch doesn't reference anything by itself, so only resolutions that it makes are counted, separately from lookups.
+		const bool isPrefetch = a_counter == Counter::kPrefetch;
+
+		{
+			ReadLocker locker(lock);
+			if (const auto it = a_cache.find(a_key); it != a_cache.end()) {
+				if (!isPrefetch) {
+					++hits;
+				}
+				return it->second;
+			}
+		}
+
+		const auto start = clock::now();
+		auto       resolution = a_resolve();
+		const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count();
+
+		WriteLocker locker(lock);
+		// Another thread might have resolved the same identifier in the meantime, in which case theirs is kept and this counts as a hit.
+		const auto [it, inserted] = a_cache.try_emplace(std::move(a_key), std::move(resolution));
+		if (inserted) {
+			missTimeNs += elapsed;
+			++(isPrefetch ? prefetched : misses);
+		} else if (!isPrefetch) {
+			++hits;
+		}
+		return it->second;
+	}
+
+	Resolver::Resolution Resolver::resolve(RE::TESDataHandler* const a_dataHandler, const FormModPair& a_formMod)
+	{
+		Resolution result{};
+
+		auto [formID, modName] = a_formMod;
+
+		// Only MyPlugin.esp
+		if (modName && !formID) {
+			result.modName = modName;
+			if (const RE::TESFile* filterMod = a_dataHandler->LookupModByName(*modName); filterMod) {
+				result.mod = filterMod;
+			} else {
+				result.status = Status::kUnknownPlugin;
+			}
+			return result;
+		}
+
+		if (formID && g_mergeMapperInterface) {
+			result.mergeLog = detail::get_merged_IDs(formID, modName);
+		}
+
+		result.formID = formID;
+		result.modName = modName;
+
+		// Either 0x1235 or 0x1235~MyPlugin.esp
+		if (formID) {
+			if (modName) {
+				result.form = a_dataHandler->LookupForm(*formID, *modName);
+			} else {
+				result.form = RE::TESForm::LookupByID(*formID);
+			}
+
+			if (!result.form) {
+				result.status = Status::kUnknownFormID;
+			}
+		}
+
+		return result;
+	}
+
+	Resolver::Resolution Resolver::resolve(const std::string& a_editorID)
+	{
+		Resolution result{};
+
+		result.form = EditorIDIndex::GetSingleton()->Find(a_editorID);
+		if (!result.form) {
+			result.status = Status::kUnknownEditorID;
+		}
+
+		return result;
+	}
+
+	void Resolver::LogStatistics() const
+	{
+		const std::uint64_t hitCount = hits;
+		const std::uint64_t missCount = misses;
+		const std::uint64_t prefetchedCount = prefetched;
+		const std::uint64_t restoredCount = restored;
+		const std::uint64_t total = hitCount + missCount;
+
+		if (total == 0) {
+			return;
+		}
+
+		const std::uint64_t resolvedCount = missCount + prefetchedCount;
+		if (resolvedCount == 0) {
+			logger::info("Resolved {} references, all of them from {} restored forms", total, restoredCount);
+			return;
+		}
+
+		// Lookups hit whatever prefetch resolved, but the first reference to each of those forms would've been resolved anyway.
+		const auto reusedCount = hitCount - std::min(hitCount, prefetchedCount);
+		const auto reuseRate = 100.0 * static_cast<double>(reusedCount) / static_cast<double>(total);
+
+		// Each reused resolution would otherwise cost an average uncached resolution.
+		const auto savedμs = static_cast<double>(missTimeNs) / static_cast<double>(resolvedCount) * static_cast<double>(reusedCount) / 1000.0;
+
+		logger::info("Resolved {} unique forms ({} prefetched) for {} references: {} cache hits ({:.1f}%, {} restored forms), saved ~{:.0f}μs", resolvedCount, prefetchedCount, total, reusedCount, reuseRate, restoredCount, savedμs);
+	}
+
+	void Resolver::Clear()
+	{
+		WriteLocker locker(lock);
+		formIDs.clear();
+		editorIDs.clear();
+		hits = 0;
+		misses = 0;
+		prefetched = 0;
+		restored = 0;
+		missTimeNs = 0;
+	}
+}
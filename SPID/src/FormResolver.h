@@ -0,0 +1,134 @@
+#pragma once
+
+namespace Forms
+{
+	/// <summary>
+	/// Memoizing resolver of raw FormOrEditorID identifiers.
+	///
+	/// The same raw identifier is usually referenced many times across distributables, filters, linked forms, death forms and exclusive groups.
+	/// Resolver queries TESDataHandler and MergeMapper only once per unique identifier and caches the outcome, including failures.
+	///
+	/// Cache keys are normalized identifiers: "formID~plugin" (or "~plugin" for a plugin alone) with casefolded plugin name for FormModPair and casefolded editorID for editorIDs.
+	/// Only the raw resolution is cached, form type checks and keyword creation are still done by the caller on every lookup.
+	/// </summary>
+	class Resolver : public ISingleton<Resolver>
+	{
+	public:
+		enum class Status : std::uint8_t
+		{
+			kResolved = 0,
+			kUnknownPlugin,
+			kUnknownFormID,
+			kUnknownEditorID
+		};
+
+		/// Kind of identifier that a resolution is cached for.
+		enum class Kind : std::uint8_t
+		{
+			kFormID = 0,
+			kEditorID,
+
+			kTotal
+		};
+
+		struct Resolution
+		{
+			Status             status{ Status::kResolved };
+			RE::TESForm*       form{ nullptr };
+			const RE::TESFile* mod{ nullptr };
+
+			/// Identifiers after MergeMapper remapping. These are used for error reporting.
+			std::optional<RE::FormID>  formID{};
+			std::optional<std::string> modName{};
+
+			/// MergeMapper conversion (e.g. "0x123->0x456~Old.esp->Merged.esp") or empty if identifiers weren't remapped.
+			/// Resolutions can be made on worker threads, so it is logged by the caller instead.
+			std::string mergeLog{};
+		};
+
+		/// <summary>
+		/// Resolves either "0x123~MyPlugin.esp", "0x123" or "MyPlugin.esp".
+		/// </summary>
+		const Resolution& Resolve(RE::TESDataHandler* const a_dataHandler, const FormModPair& a_formMod);
+
+		/// <summary>
+		/// Resolves editorID of any form (see EditorIDIndex::Find).
+		/// </summary>
+		const Resolution& Resolve(const std::string& a_editorID);
+
+		/// <summary>
+		/// Resolves all given identifiers on worker threads, so that subsequent lookups only hit the cache.
+		///
+		/// Only read-only queries are made here. Anything that modifies game data (e.g. creating missing keywords)
+		/// is left to the sequential lookup, which also keeps the order of processed entries deterministic.
+		/// FormIDs are resolved on the calling thread when MergeMapper is installed, since it might remap them.
+		/// </summary>
+		void Prefetch(RE::TESDataHandler* const a_dataHandler, const RawFormRefs& a_identifiers);
+
+		/// <summary>
+		/// Iterates over all cached resolutions along with their normalized keys.
+		/// </summary>
+		template <class Func>
+		void ForEachResolution(Func&& a_func) const
+		{
+			ReadLocker locker(lock);
+			for (const auto& [key, resolution] : formIDs) {
+				a_func(Kind::kFormID, std::string_view(key), resolution);
+			}
+			for (const auto& [key, resolution] : editorIDs) {
+				a_func(Kind::kEditorID, std::string_view(key), resolution);
+			}
+		}
+
+		/// <summary>
+		/// Adds a resolution restored from the lookup cache (see LookupCache).
+		/// Restored resolutions are then used the same way as those resolved in this session.
+		/// </summary>
+		void Restore(Kind a_kind, std::string a_key, Resolution a_resolution);
+
+		/// <summary>
+		/// Number of identifiers that were actually resolved (rather than restored or reused) since the last Clear.
+		/// </summary>
+		[[nodiscard]] std::uint64_t GetResolvedCount() const { return misses + prefetched; }
+
+		/// <summary>
+		/// Logs cache statistics: hit rate and an estimate of time saved by cached lookups.
+		/// Only Resolve calls count as references, Prefetch only contributes forms that it resolved.
+		/// </summary>
+		void LogStatistics() const;
+
+		/// <summary>
+		/// Drops all cached resolutions and statistics.
+		/// </summary>
+		void Clear();
+
+	private:
+		using clock = std::chrono::steady_clock;
+
+		/// Statistics that a resolution is counted in.
+		enum class Counter : std::uint8_t
+		{
+			kLookup = 0,
+			kPrefetch
+		};
+
+		static Resolution resolve(RE::TESDataHandler* const a_dataHandler, const FormModPair& a_formMod);
+		static Resolution resolve(const std::string& a_editorID);
+
+		void prefetch(RE::TESDataHandler* const a_dataHandler, const FormModPair& a_formMod);
+		void prefetch(const std::string& a_editorID);
+
+		template <class Func>
+		const Resolution& find_or_resolve(StringMap<Resolution>& a_cache, std::string&& a_key, Func&& a_resolve, Counter a_counter);
+
+		mutable Lock          lock;
+		StringMap<Resolution> formIDs{};  // segmented map keeps references to cached resolutions stable
+		StringMap<Resolution> editorIDs{};
+
+		std::atomic<std::uint64_t> hits{ 0 };
+		std::atomic<std::uint64_t> misses{ 0 };
+		std::atomic<std::uint64_t> prefetched{ 0 };
+		std::atomic<std::uint64_t> restored{ 0 };
+		std::atomic<std::uint64_t> missTimeNs{ 0 };
+	};
+}
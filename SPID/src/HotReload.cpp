@@ -0,0 +1,308 @@
+#include "HotReload.h"
+#include "ConfigCache.h"
+#include "FormData.h"
+#include "FormResolver.h"
+#include "KeywordDependencies.h"
+#include "LookupForms.h"
+#include "Settings.h"
+
+namespace Distribution
+{
+	namespace HotReload::detail
+	{
+		using namespace std::chrono_literals;
+
+		/// How often configs are checked for changes.
+		constexpr auto pollInterval = 1s;
+
+		struct Stamp
+		{
+			std::uint64_t size{ 0 };
+			std::int64_t  modifiedTime{ 0 };
+
+			bool operator==(const Stamp&) const = default;
+		};
+
+		std::optional<Stamp> get_stamp(const std::string& a_path)
+		{
+			std::error_code ec;
+
+			const auto size = std::filesystem::file_size(a_path, ec);
+			if (ec) {
+				return std::nullopt;
+			}
+
+			const auto modifiedTime = std::filesystem::last_write_time(a_path, ec);
+			if (ec) {
+				return std::nullopt;
+			}
+
+			return Stamp{ size, static_cast<std::int64_t>(modifiedTime.time_since_epoch().count()) };
+		}
+
+		/// Stamps of configs as they were when they were last checked. Only accessed by the watcher thread once it's started.
+		StringMap<Stamp> stamps{};
+
+		std::jthread watcher{};
+
+		Lock                           lock;
+		Map<RE::FormID, std::uint32_t> npcGenerations{};  // NPCs that were processed after a reload -> generation they received
+
+		/// Returns paths of configs that were added, changed or removed since the last check.
+		std::vector<std::string> find_changes()
+		{
+			std::vector<std::string> changes{};
+			StringMap<Stamp>         current{};
+
+			for (auto& path : distribution::get_configs(R"(Data\)", "_DISTR"sv)) {
+				const auto stamp = get_stamp(path);
+				if (!stamp) {
+					continue;
+				}
+				if (const auto it = stamps.find(path); it == stamps.end() || it->second != *stamp) {
+					changes.push_back(path);
+				}
+				current.emplace(std::move(path), *stamp);
+			}
+
+			for (const auto& [path, stamp] : stamps) {
+				if (!current.contains(path)) {
+					changes.push_back(path);
+				}
+			}
+
+			stamps = std::move(current);
+			return changes;
+		}
+
+		/// <summary>
+		/// Replaces entries of a_distributable that were looked up from a_path:
+		/// entries whose sources are in a_stale are removed, and entries appended after a_oldSize are moved to where entries of a_path are.
+		/// </summary>
+		/// <returns>Number of removed entries.</returns>
+		template <class Form>
+		std::size_t patch(Forms::Distributables<Form>& a_distributable, std::string_view a_path, std::size_t a_oldSize, Map<std::uint64_t, std::uint32_t>& a_stale)
+		{
+			auto& forms = a_distributable.GetForms();
+
+			Forms::DataVec<Form> result{};
+			result.reserve(forms.size());
+
+			std::size_t                removed = 0;
+			std::optional<std::size_t> afterLastKept{};
+			std::optional<std::size_t> firstRemoved{};
+
+			for (std::size_t i = 0; i < a_oldSize; ++i) {
+				auto& entry = forms[i];
+				if (entry.path == a_path) {
+					if (const auto it = a_stale.find(entry.source); it != a_stale.end() && it->second > 0) {
+						--it->second;
+						++removed;
+						if (!firstRemoved) {
+							firstRemoved = result.size();
+						}
+						continue;
+					}
+					result.push_back(std::move(entry));
+					afterLastKept = result.size();
+				} else {
+					result.push_back(std::move(entry));
+				}
+			}
+
+			// New entries go after the last entry of the same file that was kept, or where the first removed one was,
+			// so that they're distributed in about the same order as they would've been after restarting the game.
+			const auto position = afterLastKept.value_or(firstRemoved.value_or(result.size()));
+			result.insert(result.begin() + position, std::make_move_iterator(forms.begin() + a_oldSize), std::make_move_iterator(forms.end()));
+
+			forms = std::move(result);
+
+			return removed;
+		}
+
+		void reload(RE::TESDataHandler* const a_dataHandler, const std::string& a_path)
+		{
+			using namespace Forms;
+
+			Timer timer;
+			timer.start();
+
+			logger::info("Reloading {}", a_path);
+
+			const auto path = a_path.substr(5);  //strip "Data\\"
+
+			const auto file = std::filesystem::exists(a_path) ? INI::ParseConfig(a_path) : INI::ConfigFile{ .path = a_path };
+			if (!file.deathConfigs.empty() || !file.linkedConfigs.empty() || !file.exclusiveGroups.empty()) {
+				logger::warn("\tChanges to Death, Linked and ExclusiveGroup entries require restarting the game");
+			}
+
+			// Actors can be loaded on other threads in the meantime, so they wait until entries are consistent again.
+			WriteLocker locker(distributablesLock);
+
+			// Sources of entries that are currently distributed, which are removed unless the new version of the file still has them.
+			Map<std::uint64_t, std::uint32_t> stale{};
+			ForEachDistributable([&]<class Form>(Distributables<Form>& a_distributable) {
+				for (const auto& entry : a_distributable.GetForms()) {
+					if (entry.path == path) {
+						++stale[entry.source];
+					}
+				}
+			});
+
+			std::size_t kept = 0;
+
+			INI::Configs added{};
+			for (const auto& [type, entries] : file.configs) {
+				for (const auto& entry : entries) {
+					if (const auto it = stale.find(INI::Cache::Hash(entry)); it != stale.end() && it->second > 0) {
+						--it->second;
+						++kept;
+					} else {
+						added[type].push_back(entry);
+					}
+				}
+			}
+
+			std::vector<std::size_t> oldSizes{};
+			ForEachDistributable([&]<class Form>(Distributables<Form>& a_distributable) {
+				oldSizes.push_back(a_distributable.GetSize());
+			});
+
+			Lookup::LookupEntries(a_dataHandler, added);
+
+			std::size_t addedCount = 0;
+			std::size_t removedCount = 0;
+			bool        keywordsChanged = false;
+
+			const auto newGeneration = distributablesGeneration + 1;
+
+			std::size_t i = 0;
+			ForEachDistributable([&]<class Form>(Distributables<Form>& a_distributable) {
+				const auto oldSize = oldSizes[i++];
+
+				auto& forms = a_distributable.GetForms();
+				for (auto entry = forms.begin() + oldSize; entry != forms.end(); ++entry) {
+					entry->generation = newGeneration;
+				}
+
+				const auto addedHere = forms.size() - oldSize;
+				const auto removedHere = patch(a_distributable, path, oldSize, stale);
+
+				if (addedHere > 0 || removedHere > 0) {
+					a_distributable.FinishLookupForms();
+					if constexpr (std::is_same_v<Form, RE::BGSKeyword>) {
+						keywordsChanged = true;
+					}
+				}
+
+				addedCount += addedHere;
+				removedCount += removedHere;
+			});
+
+			if (keywordsChanged) {
+				Dependencies::ResolveKeywords();
+				keywords.FinishLookupForms();
+			}
+
+			if (addedCount > 0) {
+				distributablesGeneration = newGeneration;
+			}
+
+			Resolver::GetSingleton()->Clear();
+
+			timer.end();
+
+			logger::info("\t{} entries unchanged, {} removed, {} added in {}μs / {}ms", kept, removedCount, addedCount, timer.duration_μs(), timer.duration_ms());
+		}
+
+		void watch(std::stop_token a_token)
+		{
+			std::mutex                  mutex;
+			std::condition_variable_any wakeUp;
+
+			while (!a_token.stop_requested()) {
+				{
+					std::unique_lock guard(mutex);
+					(void)wakeUp.wait_for(guard, a_token, pollInterval, [] { return false; });
+				}
+				if (a_token.stop_requested()) {
+					break;
+				}
+
+				if (auto changes = find_changes(); !changes.empty()) {
+					SKSE::GetTaskInterface()->AddTask([changes = std::move(changes)] {
+						const auto dataHandler = RE::TESDataHandler::GetSingleton();
+						for (const auto& path : changes) {
+							reload(dataHandler, path);
+						}
+					});
+				}
+			}
+		}
+	}
+
+	namespace INI
+	{
+		std::uint64_t GetSourceID(const Data& a_data)
+		{
+			return HotReload::IsEnabled() ? Cache::Hash(a_data) : 0;
+		}
+	}
+
+	namespace HotReload
+	{
+		bool IsEnabled()
+		{
+			return Settings::GetSingleton()->hotReload;
+		}
+
+		void Start()
+		{
+			using namespace detail;
+
+			if (!IsEnabled() || watcher.joinable()) {
+				return;
+			}
+
+			(void)find_changes();
+			logger::info("Watching {} configs for changes", stamps.size());
+
+			watcher = std::jthread(watch);
+		}
+
+		std::uint32_t GetGeneration()
+		{
+			return Forms::distributablesGeneration;
+		}
+
+		void MarkDistributed(const RE::TESNPC* a_npc, std::uint32_t a_generation)
+		{
+			using namespace detail;
+
+			if (a_generation > 0) {
+				WriteLocker locker(lock);
+				npcGenerations.insert_or_assign(a_npc->GetFormID(), a_generation);
+			}
+		}
+
+		std::optional<std::uint32_t> CatchUp(const RE::TESNPC* a_npc)
+		{
+			using namespace detail;
+
+			const auto current = Forms::distributablesGeneration.load();
+			if (current == 0) {
+				return std::nullopt;
+			}
+
+			WriteLocker locker(lock);
+
+			// NPCs that aren't tracked were processed before the first reload.
+			auto& received = npcGenerations[a_npc->GetFormID()];
+			if (received >= current) {
+				return std::nullopt;
+			}
+
+			return std::exchange(received, current);
+		}
+	}
+}
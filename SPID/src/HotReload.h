@@ -0,0 +1,45 @@
+#pragma once
+
+namespace Distribution
+{
+	/// <summary>
+	/// Applies changes of _DISTR configs while the game is running, so that configs can be iterated on without restarting the game.
+	///
+	/// A background thread polls configs for changes. Changed files are parsed again on the main thread and their entries are compared
+	/// with entries that are currently distributed: unchanged entries are kept as they are, removed entries are no longer distributed,
+	/// and new entries are looked up and inserted where entries of the same file are.
+	/// Entries are changed while holding Forms::distributablesLock, so distribution running on other threads sees them either before or after a reload.
+	///
+	/// Forms that were already distributed are not taken away from NPCs.
+	/// NPCs that were processed before a reload receive entries added by it the next time they are loaded.
+	/// Only regular distribution entries are reloaded: changes to Death, Linked and ExclusiveGroup entries still require restarting the game.
+	///
+	/// Hot reload is disabled unless enabled in settings (see Settings::hotReload).
+	/// </summary>
+	namespace HotReload
+	{
+		[[nodiscard]] bool IsEnabled();
+
+		/// <summary>
+		/// Starts watching configs for changes, if hot reload is enabled. Must be called once lookup is done.
+		/// </summary>
+		void Start();
+
+		/// <summary>
+		/// Number of reloads that added entries. Entries are tagged with the generation that added them.
+		/// </summary>
+		[[nodiscard]] std::uint32_t GetGeneration();
+
+		/// <summary>
+		/// Records that NPC received all entries up to given generation.
+		///
+		/// The generation must be the one that Distribute returned, since a reload might add entries before this is called.
+		/// </summary>
+		void MarkDistributed(const RE::TESNPC* a_npc, std::uint32_t a_generation);
+
+		/// <summary>
+		/// Returns generation of entries that NPC last received, if entries were added since then, and marks NPC as up to date.
+		/// </summary>
+		[[nodiscard]] std::optional<std::uint32_t> CatchUp(const RE::TESNPC* a_npc);
+	}
+}
@@ -0,0 +1,138 @@
+#include "IniReader.h"
+
+namespace Ini
+{
+	namespace detail
+	{
+		// Character classes match CSimpleIniA's IsSpace, IsNewLineChar and IsComment.
+		constexpr bool is_space(char a_ch)
+		{
+			return a_ch == ' ' || a_ch == '\t' || a_ch == '\r' || a_ch == '\n';
+		}
+
+		constexpr bool is_new_line(char a_ch)
+		{
+			return a_ch == '\n' || a_ch == '\r';
+		}
+
+		constexpr bool is_comment(char a_ch)
+		{
+			return a_ch == ';' || a_ch == '#';
+		}
+
+		constexpr std::string_view trim_end(std::string_view a_str)
+		{
+			while (!a_str.empty() && is_space(a_str.back())) {
+				a_str.remove_suffix(1);
+			}
+			return a_str;
+		}
+
+		constexpr long lower(char a_ch)
+		{
+			return (a_ch < 'A' || a_ch > 'Z') ? static_cast<signed char>(a_ch) : a_ch - 'A' + 'a';
+		}
+	}
+
+	Scanner::Scanner(std::string_view a_text)
+	{
+		// CSimpleIniA only sees text up to the first NUL.
+		if (const auto end = a_text.find('\0'); end != std::string_view::npos) {
+			a_text = a_text.substr(0, end);
+		}
+
+		if (a_text.starts_with("\xEF\xBB\xBF")) {
+			a_text.remove_prefix(3);
+		}
+
+		text = a_text;
+	}
+
+	bool Scanner::Next(Entry& a_entry)
+	{
+		using namespace detail;
+
+		const auto size = text.size();
+		auto&      i = position;
+
+		const auto skip_line = [&] {
+			while (i < size && !is_new_line(text[i])) {
+				++i;
+			}
+		};
+
+		while (i < size) {
+			while (i < size && is_space(text[i])) {
+				++i;
+			}
+			if (i == size) {
+				break;
+			}
+
+			const auto ch = text[i];
+
+			if (is_comment(ch)) {
+				skip_line();
+				continue;
+			}
+
+			if (ch == '[') {
+				++i;
+				while (i < size && is_space(text[i])) {
+					++i;
+				}
+
+				const auto start = i;
+				while (i < size && text[i] != ']' && !is_new_line(text[i])) {
+					++i;
+				}
+				// Unterminated section headers are ignored along with the rest of the line.
+				if (i == size || text[i] != ']') {
+					continue;
+				}
+
+				isRootSection = trim_end(text.substr(start, i - start)).empty();
+				skip_line();
+				continue;
+			}
+
+			const auto keyStart = i;
+			while (i < size && text[i] != '=' && !is_new_line(text[i])) {
+				++i;
+			}
+			if (i == size || text[i] != '=' || i == keyStart) {
+				skip_line();
+				continue;
+			}
+			const auto key = trim_end(text.substr(keyStart, i - keyStart));
+
+			++i;
+			while (i < size && is_space(text[i]) && !is_new_line(text[i])) {
+				++i;
+			}
+			const auto valueStart = i;
+			skip_line();
+
+			if (isRootSection) {
+				a_entry.key = key;
+				a_entry.value = trim_end(text.substr(valueStart, i - valueStart));
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool KeyLess(std::string_view a_lhs, std::string_view a_rhs)
+	{
+		const auto size = a_lhs.size() < a_rhs.size() ? a_lhs.size() : a_rhs.size();
+		for (std::size_t i = 0; i < size; ++i) {
+			const auto lhs = detail::lower(a_lhs[i]);
+			const auto rhs = detail::lower(a_rhs[i]);
+			if (lhs != rhs) {
+				return lhs < rhs;
+			}
+		}
+		return a_lhs.size() < a_rhs.size();
+	}
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+// Streaming reader of _DISTR config files.
+// This header is intentionally self-contained (it doesn't rely on PCH), so that reader can be tested and benchmarked outside of the game.
+
+#include <cstddef>
+#include <string_view>
+
+namespace Ini
+{
+	/// A single "Key = Value" line. Both views point into the scanned text.
+	struct Entry
+	{
+		std::string_view key{};
+		std::string_view value{};
+	};
+
+	/// <summary>
+	/// Scans entries of the root section (the one before any [Section] header) of an INI text, in the order they appear.
+	/// Nothing is copied or allocated, so a single pass over a memory-mapped file is all the work that reading takes.
+	///
+	/// Lines are interpreted exactly as CSimpleIniA (with SetUnicode and SetMultiKey) loads them:
+	///  - whitespace around keys and values is trimmed, and lines end at either '\n' or '\r';
+	///  - lines starting with ';' or '#' are comments;
+	///  - lines without '=' or with an empty key are skipped;
+	///  - every line is an entry of its own, even if the same key appears multiple times;
+	///  - "[]" switches back to the root section;
+	///  - a UTF-8 BOM is skipped and scanning stops at the first NUL character.
+	/// </summary>
+	class Scanner
+	{
+	public:
+		explicit Scanner(std::string_view a_text);
+
+		/// Reads the next entry of the root section into a_entry. Returns false once there are no more entries.
+		bool Next(Entry& a_entry);
+
+	private:
+		std::string_view text;
+		std::size_t      position{ 0 };
+		bool             isRootSection{ true };
+	};
+
+	/// <summary>
+	/// Order in which CSimpleIniA iterates keys of a section: case-insensitive for ASCII letters,
+	/// comparing other bytes as MSVC's signed char. Entries with equal keys keep the order in which they were loaded.
+	///
+	/// SPID used to parse entries in this order, so it is preserved to keep distribution order unchanged.
+	/// </summary>
+	bool KeyLess(std::string_view a_lhs, std::string_view a_rhs);
+}
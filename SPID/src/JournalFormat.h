@@ -0,0 +1,189 @@
+#pragma once
+
+// On-disk layout of the distribution journal (see DistributionJournal.h).
+// This header is intentionally self-contained (it doesn't rely on PCH), so that journals can be decoded outside of the game.
+
+#include "BinaryIO.h"
+
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <utility>
+
+namespace Distribution::Journal
+{
+	/// Part of distribution that distributed a form. 0 is reserved, so that zeroed space at the end of a journal is never mistaken for a record.
+	enum class Phase : std::uint8_t
+	{
+		kNone = 0,
+		kRegular,  // distribution to an actor when it's loaded
+		kLevelUp,  // redistribution of PC-level-mult entries when the player levels up
+		kOutfits,  // distribution of outfits when an actor is loaded
+		kDeath,    // distribution to a dying actor
+		kReload,   // distribution of entries added by hot reload
+
+		kTotal
+	};
+
+	inline constexpr std::array<std::string_view, std::to_underlying(Phase::kTotal)> phaseNames{ "none", "regular", "levelup", "outfits", "death", "reload" };
+
+	inline std::string_view GetPhaseName(Phase a_phase)
+	{
+		return a_phase < Phase::kTotal ? phaseNames[std::to_underlying(a_phase)] : "unknown";
+	}
+
+	inline std::optional<Phase> ParsePhase(std::string_view a_name)
+	{
+		if (const auto it = std::ranges::find(phaseNames, a_name); it != phaseNames.end() && it != phaseNames.begin()) {
+			return static_cast<Phase>(it - phaseNames.begin());
+		}
+		return std::nullopt;
+	}
+
+	/// A single distributed form. Records are written in native byte order, same as the header.
+	struct Record
+	{
+		std::uint64_t timestamp{ 0 };  // ns since the journal was started
+		std::uint32_t actorID{ 0 };
+		std::uint32_t baseID{ 0 };  // actor's TESNPC
+		std::uint32_t formID{ 0 };  // distributed form, which differs from entry's form for leveled items
+		std::uint32_t entry{ 0 };   // index into EntryTable::entries
+		std::uint8_t  formType{ 0 };
+		Phase         phase{ Phase::kNone };
+		std::uint8_t  padding[6]{};
+	};
+	static_assert(sizeof(Record) == 32 && std::is_trivially_copyable_v<Record>);
+
+	struct Header
+	{
+		static constexpr std::uint64_t kMagic = 0x314E524A44495053;  // "SPIDJRN1"
+		static constexpr std::uint32_t kFormatVersion = 1;           // must be bumped whenever layout of Header or Record changes
+
+		std::uint64_t magic{ kMagic };
+		std::uint32_t formatVersion{ kFormatVersion };
+		std::uint32_t recordSize{ sizeof(Record) };
+		std::uint64_t session{ 0 };    // identifies the entry table that belongs to the journal
+		std::uint64_t startTime{ 0 };  // unix time in ms at which the journal was started
+	};
+	static_assert(sizeof(Header) == 32 && std::is_trivially_copyable_v<Header>);
+
+	/// Distributed form and the file that distributed it, which is what records refer to.
+	struct Entry
+	{
+		std::uint32_t formID{ 0 };
+		std::uint8_t  formType{ 0 };
+		std::string   formTypeName{};
+		std::string   editorID{};
+		std::string   path{};
+	};
+
+	struct EntryTable
+	{
+		std::uint64_t      session{ 0 };
+		std::vector<Entry> entries{};
+	};
+
+	struct Journal
+	{
+		Header              header{};
+		std::vector<Record> records{};
+
+		/// Whether the journal ended with an incomplete record, e.g. because the game crashed while it was written.
+		bool truncated{ false };
+	};
+
+	/// Entry table is saved next to the journal.
+	inline std::filesystem::path GetEntriesPath(const std::filesystem::path& a_journal)
+	{
+		auto path = a_journal;
+		path += ".entries";
+		return path;
+	}
+
+	namespace detail
+	{
+		/// Build is left empty, since tables are meant to be decoded by any build.
+		inline constexpr Binary::FileHeader entriesHeader{
+			.magic = 0x544E454A44495053,  // "SPIDJENT"
+			.formatVersion = 1
+		};
+	}
+
+	inline std::expected<void, Binary::FileError> SaveEntries(const std::filesystem::path& a_path, const EntryTable& a_table)
+	{
+		Binary::Writer payload{};
+		payload.write(a_table.session);
+		payload.write(static_cast<std::uint32_t>(a_table.entries.size()));
+		for (const auto& entry : a_table.entries) {
+			payload.write(entry.formID);
+			payload.write(entry.formType);
+			payload.write(entry.formTypeName);
+			payload.write(entry.editorID);
+			payload.write(entry.path);
+		}
+		return Binary::save_file(a_path, detail::entriesHeader, payload);
+	}
+
+	inline std::expected<EntryTable, std::string> ReadEntries(std::span<const std::byte> a_bytes)
+	{
+		const auto payload = Binary::open_payload(a_bytes, detail::entriesHeader);
+		if (!payload) {
+			return std::unexpected("entry table " + std::string(Binary::describe(payload.error())));
+		}
+
+		EntryTable table{};
+		try {
+			Binary::Reader reader(*payload);
+			table.session = reader.read<std::uint64_t>();
+			table.entries.resize(reader.read_count(sizeof(std::uint32_t) + sizeof(std::uint8_t) + 3 * sizeof(std::uint32_t)));
+			for (auto& entry : table.entries) {
+				entry.formID = reader.read<std::uint32_t>();
+				entry.formType = reader.read<std::uint8_t>();
+				entry.formTypeName = reader.read_string();
+				entry.editorID = reader.read_string();
+				entry.path = reader.read_string();
+			}
+		} catch (const Binary::ReadError& e) {
+			return std::unexpected(std::string("entry table is corrupted (") + e.what() + ")");
+		}
+		return table;
+	}
+
+	/// <summary>
+	/// Reads a journal, which can end with zeroed space if it wasn't closed.
+	/// Fails if it's not a journal or if any record is corrupted.
+	/// </summary>
+	inline std::expected<Journal, std::string> Read(std::span<const std::byte> a_bytes)
+	{
+		Journal journal{};
+
+		if (a_bytes.size() < sizeof(Header)) {
+			return std::unexpected(std::string("not a SPID journal"));
+		}
+		std::memcpy(&journal.header, a_bytes.data(), sizeof(Header));
+		if (journal.header.magic != Header::kMagic) {
+			return std::unexpected(std::string("not a SPID journal"));
+		}
+		if (journal.header.formatVersion != Header::kFormatVersion || journal.header.recordSize != sizeof(Record)) {
+			return std::unexpected("unsupported journal format version " + std::to_string(journal.header.formatVersion) + " (expected " + std::to_string(Header::kFormatVersion) + ")");
+		}
+
+		auto records = a_bytes.subspan(sizeof(Header));
+		journal.records.reserve(records.size() / sizeof(Record));
+
+		for (; records.size() >= sizeof(Record); records = records.subspan(sizeof(Record))) {
+			Record record;
+			std::memcpy(&record, records.data(), sizeof(Record));
+			if (record.phase == Phase::kNone) {
+				return journal;
+			}
+			if (record.phase >= Phase::kTotal) {
+				return std::unexpected("journal is corrupted (unknown phase of record " + std::to_string(journal.records.size()) + ")");
+			}
+			journal.records.push_back(record);
+		}
+
+		journal.truncated = std::ranges::any_of(records, [](std::byte a_byte) { return a_byte != std::byte{ 0 }; });
+		return journal;
+	}
+}
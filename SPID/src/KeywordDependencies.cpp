@@ -1,6 +1,9 @@
 #include "KeywordDependencies.h"
 #include "DependencyResolver.h"
+#include "EditorIDIndex.h"
 #include "FormData.h"
+#include "StringKernels.h"
+#include "Trace.h"
 
 using Keyword = RE::BGSKeyword*;
 
@@ -63,6 +66,8 @@ void AddDependency(Resolver& resolver, const Keyword& lhs, const Keyword& rhs)
 
 void Dependencies::ResolveKeywords()
 {
+	TRACE_ZONE("ResolveKeywords");
+
 	if (!Forms::keywords) {
 		return;
 	}
@@ -70,30 +75,21 @@ void Dependencies::ResolveKeywords()
 	Timer timer;
 	timer.start();
 
-	// Pre-build a map of all available keywords by names.
-	StringMap<RE::BGSKeyword*> allKeywords{};
-
 	auto& keywordForms = Forms::keywords.GetForms();
 
-	const auto dataHandler = RE::TESDataHandler::GetSingleton();
-	for (const auto& kwd : dataHandler->GetFormArray<RE::BGSKeyword>()) {
-		if (kwd) {
-			if (const auto edid = kwd->GetFormEditorID(); !string::is_empty(edid)) {
-				allKeywords[edid] = kwd;
-			} else {
-				if (const auto file = kwd->GetFile(0)) {
-					const auto  modname = file->GetFilename();
-					const auto  formID = kwd->GetLocalFormID();
-					std::string mergeDetails;
-					if (g_mergeMapperInterface && g_mergeMapperInterface->isMerge(modname.data())) {
-						const auto [mergedModName, mergedFormID] = g_mergeMapperInterface->GetOriginalFormID(
-							modname.data(),
-							formID);
-						mergeDetails = std::format("->0x{:X}~{}", mergedFormID, mergedModName);
-					}
-					logger::error("\tWARN : [0x{:X}~{}{}] keyword has an empty editorID!", formID, modname, mergeDetails);
-				}
+	const auto index = Forms::EditorIDIndex::GetSingleton();
+	for (const auto& kwd : index->GetUnnamedKeywords()) {
+		if (const auto file = kwd->GetFile(0)) {
+			const auto  modname = file->GetFilename();
+			const auto  formID = kwd->GetLocalFormID();
+			std::string mergeDetails;
+			if (g_mergeMapperInterface && g_mergeMapperInterface->isMerge(modname.data())) {
+				const auto [mergedModName, mergedFormID] = g_mergeMapperInterface->GetOriginalFormID(
+					modname.data(),
+					formID);
+				mergeDetails = fmt::format("->0x{:X}~{}", mergedFormID, mergedModName);
 			}
+			logger::error("\tWARN : [0x{:X}~{}{}] keyword has an empty editorID!", formID, modname, mergeDetails);
 		}
 	}
 
@@ -113,8 +109,9 @@ void Dependencies::ResolveKeywords()
 		dataKeywords.emplace(formData.form, formData);
 		resolver.addIsolated(formData.form);
 
+		// Names are matched ignoring case, same as keyword filters match NPCs, so a dependency isn't missed because of a different case.
 		const auto findKeyword = [&](const std::string& name) -> RE::BGSKeyword* {
-			return allKeywords[name];
+			return index->FindKeyword(name);
 		};
 
 		const auto addDependencies = [&](const StringVec& a_strings, const std::function<RE::BGSKeyword*(const std::string&)>& matchingKeyword) {
@@ -131,12 +128,14 @@ void Dependencies::ResolveKeywords()
 		addDependencies(stringFilters.NOT, findKeyword);
 		addDependencies(stringFilters.MATCH, findKeyword);
 		addDependencies(stringFilters.ANY, [&](const std::string& name) -> RE::BGSKeyword* {
-			for (const auto& [keywordName, keyword] : allKeywords) {
-				if (string::icontains(keywordName, name)) {
-					return keyword;
+			const auto      foldedName = Strings::fold(name);
+			RE::BGSKeyword* result = nullptr;
+			index->ForEachKeyword([&](std::string_view keywordName, RE::BGSKeyword* keyword) {
+				if (!result && Strings::contains(keywordName, foldedName)) {
+					result = keyword;
 				}
-			}
-			return nullptr;
+			});
+			return result;
 		});
 	}
 
@@ -157,6 +156,4 @@ void Dependencies::ResolveKeywords()
 	}
 
 	logger::info("\tKeyword resolution took {}μs / {}ms", timer.duration_μs(), timer.duration_ms());
-
-	allKeywords.clear();
 }
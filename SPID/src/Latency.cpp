@@ -0,0 +1,171 @@
+#include "Latency.h"
+#include "Settings.h"
+
+namespace Latency
+{
+	namespace detail
+	{
+		std::atomic<bool> enabled{ false };
+
+		std::array<Histogram, std::to_underlying(Hook::kTotal)> histograms{};
+
+		/// Stats file is moved aside once it grows larger than this, so that at most two files are kept.
+		constexpr std::uintmax_t maxFileSize = 1024 * 1024;
+
+		double to_us(std::uint64_t a_ns)
+		{
+			return static_cast<double>(a_ns) / 1e3;
+		}
+
+		void append_to_file(const std::array<Summary, std::to_underlying(Hook::kTotal)>& a_summaries)
+		{
+			auto path = SKSE::log::log_directory();
+			if (!path) {
+				return;
+			}
+
+			*path /= Version::PROJECT;
+			*path += "_latency.csv"sv;
+
+			std::error_code error;
+			if (const auto size = std::filesystem::file_size(*path, error); !error && size > maxFileSize) {
+				auto previous = *path;
+				previous.replace_extension(".old.csv");
+				std::filesystem::rename(*path, previous, error);
+			}
+
+			const bool exists = std::filesystem::exists(*path, error);
+
+			std::ofstream file(*path, std::ios::binary | std::ios::app);
+			if (!exists) {
+				file << "unix_time,hook,count,mean_us,p50_us,p99_us,p999_us,max_us\n";
+			}
+
+			const auto time = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+			for (std::size_t i = 0; i < a_summaries.size(); ++i) {
+				const auto& summary = a_summaries[i];
+				if (summary.count > 0) {
+					file << fmt::format("{},{},{},{:.1f},{:.1f},{:.1f},{:.1f},{:.1f}\n",
+						time, GetHookName(static_cast<Hook>(i)), summary.count, to_us(summary.meanNs),
+						to_us(summary.p50Ns), to_us(summary.p99Ns), to_us(summary.p999Ns), to_us(summary.maxNs));
+				}
+			}
+
+			if (!file) {
+				logger::warn("Failed to write latency stats to {}", path->string());
+			}
+		}
+	}
+
+	std::string_view GetHookName(Hook a_hook)
+	{
+		switch (a_hook) {
+		case Hook::kDistribute:
+			return "Distribute"sv;
+		case Hook::kOutfitLoad3D:
+			return "OutfitLoad3D"sv;
+		case Hook::kDeathDistribution:
+			return "DeathDistribution"sv;
+		case Hook::kLevelUp:
+			return "LevelUp"sv;
+		case Hook::kCoSaveLoad:
+			return "CoSaveLoad"sv;
+		case Hook::kCoSaveSave:
+			return "CoSaveSave"sv;
+		default:
+			return "Unknown"sv;
+		}
+	}
+
+	Summary Histogram::Collect()
+	{
+		Counts counts{};
+		for (std::size_t i = 0; i < bucketCount; ++i) {
+			counts[i] = buckets[i].exchange(0, std::memory_order_relaxed);
+		}
+		return Summarize(counts, sum.exchange(0, std::memory_order_relaxed));
+	}
+
+	Summary Histogram::Summarize(const Counts& a_counts, std::uint64_t a_sum)
+	{
+		Summary summary{};
+		for (const auto count : a_counts) {
+			summary.count += count;
+		}
+		if (summary.count == 0) {
+			return summary;
+		}
+
+		summary.meanNs = a_sum / summary.count;
+
+		// Each percentile is the highest value of the first bucket at which cumulative count reaches its rank.
+		const std::array<std::pair<double, std::uint64_t*>, 3> percentiles{ { { 0.5, &summary.p50Ns }, { 0.99, &summary.p99Ns }, { 0.999, &summary.p999Ns } } };
+
+		std::size_t   next = 0;
+		std::uint64_t cumulative = 0;
+		for (std::size_t i = 0; i < bucketCount; ++i) {
+			if (a_counts[i] == 0) {
+				continue;
+			}
+			cumulative += a_counts[i];
+			while (next < percentiles.size() && cumulative >= static_cast<std::uint64_t>(std::ceil(percentiles[next].first * static_cast<double>(summary.count)))) {
+				*percentiles[next++].second = GetHighestValue(i);
+			}
+			summary.maxNs = GetHighestValue(i);
+		}
+
+		return summary;
+	}
+
+	void SetEnabled(bool a_enabled)
+	{
+		detail::enabled.store(a_enabled, std::memory_order_relaxed);
+	}
+
+	bool IsEnabled()
+	{
+		return detail::enabled.load(std::memory_order_relaxed);
+	}
+
+	void Record(Hook a_hook, clock::duration a_duration)
+	{
+		const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(a_duration).count();
+		detail::histograms[std::to_underlying(a_hook)].Record(static_cast<std::uint64_t>(std::max<decltype(ns)>(ns, 0)));
+	}
+
+	std::array<Summary, std::to_underlying(Hook::kTotal)> Collect()
+	{
+		std::array<Summary, std::to_underlying(Hook::kTotal)> result{};
+		for (std::size_t i = 0; i < result.size(); ++i) {
+			result[i] = detail::histograms[i].Collect();
+		}
+		return result;
+	}
+
+	void Dump()
+	{
+		if (!IsEnabled()) {
+			return;
+		}
+
+		const auto summaries = Collect();
+		if (std::ranges::all_of(summaries, [](const Summary& a_summary) { return a_summary.count == 0; })) {
+			return;
+		}
+
+		LOG_HEADER("LATENCY");
+		logger::info("{:<20} {:>10} {:>12} {:>12} {:>12} {:>12} {:>12}", "Since last save", "Count", "Mean (us)", "p50 (us)", "p99 (us)", "p99.9 (us)", "Max (us)");
+		for (std::size_t i = 0; i < summaries.size(); ++i) {
+			const auto& summary = summaries[i];
+			if (summary.count > 0) {
+				logger::info("{:<20} {:>10} {:>12.1f} {:>12.1f} {:>12.1f} {:>12.1f} {:>12.1f}",
+					GetHookName(static_cast<Hook>(i)), summary.count, detail::to_us(summary.meanNs),
+					detail::to_us(summary.p50Ns), detail::to_us(summary.p99Ns), detail::to_us(summary.p999Ns), detail::to_us(summary.maxNs));
+			}
+		}
+
+		if (Settings::GetSingleton()->latencyStatsFile) {
+			detail::append_to_file(summaries);
+		}
+	}
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+/// <summary>
+/// Latency histograms of SPID's entry points, to find hitches that averages hide.
+///
+/// Every entry point has a histogram with logarithmic buckets, each split into 32 linear sub-buckets (as in HdrHistogram),
+/// so percentiles are reported within ~3% of actual durations. Recording only increments atomic counters, so it never waits for other threads.
+///
+/// Latencies are only recorded when enabled in settings (see Settings::latencyStats). Percentiles since the previous save are logged
+/// whenever the game is saved, and can also be appended to a rolling CSV next to the log (see Settings::latencyStatsFile).
+/// </summary>
+namespace Latency
+{
+	using clock = std::chrono::steady_clock;
+
+	enum class Hook : std::uint8_t
+	{
+		kDistribute = 0,     // distribution to an actor when it's loaded
+		kOutfitLoad3D,       // resolution of worn outfit in Load3D
+		kDeathDistribution,  // distribution to a dying actor
+		kLevelUp,            // redistribution of PC-level-mult entries when the player levels up
+		kCoSaveLoad,         // loading outfits from SKSE co-save
+		kCoSaveSave,         // saving outfits to SKSE co-save
+
+		kTotal
+	};
+
+	std::string_view GetHookName(Hook a_hook);
+
+	struct Summary
+	{
+		std::uint64_t count{ 0 };
+		std::uint64_t meanNs{ 0 };
+		std::uint64_t p50Ns{ 0 };
+		std::uint64_t p99Ns{ 0 };
+		std::uint64_t p999Ns{ 0 };
+		std::uint64_t maxNs{ 0 };  // within precision of a bucket
+	};
+
+	/// <summary>
+	/// Histogram of durations in ns with 32 sub-buckets per power of two. Values below 32 ns are counted exactly.
+	/// </summary>
+	class Histogram
+	{
+	public:
+		static constexpr std::size_t subBucketBits = 5;
+		static constexpr std::size_t subBuckets = 1 << subBucketBits;
+		static constexpr std::size_t bucketCount = (64 - subBucketBits + 1) * subBuckets;
+
+		using Counts = std::array<std::uint64_t, bucketCount>;
+
+		/// Index of the bucket that counts a_value.
+		[[nodiscard]] static constexpr std::size_t GetBucket(std::uint64_t a_value)
+		{
+			if (a_value < subBuckets) {
+				return static_cast<std::size_t>(a_value);
+			}
+			const auto shift = static_cast<std::size_t>(std::bit_width(a_value)) - 1 - subBucketBits;
+			return (shift + 1) * subBuckets + static_cast<std::size_t>((a_value >> shift) - subBuckets);
+		}
+
+		/// Largest value that is counted by a_bucket.
+		[[nodiscard]] static constexpr std::uint64_t GetHighestValue(std::size_t a_bucket)
+		{
+			if (a_bucket < subBuckets) {
+				return a_bucket;
+			}
+			const auto shift = a_bucket / subBuckets - 1;
+			const auto lowest = (subBuckets + a_bucket % subBuckets) << shift;
+			return lowest + ((std::uint64_t{ 1 } << shift) - 1);
+		}
+
+		void Record(std::uint64_t a_ns)
+		{
+			buckets[GetBucket(a_ns)].fetch_add(1, std::memory_order_relaxed);
+			sum.fetch_add(a_ns, std::memory_order_relaxed);
+		}
+
+		/// <summary>
+		/// Summarizes everything recorded since the previous call and starts over.
+		/// Counters are swapped out one by one, so durations that are recorded meanwhile are either in this summary or in the next one.
+		/// </summary>
+		[[nodiscard]] Summary Collect();
+
+		/// Summarizes a_counts, which sum up to a_sum ns.
+		[[nodiscard]] static Summary Summarize(const Counts& a_counts, std::uint64_t a_sum);
+
+	private:
+		std::array<std::atomic<std::uint64_t>, bucketCount> buckets{};
+		std::atomic<std::uint64_t>                          sum{ 0 };
+	};
+
+	void               SetEnabled(bool a_enabled);
+	[[nodiscard]] bool IsEnabled();
+
+	/// Records a_duration for a_hook, if recording is enabled.
+	void Record(Hook a_hook, clock::duration a_duration);
+
+	/// <summary>
+	/// Summaries of all hooks since the previous collection.
+	/// </summary>
+	[[nodiscard]] std::array<Summary, std::to_underlying(Hook::kTotal)> Collect();
+
+	/// <summary>
+	/// Logs summaries of hooks that were called since the previous dump, and appends them to the stats file if it's enabled.
+	/// </summary>
+	void Dump();
+
+	/// Records time between its construction and destruction for a hook.
+	class Scope
+	{
+	public:
+		explicit Scope(Hook a_hook) :
+			hook(a_hook),
+			start(IsEnabled() ? clock::now() : clock::time_point{})
+		{}
+
+		~Scope()
+		{
+			if (start != clock::time_point{}) {
+				Record(hook, clock::now() - start);
+			}
+		}
+
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+
+	private:
+		Hook              hook;
+		clock::time_point start;
+	};
+}
@@ -11,8 +11,6 @@ namespace LinkedDistribution
 #pragma region Parsing
 	namespace INI
 	{
-		LinkedFormsConfig linkedConfigs{};
-
 		namespace concepts
 		{
 			template <typename Data>
@@ -37,32 +35,31 @@ namespace LinkedDistribution
 		struct LinkedKeyComponentParser
 		{
 			template <concepts::linked_typed_data Data>
-			bool operator()(const std::string& originalKey, Data& data) const
+			bool operator()(std::string_view key, Data& data) const
 			{
 				// Preferred order of keywords to sound more natural :) presumably.
 				// LinkedFinalOutfit
 				// GlobalLinkedFinalDeathOutfit
-				std::string key = originalKey;
 
 				if (key.starts_with("Global"sv)) {
 					data.scope = kGlobal;
-					key.erase(0, 6);
+					key.remove_prefix(6);
 				}
 
 				if (!key.starts_with("Linked"sv)) {
 					return false;
 				}
 
-				key.erase(0, 6);
+				key.remove_prefix(6);
 
 				if (key.starts_with("Final"sv)) {
 					data.recordTraits = RECORD::TRAITS::Final;
-					key.erase(0, 5);
+					key.remove_prefix(5);
 				}
 
 				if (key.starts_with("Death"sv)) {
 					data.distributionType = kDeath;
-					key.erase(0, 5);
+					key.remove_prefix(5);
 				}
 
 				auto type = RECORD::GetType(key);
@@ -76,7 +73,7 @@ namespace LinkedDistribution
 			}
 		};
 
-		bool TryParse(const std::string& key, const std::string& value, const Path& path)
+		bool TryParse(const std::string& key, const std::string& value, const Path& path, LinkedFormsConfig& a_configs)
 		{
 			try {
 				if (auto optData = Parse<RawLinkedForm,
@@ -95,7 +92,7 @@ namespace LinkedDistribution
 						logger::warn("\t\t[{} = {}]", key, value);
 						logger::warn("\t\t\tFinal modifier can only be applied to Outfits.");
 					}
-					linkedConfigs[data.type].push_back(data);
+					a_configs[data.type].push_back(data);
 				} else {
 					return false;
 				}
@@ -108,6 +105,16 @@ namespace LinkedDistribution
 			}
 			return true;
 		}
+
+		void CollectRawForms(RawFormRefs& refs)
+		{
+			for (const auto& [type, linkedForms] : linkedConfigs) {
+				for (const auto& linkedForm : linkedForms) {
+					refs.push_back(&linkedForm.rawForm);
+					Distribution::INI::CollectRawForms(linkedForm.formFilters, refs);
+				}
+			}
+		}
 	}
 #pragma endregion
 
@@ -116,6 +123,9 @@ namespace LinkedDistribution
 	void Manager::LookupLinkedForms(RE::TESDataHandler* const dataHandler)
 	{
 		ForEachLinkedForms([&]<class Form>(LinkedForms<Form>& forms) {
+			// Forms of the previous lookup are discarded, so that lookup can be repeated (as benchmarks do).
+			forms.forms.clear();
+
 			// If it's spells distributable we want to manually lookup forms to pick LevSpells that are added into the list.
 			if constexpr (!std::is_same_v<Form, RE::SpellItem>) {
 				forms.LookupForms(dataHandler, INI::linkedConfigs[forms.GetType()]);
@@ -62,11 +62,18 @@ namespace LinkedDistribution
 		using LinkedFormsVec = std::vector<RawLinkedForm>;
 		using LinkedFormsConfig = std::unordered_map<RECORD::TYPE, LinkedFormsVec>;
 
+		inline LinkedFormsConfig linkedConfigs{};
+
 		/// <summary>
 		/// Checks whether given entry is a linked form and attempts to parse it.
 		/// </summary>
 		/// <returns>true if given entry was a linked form. Note that returned value doesn't represent whether parsing was successful.</returns>
-		bool TryParse(const std::string& key, const std::string& value, const Path&);
+		bool TryParse(const std::string& key, const std::string& value, const Path&, LinkedFormsConfig& a_configs = linkedConfigs);
+
+		/// <summary>
+		/// Appends identifiers of all linked forms and their parent forms.
+		/// </summary>
+		void CollectRawForms(RawFormRefs&);
 	}
 
 	using namespace Forms;
@@ -83,7 +90,7 @@ namespace LinkedDistribution
 	struct LinkedForms
 	{
 		friend Manager;  // allow Manager to later modify forms directly.
-		friend Form* detail::LookupLinkedForm(RE::TESDataHandler* const, INI::RawLinkedForm&);
+		friend Form* detail::LookupLinkedForm<Form>(RE::TESDataHandler* const, INI::RawLinkedForm&);
 
 		using FormsMap = std::unordered_map<DistributionType, std::unordered_map<Path, std::unordered_map<RE::TESForm*, DataVec<Form>>>>;
 
@@ -168,44 +175,49 @@ namespace LinkedDistribution
 	{
 		using namespace Forms::Lookup;
 
-		try {
-			return Forms::detail::get_form<Form>(dataHandler, rawForm.rawForm, rawForm.path, LookupOptions::kCreateIfMissing);
-		} catch (const UnknownFormIDException& e) {
-			buffered_logger::error("\t\t[{}] LinkedForm [0x{:X}] ({}) SKIP - formID doesn't exist", e.path, e.formID, e.modName.value_or(""));
-		} catch (const UnknownPluginException& e) {
-			buffered_logger::error("\t\t[{}] LinkedForm ({}) SKIP - mod cannot be found", e.path, e.modName);
-		} catch (const InvalidKeywordException& e) {
-			buffered_logger::error("\t\t[{}] LinkedForm [0x{:X}] ({}) SKIP - keyword does not have a valid editorID", e.path, e.formID, e.modName.value_or(""));
-		} catch (const KeywordNotFoundException& e) {
+		const auto form = Forms::detail::get_form<Form>(dataHandler, rawForm.rawForm, rawForm.path, LookupOptions::kCreateIfMissing);
+		if (form) {
+			return *form;
+		}
+
+		const auto& e = form.error();
+		switch (e.type) {
+		case ErrorType::kUnknownFormID:
+			buffered_logger::error("\t\t[{}] LinkedForm [0x{:X}] ({}) SKIP - formID doesn't exist", e.path, *e.formID, e.modName.value_or(""));
+			break;
+		case ErrorType::kUnknownPlugin:
+			buffered_logger::error("\t\t[{}] LinkedForm ({}) SKIP - mod cannot be found", e.path, *e.modName);
+			break;
+		case ErrorType::kInvalidKeyword:
+			buffered_logger::error("\t\t[{}] LinkedForm [0x{:X}] ({}) SKIP - keyword does not have a valid editorID", e.path, *e.formID, e.modName.value_or(""));
+			break;
+		case ErrorType::kKeywordNotFound:
 			if (e.isDynamic) {
 				buffered_logger::critical("\t\t[{}] LinkedForm {} FAIL - couldn't create keyword", e.path, e.editorID);
 			} else {
 				buffered_logger::critical("\t\t[{}] LinkedForm {} FAIL - couldn't get existing keyword", e.path, e.editorID);
 			}
-		} catch (const UnknownEditorIDException& e) {
+			break;
+		case ErrorType::kUnknownEditorID:
 			buffered_logger::error("\t\t[{}] LinkedForm ({}) SKIP - editorID doesn't exist", e.path, e.editorID);
-		} catch (const MalformedEditorIDException& e) {
+			break;
+		case ErrorType::kMalformedEditorID:
 			buffered_logger::error("\t\t[{}] LinkedForm (\"\") SKIP - malformed editorID", e.path);
-		} catch (const MismatchingFormTypeException& e) {
-			std::visit(overload{
-						   [&](const FormModPair& formMod) {
-							   auto& [formID, modName] = formMod;
-							   buffered_logger::error("\t\t[{}] LinkedForm [0x{:X}] ({}) SKIP - mismatching form type (expected: {}, actual: {})", e.path, *formID, modName.value_or(""), e.expectedFormType, e.actualFormType);
-						   },
-						   [&](std::string editorID) {
-							   buffered_logger::error("\t\t[{}] LinkedForm ({}) SKIP - mismatching form type (expected: {}, actual: {})", e.path, editorID, e.expectedFormType, e.actualFormType);
-						   } },
-				e.formOrEditorID);
-		} catch (const InvalidFormTypeException& e) {
-			std::visit(overload{
-						   [&](const FormModPair& formMod) {
-							   auto& [formID, modName] = formMod;
-							   buffered_logger::error("\t\t[{}] LinkedForm [0x{:X}] ({}) SKIP - unsupported form type ({})", e.path, *formID, modName.value_or(""), e.formType);
-						   },
-						   [&](std::string editorID) {
-							   buffered_logger::error("\t\t[{}] LinkedForm ({}) SKIP - unsupported form type ({})", e.path, editorID, e.formType);
-						   } },
-				e.formOrEditorID);
+			break;
+		case ErrorType::kMismatchingFormType:
+			if (e.IsEditorID()) {
+				buffered_logger::error("\t\t[{}] LinkedForm ({}) SKIP - mismatching form type (expected: {}, actual: {})", e.path, e.editorID, e.expectedFormType, e.actualFormType);
+			} else {
+				buffered_logger::error("\t\t[{}] LinkedForm [0x{:X}] ({}) SKIP - mismatching form type (expected: {}, actual: {})", e.path, *e.formID, e.modName.value_or(""), e.expectedFormType, e.actualFormType);
+			}
+			break;
+		case ErrorType::kInvalidFormType:
+			if (e.IsEditorID()) {
+				buffered_logger::error("\t\t[{}] LinkedForm ({}) SKIP - unsupported form type ({})", e.path, e.editorID, e.actualFormType);
+			} else {
+				buffered_logger::error("\t\t[{}] LinkedForm [0x{:X}] ({}) SKIP - unsupported form type ({})", e.path, *e.formID, e.modName.value_or(""), e.actualFormType);
+			}
+			break;
 		}
 		return nullptr;
 	}
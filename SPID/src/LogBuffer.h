@@ -1,70 +1,144 @@
 #pragma once
 
-#define MAKE_BUFFERED_LOG(a_func, a_type)                                                             \
-                                                                                                      \
-	template <class... Args>                                                                          \
-	struct [[maybe_unused]] a_func                                                                    \
-	{                                                                                                 \
-		a_func() = delete;                                                                            \
-                                                                                                      \
-		explicit a_func(                                                                              \
-			fmt::format_string<Args...> a_fmt,                                                        \
-			Args&&... a_args,                                                                         \
-			std::source_location a_loc = std::source_location::current())                             \
-		{                                                                                             \
-			if (buffer.insert({ a_loc, fmt::format(a_fmt, std::forward<Args>(a_args)...) }).second) { \
-				spdlog::log(                                                                          \
-					spdlog::source_loc{                                                               \
-						a_loc.file_name(),                                                            \
-						static_cast<int>(a_loc.line()),                                               \
-						a_loc.function_name() },                                                      \
-					spdlog::level::a_type,                                                            \
-					a_fmt,                                                                            \
-					std::forward<Args>(a_args)...);                                                   \
-			}                                                                                         \
-		}                                                                                             \
-	};                                                                                                \
-	template <class... Args>                                                                          \
+#define MAKE_BUFFERED_LOG(a_func, a_type)                                             \
+                                                                                      \
+	template <class... Args>                                                          \
+	struct [[maybe_unused]] a_func                                                    \
+	{                                                                                 \
+		a_func() = delete;                                                            \
+                                                                                      \
+		explicit a_func(                                                              \
+			fmt::format_string<Args...> a_fmt,                                        \
+			Args&&... a_args,                                                         \
+			std::source_location a_loc = std::source_location::current())             \
+		{                                                                             \
+			if (!spdlog::should_log(spdlog::level::a_type)) {                         \
+				return;                                                               \
+			}                                                                         \
+			if (detail::remember(detail::make_key(a_loc, a_args...))) {               \
+				spdlog::log(                                                          \
+					spdlog::source_loc{                                               \
+						a_loc.file_name(),                                            \
+						static_cast<int>(a_loc.line()),                               \
+						a_loc.function_name() },                                      \
+					spdlog::level::a_type,                                            \
+					a_fmt,                                                            \
+					std::forward<Args>(a_args)...);                                   \
+			}                                                                         \
+		}                                                                             \
+	};                                                                                \
+	template <class... Args>                                                          \
 	a_func(fmt::format_string<Args...>, Args&&...) -> a_func<Args...>;
 
+/// LogBuffer proxies typical logging calls and buffers received entries to avoid duplication.
+///
+/// Main log proxy functions.
+/// Each log function checks whether given message was already logged and skips the log.
+/// Messages are identified by their source location and arguments rather than by their text, so they are only formatted when they are actually logged.
 namespace LogBuffer
 {
-	struct Entry
+	namespace detail
 	{
-		std::source_location loc;
-		std::string          message;
+		struct key_hash
+		{
+			using is_transparent = void;
+			using is_avalanching = void;
+
+			[[nodiscard]] std::uint64_t operator()(std::string_view a_key) const noexcept
+			{
+				return ankerl::unordered_dense::detail::wyhash::hash(a_key.data(), a_key.size());
+			}
+		};
+
+		/// Number of remembered messages, after which all of them are forgotten (see SetCapacity).
+		inline std::size_t capacity{ 1 << 16 };
+
+		/// Keys of remembered messages (see make_key).
+		inline ankerl::unordered_dense::set<std::string, key_hash, std::equal_to<>> buffer{};
+
+		/// Key of the message that is being logged. It's reused, so that messages that were already logged don't allocate.
+		inline thread_local std::string key{};
 
-		bool operator==(const Entry& other) const
+		inline void append_bytes(std::string& a_key, const void* a_data, std::size_t a_size)
 		{
-			return strcmp(loc.file_name(), other.loc.file_name()) == 0 && loc.line() == other.loc.line() && message == other.message;
+			a_key.append(static_cast<const char*>(a_data), a_size);
 		}
-	};
-}
 
-/// Add hashing for custom log entries.
-template <>
-struct ankerl::unordered_dense::hash<LogBuffer::Entry>
-{
-	using is_avalanching = void;
+		/// Strings are prefixed with their size, so that e.g. ("ab", "c") and ("a", "bc") make different keys.
+		inline void append_string(std::string& a_key, std::string_view a_str)
+		{
+			const auto size = a_str.size();
+			append_bytes(a_key, &size, sizeof(size));
+			a_key.append(a_str);
+		}
 
-	[[nodiscard]] std::uint64_t operator()(const LogBuffer::Entry& entry) const noexcept
-	{
-		return detail::wyhash::hash(entry.message.c_str(), entry.message.size());
-	}
-};
+		/// Appends a log argument. Strings, numbers and enums are appended as they are, anything else (e.g. forms) is appended as formatted text.
+		template <class T>
+		void append_arg(std::string& a_key, const T& a_arg)
+		{
+			using U = std::remove_cvref_t<T>;
+			if constexpr (std::is_same_v<U, const char*> || std::is_same_v<U, char*>) {
+				if (a_arg) {
+					append_string(a_key, a_arg);
+				} else {
+					// Null gets a size that no string can have.
+					constexpr auto null = std::numeric_limits<std::size_t>::max();
+					append_bytes(a_key, &null, sizeof(null));
+				}
+			} else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+				append_string(a_key, a_arg);
+			} else if constexpr (std::is_enum_v<U> || std::is_arithmetic_v<U>) {
+				append_bytes(a_key, &a_arg, sizeof(U));
+			} else {
+				fmt::memory_buffer formatted;
+				fmt::format_to(std::back_inserter(formatted), "{}", a_arg);
+				append_string(a_key, std::string_view(formatted.data(), formatted.size()));
+			}
+		}
 
-/// LogBuffer proxies typical logging calls and buffers received entries to avoid duplication.
-///
-/// Main log proxy functions.
-/// Each log function checks whether given message was already logged and skips the log.
-namespace LogBuffer
-{
-	inline ankerl::unordered_dense::set<Entry> buffer{};
+		/// Builds a key that identifies a message: its source location followed by its arguments.
+		template <class... Args>
+		[[nodiscard]] const std::string& make_key(const std::source_location& a_loc, const Args&... a_args)
+		{
+			const auto line = a_loc.line();
+
+			key.clear();
+			append_string(key, a_loc.file_name());
+			append_bytes(key, &line, sizeof(line));
+			(append_arg(key, a_args), ...);
+			return key;
+		}
+
+		/// Remembers a message and returns whether it's new.
+		[[nodiscard]] inline bool remember(const std::string& a_key)
+		{
+			if (buffer.contains(a_key)) {
+				return false;
+			}
+			if (buffer.size() >= capacity) {
+				buffer.clear();
+			}
+			buffer.emplace(a_key);
+			return true;
+		}
+	}
 
 	/// Clears already buffered messages to allow them to be logged once again.
 	inline void clear()
 	{
-		buffer.clear();
+		detail::buffer.clear();
+	}
+
+	/// <summary>
+	/// Sets how many distinct messages are remembered.
+	/// Once there are more, all remembered messages are forgotten, so memory stays bounded at the cost of some messages being logged again.
+	/// </summary>
+	inline void SetCapacity(std::size_t a_capacity)
+	{
+		detail::capacity = std::max<std::size_t>(a_capacity, 1);
+		if (detail::buffer.size() > detail::capacity) {
+			detail::buffer.clear();
+		}
 	}
 
 	MAKE_BUFFERED_LOG(trace, trace);
@@ -0,0 +1,331 @@
+#include "LookupCache.h"
+#include "BinaryIO.h"
+#include "FormResolver.h"
+#include "MappedFile.h"
+#include "Settings.h"
+
+namespace Forms::LookupCache
+{
+	namespace detail
+	{
+		using Binary::Reader;
+		using Binary::Writer;
+
+		using Kind = Resolver::Kind;
+		using Status = Resolver::Status;
+		using Resolution = Resolver::Resolution;
+
+		/// formatVersion must be bumped whenever layout of the cache, of Resolution or of Resolver's keys changes.
+		inline constexpr Binary::FileHeader header{
+			.magic = 0x31504B4C44495053,  // "SPIDLKP1"
+			.formatVersion = 3,
+			.build = Version::NAME
+		};
+
+		struct Plugin
+		{
+			std::string   name{};
+			std::uint64_t size{ 0 };
+			std::int64_t  modifiedTime{ 0 };
+
+			bool operator==(const Plugin&) const = default;
+		};
+
+		/// Everything that affects how identifiers are resolved.
+		struct LoadOrder
+		{
+			std::vector<Plugin> plugins{};
+			bool                hasMergeMapper{ false };
+		};
+
+		/// Load order of the current session, captured during Restore.
+		LoadOrder currentLoadOrder{};
+		/// Whether the cache was restored, and how many resolutions it had.
+		bool        isUpToDate{ false };
+		std::size_t restoredCount{ 0 };
+
+		std::optional<std::filesystem::path> get_path()
+		{
+			auto path = SKSE::log::log_directory();
+			if (!path) {
+				return std::nullopt;
+			}
+
+			*path /= Version::PROJECT;
+			*path += ".lookup.cache"sv;
+			return path;
+		}
+
+		LoadOrder get_load_order(RE::TESDataHandler* const a_dataHandler)
+		{
+			LoadOrder result{};
+			result.hasMergeMapper = g_mergeMapperInterface != nullptr;
+
+			for (const auto file : a_dataHandler->files) {
+				// Plugins that are present in Data folder, but not active.
+				if (!file || file->compileIndex == 0xFF) {
+					continue;
+				}
+
+				Plugin plugin{ .name = std::string(file->GetFilename()) };
+
+				// Size and time catch plugins that were updated without changing the load order.
+				std::error_code ec;
+				const auto      path = std::filesystem::path("Data") / plugin.name;
+				plugin.size = std::filesystem::file_size(path, ec);
+				if (!ec) {
+					plugin.modifiedTime = static_cast<std::int64_t>(std::filesystem::last_write_time(path, ec).time_since_epoch().count());
+				}
+
+				result.plugins.push_back(std::move(plugin));
+			}
+
+			return result;
+		}
+
+		/// Explains the first difference between cached and current load orders, or returns an empty string if they are the same.
+		std::string describe_changes(const LoadOrder& a_cached, const LoadOrder& a_current)
+		{
+			if (a_cached.hasMergeMapper != a_current.hasMergeMapper) {
+				return a_current.hasMergeMapper ? "MergeMapper was installed" : "MergeMapper was removed";
+			}
+
+			const auto& cached = a_cached.plugins;
+			const auto& current = a_current.plugins;
+
+			for (std::size_t i = 0; i < std::min(cached.size(), current.size()); ++i) {
+				if (cached[i].name != current[i].name) {
+					return fmt::format("load order changed at #{}: {} -> {}", i, cached[i].name, current[i].name);
+				}
+				if (cached[i] != current[i]) {
+					return fmt::format("{} was modified", current[i].name);
+				}
+			}
+
+			if (current.size() > cached.size()) {
+				return fmt::format("{} was added", current[cached.size()].name);
+			}
+			if (cached.size() > current.size()) {
+				return fmt::format("{} was removed", cached[current.size()].name);
+			}
+
+			return {};
+		}
+
+		void save(Writer& a_out, const LoadOrder& a_loadOrder)
+		{
+			a_out.write(a_loadOrder.hasMergeMapper);
+			a_out.write(static_cast<std::uint32_t>(a_loadOrder.plugins.size()));
+			for (const auto& [name, size, modifiedTime] : a_loadOrder.plugins) {
+				a_out.write(name);
+				a_out.write(size);
+				a_out.write(modifiedTime);
+			}
+		}
+
+		void load(Reader& a_in, LoadOrder& a_loadOrder)
+		{
+			a_loadOrder.hasMergeMapper = a_in.read<bool>();
+			a_loadOrder.plugins.resize(a_in.read_count());
+			for (auto& [name, size, modifiedTime] : a_loadOrder.plugins) {
+				name = a_in.read_string();
+				size = a_in.read<std::uint64_t>();
+				modifiedTime = a_in.read<std::int64_t>();
+			}
+		}
+
+		void save(Writer& a_out, Kind a_kind, std::string_view a_key, const Resolution& a_resolution)
+		{
+			a_out.write(a_kind);
+			a_out.write(a_key);
+			a_out.write(a_resolution.status);
+			a_out.write(a_resolution.form ? a_resolution.form->GetFormID() : RE::FormID{ 0 });
+			a_out.write(a_resolution.form ? a_resolution.form->GetFormType() : RE::FormType::None);
+			a_out.write(a_resolution.mod ? a_resolution.mod->GetFilename() : ""sv);
+			a_out.write(a_resolution.formID.has_value());
+			if (a_resolution.formID) {
+				a_out.write(*a_resolution.formID);
+			}
+			a_out.write(a_resolution.modName.has_value());
+			if (a_resolution.modName) {
+				a_out.write(*a_resolution.modName);
+			}
+			a_out.write(a_resolution.mergeLog);
+		}
+
+		struct CachedResolution
+		{
+			Kind        kind{ Kind::kFormID };
+			std::string key{};
+			Resolution  resolution{};
+		};
+
+		/// Reads a single resolution and looks up its form and plugin. Returns an error if they no longer exist.
+		std::expected<CachedResolution, std::string> load(Reader& a_in, RE::TESDataHandler* const a_dataHandler)
+		{
+			CachedResolution result{};
+			auto& [kind, key, resolution] = result;
+
+			kind = a_in.read_enum(Kind::kTotal);
+			key = a_in.read_string();
+
+			// Only successful resolutions are saved.
+			resolution.status = a_in.read<Status>();
+			if (resolution.status != Status::kResolved) {
+				throw Binary::ReadError("invalid resolution status");
+			}
+
+			const auto formID = a_in.read<RE::FormID>();
+			const auto formType = a_in.read<RE::FormType>();
+			if (formID) {
+				resolution.form = RE::TESForm::LookupByID(formID);
+				if (!resolution.form || resolution.form->GetFormType() != formType) {
+					return std::unexpected(fmt::format("form {:08X} for {} no longer exists", formID, key));
+				}
+			}
+
+			if (const auto modName = a_in.read_string(); !modName.empty()) {
+				resolution.mod = a_dataHandler->LookupModByName(modName);
+				if (!resolution.mod) {
+					return std::unexpected(fmt::format("plugin {} no longer exists", modName));
+				}
+			}
+
+			if (a_in.read<bool>()) {
+				resolution.formID = a_in.read<RE::FormID>();
+			}
+			if (a_in.read<bool>()) {
+				resolution.modName = a_in.read_string();
+			}
+			resolution.mergeLog = a_in.read_string();
+
+			return result;
+		}
+
+		/// Returns number of restored resolutions, or a reason why the cache can't be used.
+		std::expected<std::size_t, std::string> restore(const std::filesystem::path& a_path, RE::TESDataHandler* const a_dataHandler)
+		{
+			const MappedFile file(a_path);
+			if (!file) {
+				return std::unexpected(fmt::format("cache {}", Binary::describe(Binary::FileError::kNotFound)));
+			}
+
+			const auto payload = Binary::open_payload(file.bytes(), header);
+			if (!payload) {
+				return std::unexpected(fmt::format("cache {}", Binary::describe(payload.error())));
+			}
+
+			std::vector<CachedResolution> resolutions{};
+
+			try {
+				Reader reader(*payload);
+
+				LoadOrder cachedLoadOrder{};
+				load(reader, cachedLoadOrder);
+
+				if (auto changes = describe_changes(cachedLoadOrder, currentLoadOrder); !changes.empty()) {
+					return std::unexpected(std::move(changes));
+				}
+
+				resolutions.resize(reader.read_count());
+				for (auto& resolution : resolutions) {
+					auto cached = load(reader, a_dataHandler);
+					if (!cached) {
+						return std::unexpected(std::move(cached.error()));
+					}
+					resolution = std::move(*cached);
+				}
+			} catch (const Binary::ReadError&) {
+				return std::unexpected(fmt::format("cache {}", Binary::describe(Binary::FileError::kCorrupted)));
+			}
+
+			// Resolutions are only restored once all of them were validated, so that a stale cache doesn't leave partial results.
+			const auto resolver = Resolver::GetSingleton();
+			for (auto& [kind, key, resolution] : resolutions) {
+				resolver->Restore(kind, std::move(key), std::move(resolution));
+			}
+
+			return resolutions.size();
+		}
+	}
+
+	void Restore(RE::TESDataHandler* const a_dataHandler)
+	{
+		using namespace detail;
+
+		isUpToDate = false;
+		restoredCount = 0;
+
+		if (!Settings::GetSingleton()->lookupCache) {
+			return;
+		}
+
+		const auto path = get_path();
+		if (!path) {
+			return;
+		}
+
+		Timer timer;
+
+		timer.start();
+		currentLoadOrder = get_load_order(a_dataHandler);
+		const auto restored = restore(*path, a_dataHandler);
+		timer.end();
+
+		if (restored) {
+			isUpToDate = true;
+			restoredCount = *restored;
+			logger::info("Lookup cache hit: restored {} forms in {}μs / {}ms", *restored, timer.duration_μs(), timer.duration_ms());
+		} else {
+			logger::info("Lookup cache miss: {}", restored.error());
+		}
+	}
+
+	void Save()
+	{
+		using namespace detail;
+
+		if (!Settings::GetSingleton()->lookupCache) {
+			return;
+		}
+
+		const auto resolver = Resolver::GetSingleton();
+
+		// Nothing new was resolved, so the cache already has everything.
+		if (isUpToDate && resolver->GetResolvedCount() == 0) {
+			return;
+		}
+
+		const auto path = get_path();
+		if (!path) {
+			return;
+		}
+
+		Writer entries{};
+		std::uint32_t count = 0;
+
+		resolver->ForEachResolution([&](Kind a_kind, std::string_view a_key, const Resolution& a_resolution) {
+			if (a_resolution.status != Status::kResolved || (a_resolution.form && a_resolution.form->IsDynamicForm())) {
+				return;
+			}
+			save(entries, a_kind, a_key, a_resolution);
+			++count;
+		});
+
+		// Only failures were resolved anew, and those aren't saved.
+		if (isUpToDate && count == restoredCount) {
+			return;
+		}
+
+		Writer payload{};
+		save(payload, currentLoadOrder);
+		payload.write(count);
+		payload.write_bytes(entries.bytes());
+
+		if (const auto saved = Binary::save_file(*path, header, payload); saved) {
+			logger::info("Lookup cache updated with {} forms", count);
+		} else {
+			logger::warn("Failed to update lookup cache: cache {}", Binary::describe(saved.error()));
+		}
+	}
+}
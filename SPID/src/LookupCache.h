@@ -0,0 +1,32 @@
+#pragma once
+
+namespace Forms
+{
+	/// <summary>
+	/// Resolver's resolutions persisted between launches with the same load order.
+	///
+	/// The cache stores every successful identifier -> form resolution, along with the load order it was made with:
+	/// name, size and modification time of each loaded plugin. When the load order is exactly the same on the next launch,
+	/// resolutions are restored with a single TESForm::LookupByID per form, skipping editorID searches and MergeMapper remapping.
+	/// Identifiers that weren't cached yet are resolved as usual and are added to the cache afterwards.
+	///
+	/// Failed resolutions are never cached, since whether an editorID can be found also depends on other SKSE plugins (e.g. po3_Tweaks),
+	/// which the load order doesn't cover. Neither are dynamic forms, since their IDs differ between launches.
+	/// Everything that lookup does with resolved forms (type checks, keyword creation, filters) runs on restored resolutions the same way.
+	///
+	/// The cache is disabled unless enabled in settings (see Settings::lookupCache).
+	/// </summary>
+	namespace LookupCache
+	{
+		/// <summary>
+		/// Restores cached resolutions into Resolver if the load order didn't change. Logs the outcome.
+		/// </summary>
+		void Restore(RE::TESDataHandler* const a_dataHandler);
+
+		/// <summary>
+		/// Writes Resolver's resolutions to the cache, unless they were all restored from it.
+		/// Must be called after lookup and before Resolver is cleared.
+		/// </summary>
+		void Save();
+	}
+}
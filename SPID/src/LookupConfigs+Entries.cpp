@@ -0,0 +1,57 @@
+#include "LookupConfigs.h"
+#include "Parser.h"
+
+// Parsing of individual entries, which doesn't depend on how config files are read.
+namespace Distribution::INI
+{
+	void TryParse(const std::string& key, const std::string& value, const Path& path, Configs& a_configs)
+	{
+		try {
+			if (auto optData = Parse<Data,
+					DefaultKeyComponentParser,
+					DistributableFormComponentParser,
+					StringFiltersComponentParser<>,
+					FormFiltersComponentParser<>,
+					LevelFiltersComponentParser,
+					TraitsFilterComponentParser,
+					IndexOrCountComponentParser,
+					ChanceComponentParser>(key, value);
+				optData) {
+				auto& data = *optData;
+
+				data.path = path;
+
+				if (data.chance.deterministic) {
+					data.chance.lineSeed = std::hash<std::string>{}(value);
+				}
+
+				if (data.recordTraits & RECORD::TRAITS::Final && data.type != RECORD::TYPE::kOutfit) {
+					data.recordTraits &= ~RECORD::TRAITS::Final;
+					logger::warn("\t\t[{} = {}]", key, value);
+					logger::warn("\t\t\tFinal modifier can only be applied to Outfits.");
+				}
+
+				a_configs[data.type].emplace_back(data);
+			}
+		} catch (const std::exception& e) {
+			logger::warn("\t\tFailed to parse entry [{} = {}]: {}", key, value, e.what());
+		}
+	}
+
+	void CollectRawForms(const RawFormFilters& a_filters, RawFormRefs& a_refs)
+	{
+		for (const auto* filters : { &a_filters.ALL, &a_filters.NOT, &a_filters.MATCH }) {
+			for (const auto& rawForm : *filters) {
+				a_refs.push_back(&rawForm);
+			}
+		}
+	}
+
+	void CollectRawForms(const DataVec& a_entries, RawFormRefs& a_refs)
+	{
+		for (const auto& entry : a_entries) {
+			a_refs.push_back(&entry.rawForm);
+			CollectRawForms(entry.formFilters, a_refs);
+		}
+	}
+}
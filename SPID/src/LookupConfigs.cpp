@@ -1,8 +1,14 @@
 #include "LookupConfigs.h"
+#include "ConfigCache.h"
 #include "DeathDistribution.h"
+#include "EntrySanitizer.h"
 #include "ExclusiveGroups.h"
+#include "IniReader.h"
 #include "LinkedDistribution.h"
-#include "Parser.h"
+#include "MappedFile.h"
+#include "Settings.h"
+#include "Trace.h"
+#include "WriteBack.h"
 
 namespace Distribution
 {
@@ -10,156 +16,299 @@ namespace Distribution
 	{
 		namespace detail
 		{
-			std::string sanitize(const std::string& a_value)
+			void sanitize(std::string_view a_value, std::string& a_out)
 			{
-				auto newValue = a_value;
-
-				//formID hypen
-				if (!newValue.contains('~')) {
-					string::replace_first_instance(newValue, " - ", "~");
-				}
-
 #ifdef SKYRIMVR
-				// swap dawnguard and dragonborn forms
 				// we do this during sanitize instead of in get_formID to squelch log errors
-				// VR apparently does not load masters in order so the lookup fails
-				static const srell::regex re_dawnguard(R"((0x0*2)([0-9a-f]{6}))", srell::regex_constants::optimize | srell::regex::icase);
-				newValue = regex_replace(newValue, re_dawnguard, "0x$2~Dawnguard.esm");
-
-				static const srell::regex re_dragonborn(R"((0x0*4)([0-9a-f]{6}))", srell::regex_constants::optimize | srell::regex::icase);
-				newValue = regex_replace(newValue, re_dragonborn, "0x$2~Dragonborn.esm");
+				constexpr bool swapVRMasters = true;
+#else
+				constexpr bool swapVRMasters = false;
 #endif
+				Sanitizer::sanitize(a_value, a_out, swapVRMasters);
+			}
 
-				//strip spaces between " | "
-				static const srell::regex re_bar(R"(\s*\|\s*)", srell::regex_constants::optimize);
-				newValue = srell::regex_replace(newValue, re_bar, "|");
+			using clock = std::chrono::steady_clock;
 
-				//strip spaces between " , "
-				static const srell::regex re_comma(R"(\s*,\s*)", srell::regex_constants::optimize);
-				newValue = srell::regex_replace(newValue, re_comma, ",");
+			/// Log of the config file that is being parsed on the current thread.
+			thread_local DeferredLog* deferredLog{ nullptr };
 
-				//convert 00012345 formIDs to 0x12345
-				static const srell::regex re_formID(R"(\b00+([0-9a-fA-F]{1,6})\b)", srell::regex_constants::optimize);
-				newValue = srell::regex_replace(newValue, re_formID, "0x$1");
+			/// Redirects messages logged on the current thread into given DeferredLog for the lifetime of the scope.
+			struct DeferredLogScope
+			{
+				explicit DeferredLogScope(DeferredLog& a_log) :
+					previous(std::exchange(deferredLog, &a_log))
+				{}
 
-				//strip leading zeros
-				static const srell::regex re_zeros(R"((0x00+)([0-9a-fA-F]+))", srell::regex_constants::optimize);
-				newValue = srell::regex_replace(newValue, re_zeros, "0x$2");
+				~DeferredLogScope()
+				{
+					deferredLog = previous;
+				}
 
-				//NOT to hyphen
-				//string::replace_all(newValue, "NOT ", "-");
+				DeferredLog* previous;
+			};
 
-				return newValue;
-			}
-		}
+			/// Sink that diverts messages of threads with an active DeferredLogScope and passes the rest to the original sinks.
+			/// Since files are parsed in parallel, this keeps messages of each file together in the log.
+			class DeferringSink final : public spdlog::sinks::base_sink<spdlog::details::null_mutex>
+			{
+			public:
+				explicit DeferringSink(std::vector<spdlog::sink_ptr> a_sinks) :
+					sinks(std::move(a_sinks))
+				{}
+
+			protected:
+				void sink_it_(const spdlog::details::log_msg& a_msg) override
+				{
+					if (deferredLog) {
+						deferredLog->emplace_back(a_msg.level, std::string(a_msg.payload.data(), a_msg.payload.size()));
+						return;
+					}
 
-		void TryParse(const std::string& key, const std::string& value, const Path& path)
-		{
-			try {
-				if (auto optData = Parse<Data,
-						DefaultKeyComponentParser,
-						DistributableFormComponentParser,
-						StringFiltersComponentParser<>,
-						FormFiltersComponentParser<>,
-						LevelFiltersComponentParser,
-						TraitsFilterComponentParser,
-						IndexOrCountComponentParser,
-						ChanceComponentParser>(key, value);
-					optData) {
-					auto& data = *optData;
-
-					data.path = path;
-
-					if (data.chance.deterministic) {
-						data.chance.lineSeed = std::hash<std::string>{}(value);
+					for (const auto& sink : sinks) {
+						if (sink->should_log(a_msg.level)) {
+							sink->log(a_msg);
+						}
 					}
+				}
 
-					if (data.recordTraits & RECORD::TRAITS::Final && data.type != RECORD::TYPE::kOutfit) {
-						data.recordTraits &= ~RECORD::TRAITS::Final;
-						logger::warn("\t\t[{} = {}]", key, value);
-						logger::warn("\t\t\tFinal modifier can only be applied to Outfits.");
+				void flush_() override
+				{
+					for (const auto& sink : sinks) {
+						sink->flush();
 					}
+				}
+
+			private:
+				std::vector<spdlog::sink_ptr> sinks;
+			};
+
+			void install_deferring_sink()
+			{
+				auto& sinks = spdlog::default_logger()->sinks();
+				sinks = { std::make_shared<DeferringSink>(sinks) };
+			}
 
-					configs[data.type].emplace_back(data);
+			void replay(const DeferredLog& a_log)
+			{
+				for (const auto& [level, message] : a_log) {
+					spdlog::log(level, "{}", message);
 				}
-			} catch (const std::exception& e) {
-				logger::warn("\t\tFailed to parse entry [{} = {}]: {}", key, value, e.what());
 			}
-		}
 
-		std::pair<bool, bool> GetConfigs()
-		{
-			LOG_HEADER("INI");
+			struct ParsedConfigs
+			{
+				std::vector<ConfigFile> files{};
 
-			std::vector<std::string> files = distribution::get_configs(R"(Data\)", "_DISTR"sv);
+				std::optional<Cache::LoadResult> cache{};
+				std::string                      cacheSaveError{};
 
-			if (files.empty()) {
-				logger::warn("No .ini files with _DISTR suffix were found within the Data folder, aborting...");
-				return { false, false };
-			}
+				clock::time_point start{};
+				clock::time_point end{};
+			};
 
-			logger::info("{} matching inis found", files.size());
+			std::future<ParsedConfigs> pendingConfigs{};
+		}
 
-			bool shouldLogErrors{ false };
+		namespace detail
+		{
+			/// <summary>
+			/// Parses a_file and, if a_writeBack is set and sanitizing is enabled in settings, queues its entries that use old format to be rewritten.
+			/// </summary>
+			void parse(ConfigFile& a_file, bool a_writeBack)
+			{
+				TRACE_ZONE("ParseConfig");
+				DeferredLogScope deferred(a_file.log);
 
-			for (const auto& path : files) {
-				logger::info("\tINI : {}", path);
+				const auto& path = a_file.path;
 
-				CSimpleIniA ini;
-				ini.SetUnicode();
-				ini.SetMultiKey();
+				logger::info("\tINI : {}", path);
 
-				if (const auto rc = ini.LoadFile(path.c_str()); rc < 0) {
+				const MappedFile file(path);
+				if (!file) {
 					logger::error("\t\tcouldn't read INI");
-					continue;
+					return;
 				}
 
-				if (auto values = ini.GetSection(""); values && !values->empty()) {
-					std::multimap<CSimpleIniA::Entry, std::pair<std::string, std::string>, CSimpleIniA::Entry::LoadOrder> oldFormatMap;
+				const auto text = file.text();
 
-					auto truncatedPath = path.substr(5);  //strip "Data\\"
+				std::vector<Ini::Entry> entries{};
+				Ini::Scanner            scanner(text);
+				for (Ini::Entry entry; scanner.Next(entry);) {
+					entries.push_back(entry);
+				}
 
-					for (auto& [key, entry] : *values) {
-						try {
-							auto sanitized_str = detail::sanitize(entry);
+				// Entries are parsed in the order in which CSimpleIniA used to iterate them, so that distribution order stays the same.
+				std::ranges::stable_sort(entries, Ini::KeyLess, &Ini::Entry::key);
 
-							if (ExclusiveGroups::INI::TryParse(key.pItem, sanitized_str, truncatedPath)) {
-								continue;
-							}
+				auto truncatedPath = path.substr(5);  //strip "Data\\"
 
-							if (LinkedDistribution::INI::TryParse(key.pItem, sanitized_str, truncatedPath)) {
-								continue;
-							}
+				std::vector<WriteBack::Rewrite> rewrites{};
 
-							if (DeathDistribution::INI::TryParse(key.pItem, sanitized_str, truncatedPath)) {
-								continue;
-							}
+				std::string key{};            // reused between entries
+				std::string sanitized_str{};  // reused between entries
 
-							TryParse(key.pItem, sanitized_str, truncatedPath);
+				for (const auto& [keyView, entry] : entries) {
+					key.assign(keyView);
+					try {
+						sanitize(entry, sanitized_str);
 
-							if (sanitized_str != entry) {
-								oldFormatMap.emplace(key, std::make_pair(entry, sanitized_str));
-							}
-						} catch (...) {
-							logger::warn("\t\tFailed to parse entry [{} = {}]"sv, key.pItem, entry);
-							shouldLogErrors = true;
+						if (ExclusiveGroups::INI::TryParse(key, sanitized_str, truncatedPath, a_file.exclusiveGroups)) {
+							continue;
 						}
-					}
 
-					if (!oldFormatMap.empty()) {
-						logger::debug("\t\tsanitizing {} entries", oldFormatMap.size());
+						if (LinkedDistribution::INI::TryParse(key, sanitized_str, truncatedPath, a_file.linkedConfigs)) {
+							continue;
+						}
 
-						for (auto& [key, entry] : oldFormatMap) {
-							auto& [original, sanitized] = entry;
-							ini.DeleteValue("", key.pItem, original.c_str());
-							ini.SetValue("", key.pItem, sanitized.c_str(), key.pComment, false);
+						if (DeathDistribution::INI::TryParse(key, sanitized_str, truncatedPath, a_file.deathConfigs)) {
+							continue;
 						}
 
-						(void)ini.SaveFile(path.c_str());
+						TryParse(key, sanitized_str, truncatedPath, a_file.configs);
+
+						if (sanitized_str != entry) {
+							rewrites.push_back({ static_cast<std::size_t>(keyView.data() - text.data()), key, std::string(entry), sanitized_str });
+						}
+					} catch (...) {
+						logger::warn("\t\tFailed to parse entry [{} = {}]"sv, key, entry);
+						a_file.shouldLogErrors = true;
+					}
+				}
+
+				if (!rewrites.empty()) {
+					const auto sanitizeConfigs = Settings::GetSingleton()->sanitizeConfigs;
+					if (sanitizeConfigs && a_writeBack) {
+						logger::debug("\t\tsanitizing {} entries", rewrites.size());
+						WriteBack::Enqueue(path, std::move(rewrites));
+						// The file is about to change, so it is cached on the next launch, once it's parsed in its sanitized form.
+						return;
+					}
+
+					logger::info("\t\t{} entries use old format ({}):", rewrites.size(), sanitizeConfigs ? "configs are only sanitized on launch" : "sanitizing is disabled in settings");
+					for (const auto& rewrite : rewrites) {
+						logger::info("\t\t\t[{} = {}] -> [{} = {}]", rewrite.key, rewrite.original, rewrite.key, rewrite.sanitized);
 					}
 				}
+
+				a_file.key = Cache::GetFileKey(path, file.bytes());
 			}
 
+			ParsedConfigs parse_all()
+			{
+				TRACE_ZONE("ParseConfigs");
+
+				ParsedConfigs result{};
+				result.start = clock::now();
+
+				for (auto& path : distribution::get_configs(R"(Data\)", "_DISTR"sv)) {
+					result.files.push_back({ .path = std::move(path) });
+				}
+
+				const auto cachePath = Cache::GetDefaultPath();
+				if (cachePath) {
+					result.cache = Cache::Load(*cachePath, result.files);
+				}
+
+				std::for_each(std::execution::par, result.files.begin(), result.files.end(), [](ConfigFile& a_file) {
+					if (!a_file.cached) {
+						parse(a_file, true);
+					}
+				});
+
+				// Sanitized entries are written back in the background, so that slow file systems don't hold up configs.
+				WriteBack::Flush();
+
+				if (cachePath && result.cache->IsStale(result.files.size())) {
+					if (const auto saved = Cache::Save(*cachePath, result.files); !saved) {
+						result.cacheSaveError = saved.error();
+					}
+				}
+
+				result.end = clock::now();
+				return result;
+			}
+
+			template <class ConfigsMap>
+			void merge(ConfigsMap& a_from, ConfigsMap& a_into)
+			{
+				for (auto& [type, entries] : a_from) {
+					auto& merged = a_into[type];
+					merged.insert(merged.end(), std::make_move_iterator(entries.begin()), std::make_move_iterator(entries.end()));
+				}
+			}
+		}
+
+		ConfigFile ParseConfig(std::string a_path)
+		{
+			ConfigFile file{ .path = std::move(a_path) };
+			// Rewriting the file would change it once again and make hot reload read it one more time.
+			detail::parse(file, false);
+			detail::replay(file.log);
+
+			return file;
+		}
+
+		void StartParsingConfigs()
+		{
+			if (detail::pendingConfigs.valid()) {
+				return;
+			}
+
+			detail::install_deferring_sink();
+			detail::pendingConfigs = std::async(std::launch::async, detail::parse_all);
+		}
+
+		std::pair<bool, bool> GetConfigs()
+		{
+			StartParsingConfigs();
+
+			const auto waitStart = detail::clock::now();
+			auto       parsed = detail::pendingConfigs.get();
+			const auto waitEnd = detail::clock::now();
+
+			LOG_HEADER("INI");
+
+			if (parsed.files.empty()) {
+				logger::warn("No .ini files with _DISTR suffix were found within the Data folder, aborting...");
+				return { false, false };
+			}
+
+			logger::info("{} matching inis found", parsed.files.size());
+
+			if (const auto& cache = parsed.cache) {
+				if (!cache->error.empty()) {
+					logger::info("Config cache {}, all inis were parsed", cache->error);
+				} else {
+					logger::info("{} inis loaded from config cache, {} changed since last launch", cache->loaded, cache->changed);
+				}
+				if (!parsed.cacheSaveError.empty()) {
+					logger::warn("Failed to update config cache: {}", parsed.cacheSaveError);
+				}
+			}
+
+			bool shouldLogErrors{ false };
+
+			// Files are merged in the order in which they were found, so that entries end up exactly where sequential parsing would've put them.
+			for (auto& file : parsed.files) {
+				detail::replay(file.log);
+
+				detail::merge(file.configs, configs);
+				detail::merge(file.deathConfigs, DeathDistribution::INI::deathConfigs);
+				detail::merge(file.linkedConfigs, LinkedDistribution::INI::linkedConfigs);
+				ExclusiveGroups::INI::exclusiveGroups.insert(ExclusiveGroups::INI::exclusiveGroups.end(), std::make_move_iterator(file.exclusiveGroups.begin()), std::make_move_iterator(file.exclusiveGroups.end()));
+
+				shouldLogErrors |= file.shouldLogErrors;
+			}
+
+			using namespace std::chrono;
+
+			const auto parseTime = duration_cast<microseconds>(parsed.end - parsed.start);
+			const auto waitTime = duration_cast<microseconds>(waitEnd - waitStart);
+			// Parsing may have finished long before configs were requested, in which case it was entirely overlapped.
+			const auto overlapTime = std::max(parseTime - waitTime, microseconds::zero());
+
+			logger::info("Parsing took {}μs / {}ms, {}μs / {}ms of which overlapped with game startup", parseTime.count(), duration_cast<milliseconds>(parseTime).count(), overlapTime.count(), duration_cast<milliseconds>(overlapTime).count());
+
 			return { true, shouldLogErrors };
 		}
 	}
@@ -106,11 +106,51 @@ namespace Distribution
 		};
 
 		using DataVec = std::vector<Data>;
+		using Configs = Map<RECORD::TYPE, DataVec>;
 
-		inline Map<RECORD::TYPE, DataVec> configs{};
+		inline Configs configs{};
 
+		/// <summary>
+		/// Starts reading and parsing all _DISTR configs on a background thread.
+		///
+		/// Parsing doesn't depend on any game data, so it is started from SKSEPlugin_Load to overlap with engine startup.
+		/// Files are parsed in parallel, but their entries and log messages are merged in the same order in which files were found.
+		/// </summary>
+		void StartParsingConfigs();
+
+		/// <summary>
+		/// Waits for parsing started by StartParsingConfigs (or parses configs in place if it wasn't started),
+		/// merges parsed entries into configs of each distribution type and logs the results.
+		/// </summary>
+		/// <returns>Whether any configs were found and whether parsing errors should be logged.</returns>
 		std::pair<bool, bool> GetConfigs();
-		void                  TryParse(const std::string& key, const std::string& value, const Path& path);
+
+		struct ConfigFile;
+
+		/// <summary>
+		/// Parses a single config file and logs messages produced while parsing it.
+		/// Used to re-read configs that changed while the game is running (see HotReload).
+		/// Entries that use old format are only reported, they're written back on the next launch.
+		/// </summary>
+		ConfigFile ParseConfig(std::string a_path);
+
+		/// <summary>
+		/// Identifies contents of an entry, so that hot reload can tell which entries of a changed config are still the same.
+		/// Returns 0 when hot reload is disabled, since nothing needs it then.
+		/// </summary>
+		std::uint64_t GetSourceID(const Data& a_data);
+
+		void TryParse(const std::string& key, const std::string& value, const Path& path, Configs& a_configs = configs);
+
+		/// <summary>
+		/// Appends identifiers of all forms referenced by given filters.
+		/// </summary>
+		void CollectRawForms(const RawFormFilters& a_filters, RawFormRefs& a_refs);
+
+		/// <summary>
+		/// Appends identifiers of distributed forms and their form filters.
+		/// </summary>
+		void CollectRawForms(const DataVec& a_entries, RawFormRefs& a_refs);
 	}
 }
 
@@ -118,47 +158,47 @@ namespace Distribution::INI
 {
 	namespace Exception
 	{
-		struct UnsupportedFormTypeException : std::exception
+		struct UnsupportedFormTypeException : std::runtime_error
 		{
 			const std::string key;
 
-			UnsupportedFormTypeException(const std::string& key) :
-				std::exception(fmt::format("Unsupported form type {}"sv, key).c_str()),
+			UnsupportedFormTypeException(std::string_view key) :
+				std::runtime_error(fmt::format("Unsupported form type {}"sv, key)),
 				key(key)
 			{}
 		};
 
-		struct InvalidIndexOrCountException : std::exception
+		struct InvalidIndexOrCountException : std::runtime_error
 		{
 			const std::string entry;
 
-			InvalidIndexOrCountException(const std::string& entry) :
-				std::exception(fmt::format("Invalid index or count {}"sv, entry).c_str()),
+			InvalidIndexOrCountException(std::string_view entry) :
+				std::runtime_error(fmt::format("Invalid index or count {}"sv, entry)),
 				entry(entry)
 			{}
 		};
 
-		struct InvalidChanceException : std::exception
+		struct InvalidChanceException : std::runtime_error
 		{
 			const std::string entry;
 
-			InvalidChanceException(const std::string& entry) :
-				std::exception(fmt::format("Invalid chance {}"sv, entry).c_str()),
+			InvalidChanceException(std::string_view entry) :
+				std::runtime_error(fmt::format("Invalid chance {}"sv, entry)),
 				entry(entry)
 			{}
 		};
 
-		struct MissingDistributableFormException : std::exception
+		struct MissingDistributableFormException : std::runtime_error
 		{
 			MissingDistributableFormException() :
-				std::exception("Missing distributable form")
+				std::runtime_error("Missing distributable form")
 			{}
 		};
 
-		struct MissingComponentParserException : std::exception
+		struct MissingComponentParserException : std::runtime_error
 		{
 			MissingComponentParserException() :
-				std::exception("Missing component parser")
+				std::runtime_error("Missing component parser")
 			{}
 		};
 	}
@@ -283,51 +323,51 @@ namespace Distribution::INI
 	struct DefaultKeyComponentParser
 	{
 		template <typed_data Data>
-		bool operator()(const std::string& key, Data& data) const;
+		bool operator()(std::string_view key, Data& data) const;
 	};
 
 	struct DistributableFormComponentParser
 	{
 		template <form_data Data>
-		void operator()(const std::string& entry, Data& data) const;
+		void operator()(std::string_view entry, Data& data) const;
 	};
 
 	template <ComponentParserFlags flags = kAllowAllModifiers>
 	struct StringFiltersComponentParser
 	{
 		template <string_filterable_data Data>
-		void operator()(const std::string& entry, Data& data) const;
+		void operator()(std::string_view entry, Data& data) const;
 	};
 
 	template <ComponentParserFlags flags = kAllowFormsModifiers>
 	struct FormFiltersComponentParser
 	{
 		template <form_filterable_data Data>
-		void operator()(const std::string& entry, Data& data) const;
+		void operator()(std::string_view entry, Data& data) const;
 	};
 
 	struct LevelFiltersComponentParser
 	{
 		template <level_filterable_data Data>
-		void operator()(const std::string& entry, Data& data) const;
+		void operator()(std::string_view entry, Data& data) const;
 	};
 
 	struct TraitsFilterComponentParser
 	{
 		template <trait_filterable_data Data>
-		void operator()(const std::string& entry, Data& data) const;
+		void operator()(std::string_view entry, Data& data) const;
 	};
 
 	struct IndexOrCountComponentParser
 	{
 		template <countable_data Data>
-		void operator()(const std::string& entry, Data& data) const;
+		void operator()(std::string_view entry, Data& data) const;
 	};
 
 	struct ChanceComponentParser
 	{
 		template <randomized_data Data>
-		void operator()(const std::string& entry, Data& data) const;
+		void operator()(std::string_view entry, Data& data) const;
 	};
 }
 
@@ -335,14 +375,35 @@ namespace Distribution::INI
 {
 	using namespace Exception;
 
-	template <typed_data Data>
-	bool DefaultKeyComponentParser::operator()(const std::string& originalKey, Data& data) const
+	namespace detail
 	{
-		std::string key = originalKey;
+		/// Lazily splits a_str into views of its sections. Same as string::split, but without copying each section.
+		inline auto split(std::string_view a_str, std::string_view a_delimiter)
+		{
+			return a_str | std::views::split(a_delimiter) | std::views::transform([](auto&& a_section) {
+				return std::string_view(a_section.begin(), a_section.end());
+			});
+		}
+
+		/// distribution::is_valid_entry for views. Sections are short, so the temporary string rarely allocates.
+		inline bool is_valid_entry(std::string_view a_entry)
+		{
+			return distribution::is_valid_entry(std::string(a_entry));
+		}
+
+		template <class T>
+		T to_num(std::string_view a_str)
+		{
+			return string::to_num<T>(std::string(a_str));
+		}
+	}
 
+	template <typed_data Data>
+	bool DefaultKeyComponentParser::operator()(std::string_view key, Data& data) const
+	{
 		if (key.starts_with("Final"sv)) {
 			data.recordTraits = RECORD::TRAITS::Final;
-			key.erase(0, 5);
+			key.remove_prefix(5);
 		}
 
 		auto type = RECORD::GetType(key);
@@ -355,38 +416,44 @@ namespace Distribution::INI
 	}
 
 	template <form_data Data>
-	void DistributableFormComponentParser::operator()(const std::string& entry, Data& data) const
+	void DistributableFormComponentParser::operator()(std::string_view entry, Data& data) const
 	{
 		if (entry.empty()) {
 			throw MissingDistributableFormException();
 		}
 
-		data.rawForm = distribution::get_record(entry);
+		data.rawForm = distribution::get_record(std::string(entry));
 	}
 
 	template <ComponentParserFlags flags>
 	template <string_filterable_data Data>
-	void StringFiltersComponentParser<flags>::operator()(const std::string& entry, Data& data) const
+	void StringFiltersComponentParser<flags>::operator()(std::string_view entry, Data& data) const
 	{
-		auto split_str = distribution::split_entry(entry);
-		for (auto& str : split_str) {
+		if (!detail::is_valid_entry(entry)) {
+			return;
+		}
+
+		for (auto str : detail::split(entry, ","sv)) {
 			if constexpr (flags & kAllowCombineModifier) {
-				if (str.contains("+"sv)) {
-					auto strings = distribution::split_entry(str, "+");
-					data.stringFilters.ALL.insert(data.stringFilters.ALL.end(), strings.begin(), strings.end());
+				if (str.contains('+')) {
+					if (detail::is_valid_entry(str)) {
+						for (const auto combined : detail::split(str, "+"sv)) {
+							data.stringFilters.ALL.emplace_back(combined);
+						}
+					}
 					continue;
 				}
 			}
 			if constexpr (flags & kAllowExclusionModifier) {
 				if (str.at(0) == '-') {
-					str.erase(0, 1);
+					str.remove_prefix(1);
 					data.stringFilters.NOT.emplace_back(str);
 					continue;
 				}
 			}
 			if constexpr (flags & kAllowPartialMatchModifier) {
 				if (str.at(0) == '*') {
-					str.erase(0, 1);
+					str.remove_prefix(1);
 					data.stringFilters.ANY.emplace_back(str);
 					continue;
 				}
@@ -398,23 +465,22 @@ namespace Distribution::INI
 
 	template <ComponentParserFlags flags>
 	template <form_filterable_data Data>
-	void FormFiltersComponentParser<flags>::operator()(const std::string& entry, Data& data) const
+	void FormFiltersComponentParser<flags>::operator()(std::string_view entry, Data& data) const
 	{
-		auto split_IDs = distribution::split_entry(entry);
-
-		if (split_IDs.empty()) {
+		if (!detail::is_valid_entry(entry)) {
 			if constexpr (flags & ComponentParserFlags::kRequired) {
 				throw MissingComponentParserException();
 			}
 			return;
 		}
 
-		for (auto& IDs : split_IDs) {
+		for (auto IDs : detail::split(entry, ","sv)) {
 			if constexpr (flags & kAllowCombineModifier) {
-				if (IDs.contains("+"sv)) {
-					auto splitIDs_ALL = distribution::split_entry(IDs, "+");
-					for (auto& IDs_ALL : splitIDs_ALL) {
-						data.formFilters.ALL.push_back(distribution::get_record(IDs_ALL));
+				if (IDs.contains('+')) {
+					if (detail::is_valid_entry(IDs)) {
+						for (const auto IDs_ALL : detail::split(IDs, "+"sv)) {
+							data.formFilters.ALL.push_back(distribution::get_record(std::string(IDs_ALL)));
+						}
 					}
 					continue;
 				}
@@ -422,28 +488,28 @@ namespace Distribution::INI
 
 			if constexpr (flags & kAllowExclusionModifier) {
 				if (IDs.at(0) == '-') {
-					IDs.erase(0, 1);
-					data.formFilters.NOT.push_back(distribution::get_record(IDs));
+					IDs.remove_prefix(1);
+					data.formFilters.NOT.push_back(distribution::get_record(std::string(IDs)));
 					continue;
 				}
 			}
 
-			data.formFilters.MATCH.push_back(distribution::get_record(IDs));
+			data.formFilters.MATCH.push_back(distribution::get_record(std::string(IDs)));
 		}
 	}
 
 	template <level_filterable_data Data>
-	void LevelFiltersComponentParser::operator()(const std::string& entry, Data& data) const
+	void LevelFiltersComponentParser::operator()(std::string_view entry, Data& data) const
 	{
 		Range<std::uint16_t>    actorLevel;
 		std::vector<SkillLevel> skillLevels;
 		std::vector<SkillLevel> skillWeights;
-		auto                    split_levels = distribution::split_entry(entry, ",");
-		for (auto& levels : split_levels) {
+		for (const auto levels : detail::split(detail::is_valid_entry(entry) ? entry : std::string_view{}, ","sv)) {
 			if (levels.contains('(')) {
 				//skill(min/max)
 				const auto isWeightFilter = levels.starts_with('w');
-				auto       sanitizedLevel = string::remove_non_alphanumeric(levels);
+				std::string skill{ levels };
+				auto        sanitizedLevel = string::remove_non_alphanumeric(skill);
 				if (isWeightFilter) {
 					sanitizedLevel.erase(0, 1);
 				}
@@ -469,13 +535,15 @@ namespace Distribution::INI
 					}
 				}
 			} else {
-				if (auto actor_level = string::split(levels, "/"); actor_level.size() > 1) {
-					auto minLevel = string::to_num<std::uint16_t>(actor_level[0]);
-					auto maxLevel = string::to_num<std::uint16_t>(actor_level[1]);
+				if (const auto separator = levels.find('/'); separator != std::string_view::npos) {
+					const auto max = levels.substr(separator + 1);
+
+					auto minLevel = detail::to_num<std::uint16_t>(levels.substr(0, separator));
+					auto maxLevel = detail::to_num<std::uint16_t>(max.substr(0, max.find('/')));
 
 					actorLevel = Range(minLevel, maxLevel);
 				} else {
-					auto level = string::to_num<std::uint16_t>(levels);
+					auto level = detail::to_num<std::uint16_t>(levels);
 
 					actorLevel = Range(level);
 				}
@@ -485,54 +553,46 @@ namespace Distribution::INI
 	}
 
 	template <trait_filterable_data Data>
-	void TraitsFilterComponentParser::operator()(const std::string& entry, Data& data) const
-	{
-		auto split_traits = distribution::split_entry(entry, "/");
-		for (auto& trait : split_traits) {
-			switch (string::const_hash(trait)) {
-			case "M"_h:
-			case "-F"_h:
-				data.traits.sex = RE::SEX::kMale;
-				break;
-			case "F"_h:
-			case "-M"_h:
-				data.traits.sex = RE::SEX::kFemale;
-				break;
-			case "U"_h:
-				data.traits.unique = true;
-				break;
-			case "-U"_h:
-				data.traits.unique = false;
-				break;
-			case "S"_h:
-				data.traits.summonable = true;
-				break;
-			case "-S"_h:
-				data.traits.summonable = false;
-				break;
-			case "C"_h:
-				data.traits.child = true;
+	void TraitsFilterComponentParser::operator()(std::string_view entry, Data& data) const
+	{
+		if (!detail::is_valid_entry(entry)) {
+			return;
+		}
+
+		for (auto trait : detail::split(entry, "/"sv)) {
+			// Each trait is a single letter, optionally negated with "-".
+			const bool state = !trait.starts_with('-');
+			if (!state) {
+				trait.remove_prefix(1);
+			}
+			if (trait.size() != 1) {
+				continue;
+			}
+
+			switch (trait.front()) {
+			case 'F':
+				data.traits.Set(Traits::kFemale, state);
 				break;
-			case "-C"_h:
-				data.traits.child = false;
+			case 'M':
+				data.traits.Set(Traits::kFemale, !state);
 				break;
-			case "L"_h:
-				data.traits.leveled = true;
+			case 'U':
+				data.traits.Set(Traits::kUnique, state);
 				break;
-			case "-L"_h:
-				data.traits.leveled = false;
+			case 'S':
+				data.traits.Set(Traits::kSummonable, state);
 				break;
-			case "T"_h:
-				data.traits.teammate = true;
+			case 'C':
+				data.traits.Set(Traits::kChild, state);
 				break;
-			case "-T"_h:
-				data.traits.teammate = false;
+			case 'L':
+				data.traits.Set(Traits::kLeveled, state);
 				break;
-			case "D"_h:
-				data.traits.startsDead = true;
+			case 'T':
+				data.traits.Set(Traits::kTeammate, state);
 				break;
-			case "-D"_h:
-				data.traits.startsDead = false;
+			case 'D':
+				data.traits.Set(Traits::kDead, state);
 				break;
 			default:
 				break;
@@ -541,7 +601,7 @@ namespace Distribution::INI
 	}
 
 	template <countable_data Data>
-	void IndexOrCountComponentParser::operator()(const std::string& entry, Data& data) const
+	void IndexOrCountComponentParser::operator()(std::string_view entry, Data& data) const
 	{
 		auto typeHint = data.type;
 
@@ -549,20 +609,22 @@ namespace Distribution::INI
 			data.idxOrCount = 0;
 		}
 
-		if (!distribution::is_valid_entry(entry)) {
+		if (!detail::is_valid_entry(entry)) {
 			return;
 		}
 		try {
 			if (typeHint == RECORD::kPackage) {  // If it's a package, then we only expect a single number.
-				data.idxOrCount = string::to_num<Index>(entry);
+				data.idxOrCount = detail::to_num<Index>(entry);
 			} else {
-				if (auto countPair = string::split(entry, "-"); countPair.size() > 1) {
-					auto minCount = string::to_num<Count>(countPair[0]);
-					auto maxCount = string::to_num<Count>(countPair[1]);
+				if (const auto separator = entry.find('-'); separator != std::string_view::npos) {
+					const auto max = entry.substr(separator + 1);
+
+					auto minCount = detail::to_num<Count>(entry.substr(0, separator));
+					auto maxCount = detail::to_num<Count>(max.substr(0, max.find('-')));
 
 					data.idxOrCount = RandomCount(minCount, maxCount);
 				} else {
-					auto count = string::to_num<Count>(entry);
+					auto count = detail::to_num<Count>(entry);
 
 					data.idxOrCount = RandomCount(count, count);  // create the exact match range.
 				}
@@ -573,17 +635,17 @@ namespace Distribution::INI
 	}
 
 	template <randomized_data Data>
-	void ChanceComponentParser::operator()(const std::string& entry, Data& data) const
+	void ChanceComponentParser::operator()(std::string_view entry, Data& data) const
 	{
-		if (distribution::is_valid_entry(entry)) {
+		if (detail::is_valid_entry(entry)) {
 			// A trailing '!' marks a deterministic chance, e.g. "50!".
-			const bool        deterministic = !entry.empty() && entry.back() == '!';
-			const std::string numericPart = deterministic ? entry.substr(0, entry.size() - 1) : entry;
-			if (!distribution::is_valid_entry(numericPart)) {
+			const bool deterministic = !entry.empty() && entry.back() == '!';
+			const auto numericPart = deterministic ? entry.substr(0, entry.size() - 1) : entry;
+			if (!detail::is_valid_entry(numericPart)) {
 				return;
 			}
 			try {
-				data.chance = Chance(string::to_num<PercentChance>(numericPart) / 100.0, deterministic);
+				data.chance = Chance(detail::to_num<PercentChance>(numericPart) / 100.0, deterministic);
 			} catch (const std::exception&) {
 				throw InvalidChanceException(entry);
 			}
@@ -12,23 +12,47 @@ namespace Filter
 		chance(chance)
 	{
 		hasLeveledFilters = HasLevelFiltersImpl();
+		CompileStrings();
+	}
+
+	void Data::CompileStrings()
+	{
+		const auto pool = Strings::Pool::GetSingleton();
+
+		const auto intern = [&](const StringVec& a_strings, std::vector<Strings::ID>& a_ids) {
+			a_ids.reserve(a_strings.size());
+			for (const auto& str : a_strings) {
+				a_ids.push_back(pool->Intern(str));
+			}
+		};
+
+		intern(strings.ALL, compiledStrings.ALL);
+		intern(strings.NOT, compiledStrings.NOT);
+		intern(strings.MATCH, compiledStrings.MATCH);
+
+		compiledStrings.ANY.reserve(strings.ANY.size());
+		for (const auto& str : strings.ANY) {
+			compiledStrings.ANY.push_back(pool->Get(pool->Intern(str)));
+		}
 	}
 
 	Result Data::passed_string_filters(const NPCData& a_npcData) const
 	{
-		if (!strings.ALL.empty() && !a_npcData.HasStringFilter(strings.ALL, true)) {
+		const auto& [ALL, NOT, MATCH, ANY] = compiledStrings;
+
+		if (!ALL.empty() && !a_npcData.HasStringFilter(ALL, true)) {
 			return Result::kFail;
 		}
 
-		if (!strings.NOT.empty() && a_npcData.HasStringFilter(strings.NOT)) {
+		if (!NOT.empty() && a_npcData.HasStringFilter(NOT)) {
 			return Result::kFail;
 		}
 
-		if (!strings.MATCH.empty() && !a_npcData.HasStringFilter(strings.MATCH)) {
+		if (!MATCH.empty() && !a_npcData.HasStringFilter(MATCH)) {
 			return Result::kFail;
 		}
 
-		if (!strings.ANY.empty() && !a_npcData.ContainsStringFilter(strings.ANY)) {
+		if (!ANY.empty() && !a_npcData.ContainsStringFilter(ANY)) {
 			return Result::kFail;
 		}
 
@@ -146,32 +170,7 @@ namespace Filter
 
 	Result Data::passed_trait_filters(const NPCData& a_npcData) const
 	{
-		auto npc = a_npcData.GetNPC();
-
-		// Traits
-		if (traits.sex && npc->GetSex() != *traits.sex) {
-			return Result::kFail;
-		}
-		if (traits.unique && npc->IsUnique() != *traits.unique) {
-			return Result::kFail;
-		}
-		if (traits.summonable && npc->IsSummonable() != *traits.summonable) {
-			return Result::kFail;
-		}
-		if (traits.child && a_npcData.IsChild() != *traits.child) {
-			return Result::kFail;
-		}
-		if (traits.leveled && a_npcData.IsLeveled() != *traits.leveled) {
-			return Result::kFail;
-		}
-		if (traits.teammate && a_npcData.IsTeammate() != *traits.teammate) {
-			return Result::kFail;
-		}
-		if (traits.startsDead && a_npcData.IsDead() != *traits.startsDead) {
-			return Result::kFail;
-		}
-
-		return Result::kPass;
+		return traits.Matches(a_npcData.GetTraits()) ? Result::kPass : Result::kFail;
 	}
 
 	bool Data::HasLevelFilters() const
@@ -193,39 +192,93 @@ namespace Filter
 		});
 	}
 
-	Result Data::PassedFilters(const NPCData& a_npcData) const
+	Result Data::passed_chance(const NPCData& a_npcData, std::optional<double> a_roll) const
 	{
-		// Fail chance first to avoid running unnecessary checks
-		if (chance.value < 1) {
-			double randNum;
-			if (chance.deterministic) {
-				const auto  playerID = PCLevelMult::Manager::GetSingleton()->GetCurrentPlayerID();
-				const auto  actorFormID = static_cast<std::uint64_t>(a_npcData.GetActor()->GetFormID());
-				std::size_t seed = chance.lineSeed;
-				hash_combine(seed, playerID, actorFormID);
-				randNum = RNG(seed).generate();
-				logger::info("Seed for Actor {:08X}, Player {}, base {} = {}. Chance: {:.3f}", a_npcData.GetActor()->GetFormID(), playerID, chance.lineSeed, seed, randNum);
+		if (chance.value >= 1) {
+			return Result::kPass;
+		}
 
-			} else {
-				randNum = RNG().generate();
+		double randNum;
+		if (chance.deterministic) {
+			const auto  playerID = PCLevelMult::Manager::GetSingleton()->GetCurrentPlayerID();
+			const auto  actorFormID = static_cast<std::uint64_t>(a_npcData.GetActor()->GetFormID());
+			std::size_t seed = chance.lineSeed;
+			hash_combine(seed, playerID, actorFormID);
+			randNum = RNG(seed).generate();
+			if (spdlog::should_log(spdlog::level::info)) {
+				logger::info("Seed for Actor {:08X}, Player {}, base {} = {}. Chance: {:.3f}", a_npcData.GetActor()->GetFormID(), playerID, chance.lineSeed, seed, randNum);
 			}
-			if (randNum > chance.value) {
-				return Result::kFailRNG;
+		} else {
+			randNum = a_roll ? *a_roll : RNG().generate();
+		}
+
+		return randNum > chance.value ? Result::kFailRNG : Result::kPass;
+	}
+
+	Result Data::passed_filters(const NPCData& a_npcData, std::optional<double> a_roll, Stage* a_failedStage) const
+	{
+		const auto fail = [&](Stage a_stage, Result a_result) {
+			if (a_failedStage) {
+				*a_failedStage = a_stage;
 			}
+			return a_result;
+		};
+
+		// Fail chance first to avoid running unnecessary checks
+		if (passed_chance(a_npcData, a_roll) == Result::kFailRNG) {
+			return fail(Stage::kChance, Result::kFailRNG);
+		}
+
+		// Traits are a single mask test, so they go before more expensive filters.
+		if (passed_trait_filters(a_npcData) == Result::kFail) {
+			return fail(Stage::kTraits, Result::kFail);
 		}
 
 		if (passed_string_filters(a_npcData) == Result::kFail) {
-			return Result::kFail;
+			return fail(Stage::kStrings, Result::kFail);
 		}
 
 		if (passed_form_filters(a_npcData) == Result::kFail) {
-			return Result::kFail;
+			return fail(Stage::kForms, Result::kFail);
 		}
 
 		if (passed_level_filters(a_npcData) == Result::kFail) {
-			return Result::kFail;
+			return fail(Stage::kLevels, Result::kFail);
 		}
 
-		return passed_trait_filters(a_npcData);
+		return Result::kPass;
+	}
+
+	Result Data::PassedFilters(const NPCData& a_npcData) const
+	{
+		return passed_filters(a_npcData, std::nullopt);
+	}
+
+	Result Data::PassedFilters(const NPCData& a_npcData, double a_roll) const
+	{
+		return passed_filters(a_npcData, a_roll);
+	}
+
+	Result Data::PassedFilters(const NPCData& a_npcData, Stage& a_failedStage) const
+	{
+		return passed_filters(a_npcData, std::nullopt, &a_failedStage);
+	}
+
+	Result Data::EvaluateStage(Stage a_stage, const NPCData& a_npcData, double a_roll) const
+	{
+		switch (a_stage) {
+		case Stage::kChance:
+			return passed_chance(a_npcData, a_roll);
+		case Stage::kTraits:
+			return passed_trait_filters(a_npcData);
+		case Stage::kStrings:
+			return passed_string_filters(a_npcData);
+		case Stage::kForms:
+			return passed_form_filters(a_npcData);
+		case Stage::kLevels:
+			return passed_level_filters(a_npcData);
+		default:
+			return Result::kPass;
+		}
 	}
 }
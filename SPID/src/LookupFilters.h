@@ -1,5 +1,7 @@
 #pragma once
 
+#include "StringPool.h"
+
 namespace NPC
 {
 	struct Data;
@@ -14,6 +16,18 @@ namespace Filter
 		kPass
 	};
 
+	/// Stages of filters in the order they are checked by Data::PassedFilters.
+	enum class Stage : std::uint8_t
+	{
+		kChance = 0,
+		kTraits,
+		kStrings,
+		kForms,
+		kLevels,
+
+		kTotal
+	};
+
 	struct Data
 	{
 		// Note that chance passed to this constructor is expected to be in percent. It will be converted to a decimal chance by the constructor.
@@ -30,9 +44,42 @@ namespace Filter
 		[[nodiscard]] bool   HasLevelFilters() const;
 		[[nodiscard]] Result PassedFilters(const NPC::Data& a_npcData) const;
 
+		/// <summary>
+		/// Same as PassedFilters, but a_roll is used instead of a random number for non-deterministic chance,
+		/// so that an entry can be evaluated more than once with the same outcome of chance.
+		/// </summary>
+		[[nodiscard]] Result PassedFilters(const NPC::Data& a_npcData, double a_roll) const;
+
+		/// <summary>
+		/// Same as PassedFilters, but also reports the stage that NPC failed, if any (see Distribute::Profiler).
+		/// </summary>
+		[[nodiscard]] Result PassedFilters(const NPC::Data& a_npcData, Stage& a_failedStage) const;
+
+		/// <summary>
+		/// Evaluates a single stage of filters, regardless of whether previous stages passed. Meant for diagnostics (see Distribute::Shadow).
+		/// </summary>
+		[[nodiscard]] Result EvaluateStage(Stage a_stage, const NPC::Data& a_npcData, double a_roll) const;
+
 	private:
+		/// String filters casefolded and interned once per entry, so that matching an NPC doesn't casefold them again.
+		struct CompiledStrings
+		{
+			std::vector<Strings::ID>      ALL{};
+			std::vector<Strings::ID>      NOT{};
+			std::vector<Strings::ID>      MATCH{};
+			std::vector<std::string_view> ANY{};  // views into Strings::Pool
+		};
+
+		CompiledStrings compiledStrings{};
+
+		void CompileStrings();
+
 		[[nodiscard]] bool HasLevelFiltersImpl() const;
 
+		[[nodiscard]] Result passed_filters(const NPC::Data& a_npcData, std::optional<double> a_roll, Stage* a_failedStage = nullptr) const;
+
+		[[nodiscard]] Result passed_chance(const NPC::Data& a_npcData, std::optional<double> a_roll) const;
+
 		[[nodiscard]] Result passed_string_filters(const NPC::Data& a_npcData) const;
 		[[nodiscard]] Result passed_form_filters(const NPC::Data& a_npcData) const;
 		[[nodiscard]] Result passed_level_filters(const NPC::Data& a_npcData) const;
@@ -0,0 +1,77 @@
+#include "LookupForms.h"
+#include "FormData.h"
+
+// Lookup of regular distribution entries, which doesn't depend on Death, Linked or cached lookups.
+void Lookup::LookupEntries(RE::TESDataHandler* const dataHandler, Distribution::INI::Configs& a_configs)
+{
+	using namespace Forms;
+
+	ForEachDistributable([&]<class Form>(Distributables<Form>& a_distributable) {
+		// If it's spells distributable we want to manually lookup forms to pick LevSpells that are added into the list.
+		if constexpr (!std::is_same_v<Form, RE::SpellItem>) {
+			const auto& recordName = RECORD::GetTypeName(a_distributable.GetType());
+
+			a_distributable.LookupForms(dataHandler, recordName, a_configs[a_distributable.GetType()]);
+		}
+	});
+
+	// Sort out Spells and Leveled Spells into two separate lists.
+	auto& rawSpells = a_configs[RECORD::kSpell];
+
+	for (auto& rawSpell : rawSpells) {
+		const auto source = Distribution::INI::GetSourceID(rawSpell);
+
+		LookupGenericForm<RE::TESForm>(dataHandler, rawSpell, [&](bool isValid, auto form, const bool& isFinal, const auto& idxOrCount, const auto& filters, const auto& path) {
+			if (const auto spell = form->template As<RE::SpellItem>(); spell) {
+				spells.EmplaceForm(isValid, spell, isFinal, idxOrCount, filters, path, source);
+			} else if (const auto levSpell = form->template As<RE::TESLevSpell>(); levSpell) {
+				levSpells.EmplaceForm(isValid, levSpell, isFinal, idxOrCount, filters, path, source);
+			}
+		});
+	}
+
+	auto& genericForms = a_configs[RECORD::kForm];
+
+	for (auto& rawForm : genericForms) {
+		const auto source = Distribution::INI::GetSourceID(rawForm);
+
+		// Add to appropriate list. (Note that type inferring doesn't recognize SleepOutfit, Skin)
+		LookupGenericForm<RE::TESForm>(dataHandler, rawForm, [&](bool isValid, auto form, const bool& isFinal, const auto& idxOrCount, const auto& filters, const auto& path) {
+			if (const auto keyword = form->template As<RE::BGSKeyword>(); keyword) {
+				keywords.EmplaceForm(isValid, keyword, isFinal, idxOrCount, filters, path, source);
+			} else if (const auto spell = form->template As<RE::SpellItem>(); spell) {
+				spells.EmplaceForm(isValid, spell, isFinal, idxOrCount, filters, path, source);
+			} else if (const auto levSpell = form->template As<RE::TESLevSpell>(); levSpell) {
+				levSpells.EmplaceForm(isValid, levSpell, isFinal, idxOrCount, filters, path, source);
+			} else if (const auto perk = form->template As<RE::BGSPerk>(); perk) {
+				perks.EmplaceForm(isValid, perk, isFinal, idxOrCount, filters, path, source);
+			} else if (const auto shout = form->template As<RE::TESShout>(); shout) {
+				shouts.EmplaceForm(isValid, shout, isFinal, idxOrCount, filters, path, source);
+			} else if (const auto item = form->template As<RE::TESBoundObject>(); item) {
+				items.EmplaceForm(isValid, item, isFinal, idxOrCount, filters, path, source);
+			} else if (const auto outfit = form->template As<RE::BGSOutfit>(); outfit) {
+				outfits.EmplaceForm(isValid, outfit, isFinal, idxOrCount, filters, path, source);
+			} else if (const auto faction = form->template As<RE::TESFaction>(); faction) {
+				factions.EmplaceForm(isValid, faction, isFinal, idxOrCount, filters, path, source);
+			} else {
+				auto type = form->GetFormType();
+				if (type == RE::FormType::Package || type == RE::FormType::FormList) {
+					// With generic Form entries we default to RandomCount, so we need to properly convert it to Index if it turned out to be a package.
+					Index packageIndex = 1;
+					if (std::holds_alternative<RandomCount>(idxOrCount)) {
+						auto& count = std::get<RandomCount>(idxOrCount);
+						if (!count.IsExact()) {
+							logger::warn("\t[{}] Inferred Form is a Package, but specifies a random count instead of index. Min value ({}) of the range will be used as an index.", path, count.min);
+						}
+						packageIndex = count.min;
+					} else {
+						packageIndex = std::get<Index>(idxOrCount);
+					}
+					packages.EmplaceForm(isValid, form, isFinal, packageIndex, filters, path, source);
+				} else {
+					logger::warn("\t[{}] Unsupported Form type: {}", path, type);
+				}
+			}
+		});
+	}
+}
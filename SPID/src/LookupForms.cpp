@@ -1,77 +1,43 @@
 #include "LookupForms.h"
 #include "DeathDistribution.h"
+#include "EditorIDIndex.h"
 #include "ExclusiveGroups.h"
 #include "FormData.h"
+#include "FormResolver.h"
 #include "KeywordDependencies.h"
 #include "LinkedDistribution.h"
+#include "LookupCache.h"
+#include "Trace.h"
 
-bool LookupDistributables(RE::TESDataHandler* const dataHandler)
+namespace
 {
-	using namespace Forms;
+	// Resolves all identifiers referenced by configs in parallel, before the sequential lookups below consume them in order.
+	void PrefetchForms(RE::TESDataHandler* const dataHandler)
+	{
+		TRACE_ZONE("PrefetchForms");
 
-	ForEachDistributable([&]<class Form>(Distributables<Form>& a_distributable) {
-		// If it's spells distributable we want to manually lookup forms to pick LevSpells that are added into the list.
-		if constexpr (!std::is_same_v<Form, RE::SpellItem>) {
-			const auto& recordName = RECORD::GetTypeName(a_distributable.GetType());
+		RawFormRefs refs;
 
-			a_distributable.LookupForms(dataHandler, recordName, Distribution::INI::configs[a_distributable.GetType()]);
+		for (const auto& [type, entries] : Distribution::INI::configs) {
+			Distribution::INI::CollectRawForms(entries, refs);
+		}
+		DeathDistribution::INI::CollectRawForms(refs);
+		LinkedDistribution::INI::CollectRawForms(refs);
+		for (const auto& group : ExclusiveGroups::INI::exclusiveGroups) {
+			Distribution::INI::CollectRawForms(group.formFilters, refs);
 		}
-	});
 
-	// Sort out Spells and Leveled Spells into two separate lists.
-	auto& rawSpells = Distribution::INI::configs[RECORD::kSpell];
-
-	for (auto& rawSpell : rawSpells) {
-		LookupGenericForm<RE::TESForm>(dataHandler, rawSpell, [&](bool isValid, auto form, const bool& isFinal, const auto& idxOrCount, const auto& filters, const auto& path) {
-			if (const auto spell = form->As<RE::SpellItem>(); spell) {
-				spells.EmplaceForm(isValid, spell, isFinal, idxOrCount, filters, path);
-			} else if (const auto levSpell = form->As<RE::TESLevSpell>(); levSpell) {
-				levSpells.EmplaceForm(isValid, levSpell, isFinal, idxOrCount, filters, path);
-			}
-		});
+		Forms::Resolver::GetSingleton()->Prefetch(dataHandler, refs);
 	}
+}
 
-	auto& genericForms = Distribution::INI::configs[RECORD::kForm];
-
-	for (auto& rawForm : genericForms) {
-		// Add to appropriate list. (Note that type inferring doesn't recognize SleepOutfit, Skin)
-		LookupGenericForm<RE::TESForm>(dataHandler, rawForm, [&](bool isValid, auto form, const bool& isFinal, const auto& idxOrCount, const auto& filters, const auto& path) {
-			if (const auto keyword = form->As<RE::BGSKeyword>(); keyword) {
-				keywords.EmplaceForm(isValid, keyword, isFinal, idxOrCount, filters, path);
-			} else if (const auto spell = form->As<RE::SpellItem>(); spell) {
-				spells.EmplaceForm(isValid, spell, isFinal, idxOrCount, filters, path);
-			} else if (const auto levSpell = form->As<RE::TESLevSpell>(); levSpell) {
-				levSpells.EmplaceForm(isValid, levSpell, isFinal, idxOrCount, filters, path);
-			} else if (const auto perk = form->As<RE::BGSPerk>(); perk) {
-				perks.EmplaceForm(isValid, perk, isFinal, idxOrCount, filters, path);
-			} else if (const auto shout = form->As<RE::TESShout>(); shout) {
-				shouts.EmplaceForm(isValid, shout, isFinal, idxOrCount, filters, path);
-			} else if (const auto item = form->As<RE::TESBoundObject>(); item) {
-				items.EmplaceForm(isValid, item, isFinal, idxOrCount, filters, path);
-			} else if (const auto outfit = form->As<RE::BGSOutfit>(); outfit) {
-				outfits.EmplaceForm(isValid, outfit, isFinal, idxOrCount, filters, path);
-			} else if (const auto faction = form->As<RE::TESFaction>(); faction) {
-				factions.EmplaceForm(isValid, faction, isFinal, idxOrCount, filters, path);
-			} else {
-				auto type = form->GetFormType();
-				if (type == RE::FormType::Package || type == RE::FormType::FormList) {
-					// With generic Form entries we default to RandomCount, so we need to properly convert it to Index if it turned out to be a package.
-					Index packageIndex = 1;
-					if (std::holds_alternative<RandomCount>(idxOrCount)) {
-						auto& count = std::get<RandomCount>(idxOrCount);
-						if (!count.IsExact()) {
-							logger::warn("\t[{}] Inferred Form is a Package, but specifies a random count instead of index. Min value ({}) of the range will be used as an index.", path, count.min);
-						}
-						packageIndex = count.min;
-					} else {
-						packageIndex = std::get<Index>(idxOrCount);
-					}
-					packages.EmplaceForm(isValid, form, isFinal, packageIndex, filters, path);
-				} else {
-					logger::warn("\t[{}] Unsupported Form type: {}", path, type);
-				}
-			}
-		});
+bool LookupDistributables(RE::TESDataHandler* const dataHandler)
+{
+	using namespace Forms;
+
+	{
+		TRACE_ZONE("LookupEntries");
+		Lookup::LookupEntries(dataHandler, Distribution::INI::configs);
 	}
 
 	Dependencies::ResolveKeywords();
@@ -114,8 +80,6 @@ void LogDistributablesLookup()
 }
 
 // Lookup forms in exclusvie groups too.
-// P.S. Lookup process probably should build some sort of cache and reuse already discovered forms
-//      instead of quering data handler for the same raw FormOrEditorID.
 void LookupExclusiveGroups(RE::TESDataHandler* const dataHandler)
 {
 	ExclusiveGroups::Manager::GetSingleton()->LookupExclusiveGroups(dataHandler);
@@ -149,17 +113,28 @@ void LogDeathFormsLookup()
 bool Lookup::LookupForms()
 {
 	if (const auto dataHandler = RE::TESDataHandler::GetSingleton(); dataHandler) {
+		TRACE_ZONE("LookupForms");
+
 		LOG_HEADER("LOOKUP");
 
+		Timer totalTimer;
+		totalTimer.start();
+
+		Forms::EditorIDIndex::GetSingleton()->Build();
+		Forms::LookupCache::Restore(dataHandler);
+		PrefetchForms(dataHandler);
+
 		Timer timer;
 
 		timer.start();
 		const bool success = LookupDistributables(dataHandler);
 		timer.end();
+		totalTimer.end();
 
 		if (success) {
 			LogDistributablesLookup();
-			logger::info("Lookup took {}μs / {}ms", timer.duration_μs(), timer.duration_ms());
+			// Indexing and prefetching do work that lookup used to do itself, so only the total compares with versions that didn't have them.
+			logger::info("Lookup took {}μs / {}ms ({}μs / {}ms including editorID index and prefetch)", timer.duration_μs(), timer.duration_ms(), totalTimer.duration_μs(), totalTimer.duration_ms());
 		}
 
 		LookupDeathForms(dataHandler);
@@ -171,6 +146,11 @@ bool Lookup::LookupForms()
 		LookupExclusiveGroups(dataHandler);
 		LogExclusiveGroupsLookup();
 
+		// Remaining lookups mostly reference the same forms, so resolver's cache is only dropped once all of them are done.
+		Forms::LookupCache::Save();
+		Forms::Resolver::GetSingleton()->LogStatistics();
+		Forms::Resolver::GetSingleton()->Clear();
+
 		return success;
 	}
 
@@ -1,6 +1,13 @@
 #pragma once
 
+#include "LookupConfigs.h"
+
 namespace Lookup
 {
 	bool LookupForms();
+
+	/// <summary>
+	/// Looks up given config entries and appends valid ones to distributables of their types.
+	/// </summary>
+	void LookupEntries(RE::TESDataHandler* const dataHandler, Distribution::INI::Configs& a_configs);
 }
@@ -1,4 +1,5 @@
 #include "LookupNPC.h"
+#include "EditorIDIndex.h"
 #include "ExclusiveGroups.h"
 #include "Outfits/OutfitManager.h"
 
@@ -6,22 +7,29 @@ namespace NPC
 {
 	Data::ID::ID(const RE::TESForm* a_base) :
 		formID(a_base->GetFormID()),
-		editorID(editorID::get_editorID(a_base))
-	{}
+		editorID(Strings::fold(Forms::EditorIDIndex::GetSingleton()->GetEditorID(a_base))),
+		editorIDStr(Strings::Pool::GetSingleton()->Find(editorID))
+	{
+		// Forms that aren't in game's editorID map might still have editorIDs (e.g. provided by po3_Tweaks).
+		if (editorID.empty()) {
+			editorID = Strings::fold(editorID::get_editorID(a_base));
+			editorIDStr = Strings::Pool::GetSingleton()->Find(editorID);
+		}
+	}
 
-	bool Data::ID::contains(const std::string& a_str) const
+	bool Data::ID::contains(std::string_view a_folded) const
 	{
-		return string::icontains(editorID, a_str);
+		return Strings::contains(editorID, a_folded);
 	}
 
-	bool Data::ID::operator==(const RE::TESFile* a_mod) const
+	bool Data::ID::is_editorID(Strings::ID a_editorID) const
 	{
-		return a_mod->IsFormInMod(formID);
+		return editorIDStr != Strings::kInvalidID && editorIDStr == a_editorID;
 	}
 
-	bool Data::ID::operator==(const std::string& a_str) const
+	bool Data::ID::operator==(const RE::TESFile* a_mod) const
 	{
-		return string::iequals(editorID, a_str);
+		return a_mod->IsFormInMod(formID);
 	}
 
 	bool Data::ID::operator==(RE::FormID a_formID) const
@@ -36,14 +44,16 @@ namespace NPC
 		npc(a_npc),
 		actor(a_actor),
 		race(a_actor->GetRace()),
-		name(a_actor->GetName()),
+		name(Strings::fold(a_actor->GetName())),
 		level(a_npc->GetLevel()),
 		child(a_actor->IsChild() || race && race->formEditorID.contains("RaceChild")),
 		leveled(a_actor->IsLeveled()),
 		dying(isDying)
 	{
+		nameStr = Strings::Pool::GetSingleton()->Find(name);
+
 		npc->ForEachKeyword([&](const RE::BGSKeyword* a_keyword) {
-			keywords.emplace(a_keyword->GetFormEditorID());
+			InsertKeyword(a_keyword->GetFormEditorID());
 			return RE::BSContainer::ForEachResult::kContinue;
 		});
 
@@ -64,13 +74,27 @@ namespace NPC
 
 		if (race) {
 			race->ForEachKeyword([&](const RE::BGSKeyword* a_keyword) {
-				keywords.emplace(a_keyword->GetFormEditorID());
+				InsertKeyword(a_keyword->GetFormEditorID());
 				return RE::BSContainer::ForEachResult::kContinue;
 			});
 		}
 
 		std::call_once(init, [&] { potentialFollowerFaction = RE::TESForm::LookupByID<RE::TESFaction>(0x0005C84D); });
 		teammate = actor->IsPlayerTeammate() || potentialFollowerFaction && npc->IsInFaction(potentialFollowerFaction);
+
+		const auto set_trait = [&](Traits::Flag a_flag, bool a_state) {
+			if (a_state) {
+				traits |= a_flag;
+			}
+		};
+
+		set_trait(Traits::kFemale, npc->GetSex() == RE::SEX::kFemale);
+		set_trait(Traits::kUnique, npc->IsUnique());
+		set_trait(Traits::kSummonable, npc->IsSummonable());
+		set_trait(Traits::kChild, child);
+		set_trait(Traits::kLeveled, leveled);
+		set_trait(Traits::kTeammate, teammate);
+		set_trait(Traits::kDead, IsDead());
 	}
 
 	RE::TESNPC* Data::GetNPC() const
@@ -83,40 +107,45 @@ namespace NPC
 		return actor;
 	}
 
-	bool Data::has_keyword_string(const std::string& a_string) const
+	bool Data::has_keyword_string(std::string_view a_string) const
 	{
-		return std::any_of(keywords.begin(), keywords.end(), [&](const auto& keyword) {
-			return string::iequals(keyword, a_string);
-		});
+		return keywords.contains(Strings::fold(a_string));
 	}
 
-	bool Data::HasStringFilter(const StringVec& a_strings, bool a_all) const
+	bool Data::HasStringFilter(const std::vector<Strings::ID>& a_strings, bool a_all) const
 	{
+		const auto has_string = [&](Strings::ID a_str) {
+			return keywordStrs.contains(a_str) || nameStr == a_str || std::ranges::any_of(IDs, [&](const auto& ID) { return ID.is_editorID(a_str); });
+		};
+
 		if (a_all) {
-			return std::ranges::all_of(a_strings, [&](const auto& str) {
-				return has_keyword_string(str) || string::iequals(name, str) || std::ranges::any_of(IDs, [&](const auto& ID) { return ID == str; });
-			});
+			return std::ranges::all_of(a_strings, has_string);
 		} else {
-			return std::ranges::any_of(a_strings, [&](const auto& str) {
-				return has_keyword_string(str) || string::iequals(name, str) || std::ranges::any_of(IDs, [&](const auto& ID) { return ID == str; });
-			});
+			return std::ranges::any_of(a_strings, has_string);
 		}
 	}
 
-	bool Data::ContainsStringFilter(const StringVec& a_strings) const
+	bool Data::ContainsStringFilter(const std::vector<std::string_view>& a_strings) const
 	{
 		return std::ranges::any_of(a_strings, [&](const auto& str) {
-			return string::icontains(name, str) ||
+			return Strings::contains(name, str) ||
 			       std::ranges::any_of(IDs, [&](const auto& ID) { return ID.contains(str); }) ||
 			       std::any_of(keywords.begin(), keywords.end(), [&](const auto& keyword) {
-					   return string::icontains(keyword, str);
+					   return Strings::contains(keyword, str);
 				   });
 		});
 	}
 
 	bool Data::InsertKeyword(const char* a_keyword)
 	{
-		return keywords.emplace(a_keyword).second;
+		auto folded = Strings::fold(a_keyword);
+
+		// Keywords that aren't used by any string filter won't have an ID, but they are still needed for substring filters.
+		if (const auto str = Strings::Pool::GetSingleton()->Find(folded); str != Strings::kInvalidID) {
+			keywordStrs.insert(str);
+		}
+
+		return keywords.emplace(std::move(folded)).second;
 	}
 
 	bool Data::has_form(RE::TESForm* a_form) const
@@ -204,7 +233,7 @@ namespace NPC
 			return false;
 		}
 		return std::ranges::any_of(excludedForms, [&](auto form) {
-			if (const auto keyword = form->As<RE::BGSKeyword>(); keyword) {
+			if (const auto keyword = form->template As<RE::BGSKeyword>(); keyword) {
 				return has_keyword_string(keyword->GetFormEditorID());
 			}
 			return has_form(form);
@@ -231,6 +260,11 @@ namespace NPC
 		return teammate;
 	}
 
+	std::uint8_t Data::GetTraits() const
+	{
+		return traits;
+	}
+
 	bool Data::IsDead() const
 	{
 		return IsDead(actor);
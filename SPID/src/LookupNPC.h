@@ -1,5 +1,7 @@
 #pragma once
 
+#include "StringPool.h"
+
 namespace NPC
 {
 	inline std::once_flag  init;
@@ -14,8 +16,16 @@ namespace NPC
 		[[nodiscard]] RE::TESNPC* GetNPC() const;
 		[[nodiscard]] RE::Actor*  GetActor() const;
 
-		[[nodiscard]] bool HasStringFilter(const StringVec& a_strings, bool a_all = false) const;
-		[[nodiscard]] bool ContainsStringFilter(const StringVec& a_strings) const;
+		/// <summary>
+		/// Checks whether NPC's name, editorIDs or keywords are equal to any (or all) of the interned strings.
+		/// </summary>
+		[[nodiscard]] bool HasStringFilter(const std::vector<Strings::ID>& a_strings, bool a_all = false) const;
+
+		/// <summary>
+		/// Checks whether NPC's name, editorIDs or keywords contain any of the strings.
+		/// Strings are expected to be casefolded.
+		/// </summary>
+		[[nodiscard]] bool ContainsStringFilter(const std::vector<std::string_view>& a_strings) const;
 		bool               InsertKeyword(const char* a_keyword);
 		[[nodiscard]] bool HasFormFilter(const FormVec& a_forms, bool all = false) const;
 
@@ -32,6 +42,13 @@ namespace NPC
 		[[nodiscard]] bool          IsLeveled() const;
 		[[nodiscard]] bool          IsTeammate() const;
 
+		/// <summary>
+		/// NPC's traits packed into Traits::Flag bits.
+		///
+		/// These are calculated once when NPC::Data is created, so that trait filters can be checked with a single mask test.
+		/// </summary>
+		[[nodiscard]] std::uint8_t GetTraits() const;
+
 		/// <summary>
 		/// Flag indicating whether given NPC is dead.
 		///
@@ -62,30 +79,34 @@ namespace NPC
 			explicit ID(const RE::TESForm* a_base);
 			~ID() = default;
 
-			[[nodiscard]] bool contains(const std::string& a_str) const;
+			[[nodiscard]] bool contains(std::string_view a_folded) const;
+			[[nodiscard]] bool is_editorID(Strings::ID a_editorID) const;  // Strings::ID and RE::FormID are the same type, so this can't be an operator==
 
 			bool operator==(const RE::TESFile* a_mod) const;
-			bool operator==(const std::string& a_str) const;
 			bool operator==(RE::FormID a_formID) const;
 
 			RE::FormID  formID{ 0 };
-			std::string editorID{};
+			std::string editorID{};  // casefolded
+			Strings::ID editorIDStr{ Strings::kInvalidID };
 		};
 
-		[[nodiscard]] bool has_keyword_string(const std::string& a_string) const;
+		[[nodiscard]] bool has_keyword_string(std::string_view a_string) const;
 		[[nodiscard]] bool has_form(RE::TESForm* a_form) const;
 
-		RE::TESNPC*     npc;
-		RE::Actor*      actor;
-		RE::TESRace*    race;
-		std::vector<ID> IDs;
-		std::string     name;
-		StringSet       keywords{};
-		std::uint16_t   level;
-		bool            child;
-		bool            teammate;
-		bool            leveled;
-		bool            dying;
+		RE::TESNPC*      npc;
+		RE::Actor*       actor;
+		RE::TESRace*     race;
+		std::vector<ID>  IDs;
+		std::string      name;  // casefolded
+		Strings::ID      nameStr{ Strings::kInvalidID };
+		StringSet        keywords{};  // casefolded
+		Set<Strings::ID> keywordStrs{};
+		std::uint16_t    level;
+		bool             child;
+		bool             teammate;
+		bool             leveled;
+		bool             dying;
+		std::uint8_t     traits{ Traits::kNone };
 	};
 }
 
@@ -0,0 +1,252 @@
+#include "MappedFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#ifdef _WIN32
+#	ifndef WIN32_LEAN_AND_MEAN
+#		define WIN32_LEAN_AND_MEAN
+#	endif
+#	ifndef NOMINMAX
+#		define NOMINMAX
+#	endif
+#	include <Windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::filesystem::path& a_path)
+{
+#ifdef _WIN32
+	const auto file = CreateFileW(a_path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return;
+	}
+
+	LARGE_INTEGER fileSize{};
+	if (!GetFileSizeEx(file, &fileSize)) {
+		CloseHandle(file);
+		return;
+	}
+
+	// Mapping of an empty file fails, but there is nothing to read anyway.
+	if (fileSize.QuadPart > 0) {
+		const auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping) {
+			view = static_cast<const std::byte*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+			// The view keeps the mapping alive on its own.
+			CloseHandle(mapping);
+		}
+		if (!view) {
+			CloseHandle(file);
+			return;
+		}
+		viewSize = static_cast<std::size_t>(fileSize.QuadPart);
+	}
+
+	CloseHandle(file);
+#else
+	const auto file = ::open(a_path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (file < 0) {
+		return;
+	}
+
+	struct stat info{};
+	if (::fstat(file, &info) != 0) {
+		::close(file);
+		return;
+	}
+
+	if (info.st_size > 0) {
+		const auto mapped = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+		if (mapped == MAP_FAILED) {
+			::close(file);
+			return;
+		}
+		view = static_cast<const std::byte*>(mapped);
+		viewSize = static_cast<std::size_t>(info.st_size);
+	}
+
+	::close(file);
+#endif
+	isOpen = true;
+}
+
+MappedFile::MappedFile(MappedFile&& a_other) noexcept :
+	view(std::exchange(a_other.view, nullptr)),
+	viewSize(std::exchange(a_other.viewSize, 0)),
+	isOpen(std::exchange(a_other.isOpen, false))
+{}
+
+MappedFile& MappedFile::operator=(MappedFile&& a_other) noexcept
+{
+	if (this != &a_other) {
+		close();
+		view = std::exchange(a_other.view, nullptr);
+		viewSize = std::exchange(a_other.viewSize, 0);
+		isOpen = std::exchange(a_other.isOpen, false);
+	}
+	return *this;
+}
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+void MappedFile::close()
+{
+	if (view) {
+#ifdef _WIN32
+		UnmapViewOfFile(view);
+#else
+		::munmap(const_cast<std::byte*>(view), viewSize);
+#endif
+	}
+	view = nullptr;
+	viewSize = 0;
+	isOpen = false;
+}
+
+AppendMappedFile::~AppendMappedFile()
+{
+	Close();
+}
+
+bool AppendMappedFile::Open(const std::filesystem::path& a_path, std::size_t a_growth)
+{
+	Close();
+
+#ifdef _WIN32
+	SYSTEM_INFO info{};
+	GetSystemInfo(&info);
+	// Views must start at multiples of allocation granularity, which is coarser than pages.
+	const std::size_t pageSize = info.dwAllocationGranularity;
+
+	const auto handle = CreateFileW(a_path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (handle == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	file = handle;
+#else
+	const auto pageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+
+	file = ::open(a_path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (file < 0) {
+		return false;
+	}
+#endif
+
+	growth = (std::max<std::size_t>(a_growth, 1) + pageSize - 1) / pageSize * pageSize;
+	written = 0;
+
+	if (!remap(growth)) {
+		Close();
+		return false;
+	}
+	return true;
+}
+
+bool AppendMappedFile::Append(std::span<const std::byte> a_bytes)
+{
+	if (!view) {
+		return false;
+	}
+
+	if (a_bytes.size() > capacity - written) {
+		const auto steps = (written + a_bytes.size() - capacity + growth - 1) / growth;
+		if (!remap(capacity + steps * growth)) {
+			return false;
+		}
+	}
+
+	std::memcpy(view + written, a_bytes.data(), a_bytes.size());
+	written += a_bytes.size();
+	return true;
+}
+
+void AppendMappedFile::Flush()
+{
+	if (view && written > 0) {
+#ifdef _WIN32
+		FlushViewOfFile(view, written);
+#else
+		::msync(view, written, MS_ASYNC);
+#endif
+	}
+}
+
+void AppendMappedFile::Close()
+{
+	unmap();
+
+#ifdef _WIN32
+	if (file) {
+		LARGE_INTEGER end{};
+		end.QuadPart = static_cast<LONGLONG>(written);
+		SetFilePointerEx(file, end, nullptr, FILE_BEGIN);
+		SetEndOfFile(file);
+		CloseHandle(file);
+		file = nullptr;
+	}
+#else
+	if (file >= 0) {
+		(void)::ftruncate(file, static_cast<off_t>(written));
+		::close(file);
+		file = -1;
+	}
+#endif
+
+	capacity = 0;
+	written = 0;
+}
+
+bool AppendMappedFile::remap(std::size_t a_capacity)
+{
+	unmap();
+
+#ifdef _WIN32
+	LARGE_INTEGER end{};
+	end.QuadPart = static_cast<LONGLONG>(a_capacity);
+	if (!SetFilePointerEx(file, end, nullptr, FILE_BEGIN) || !SetEndOfFile(file)) {
+		return false;
+	}
+
+	const auto mapping = CreateFileMappingW(file, nullptr, PAGE_READWRITE, 0, 0, nullptr);
+	if (!mapping) {
+		return false;
+	}
+	view = static_cast<std::byte*>(MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, a_capacity));
+	// The view keeps the mapping alive on its own.
+	CloseHandle(mapping);
+#else
+	if (::ftruncate(file, static_cast<off_t>(a_capacity)) != 0) {
+		return false;
+	}
+
+	const auto mapped = ::mmap(nullptr, a_capacity, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+	view = mapped != MAP_FAILED ? static_cast<std::byte*>(mapped) : nullptr;
+#endif
+
+	if (!view) {
+		return false;
+	}
+	capacity = a_capacity;
+	return true;
+}
+
+void AppendMappedFile::unmap()
+{
+	if (view) {
+#ifdef _WIN32
+		UnmapViewOfFile(view);
+#else
+		::munmap(view, capacity);
+#endif
+	}
+	view = nullptr;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+// Memory mapping of whole files, for reading or appending.
+// This header is intentionally self-contained (it doesn't rely on PCH), so that it can be tested and benchmarked outside of the game.
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <string_view>
+
+/// <summary>
+/// Maps an entire file into memory for reading. The mapping lives as long as the object.
+///
+/// Empty files are "mapped" successfully, but have no data.
+/// </summary>
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	explicit MappedFile(const std::filesystem::path& a_path);
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	MappedFile(MappedFile&& a_other) noexcept;
+	MappedFile& operator=(MappedFile&& a_other) noexcept;
+
+	~MappedFile();
+
+	/// Whether the file was opened and mapped.
+	[[nodiscard]] bool IsOpen() const { return isOpen; }
+	explicit           operator bool() const { return isOpen; }
+
+	[[nodiscard]] const std::byte* data() const { return view; }
+	[[nodiscard]] std::size_t      size() const { return viewSize; }
+
+	[[nodiscard]] std::span<const std::byte> bytes() const { return { view, viewSize }; }
+	[[nodiscard]] std::string_view           text() const { return { reinterpret_cast<const char*>(view), viewSize }; }
+
+private:
+	void close();
+
+	const std::byte* view{ nullptr };
+	std::size_t      viewSize{ 0 };
+	bool             isOpen{ false };
+};
+
+/// <summary>
+/// Appends to a file through a writable memory mapping, so appending is a copy into memory and appended data reaches the file even if the process crashes.
+///
+/// The file grows by a fixed step whenever the mapping runs out of space, and is truncated to the appended size when closed.
+/// Until then it ends with zeroed space, so formats must be able to tell where appended data ends on their own.
+/// </summary>
+class AppendMappedFile
+{
+public:
+	AppendMappedFile() = default;
+	~AppendMappedFile();
+
+	AppendMappedFile(const AppendMappedFile&) = delete;
+	AppendMappedFile& operator=(const AppendMappedFile&) = delete;
+
+	/// Creates the file, overwriting it if it exists. a_growth is rounded up to whole pages.
+	bool Open(const std::filesystem::path& a_path, std::size_t a_growth = 1 << 20);
+
+	/// Appends a_bytes, growing the file if needed. Fails if the file isn't open or can't grow.
+	bool Append(std::span<const std::byte> a_bytes);
+
+	/// Asks the system to start writing appended data to disk, without waiting for it.
+	void Flush();
+
+	/// Truncates the file to the appended size and closes it.
+	void Close();
+
+	[[nodiscard]] bool        IsOpen() const { return view != nullptr; }
+	[[nodiscard]] std::size_t size() const { return written; }
+
+private:
+	/// Resizes the file to a_capacity and maps all of it.
+	bool remap(std::size_t a_capacity);
+	void unmap();
+
+	std::byte*  view{ nullptr };
+	std::size_t capacity{ 0 };
+	std::size_t written{ 0 };
+	std::size_t growth{ 0 };
+
+#ifdef _WIN32
+	void* file{ nullptr };
+#else
+	int file{ -1 };
+#endif
+};
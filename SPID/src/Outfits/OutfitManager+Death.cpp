@@ -1,4 +1,5 @@
 #include "OutfitManager.h"
+#include "Trace.h"
 
 namespace Outfits
 {
@@ -9,6 +10,8 @@ namespace Outfits
 		}
 
 		if (const auto actor = event->actorDying->As<RE::Actor>(); actor && !actor->IsPlayerRef()) {
+			TRACE_ZONE("Outfits::TESDeathEvent");
+
 			// If there is no pending outfit after death, that means death distriubtion didn't provide anything, so we finalize current outfit by marking it as dead.
 			if (!HasPendingOutfit(actor)) {
 				auto data = NPCData(actor, true);
@@ -1,4 +1,5 @@
 #include "Helpers.h"
+#include "Latency.h"
 #include "OutfitManager.h"
 
 namespace Outfits
@@ -54,6 +55,7 @@ namespace Outfits
 	RE::NiAVObject* Manager::ProcessLoad3D(RE::Actor* actor, std::function<RE::NiAVObject*()> funcCall)
 	{
 		if (!isLoadingGame) {
+			Latency::Scope latency(Latency::Hook::kOutfitLoad3D);
 			if (const auto outfit = ResolveWornOutfit(actor, false); outfit) {
 				ApplyOutfit(actor, outfit->distributed);
 			}
@@ -1,5 +1,6 @@
 #include "Hooking.h"
 #include "OutfitManager.h"
+#include "Trace.h"
 
 namespace Outfits
 {
@@ -11,6 +12,7 @@ namespace Outfits
 
 		static bool thunk(RE::Character* actor)
 		{
+			TRACE_ZONE("Outfits::ShouldBackgroundClone");
 #ifndef NDEBUG
 			//	logger::info("Outfits: ShouldBackgroundClone({})", *(actor->As<RE::Actor>()));
 #endif
@@ -33,6 +35,7 @@ namespace Outfits
 
 		static RE::NiAVObject* thunk(RE::Character* actor, bool a_backgroundLoading)
 		{
+			TRACE_ZONE("Outfits::Load3D");
 			//logger::info("Load3D ({}); Background: {}", *(actor->As<RE::Actor>()), a_backgroundLoading);
 			return Manager::GetSingleton()->ProcessLoad3D(actor, [&] { return func(actor, a_backgroundLoading); });
 		}
@@ -54,6 +57,7 @@ namespace Outfits
 
 		static void thunk(RE::TESNPC* npc)
 		{
+			TRACE_ZONE("Outfits::InitItemImpl");
 			Manager::GetSingleton()->ProcessInitItemImpl(npc, [&] { func(npc); });
 		}
 
@@ -234,6 +238,7 @@ namespace Outfits
 
 		static void thunk(RE::ItemList* itemList, RE::InventoryChanges* invChanges, RE::NiPointer<RE::TESObjectREFR>& container)
 		{
+			TRACE_ZONE("Outfits::FilterInventoryItems");
 			return Manager::GetSingleton()->ProcessFilterInventoryItems(container, [&] { return func(itemList, invChanges, container); });
 		}
 
@@ -253,6 +258,7 @@ namespace Outfits
 
 		static void thunk(RE::ItemList* itemList, RE::InventoryChanges* invChanges, RE::InventoryEntryData* item, RE::NiPointer<RE::TESObjectREFR>& container)
 		{
+			TRACE_ZONE("Outfits::FilterInventoryItems");
 			return Manager::GetSingleton()->ProcessFilterInventoryItems(container, [&] { return func(itemList, invChanges, item, container); });
 		}
 
@@ -273,6 +279,7 @@ namespace Outfits
 
 		static void thunk(RE::ItemList* itemList, RE::InventoryChanges* invChanges, RE::NiPointer<RE::TESObjectREFR>& container)
 		{
+			TRACE_ZONE("Outfits::FilterInventoryItems");
 			return Manager::GetSingleton()->ProcessFilterInventoryItems(container, [&] { return func(itemList, invChanges, container); });
 		}
 
@@ -292,6 +299,7 @@ namespace Outfits
 
 		static void thunk(RE::ItemList* itemList, RE::InventoryChanges* invChanges, RE::InventoryEntryData* item, RE::NiPointer<RE::TESObjectREFR>& container)
 		{
+			TRACE_ZONE("Outfits::FilterInventoryItems");
 			return Manager::GetSingleton()->ProcessFilterInventoryItems(container, [&] { return func(itemList, invChanges, item, container); });
 		}
 
@@ -312,6 +320,7 @@ namespace Outfits
 
 		static void thunk(RE::ItemList* itemList, RE::InventoryChanges* invChanges, RE::NiPointer<RE::TESObjectREFR>& container)
 		{
+			TRACE_ZONE("Outfits::FilterInventoryItems");
 			return Manager::GetSingleton()->ProcessFilterInventoryItems(container, [&] { return func(itemList, invChanges, container); });
 		}
 
@@ -332,6 +341,7 @@ namespace Outfits
 
 		static void thunk(RE::ItemList* itemList, RE::InventoryChanges* invChanges, RE::NiPointer<RE::TESObjectREFR>& container)
 		{
+			TRACE_ZONE("Outfits::FilterInventoryItems");
 			return Manager::GetSingleton()->ProcessFilterInventoryItems(container, [&] { return func(itemList, invChanges, container); });
 		}
 
@@ -395,6 +405,7 @@ namespace Outfits
 
 		static void thunk(RE::Actor* actor, RE::BGSOutfit* outfit, bool forceUpdate)
 		{
+			TRACE_ZONE("Outfits::UpdateWornGear");
 			Manager::GetSingleton()->ProcessUpdateWornGear(actor, outfit, forceUpdate, [&]() { return func(actor, outfit, forceUpdate); });
 		}
 
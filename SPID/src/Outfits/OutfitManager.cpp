@@ -30,40 +30,6 @@ namespace Outfits
 		}
 	}
 
-	bool Manager::HasDefaultOutfit(const RE::TESNPC* npc, const RE::BGSOutfit* outfit) const
-	{
-		if (!outfit) {
-			return false;
-		}
-
-		if (auto existing = initialOutfits.find(npc->formID); existing != initialOutfits.end()) {
-			return existing->second == outfit;
-		}
-
-		return npc->defaultOutfit == outfit;
-	}
-
-	bool Manager::CanEquipOutfit(const RE::Actor* actor, const RE::BGSOutfit* outfit) const
-	{
-		// Actors that don't have default outfit can't wear any outfit.
-		if (!actor->GetActorBase()->defaultOutfit) {
-			return false;
-		}
-
-		const auto race = actor->GetRace();
-		for (const auto& item : outfit->outfitItems) {
-			if (const auto armor = item->As<RE::TESObjectARMO>()) {
-				if (!std::any_of(armor->armorAddons.begin(), armor->armorAddons.end(), [&](const auto& arma) {
-						return arma && arma->IsValidRace(race);
-					})) {
-					return false;
-				}
-			}
-		}
-
-		return true;
-	}
-
 	void Manager::RestoreOutfit(RE::Actor* actor)
 	{
 		UpdateWornOutfit(actor, [&](OutfitReplacement& W) {
@@ -103,52 +69,6 @@ namespace Outfits
 		return false;
 	}
 
-	bool Manager::SetOutfit(const NPCData& data, RE::BGSOutfit* outfit, bool isDeathOutfit, bool isFinalOutfit)
-	{
-		const auto actor = data.GetActor();
-		const auto npc = data.GetNPC();
-
-		if (!actor || !npc) {  // invalid call
-			return false;
-		}
-
-		const auto defaultOutfit = npc->defaultOutfit;
-
-		if (!defaultOutfit) {
-			return false;
-		}
-
-		// If outfit is nullptr, we just track that distribution didn't provide any outfit for this actor.
-		if (outfit) {
-			//#ifndef NDEBUG
-			logger::debug("[🧥] Evaluating outfit for {}", *actor);
-			logger::debug("[🧥] \tDefault Outfit: {}", *defaultOutfit);
-			if (auto worn = wornReplacements.find(actor->formID); worn != wornReplacements.end()) {
-				logger::debug("[🧥] \tWorn Outfit: {}", *worn->second.distributed);
-			} else {
-				logger::debug("[🧥] \tWorn Outfit: None");
-			}
-			logger::debug("[🧥] \tNew Outfit: {}", *outfit);
-			//#endif
-			if (!CanEquipOutfit(actor, outfit)) {
-				//#ifndef NDEBUG
-				logger::warn("[🧥] \tAttempted to set Outfit {} that can't be worn by given actor.", *outfit);
-				//#endif
-				return false;
-			}
-		}
-
-		if (auto replacement = ResolvePendingOutfit(data, outfit, isDeathOutfit, isFinalOutfit); replacement) {
-			//#ifndef NDEBUG
-			if (replacement->distributed) {
-				logger::debug("[🧥] \tResolved Pending Outfit: {}", *replacement->distributed);
-			}
-			//#endif
-		}
-
-		return true;
-	}
-
 	bool Manager::ApplyOutfit(RE::Actor* actor, RE::BGSOutfit* outfit, bool shouldUpdate3D) const
 	{
 		if (!actor) {
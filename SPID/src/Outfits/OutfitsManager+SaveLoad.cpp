@@ -1,3 +1,4 @@
+#include "Latency.h"
 #include "OutfitManager.h"
 
 namespace Outfits
@@ -277,6 +278,8 @@ namespace Outfits
 
 	void Manager::Load(SKSE::SerializationInterface* interface)
 	{
+		Latency::Scope latency(Latency::Hook::kCoSaveLoad);
+
 		//#ifndef NDEBUG
 		LOG_HEADER("LOADING");
 		std::unordered_map<RE::FormID, OutfitReplacement> loadedReplacements;
@@ -359,6 +362,8 @@ namespace Outfits
 
 	void Manager::Save(SKSE::SerializationInterface* interface)
 	{
+		Latency::Scope latency(Latency::Hook::kCoSaveSave);
+
 		//#ifndef NDEBUG
 		LOG_HEADER("SAVING");
 		//#endif
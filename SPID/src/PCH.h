@@ -3,6 +3,9 @@
 #define WIN32_LEAN_AND_MEAN
 #define NOMINMAX
 
+#include <execution>
+#include <expected>
+#include <future>
 #include <ranges>
 #include <shared_mutex>
 
@@ -6,33 +6,33 @@ namespace detail
 	/// An utility function that will iterate over the list of ComponentParsers and call each one with the corresponding section of the entry.
 	/// </summary>
 	template <typename Data, typename... ComponentParsers, size_t... Is>
-	void parse_each(Data& data, const std::string splited[sizeof...(ComponentParsers)], std::index_sequence<Is...>)
+	void parse_each(Data& data, const std::string_view splited[sizeof...(ComponentParsers)], std::index_sequence<Is...>)
 	{
 		(ComponentParsers()(splited[Is], data), ...);
 	}
 }
 
 template <typename ComponentParser, typename Data>
-concept component_parser = requires(ComponentParser const, const std::string& section, Data& data) {
+concept component_parser = requires(ComponentParser const, std::string_view section, Data& data) {
 	{
 		ComponentParser()(section, data)
 	} -> std::same_as<void>;
 };
 
 template <typename KeyComponentParser, typename Data>
-concept key_component_parser = requires(KeyComponentParser const, const std::string& key, Data& data) {
+concept key_component_parser = requires(KeyComponentParser const, std::string_view key, Data& data) {
 	{
 		KeyComponentParser()(key, data)
 	} -> std::same_as<bool>;
 };
 
-struct NotEnoughComponentsException : std::exception
+struct NotEnoughComponentsException : std::runtime_error
 {
 	const size_t componentParsersCount;
 	const size_t entrySectionsCount;
 
 	NotEnoughComponentsException(size_t componentParsersCount, size_t entrySectionsCount) :
-		std::exception(fmt::format("Too many sections. Expected at most {}, but got {}"sv, componentParsersCount, entrySectionsCount).c_str()),
+		std::runtime_error(fmt::format("Too many sections. Expected at most {}, but got {}"sv, componentParsersCount, entrySectionsCount)),
 		componentParsersCount(componentParsersCount),
 		entrySectionsCount(entrySectionsCount)
 	{}
@@ -44,6 +44,8 @@ struct NotEnoughComponentsException : std::exception
 /// Number of component parsers must be at least the same as the number of sections in the entry.
 /// If there are fewer sections than component parsers, the remaining parsers will be called with an empty string.
 ///
+/// Sections are passed to ComponentParsers as views of the entry, so nothing is copied until parsers store the results in Data.
+///
 /// Parsing may throw and exception if there was not enough ComponentParsers to match all available entries.
 /// It will also rethrow any exceptions thrown by the ComponentParsers.
 /// </summary>
@@ -54,7 +56,7 @@ struct NotEnoughComponentsException : std::exception
 /// <param name="entry">The entry line as it was read from the file.</param>
 /// <returns></returns>
 template <typename Data, key_component_parser<Data> KeyComponentParser, component_parser<Data>... ComponentParsers>
-std::optional<Data> Parse(const std::string& key, const std::string& entry)
+std::optional<Data> Parse(std::string_view key, std::string_view entry)
 {
 	Data data{};
 
@@ -64,21 +66,20 @@ std::optional<Data> Parse(const std::string& key, const std::string& entry)
 
 	constexpr const size_t numberOfComponents = sizeof...(ComponentParsers);
 
-	const auto   rawSections = string::split(entry, "|");
-	const size_t numberOfSections = rawSections.size();
+	const size_t numberOfSections = entry.empty() ? 0 : std::ranges::count(entry, '|') + 1;
 
 	if (numberOfSections > numberOfComponents) {
 		throw NotEnoughComponentsException(numberOfComponents, numberOfSections);
 	}
 
-	std::string sections[numberOfComponents];
-	for (size_t i = 0; i < numberOfSections; i++) {
-		sections[i] = rawSections[i];
-	}
+	// Default empty trailing sections are left as empty views.
+	std::string_view sections[numberOfComponents]{};
 
-	// Fill in default empty trailing sections.
-	for (size_t i = numberOfSections; i < numberOfComponents; i++) {
-		sections[i] = "";
+	size_t i = 0;
+	for (size_t start = 0; i < numberOfSections; ++i) {
+		const auto end = std::min(entry.find('|', start), entry.size());
+		sections[i] = entry.substr(start, end - start);
+		start = end + 1;
 	}
 
 	detail::parse_each<Data, ComponentParsers...>(data, sections, std::index_sequence_for<ComponentParsers...>());
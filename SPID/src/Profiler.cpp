@@ -0,0 +1,236 @@
+#include "Profiler.h"
+
+namespace Distribute::Profiler
+{
+	namespace detail
+	{
+		std::atomic<bool> enabled{ false };
+
+		Lock lock;
+
+		/// Profiles of entries grouped by file, keyed by formID and index of each entry.
+		StringMap<Map<std::uint64_t, EntryProfile>> profiles{};
+
+		constexpr std::array<std::string_view, std::to_underlying(Rejection::kTotal)> rejectionNames{ "chance", "traits", "strings", "forms", "levels", "exclusive" };
+
+		std::uint64_t get_key(RE::FormID a_formID, std::uint32_t a_index)
+		{
+			return (static_cast<std::uint64_t>(a_formID) << 32) | a_index;
+		}
+
+		double to_ms(std::uint64_t a_ns)
+		{
+			return static_cast<double>(a_ns) / 1e6;
+		}
+
+		double get_pass_rate(const Counters& a_counters)
+		{
+			return a_counters.evaluations ? 100.0 * static_cast<double>(a_counters.passes) / static_cast<double>(a_counters.evaluations) : 0.0;
+		}
+
+		/// Most common reason for rejection, or an empty string if nothing was rejected.
+		std::string_view get_top_rejection(const Counters& a_counters)
+		{
+			const auto top = std::ranges::max_element(a_counters.rejections);
+			return *top > 0 ? rejectionNames[top - a_counters.rejections.begin()] : ""sv;
+		}
+
+		std::string escape_csv(std::string_view a_value)
+		{
+			if (a_value.find_first_of(",\"\n") == std::string_view::npos) {
+				return std::string(a_value);
+			}
+
+			std::string result{ '"' };
+			for (const auto c : a_value) {
+				if (c == '"') {
+					result += '"';
+				}
+				result += c;
+			}
+			result += '"';
+			return result;
+		}
+	}
+
+	Counters& Counters::operator+=(const Counters& a_rhs)
+	{
+		evaluations += a_rhs.evaluations;
+		passes += a_rhs.passes;
+		for (std::size_t i = 0; i < rejections.size(); ++i) {
+			rejections[i] += a_rhs.rejections[i];
+		}
+		ns += a_rhs.ns;
+		return *this;
+	}
+
+	void SetEnabled(bool a_enabled)
+	{
+		detail::enabled = a_enabled;
+	}
+
+	bool IsEnabled()
+	{
+		return detail::enabled;
+	}
+
+	void Reset()
+	{
+		WriteLocker locker(detail::lock);
+		detail::profiles.clear();
+	}
+
+	void Record(const RE::TESForm* a_form, std::uint32_t a_index, const Path& a_path, std::optional<Rejection> a_rejection, clock::duration a_duration)
+	{
+		WriteLocker locker(detail::lock);
+
+		auto it = detail::profiles.find(a_path);
+		if (it == detail::profiles.end()) {
+			it = detail::profiles.emplace(a_path, Map<std::uint64_t, EntryProfile>{}).first;
+		}
+
+		auto [entry, inserted] = it->second.try_emplace(detail::get_key(a_form->GetFormID(), a_index));
+		auto& profile = entry->second;
+		if (inserted) {
+			profile.formID = a_form->GetFormID();
+			profile.formType = a_form->GetFormType();
+			profile.editorID = editorID::get_editorID(a_form);
+			profile.index = a_index;
+			profile.path = a_path;
+		}
+
+		auto& counters = profile.counters;
+		++counters.evaluations;
+		if (a_rejection) {
+			++counters.rejections[std::to_underlying(*a_rejection)];
+		} else {
+			++counters.passes;
+		}
+		counters.ns += static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(a_duration).count());
+	}
+
+	std::vector<EntryProfile> GetEntries()
+	{
+		std::vector<EntryProfile> result{};
+		{
+			ReadLocker locker(detail::lock);
+			for (const auto& [path, entries] : detail::profiles) {
+				for (const auto& [key, profile] : entries) {
+					result.push_back(profile);
+				}
+			}
+		}
+
+		std::ranges::sort(result, std::greater{}, [](const EntryProfile& a_profile) { return a_profile.counters.ns; });
+		return result;
+	}
+
+	std::vector<FileProfile> GetFiles()
+	{
+		std::vector<FileProfile> result{};
+		{
+			ReadLocker locker(detail::lock);
+			for (const auto& [path, entries] : detail::profiles) {
+				auto& file = result.emplace_back(FileProfile{ .path = path, .entries = entries.size() });
+				for (const auto& [key, profile] : entries) {
+					file.counters += profile.counters;
+				}
+			}
+		}
+
+		std::ranges::sort(result, std::greater{}, [](const FileProfile& a_profile) { return a_profile.counters.ns; });
+		return result;
+	}
+
+	std::string FormatTable(std::size_t a_maxEntries)
+	{
+		using namespace detail;
+
+		const auto files = GetFiles();
+		const auto entries = GetEntries();
+
+		std::uint64_t totalNs = 0;
+		for (const auto& file : files) {
+			totalNs += file.counters.ns;
+		}
+		const auto share = [&](std::uint64_t a_ns) {
+			return totalNs ? 100.0 * static_cast<double>(a_ns) / static_cast<double>(totalNs) : 0.0;
+		};
+
+		std::string result = fmt::format("{:<60} {:>8} {:>12} {:>7} {:>10} {:>7}  {}\n", "File", "Entries", "Evaluations", "Pass %", "Total ms", "Share", "Top rejection");
+		for (const auto& [path, entryCount, counters] : files) {
+			result += fmt::format("{:<60} {:>8} {:>12} {:>6.1f}% {:>10.3f} {:>6.1f}%  {}\n",
+				path, entryCount, counters.evaluations, get_pass_rate(counters), to_ms(counters.ns), share(counters.ns), get_top_rejection(counters));
+		}
+
+		result += fmt::format("\n{:<44} {:>6} {:<40} {:>12} {:>7} {:>10} {:>8}  {}\n", "Entry", "Index", "File", "Evaluations", "Pass %", "Total ms", "ns/eval", "Top rejection");
+		for (const auto& entry : entries | std::views::take(a_maxEntries)) {
+			const auto& counters = entry.counters;
+			result += fmt::format("{:<44} {:>6} {:<40} {:>12} {:>6.1f}% {:>10.3f} {:>8.0f}  {}\n",
+				fmt::format("{} {} [{:08X}]", entry.formType, entry.editorID, entry.formID), entry.index, entry.path,
+				counters.evaluations, get_pass_rate(counters), to_ms(counters.ns),
+				static_cast<double>(counters.ns) / static_cast<double>(std::max<std::uint64_t>(counters.evaluations, 1)),
+				get_top_rejection(counters));
+		}
+
+		return result;
+	}
+
+	std::string FormatCSV()
+	{
+		using namespace detail;
+
+		std::string result = "file,type,formID,editorID,index,evaluations,passes";
+		for (const auto name : rejectionNames) {
+			result += fmt::format(",rejected_{}", name);
+		}
+		result += ",total_ns\n";
+
+		for (const auto& entry : GetEntries()) {
+			const auto& counters = entry.counters;
+			result += fmt::format("{},{},{:08X},{},{},{},{},{},{}\n",
+				escape_csv(entry.path), entry.formType, entry.formID, escape_csv(entry.editorID), entry.index,
+				counters.evaluations, counters.passes, fmt::join(counters.rejections, ","), counters.ns);
+		}
+
+		return result;
+	}
+
+	void Dump()
+	{
+		if (!IsEnabled()) {
+			return;
+		}
+
+		bool empty;
+		{
+			ReadLocker locker(detail::lock);
+			empty = detail::profiles.empty();
+		}
+		if (empty) {
+			return;
+		}
+
+		LOG_HEADER("ENTRY PROFILE");
+
+		const auto table = FormatTable(50);
+		for (const auto line : std::views::split(std::string_view(table), '\n')) {
+			if (!line.empty()) {
+				logger::info("{}", std::string_view(line.begin(), line.end()));
+			}
+		}
+
+		if (auto path = SKSE::log::log_directory()) {
+			*path /= Version::PROJECT;
+			*path += "_profile.csv"sv;
+
+			std::ofstream file(*path, std::ios::binary | std::ios::trunc);
+			file << FormatCSV();
+			if (file) {
+				logger::info("Entry profile written to {}", path->string());
+			} else {
+				logger::warn("Failed to write entry profile to {}", path->string());
+			}
+		}
+	}
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+namespace Distribute
+{
+	/// <summary>
+	/// Opt-in attribution of distribution cost to individual entries and the _DISTR files they come from.
+	///
+	/// For every entry the profiler counts how many NPCs it was evaluated for, how many of them passed,
+	/// at which stage the rest were rejected and how much time evaluation took in total (measured with steady_clock around each evaluation).
+	/// Entries are identified by their form, index and file, so entries of linked distribution with the same form and file are merged.
+	///
+	/// Profiling is disabled unless enabled in settings (see Settings::profileEntries). Results are dumped when the game is saved.
+	/// </summary>
+	namespace Profiler
+	{
+		using clock = std::chrono::steady_clock;
+
+		/// Why an entry wasn't distributed to an NPC. Stages of filters come first, in the same order as Filter::Stage.
+		enum class Rejection : std::uint8_t
+		{
+			kChance = 0,
+			kTraits,
+			kStrings,
+			kForms,
+			kLevels,
+			kExclusive,  // NPC has a form from the same exclusive group
+
+			kTotal
+		};
+
+		using Rejections = std::array<std::uint64_t, std::to_underlying(Rejection::kTotal)>;
+
+		struct Counters
+		{
+			std::uint64_t evaluations{ 0 };
+			std::uint64_t passes{ 0 };
+			Rejections    rejections{};
+			std::uint64_t ns{ 0 };
+
+			Counters& operator+=(const Counters& a_rhs);
+		};
+
+		struct EntryProfile
+		{
+			RE::FormID    formID{ 0 };
+			RE::FormType  formType{ RE::FormType::None };
+			std::string   editorID{};
+			std::uint32_t index{ 0 };
+			Path          path{};
+
+			Counters counters{};
+		};
+
+		struct FileProfile
+		{
+			Path        path{};
+			std::size_t entries{ 0 };
+
+			Counters counters{};
+		};
+
+		void               SetEnabled(bool a_enabled);
+		[[nodiscard]] bool IsEnabled();
+
+		/// Discards everything that was recorded.
+		void Reset();
+
+		/// <summary>
+		/// Records a single evaluation of an entry. a_rejection is empty if the entry passed.
+		/// </summary>
+		void Record(const RE::TESForm* a_form, std::uint32_t a_index, const Path& a_path, std::optional<Rejection> a_rejection, clock::duration a_duration);
+
+		/// Profiles of all recorded entries, sorted by total time, most expensive first.
+		[[nodiscard]] std::vector<EntryProfile> GetEntries();
+
+		/// Profiles of entries aggregated per file, sorted by total time, most expensive first.
+		[[nodiscard]] std::vector<FileProfile> GetFiles();
+
+		/// <summary>
+		/// Formats profiles of files and of a_maxEntries most expensive entries as a table.
+		/// </summary>
+		[[nodiscard]] std::string FormatTable(std::size_t a_maxEntries);
+
+		/// Formats profiles of all entries as CSV, one entry per line.
+		[[nodiscard]] std::string FormatCSV();
+
+		/// <summary>
+		/// Logs the table and writes CSV next to the log, if profiling is enabled and anything was recorded.
+		/// </summary>
+		void Dump();
+	}
+}
@@ -0,0 +1,713 @@
+#include "SessionCapture.h"
+#include "BinaryIO.h"
+#include "FormData.h"
+#include "Settings.h"
+
+namespace Distribution::Capture
+{
+	namespace detail
+	{
+		using Binary::ReadError;
+		using Binary::Reader;
+		using Binary::Writer;
+
+		using clock = std::chrono::steady_clock;
+
+		/// formatVersion must be bumped whenever layout of any record changes.
+		inline constexpr Binary::FileHeader header{
+			.magic = 0x3150414344495053,  // "SPIDCAP1"
+			.formatVersion = 1,
+			.build = Version::NAME
+		};
+
+		/// Buffered records are written to the file once they exceed this size.
+		constexpr std::size_t flushThreshold = 1 << 20;
+
+#pragma region Save
+		void save(Writer& a_out, const std::vector<std::string>& a_strings)
+		{
+			a_out.write(static_cast<std::uint32_t>(a_strings.size()));
+			for (const auto& str : a_strings) {
+				a_out.write(str);
+			}
+		}
+
+		void save(Writer& a_out, const std::vector<RE::FormID>& a_formIDs)
+		{
+			a_out.write(static_cast<std::uint32_t>(a_formIDs.size()));
+			for (const auto formID : a_formIDs) {
+				a_out.write(formID);
+			}
+		}
+
+		void save(Writer& a_out, const std::vector<FormRef>& a_refs)
+		{
+			a_out.write(static_cast<std::uint32_t>(a_refs.size()));
+			for (const auto& ref : a_refs) {
+				a_out.write(static_cast<std::uint8_t>(ref.index()));
+				std::visit(overload{
+							   [&](RE::FormID a_formID) { a_out.write(a_formID); },
+							   [&](PluginIndex a_plugin) { a_out.write(a_plugin.value); } },
+					ref);
+			}
+		}
+
+		void save(Writer& a_out, const std::vector<SkillLevel>& a_skills)
+		{
+			a_out.write(static_cast<std::uint32_t>(a_skills.size()));
+			for (const auto& [type, range] : a_skills) {
+				a_out.write(type);
+				a_out.write(range.min);
+				a_out.write(range.max);
+			}
+		}
+
+		void save(Writer& a_out, const Form& a_form)
+		{
+			a_out.write(a_form.formID);
+			a_out.write(a_form.formType);
+			a_out.write(a_form.plugin);
+			a_out.write(a_form.editorID);
+			a_out.write(a_form.name);
+			a_out.write(a_form.flags);
+			save(a_out, a_form.keywords);
+			save(a_out, a_form.forms);
+			a_out.write(static_cast<std::uint32_t>(a_form.skillWeights.size()));
+			a_out.write_bytes(std::as_bytes(std::span(a_form.skillWeights)));
+		}
+
+		void save(Writer& a_out, const Entry& a_entry)
+		{
+			a_out.write(a_entry.type);
+			a_out.write(a_entry.form);
+			a_out.write(a_entry.isFinal);
+
+			a_out.write(static_cast<std::uint8_t>(a_entry.idxOrCount.index()));
+			std::visit(overload{
+						   [&](Index a_index) { a_out.write(a_index); },
+						   [&](const RandomCount& a_count) {
+							   a_out.write(a_count.min);
+							   a_out.write(a_count.max);
+						   } },
+				a_entry.idxOrCount);
+
+			save(a_out, a_entry.strings.ALL);
+			save(a_out, a_entry.strings.NOT);
+			save(a_out, a_entry.strings.MATCH);
+			save(a_out, a_entry.strings.ANY);
+
+			save(a_out, a_entry.forms.ALL);
+			save(a_out, a_entry.forms.NOT);
+			save(a_out, a_entry.forms.MATCH);
+
+			a_out.write(a_entry.levels.actorLevel.min);
+			a_out.write(a_entry.levels.actorLevel.max);
+			save(a_out, a_entry.levels.skillLevels);
+			save(a_out, a_entry.levels.skillWeights);
+
+			a_out.write(a_entry.traits.mask);
+			a_out.write(a_entry.traits.value);
+
+			a_out.write(a_entry.chance.value);
+			a_out.write(a_entry.chance.deterministic);
+			a_out.write(a_entry.chance.lineSeed);
+
+			a_out.write(a_entry.path);
+			a_out.write(a_entry.source);
+		}
+
+		void save(Writer& a_out, const Actor& a_actor)
+		{
+			a_out.write(a_actor.actorID);
+			a_out.write(a_actor.npcID);
+			a_out.write(a_actor.name);
+
+			a_out.write(a_actor.onlyPlayerLevelEntries);
+			a_out.write(a_actor.timestamp);
+			a_out.write(a_actor.durationNs);
+
+			for (const auto formID : { a_actor.race, a_actor.location, a_actor.originalBase, a_actor.templateBase }) {
+				a_out.write(formID);
+			}
+			for (const auto flag : { a_actor.leveled, a_actor.teammate, a_actor.dead, a_actor.startsDead }) {
+				a_out.write(flag);
+			}
+
+			for (const auto formID : { a_actor.npcRace, a_actor.npcClass, a_actor.combatStyle, a_actor.voiceType, a_actor.skin, a_actor.defaultOutfit, a_actor.sleepOutfit, a_actor.baseTemplate }) {
+				a_out.write(formID);
+			}
+			a_out.write(a_actor.level);
+			for (const auto flag : { a_actor.female, a_actor.unique, a_actor.summonable }) {
+				a_out.write(flag);
+			}
+
+			save(a_out, a_actor.keywords);
+			a_out.write(static_cast<std::uint32_t>(a_actor.factions.size()));
+			for (const auto& [faction, rank] : a_actor.factions) {
+				a_out.write(faction);
+				a_out.write(rank);
+			}
+			a_out.write_bytes(std::as_bytes(std::span(a_actor.skills)));
+		}
+
+		/// Appends a record of given type. Records are prefixed with their size, so that an incomplete last record can be detected.
+		void save_record(Writer& a_out, RecordType a_type, const Writer& a_payload)
+		{
+			a_out.write(a_type);
+			a_out.write(static_cast<std::uint64_t>(a_payload.size()));
+			a_out.write_bytes(a_payload.bytes());
+		}
+#pragma endregion
+
+#pragma region Load
+		void load(Reader& a_in, std::string& a_str)
+		{
+			a_str = a_in.read_string();
+		}
+
+		void load(Reader& a_in, RE::FormID& a_formID)
+		{
+			a_formID = a_in.read<RE::FormID>();
+		}
+
+		void load(Reader& a_in, FormRef& a_ref)
+		{
+			switch (a_in.read<std::uint8_t>()) {
+			case 0:
+				a_ref = a_in.read<RE::FormID>();
+				break;
+			case 1:
+				a_ref = PluginIndex{ a_in.read<std::uint32_t>() };
+				break;
+			default:
+				throw ReadError("invalid form reference");
+			}
+		}
+
+		void load(Reader& a_in, SkillLevel& a_skill)
+		{
+			a_skill.type = a_in.read<std::uint32_t>();
+			a_skill.range.min = a_in.read<std::uint8_t>();
+			a_skill.range.max = a_in.read<std::uint8_t>();
+		}
+
+		template <class T>
+		void load(Reader& a_in, std::vector<T>& a_values)
+		{
+			a_values.resize(a_in.read_count());
+			for (auto& value : a_values) {
+				load(a_in, value);
+			}
+		}
+
+		void load(Reader& a_in, Form& a_form)
+		{
+			a_form.formID = a_in.read<RE::FormID>();
+			a_form.formType = a_in.read<RE::FormType>();
+			a_form.plugin = a_in.read<std::uint32_t>();
+			a_form.editorID = a_in.read_string();
+			a_form.name = a_in.read_string();
+			a_form.flags = a_in.read<std::uint32_t>();
+			load(a_in, a_form.keywords);
+			load(a_in, a_form.forms);
+
+			const auto weights = a_in.read_bytes(a_in.read_count());
+			a_form.skillWeights.resize(weights.size());
+			std::memcpy(a_form.skillWeights.data(), weights.data(), weights.size());
+		}
+
+		void load(Reader& a_in, Entry& a_entry)
+		{
+			a_entry.type = a_in.read_enum(RECORD::kTotal);
+			a_entry.form = a_in.read<RE::FormID>();
+			a_entry.isFinal = a_in.read<bool>();
+
+			switch (a_in.read<std::uint8_t>()) {
+			case 0:
+				a_entry.idxOrCount = a_in.read<Index>();
+				break;
+			case 1:
+				{
+					RandomCount count{};
+					count.min = a_in.read<Count>();
+					count.max = a_in.read<Count>();
+					a_entry.idxOrCount = count;
+				}
+				break;
+			default:
+				throw ReadError("invalid index or count");
+			}
+
+			load(a_in, a_entry.strings.ALL);
+			load(a_in, a_entry.strings.NOT);
+			load(a_in, a_entry.strings.MATCH);
+			load(a_in, a_entry.strings.ANY);
+
+			load(a_in, a_entry.forms.ALL);
+			load(a_in, a_entry.forms.NOT);
+			load(a_in, a_entry.forms.MATCH);
+
+			a_entry.levels.actorLevel.min = a_in.read<std::uint16_t>();
+			a_entry.levels.actorLevel.max = a_in.read<std::uint16_t>();
+			load(a_in, a_entry.levels.skillLevels);
+			load(a_in, a_entry.levels.skillWeights);
+
+			a_entry.traits.mask = a_in.read<std::uint8_t>();
+			a_entry.traits.value = a_in.read<std::uint8_t>();
+
+			a_entry.chance.value = a_in.read<DecimalChance>();
+			a_entry.chance.deterministic = a_in.read<bool>();
+			a_entry.chance.lineSeed = a_in.read<std::uint64_t>();
+
+			a_entry.path = a_in.read_string();
+			a_entry.source = a_in.read<std::uint64_t>();
+		}
+
+		void load(Reader& a_in, Actor& a_actor)
+		{
+			a_actor.actorID = a_in.read<RE::FormID>();
+			a_actor.npcID = a_in.read<RE::FormID>();
+			a_actor.name = a_in.read_string();
+
+			a_actor.onlyPlayerLevelEntries = a_in.read<bool>();
+			a_actor.timestamp = a_in.read<std::uint64_t>();
+			a_actor.durationNs = a_in.read<std::uint64_t>();
+
+			for (const auto formID : { &a_actor.race, &a_actor.location, &a_actor.originalBase, &a_actor.templateBase }) {
+				*formID = a_in.read<RE::FormID>();
+			}
+			for (const auto flag : { &a_actor.leveled, &a_actor.teammate, &a_actor.dead, &a_actor.startsDead }) {
+				*flag = a_in.read<bool>();
+			}
+
+			for (const auto formID : { &a_actor.npcRace, &a_actor.npcClass, &a_actor.combatStyle, &a_actor.voiceType, &a_actor.skin, &a_actor.defaultOutfit, &a_actor.sleepOutfit, &a_actor.baseTemplate }) {
+				*formID = a_in.read<RE::FormID>();
+			}
+			a_actor.level = a_in.read<std::uint16_t>();
+			for (const auto flag : { &a_actor.female, &a_actor.unique, &a_actor.summonable }) {
+				*flag = a_in.read<bool>();
+			}
+
+			load(a_in, a_actor.keywords);
+			a_actor.factions.resize(a_in.read_count(sizeof(RE::FormID) + sizeof(std::int8_t)));
+			for (auto& [faction, rank] : a_actor.factions) {
+				faction = a_in.read<RE::FormID>();
+				rank = a_in.read<std::int8_t>();
+			}
+			std::memcpy(a_actor.skills.data(), a_in.read_bytes(a_actor.skills.size()).data(), a_actor.skills.size());
+		}
+
+		void load(Reader& a_in, RecordType a_type, Session& a_session)
+		{
+			switch (a_type) {
+			case RecordType::kPlugins:
+				a_session.plugins.resize(a_in.read_count());
+				for (auto& [name, compileIndex] : a_session.plugins) {
+					name = a_in.read_string();
+					compileIndex = a_in.read<std::uint32_t>();
+				}
+				break;
+			case RecordType::kForms:
+				for (auto count = a_in.read_count(); count > 0; --count) {
+					load(a_in, a_session.forms.emplace_back());
+				}
+				break;
+			case RecordType::kEntries:
+				for (auto count = a_in.read_count(); count > 0; --count) {
+					load(a_in, a_session.entries.emplace_back());
+				}
+				break;
+			case RecordType::kActor:
+				load(a_in, a_session.actors.emplace_back());
+				break;
+			default:
+				break;
+			}
+
+			if (!a_in.empty()) {
+				throw ReadError("unexpected trailing data");
+			}
+		}
+#pragma endregion
+
+		/// State of a running capture.
+		struct Recorder
+		{
+			std::ofstream     file{};
+			clock::time_point start{};
+
+			Writer                           pending{};
+			Map<const RE::TESFile*, std::uint32_t> plugins{};
+			Set<RE::FormID>                  writtenForms{};
+
+			~Recorder()
+			{
+				flush();
+			}
+
+			void flush()
+			{
+				if (pending.size() == 0 || !file) {
+					return;
+				}
+				file.write(reinterpret_cast<const char*>(pending.bytes().data()), static_cast<std::streamsize>(pending.size()));
+				file.flush();
+				pending = {};
+			}
+
+			std::uint32_t get_plugin(const RE::TESFile* a_file) const
+			{
+				if (const auto it = plugins.find(a_file); it != plugins.end()) {
+					return it->second;
+				}
+				return kNoPlugin;
+			}
+
+			/// <summary>
+			/// Returns formID of a_form, adding it (and forms that it references) to a_newForms if it wasn't written yet.
+			/// </summary>
+			RE::FormID add_form(const RE::TESForm* a_form, std::vector<Form>& a_newForms)
+			{
+				if (!a_form) {
+					return 0;
+				}
+
+				const auto formID = a_form->GetFormID();
+				if (!writtenForms.insert(formID).second) {
+					return formID;
+				}
+
+				Form form{
+					.formID = formID,
+					.formType = a_form->GetFormType(),
+					.plugin = a_form->IsDynamicForm() ? kNoPlugin : get_plugin(a_form->GetFile(0)),
+					.editorID = editorID::get_editorID(a_form),
+					.name = a_form->GetName()
+				};
+
+				std::vector<const RE::TESForm*> references{};
+
+				if (const auto race = a_form->As<RE::TESRace>()) {
+					if (race->IsChildRace()) {
+						form.flags |= Form::kChildRace;
+					}
+					race->ForEachKeyword([&](const RE::BGSKeyword* a_keyword) {
+						form.keywords.push_back(a_keyword->GetFormID());
+						references.push_back(a_keyword);
+						return RE::BSContainer::ForEachResult::kContinue;
+					});
+				} else if (const auto list = a_form->As<RE::BGSListForm>()) {
+					list->ForEachForm([&](RE::TESForm* a_formInList) {
+						form.forms.push_back(a_formInList->GetFormID());
+						references.push_back(a_formInList);
+						return RE::BSContainer::ForEachResult::kContinue;
+					});
+				} else if (const auto npcClass = a_form->As<RE::TESClass>()) {
+					const auto& weights = npcClass->data.skillWeights;
+					form.skillWeights = {
+						weights.oneHanded, weights.twoHanded, weights.archery, weights.block, weights.smithing, weights.heavyArmor,
+						weights.lightArmor, weights.pickpocket, weights.lockpicking, weights.sneak, weights.alchemy, weights.speech,
+						weights.alteration, weights.conjuration, weights.destruction, weights.illusion, weights.restoration, weights.enchanting
+					};
+				}
+
+				// Referenced forms are written first, so that a replay can link them right away.
+				for (const auto reference : references) {
+					add_form(reference, a_newForms);
+				}
+				a_newForms.push_back(std::move(form));
+
+				return formID;
+			}
+
+			/// Appends new forms as a record of their own, so that they precede records that reference them.
+			void save_forms(const std::vector<Form>& a_forms)
+			{
+				if (a_forms.empty()) {
+					return;
+				}
+
+				Writer payload{};
+				payload.write(static_cast<std::uint32_t>(a_forms.size()));
+				for (const auto& form : a_forms) {
+					save(payload, form);
+				}
+				save_record(pending, RecordType::kForms, payload);
+			}
+
+			void save_plugins(RE::TESDataHandler* const a_dataHandler)
+			{
+				Writer        payload{};
+				std::uint32_t count = 0;
+
+				Writer names{};
+				for (const auto file : a_dataHandler->files) {
+					if (!file || file->compileIndex == 0xFF) {
+						continue;
+					}
+					plugins.emplace(file, count++);
+					names.write(file->GetFilename());
+					names.write(static_cast<std::uint32_t>(file->compileIndex));
+				}
+
+				payload.write(count);
+				payload.write_bytes(names.bytes());
+				save_record(pending, RecordType::kPlugins, payload);
+			}
+
+			void save_entries()
+			{
+				std::vector<Form> newForms{};
+				std::vector<Entry> entries{};
+
+				const auto to_refs = [&](const FormVec& a_forms) {
+					std::vector<FormRef> refs{};
+					refs.reserve(a_forms.size());
+					for (const auto& formOrMod : a_forms) {
+						std::visit(overload{
+									   [&](RE::TESForm* a_form) { refs.emplace_back(add_form(a_form, newForms)); },
+									   [&](const RE::TESFile* a_file) { refs.emplace_back(PluginIndex{ get_plugin(a_file) }); } },
+							formOrMod);
+					}
+					return refs;
+				};
+
+				Forms::ForEachDistributable([&]<class Form>(Forms::Distributables<Form>& a_distributable) {
+					for (const auto& data : a_distributable.GetForms()) {
+						const auto& filters = data.filters;
+						entries.push_back({
+							.type = a_distributable.GetType(),
+							.form = add_form(data.form, newForms),
+							.isFinal = data.isFinal,
+							.idxOrCount = data.idxOrCount,
+							.strings = filters.strings,
+							.forms = { to_refs(filters.forms.ALL), to_refs(filters.forms.NOT), to_refs(filters.forms.MATCH) },
+							.levels = filters.levels,
+							.traits = filters.traits,
+							.chance = filters.chance,
+							.path = data.path,
+							.source = data.source,
+						});
+					}
+				});
+
+				save_forms(newForms);
+
+				Writer payload{};
+				payload.write(static_cast<std::uint32_t>(entries.size()));
+				for (const auto& entry : entries) {
+					save(payload, entry);
+				}
+				save_record(pending, RecordType::kEntries, payload);
+			}
+
+			Actor snapshot(RE::Actor* a_actor, RE::TESNPC* a_npc, bool a_onlyPlayerLevelEntries, std::vector<Form>& a_newForms)
+			{
+				Actor result{
+					.actorID = a_actor->GetFormID(),
+					.npcID = add_form(a_npc, a_newForms),
+					.name = a_actor->GetName(),
+					.onlyPlayerLevelEntries = a_onlyPlayerLevelEntries,
+					.timestamp = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count()),
+					.race = add_form(a_actor->GetRace(), a_newForms),
+					.location = add_form(a_actor->GetEditorLocation(), a_newForms),
+					.leveled = a_actor->IsLeveled(),
+					.teammate = a_actor->IsPlayerTeammate(),
+					.dead = a_actor->IsDead(),
+					.startsDead = (a_actor->formFlags & RE::Actor::RecordFlags::kStartsDead) != 0,
+					.npcRace = add_form(a_npc->race, a_newForms),
+					.npcClass = add_form(a_npc->npcClass, a_newForms),
+					.combatStyle = add_form(a_npc->GetCombatStyle(), a_newForms),
+					.voiceType = add_form(a_npc->voiceType, a_newForms),
+					.skin = add_form(a_npc->skin, a_newForms),
+					.defaultOutfit = add_form(a_npc->defaultOutfit, a_newForms),
+					.sleepOutfit = add_form(a_npc->sleepOutfit, a_newForms),
+					.baseTemplate = add_form(a_npc->baseTemplateForm, a_newForms),
+					.level = a_npc->GetLevel(),
+					.female = a_npc->GetSex() == RE::SEX::kFemale,
+					.unique = a_npc->IsUnique(),
+					.summonable = a_npc->IsSummonable()
+				};
+
+				if (const auto extraLvlCreature = a_actor->extraList.GetByType<RE::ExtraLeveledCreature>()) {
+					result.originalBase = add_form(extraLvlCreature->originalBase, a_newForms);
+					result.templateBase = add_form(extraLvlCreature->templateBase, a_newForms);
+				}
+
+				a_npc->ForEachKeyword([&](const RE::BGSKeyword* a_keyword) {
+					result.keywords.push_back(add_form(a_keyword, a_newForms));
+					return RE::BSContainer::ForEachResult::kContinue;
+				});
+
+				for (const auto& [faction, rank] : a_npc->factions) {
+					if (faction) {
+						result.factions.emplace_back(add_form(faction, a_newForms), rank);
+					}
+				}
+
+				std::copy_n(std::begin(a_npc->playerSkills.values), result.skills.size(), result.skills.begin());
+
+				return result;
+			}
+		};
+
+		Lock                      lock;
+		std::unique_ptr<Recorder> recorder{};
+		std::atomic<bool>         capturing{ false };
+	}
+
+	std::expected<Session, std::string> Read(std::span<const std::byte> a_bytes)
+	{
+		using namespace detail;
+
+		Session session{};
+
+		try {
+			Reader reader(a_bytes);
+
+			if (reader.read<std::uint64_t>() != header.magic) {
+				return std::unexpected("not a SPID capture"s);
+			}
+			if (const auto version = reader.read<std::uint32_t>(); version != header.formatVersion) {
+				return std::unexpected(fmt::format("unsupported capture format version {} (expected {})", version, header.formatVersion));
+			}
+			session.build = reader.read_string();
+
+			while (!reader.empty()) {
+				constexpr auto recordHeaderSize = sizeof(RecordType) + sizeof(std::uint64_t);
+				if (reader.remaining() < recordHeaderSize) {
+					session.truncated = true;
+					break;
+				}
+
+				const auto type = reader.read_enum(RecordType::kTotal);
+				const auto size = reader.read<std::uint64_t>();
+				if (size > reader.remaining()) {
+					session.truncated = true;
+					break;
+				}
+
+				Reader record(reader.read_bytes(static_cast<std::size_t>(size)));
+				load(record, type, session);
+			}
+		} catch (const ReadError& e) {
+			return std::unexpected(fmt::format("capture is corrupted ({})", e.what()));
+		}
+
+		return session;
+	}
+
+	std::optional<std::filesystem::path> GetDefaultPath()
+	{
+		auto path = SKSE::log::log_directory();
+		if (!path) {
+			return std::nullopt;
+		}
+
+		*path /= Version::PROJECT;
+		*path += ".capture"sv;
+		return path;
+	}
+
+	void Start()
+	{
+		if (!Settings::GetSingleton()->captureSession) {
+			return;
+		}
+
+		if (const auto path = GetDefaultPath(); path && Start(*path)) {
+			logger::info("Capturing distribution to {}", path->string());
+		} else {
+			logger::warn("Failed to start capturing distribution");
+		}
+	}
+
+	bool Start(const std::filesystem::path& a_path)
+	{
+		using namespace detail;
+
+		WriteLocker locker(lock);
+
+		auto newRecorder = std::make_unique<Recorder>();
+		newRecorder->file.open(a_path, std::ios::binary | std::ios::trunc);
+		if (!newRecorder->file) {
+			return false;
+		}
+		newRecorder->start = clock::now();
+
+		Writer fileHeader{};
+		fileHeader.write(header.magic);
+		fileHeader.write(header.formatVersion);
+		fileHeader.write(header.build);
+		newRecorder->pending = std::move(fileHeader);
+
+		newRecorder->save_plugins(RE::TESDataHandler::GetSingleton());
+		newRecorder->save_entries();
+		newRecorder->flush();
+
+		recorder = std::move(newRecorder);
+		capturing = true;
+
+		return true;
+	}
+
+	void Stop()
+	{
+		WriteLocker locker(detail::lock);
+
+		detail::capturing = false;
+		detail::recorder.reset();
+	}
+
+	void Flush()
+	{
+		WriteLocker locker(detail::lock);
+
+		if (detail::recorder) {
+			detail::recorder->flush();
+		}
+	}
+
+	bool IsCapturing()
+	{
+		return detail::capturing;
+	}
+
+	Scope::Scope(RE::Actor* a_actor, RE::TESNPC* a_npc, bool a_onlyPlayerLevelEntries)
+	{
+		if (!IsCapturing()) {
+			return;
+		}
+
+		WriteLocker locker(detail::lock);
+
+		if (const auto& recorder = detail::recorder) {
+			std::vector<Form> newForms{};
+			snapshot = recorder->snapshot(a_actor, a_npc, a_onlyPlayerLevelEntries, newForms);
+			recorder->save_forms(newForms);
+		}
+
+		start = detail::clock::now();
+	}
+
+	Scope::~Scope()
+	{
+		if (!snapshot) {
+			return;
+		}
+
+		snapshot->durationNs = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(detail::clock::now() - start).count());
+
+		WriteLocker locker(detail::lock);
+
+		if (const auto& recorder = detail::recorder) {
+			detail::Writer payload{};
+			detail::save(payload, *snapshot);
+			detail::save_record(recorder->pending, RecordType::kActor, payload);
+
+			if (recorder->pending.size() >= detail::flushThreshold) {
+				recorder->flush();
+			}
+		}
+	}
+}
@@ -0,0 +1,186 @@
+#pragma once
+
+#include "LookupConfigs.h"
+
+namespace Distribution
+{
+	/// <summary>
+	/// Opt-in recording of real distribution sessions, so that they can be replayed outside of the game for profiling and differential testing.
+	///
+	/// Once lookup is done, resolved entries of all regular distribution types are written along with the load order.
+	/// Then every NPC that is distributed to is recorded with a snapshot of everything that filters read (base and template forms, name,
+	/// keywords, factions, race, class, skills, level, traits and location), the distribution input and how long distribution took.
+	/// Forms referenced by entries and snapshots are written once to a form table, so that a replay can rebuild them.
+	///
+	/// Records are appended to the capture in batches, so a capture stays readable up to its last complete record even if the game crashes.
+	/// Linked entries and exclusive groups are not captured.
+	///
+	/// Capture is disabled unless enabled in settings (see Settings::captureSession).
+	/// </summary>
+	namespace Capture
+	{
+		inline constexpr std::uint32_t kNoPlugin = 0xFFFFFFFF;
+
+		enum class RecordType : std::uint8_t
+		{
+			kPlugins = 0,
+			kForms,
+			kEntries,
+			kActor,
+
+			kTotal
+		};
+
+		struct Plugin
+		{
+			std::string   name{};
+			std::uint32_t compileIndex{ 0 };
+		};
+
+		/// A form referenced by an entry or a snapshot.
+		struct Form
+		{
+			enum Flag : std::uint32_t
+			{
+				kNone = 0,
+				kChildRace = 1 << 0,
+			};
+
+			RE::FormID    formID{ 0 };
+			RE::FormType  formType{ RE::FormType::None };
+			std::uint32_t plugin{ kNoPlugin };  // index into Session::plugins
+			std::string   editorID{};
+			std::string   name{};
+			std::uint32_t flags{ kNone };
+
+			std::vector<RE::FormID>   keywords{};      // races
+			std::vector<RE::FormID>   forms{};         // contents of form lists
+			std::vector<std::uint8_t> skillWeights{};  // classes, in the order of TESNPC::Skills
+		};
+
+		/// Index into Session::plugins.
+		struct PluginIndex
+		{
+			std::uint32_t value{ kNoPlugin };
+		};
+
+		/// Either a form or a plugin used in form filters.
+		using FormRef = std::variant<RE::FormID, PluginIndex>;
+
+		/// A resolved distribution entry.
+		struct Entry
+		{
+			RECORD::TYPE type{ RECORD::kSpell };
+
+			RE::FormID   form{ 0 };
+			bool         isFinal{ false };
+			IndexOrCount idxOrCount{ RandomCount(1, 1) };
+
+			StringFilters     strings{};
+			Filters<FormRef>  forms{};
+			LevelFilters      levels{};
+			Traits            traits{};
+			Chance            chance{};
+
+			Path          path{};
+			std::uint64_t source{ 0 };
+		};
+
+		/// Snapshot of an NPC taken right before it was distributed to.
+		struct Actor
+		{
+			RE::FormID  actorID{ 0 };
+			RE::FormID  npcID{ 0 };
+			std::string name{};
+
+			// Distribution input and how long it took in game.
+			bool          onlyPlayerLevelEntries{ false };
+			std::uint64_t timestamp{ 0 };  // ns since capture started
+			std::uint64_t durationNs{ 0 };
+
+			// Actor
+			RE::FormID race{ 0 };  // actual race, which can differ from NPC's
+			RE::FormID location{ 0 };
+			RE::FormID originalBase{ 0 };  // set for leveled actors
+			RE::FormID templateBase{ 0 };
+			bool       leveled{ false };
+			bool       teammate{ false };
+			bool       dead{ false };
+			bool       startsDead{ false };
+
+			// NPC
+			RE::FormID    npcRace{ 0 };
+			RE::FormID    npcClass{ 0 };
+			RE::FormID    combatStyle{ 0 };
+			RE::FormID    voiceType{ 0 };
+			RE::FormID    skin{ 0 };
+			RE::FormID    defaultOutfit{ 0 };
+			RE::FormID    sleepOutfit{ 0 };
+			RE::FormID    baseTemplate{ 0 };
+			std::uint16_t level{ 1 };
+			bool          female{ false };
+			bool          unique{ false };
+			bool          summonable{ false };
+
+			std::vector<RE::FormID>                        keywords{};
+			std::vector<std::pair<RE::FormID, std::int8_t>> factions{};
+			std::array<std::uint8_t, 18>                   skills{};
+		};
+
+		/// Everything that was read from a capture.
+		struct Session
+		{
+			std::string build{};  // version of SPID that recorded the session
+
+			std::vector<Plugin> plugins{};
+			std::vector<Form>   forms{};
+			std::vector<Entry>  entries{};
+			std::vector<Actor>  actors{};
+
+			/// Whether capture ended with an incomplete record, e.g. because the game crashed.
+			bool truncated{ false };
+		};
+
+		/// Reads a capture. Fails if it's not a capture or if any complete record is corrupted.
+		std::expected<Session, std::string> Read(std::span<const std::byte> a_bytes);
+
+		/// Default location of the capture, next to SPID's log.
+		std::optional<std::filesystem::path> GetDefaultPath();
+
+		/// <summary>
+		/// Starts capturing to the default path, if capture is enabled. Must be called once lookup is done.
+		/// </summary>
+		void Start();
+
+		/// <summary>
+		/// Starts capturing to a_path, overwriting it. Plugins and current entries are written right away.
+		/// </summary>
+		bool Start(const std::filesystem::path& a_path);
+
+		/// Writes remaining records and closes the capture.
+		void Stop();
+
+		/// Writes records that are still buffered, e.g. before the game is saved.
+		void Flush();
+
+		[[nodiscard]] bool IsCapturing();
+
+		/// <summary>
+		/// Snapshots an NPC when created and records it, together with time that passed until it's destroyed.
+		/// Does nothing if capture isn't running.
+		/// </summary>
+		class Scope
+		{
+		public:
+			Scope(RE::Actor* a_actor, RE::TESNPC* a_npc, bool a_onlyPlayerLevelEntries);
+			~Scope();
+
+			Scope(const Scope&) = delete;
+			Scope& operator=(const Scope&) = delete;
+
+		private:
+			std::optional<Actor>                  snapshot{};
+			std::chrono::steady_clock::time_point start{};
+		};
+	}
+}
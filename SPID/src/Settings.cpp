@@ -0,0 +1,40 @@
+#include "Settings.h"
+
+void Settings::Load()
+{
+	constexpr auto settingsPath = "Data\\SKSE\\Plugins\\po3_SpellPerkItemDistributor.ini";
+
+	CSimpleIniA ini;
+	ini.SetUnicode();
+	ini.LoadFile(settingsPath);
+
+	std::string logLevelStr{ "info" };
+	clib_util::ini::get_value(ini, logLevelStr, "Log", "LogLevel", ";  Log level for SPID. Valid values: trace, debug, info, warn, error, critical.\n;  Use 'debug' to enable verbose per-NPC/outfit distribution logging.");
+
+	logLevel = spdlog::level::from_str(logLevelStr);
+	if (logLevel == spdlog::level::off) {
+		logLevel = spdlog::level::info;
+	}
+
+	clib_util::ini::get_value(ini, maxBufferedMessages, "Log", "iMaxBufferedMessages", ";  Number of distinct lookup errors and warnings that are remembered so that each of them is only logged once.\n;  Once exceeded, remembered messages are forgotten and may be logged again. Each one takes about as much memory as the message itself.");
+
+	clib_util::ini::get_value(ini, lookupCache, "Cache", "bLookupCache", ";  Cache results of form lookup between launches. The cache is only used while load order stays exactly the same.\n;  Saves time spent on searching editorIDs and remapping merged plugins on every launch.");
+
+	clib_util::ini::get_value(ini, sanitizeConfigs, "Configs", "bSanitizeConfigs", ";  Rewrite entries of _DISTR configs that use old format (e.g. 'formID - modName') in the current one.\n;  When disabled, such entries are only listed in the log.");
+
+	clib_util::ini::get_value(ini, hotReload, "Reload", "bHotReload", ";  Reload _DISTR configs as soon as they change while the game is running. Meant for authors of configs.\n;  Only changed entries are applied, and only to NPCs that are loaded afterwards. Forms that were already distributed are not removed.");
+
+	clib_util::ini::get_value(ini, captureSession, "Debug", "bCaptureSession", ";  Record every NPC that SPID distributes to, along with resolved entries, to po3_SpellPerkItemDistributor.capture next to the log.\n;  The capture can be replayed outside of the game to profile and debug distribution. It grows with every NPC, so only enable it when needed.");
+
+	clib_util::ini::get_value(ini, shadowEvaluation, "Debug", "bShadowEvaluation", ";  Evaluate filters of every entry twice, with the regular evaluator and with a slow reference one, and log NPCs for which they pick different forms.\n;  Meant for testing changes to SPID itself. Makes distribution several times slower.");
+
+	clib_util::ini::get_value(ini, profileEntries, "Debug", "bProfileEntries", ";  Measure how long filters of every entry take to evaluate and why NPCs are rejected by them.\n;  Results are logged, per file and for the most expensive entries, and written to po3_SpellPerkItemDistributor_profile.csv next to the log whenever the game is saved.");
+
+	clib_util::ini::get_value(ini, latencyStats, "Debug", "bLatencyStats", ";  Measure how long SPID takes in each of its hooks (distribution, outfits, death distribution, level ups, co-save) and log p50/p99/p99.9/max whenever the game is saved.");
+
+	clib_util::ini::get_value(ini, latencyStatsFile, "Debug", "bLatencyStatsFile", ";  Also append logged latencies to po3_SpellPerkItemDistributor_latency.csv next to the log. Once the file exceeds 1 MB it's renamed to _latency.old.csv and a new one is started.");
+
+	clib_util::ini::get_value(ini, distributionJournal, "Debug", "bDistributionJournal", ";  Record every distributed form, along with the actor and the file that distributed it, to po3_SpellPerkItemDistributor.journal next to the log.\n;  The journal takes 32 bytes per form and can be queried with SPIDJournal. Combine with LogLevel = warn to skip per-actor distribution logs.");
+
+	(void)ini.SaveFile(settingsPath);
+}
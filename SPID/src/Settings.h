@@ -0,0 +1,44 @@
+#pragma once
+
+/// <summary>
+/// SPID's own settings, read from Data\SKSE\Plugins\po3_SpellPerkItemDistributor.ini.
+///
+/// Missing settings are written back to the file with their default values and descriptions.
+/// </summary>
+class Settings : public ISingleton<Settings>
+{
+public:
+	void Load();
+
+	spdlog::level::level_enum logLevel{ spdlog::level::info };
+
+	/// Number of distinct messages that buffered_logger remembers to avoid logging them twice (see LogBuffer::SetCapacity).
+	std::uint32_t maxBufferedMessages{ 1 << 16 };
+
+	/// Whether results of form lookup are cached between launches with the same load order (see Forms::LookupCache).
+	bool lookupCache{ false };
+
+	/// Whether entries of configs that use old format are rewritten in the current one, as opposed to only being reported (see Distribution::INI::WriteBack).
+	bool sanitizeConfigs{ true };
+
+	/// Whether configs that change while the game is running are reloaded (see Distribution::HotReload).
+	bool hotReload{ false };
+
+	/// Whether distribution is recorded to a file that can be replayed outside of the game (see Distribution::Capture).
+	bool captureSession{ false };
+
+	/// Whether filters are also evaluated by a reference evaluator and compared before every distribution (see Distribute::Shadow).
+	bool shadowEvaluation{ false };
+
+	/// Whether time spent evaluating each entry is recorded and dumped when the game is saved (see Distribute::Profiler).
+	bool profileEntries{ false };
+
+	/// Whether latencies of hooks are recorded and logged when the game is saved (see Latency).
+	bool latencyStats{ false };
+
+	/// Whether logged latencies are also appended to a CSV file next to the log.
+	bool latencyStatsFile{ false };
+
+	/// Whether every distributed form is recorded to a binary journal next to the log (see Distribution::Journal).
+	bool distributionJournal{ false };
+};
@@ -0,0 +1,464 @@
+#include "Shadow.h"
+#include "Distribute.h"
+
+namespace Distribute::Shadow
+{
+	namespace Reference
+	{
+		Context::Context(const NPCData& a_npcData) :
+			npcData(a_npcData)
+		{
+			const auto actor = a_npcData.GetActor();
+			const auto npc = a_npcData.GetNPC();
+			const auto race = actor->GetRace();
+
+			name = actor->GetName();
+
+			if (npc->baseTemplateForm) {
+				editorIDs.push_back(editorID::get_editorID(npc->baseTemplateForm));
+			}
+			if (const auto extraLvlCreature = actor->extraList.GetByType<RE::ExtraLeveledCreature>()) {
+				if (extraLvlCreature->originalBase) {
+					editorIDs.push_back(editorID::get_editorID(extraLvlCreature->originalBase));
+				}
+				if (extraLvlCreature->templateBase) {
+					editorIDs.push_back(editorID::get_editorID(extraLvlCreature->templateBase));
+				}
+			} else {
+				editorIDs.push_back(editorID::get_editorID(npc));
+			}
+
+			const auto add_keyword = [&](const RE::BGSKeyword* a_keyword) {
+				keywords.emplace_back(a_keyword->GetFormEditorID());
+				return RE::BSContainer::ForEachResult::kContinue;
+			};
+			npc->ForEachKeyword(add_keyword);
+			if (race) {
+				race->ForEachKeyword(add_keyword);
+			}
+
+			const auto followerFaction = RE::TESForm::LookupByID<RE::TESFaction>(0x0005C84D);
+
+			female = npc->GetSex() == RE::SEX::kFemale;
+			unique = npc->IsUnique();
+			summonable = npc->IsSummonable();
+			child = actor->IsChild() || race && race->formEditorID.contains("RaceChild");
+			leveled = actor->IsLeveled();
+			teammate = actor->IsPlayerTeammate() || followerFaction && npc->IsInFaction(followerFaction);
+			dead = actor->IsDead() || (actor->formFlags & RE::Actor::RecordFlags::kStartsDead) != 0;
+		}
+
+		namespace detail
+		{
+			bool has_string(const Context& a_context, std::string_view a_str)
+			{
+				const auto equals = [&](const std::string& a_other) { return string::iequals(a_other, a_str); };
+				return equals(a_context.name) || std::ranges::any_of(a_context.editorIDs, equals) || std::ranges::any_of(a_context.keywords, equals);
+			}
+
+			bool contains_string(const Context& a_context, std::string_view a_str)
+			{
+				const auto contains = [&](const std::string& a_other) { return string::icontains(a_other, a_str); };
+				return contains(a_context.name) || std::ranges::any_of(a_context.editorIDs, contains) || std::ranges::any_of(a_context.keywords, contains);
+			}
+
+			Filter::Result passed_chance(const FilterData& a_filters, const Context& a_context, double a_roll)
+			{
+				const auto& chance = a_filters.chance;
+				if (chance.value >= 1) {
+					return Filter::Result::kPass;
+				}
+
+				double randNum = a_roll;
+				if (chance.deterministic) {
+					std::size_t seed = chance.lineSeed;
+					hash_combine(seed, PCLevelMult::Manager::GetSingleton()->GetCurrentPlayerID(), static_cast<std::uint64_t>(a_context.npcData.GetActor()->GetFormID()));
+					randNum = RNG(seed).generate();
+				}
+
+				return randNum > chance.value ? Filter::Result::kFailRNG : Filter::Result::kPass;
+			}
+
+			Filter::Result passed_traits(const FilterData& a_filters, const Context& a_context)
+			{
+				const auto& [mask, value] = a_filters.traits;
+
+				for (const auto& [flag, state] : {
+						 std::pair{ Traits::kFemale, a_context.female },
+						 std::pair{ Traits::kUnique, a_context.unique },
+						 std::pair{ Traits::kSummonable, a_context.summonable },
+						 std::pair{ Traits::kChild, a_context.child },
+						 std::pair{ Traits::kLeveled, a_context.leveled },
+						 std::pair{ Traits::kTeammate, a_context.teammate },
+						 std::pair{ Traits::kDead, a_context.dead } }) {
+					if ((mask & flag) && ((value & flag) != 0) != state) {
+						return Filter::Result::kFail;
+					}
+				}
+
+				return Filter::Result::kPass;
+			}
+
+			Filter::Result passed_strings(const FilterData& a_filters, const Context& a_context)
+			{
+				const auto& strings = a_filters.strings;
+				const auto  has = [&](const std::string& a_str) { return has_string(a_context, a_str); };
+
+				if (!strings.ALL.empty() && !std::ranges::all_of(strings.ALL, has)) {
+					return Filter::Result::kFail;
+				}
+
+				if (!strings.NOT.empty() && std::ranges::any_of(strings.NOT, has)) {
+					return Filter::Result::kFail;
+				}
+
+				if (!strings.MATCH.empty() && !std::ranges::any_of(strings.MATCH, has)) {
+					return Filter::Result::kFail;
+				}
+
+				if (!strings.ANY.empty() && !std::ranges::any_of(strings.ANY, [&](const std::string& a_str) { return contains_string(a_context, a_str); })) {
+					return Filter::Result::kFail;
+				}
+
+				return Filter::Result::kPass;
+			}
+		}
+
+		Filter::Result EvaluateStage(Filter::Stage a_stage, const FilterData& a_filters, const Context& a_context, double a_roll)
+		{
+			switch (a_stage) {
+			case Filter::Stage::kChance:
+				return detail::passed_chance(a_filters, a_context, a_roll);
+			case Filter::Stage::kTraits:
+				return detail::passed_traits(a_filters, a_context);
+			case Filter::Stage::kStrings:
+				return detail::passed_strings(a_filters, a_context);
+			case Filter::Stage::kForms:
+			case Filter::Stage::kLevels:
+				return a_filters.EvaluateStage(a_stage, a_context.npcData, a_roll);
+			default:
+				return Filter::Result::kPass;
+			}
+		}
+
+		Filter::Result PassedFilters(const FilterData& a_filters, const Context& a_context, double a_roll)
+		{
+			if (detail::passed_chance(a_filters, a_context, a_roll) == Filter::Result::kFailRNG) {
+				return Filter::Result::kFailRNG;
+			}
+
+			for (const auto stage : { Filter::Stage::kStrings, Filter::Stage::kForms, Filter::Stage::kLevels, Filter::Stage::kTraits }) {
+				if (EvaluateStage(stage, a_filters, a_context, a_roll) == Filter::Result::kFail) {
+					return Filter::Result::kFail;
+				}
+			}
+
+			return Filter::Result::kPass;
+		}
+	}
+
+	namespace detail
+	{
+		using clock = std::chrono::steady_clock;
+
+		std::atomic<bool> enabled{ false };
+
+		struct AtomicStats
+		{
+			std::atomic<std::uint64_t> npcs{ 0 };
+			std::atomic<std::uint64_t> divergentNPCs{ 0 };
+			std::atomic<std::uint64_t> evaluations{ 0 };
+			std::atomic<std::uint64_t> referenceNs{ 0 };
+			std::atomic<std::uint64_t> optimizedNs{ 0 };
+		} stats;
+
+		/// How entries of a type are picked, see for_each_form and for_first_form.
+		enum class Kind
+		{
+			kKeywords,  // every passing entry whose keyword the NPC doesn't have yet
+			kUnique,    // every passing entry whose form the NPC doesn't have yet
+			kEach,      // every passing entry (packages and items)
+			kFirst      // first passing entry that is accepted (outfits and skins)
+		};
+
+		/// State of NPC as seen by one of the evaluators.
+		struct Side
+		{
+			explicit Side(const NPCData& a_npcData) :
+				npcData(a_npcData),
+				context(npcData)
+			{}
+
+			Side(const Side&) = delete;
+			Side& operator=(const Side&) = delete;
+
+			NPCData            npcData;  // receives picked keywords
+			Reference::Context context;  // used by the reference evaluator only
+			Set<RE::FormID>    collected{};
+
+			std::vector<RE::FormID> picks{};
+			bool                    done{ false };  // for_first_form picked a form
+			std::uint64_t           ns{ 0 };
+		};
+
+		std::string_view to_string(Filter::Result a_result)
+		{
+			switch (a_result) {
+			case Filter::Result::kPass:
+				return "pass";
+			case Filter::Result::kFailRNG:
+				return "fail (chance)";
+			default:
+				return "fail";
+			}
+		}
+
+		constexpr std::array<std::string_view, std::to_underlying(Filter::Stage::kTotal)> stageNames{ "chance", "traits", "strings", "forms", "levels" };
+
+		struct Simulation
+		{
+			const PCLevelMult::Input& input;
+
+			Side reference;
+			Side optimized;
+
+			std::optional<Divergence> divergence{};
+
+			Simulation(const NPCData& a_npcData, const PCLevelMult::Input& a_input) :
+				input(a_input),
+				reference(a_npcData),
+				optimized(a_npcData)
+			{}
+
+			template <class Form, class Accept>
+			void simulate(RECORD::TYPE a_type, Kind a_kind, const Forms::DataVec<Form>& a_entries, Accept&& a_accept)
+			{
+				if (a_entries.empty()) {
+					return;
+				}
+
+				const auto pcLevelMultManager = PCLevelMult::Manager::GetSingleton();
+				const auto npc = optimized.npcData.GetNPC();
+
+				for (auto side : { &reference, &optimized }) {
+					side->collected.clear();
+					side->picks.clear();
+					side->done = false;
+				}
+
+				const auto pick = [&](Side& a_side, const Forms::Data<Form>& a_entry, bool a_passed) {
+					const auto form = a_entry.form;
+					const auto formID = form->GetFormID();
+
+					if (!a_passed || a_side.done || a_side.npcData.HasMutuallyExclusiveForm(form)) {
+						return;
+					}
+
+					switch (a_kind) {
+					case Kind::kKeywords:
+						if (!a_side.collected.contains(formID) && a_side.npcData.InsertKeyword(form->GetFormEditorID())) {
+							a_side.collected.insert(formID);
+							a_side.context.keywords.emplace_back(form->GetFormEditorID());
+							a_side.picks.push_back(formID);
+						}
+						break;
+					case Kind::kUnique:
+						if (!a_side.collected.contains(formID) && !Distribute::detail::has_form(npc, form) && a_side.collected.insert(formID).second) {
+							a_side.picks.push_back(formID);
+						}
+						break;
+					case Kind::kEach:
+						a_side.picks.push_back(formID);
+						break;
+					case Kind::kFirst:
+						if (a_accept(form)) {
+							a_side.picks.push_back(formID);
+							a_side.done = true;
+						}
+						break;
+					}
+				};
+
+				std::optional<std::size_t> divergentPosition{};
+
+				for (std::size_t i = 0; i < a_entries.size(); ++i) {
+					const auto& entry = a_entries[i];
+					const auto& filters = entry.filters;
+
+					if (filters.HasLevelFilters() && pcLevelMultManager->FindRejectedEntry(input, entry.form->GetFormID(), entry.index)) {
+						continue;
+					}
+
+					const auto roll = filters.chance.value < 1 && !filters.chance.deterministic ? RNG().generate() : 0.0;
+
+					auto start = clock::now();
+					const auto referenceResult = Reference::PassedFilters(filters, reference.context, roll);
+					auto end = clock::now();
+					reference.ns += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+					start = clock::now();
+					const auto optimizedResult = filters.PassedFilters(optimized.npcData, roll);
+					end = clock::now();
+					optimized.ns += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+					stats.evaluations.fetch_add(1, std::memory_order_relaxed);
+
+					if (referenceResult != optimizedResult && !divergence && !divergentPosition) {
+						divergentPosition = i;
+
+						auto& result = divergence.emplace();
+						result.type = a_type;
+						result.formID = entry.form->GetFormID();
+						result.isFinal = entry.isFinal;
+						result.path = entry.path;
+						result.position = i;
+						result.roll = roll;
+						result.reference = referenceResult;
+						result.optimized = optimizedResult;
+						for (std::size_t stage = 0; stage < result.referenceStages.size(); ++stage) {
+							result.referenceStages[stage] = Reference::EvaluateStage(static_cast<Filter::Stage>(stage), filters, reference.context, roll);
+							result.optimizedStages[stage] = filters.EvaluateStage(static_cast<Filter::Stage>(stage), optimized.npcData, roll);
+						}
+					}
+
+					pick(reference, entry, referenceResult == Filter::Result::kPass);
+					pick(optimized, entry, optimizedResult == Filter::Result::kPass);
+				}
+
+				if (divergentPosition) {
+					divergence->referencePicks = reference.picks;
+					divergence->optimizedPicks = optimized.picks;
+				}
+			}
+		};
+	}
+
+	std::string Divergence::Describe() const
+	{
+		std::string result = fmt::format("[{:08X}] {}: evaluators diverged on {} entry #{} '{}' ({:08X}{})\n",
+			actorID, actorName, RECORD::GetTypeName(type), position, path, formID, isFinal ? ", final" : "");
+
+		result += fmt::format("\treference: {}, optimized: {}", detail::to_string(reference), detail::to_string(optimized));
+		if (roll > 0) {
+			result += fmt::format(", shared chance roll {:.4f}", roll);
+		}
+		result += '\n';
+
+		for (std::size_t stage = 0; stage < referenceStages.size(); ++stage) {
+			result += fmt::format("\t\t{:<8} reference: {:<14} optimized: {}{}\n",
+				detail::stageNames[stage], detail::to_string(referenceStages[stage]), detail::to_string(optimizedStages[stage]),
+				referenceStages[stage] != optimizedStages[stage] ? "  <--" : "");
+		}
+
+		const auto describe_picks = [](const std::vector<RE::FormID>& a_picks) {
+			return a_picks.empty() ? std::string("nothing") : fmt::format("{:08X}", fmt::join(a_picks, " "));
+		};
+
+		if (referencePicks == optimizedPicks) {
+			result += fmt::format("\tboth picked {}\n", describe_picks(referencePicks));
+		} else {
+			result += fmt::format("\treference picked {}\n\toptimized picked {}\n", describe_picks(referencePicks), describe_picks(optimizedPicks));
+		}
+
+		return result;
+	}
+
+	std::optional<Divergence> Compare(const NPCData& a_npcData, const PCLevelMult::Input& a_input, const Forms::DistributionSet& a_forms)
+	{
+		using detail::Kind;
+
+		detail::Simulation simulation(a_npcData, a_input);
+
+		const auto npc = a_npcData.GetNPC();
+		const auto always = [](auto*) { return true; };
+
+		// Same order as in Distribute, so that keywords picked by earlier entries are seen by later ones.
+		simulation.simulate(RECORD::kKeyword, Kind::kKeywords, a_forms.keywords, always);
+		simulation.simulate(RECORD::kFaction, Kind::kUnique, a_forms.factions, always);
+		simulation.simulate(RECORD::kPerk, Kind::kUnique, a_forms.perks, always);
+		simulation.simulate(RECORD::kSpell, Kind::kUnique, a_forms.spells, always);
+		simulation.simulate(RECORD::kLevSpell, Kind::kUnique, a_forms.levSpells, always);
+		simulation.simulate(RECORD::kShout, Kind::kUnique, a_forms.shouts, always);
+		simulation.simulate(RECORD::kPackage, Kind::kEach, a_forms.packages, always);
+		simulation.simulate(RECORD::kItem, Kind::kEach, a_forms.items, always);
+		simulation.simulate(RECORD::kSkin, Kind::kFirst, a_forms.skins, [&](RE::TESObjectARMO* a_skin) { return npc->skin != a_skin; });
+		simulation.simulate(RECORD::kSleepOutfit, Kind::kFirst, a_forms.sleepOutfits, [&](RE::BGSOutfit* a_outfit) { return npc->sleepOutfit != a_outfit; });
+		simulation.simulate(RECORD::kOutfit, Kind::kFirst, a_forms.outfits, always);
+
+		auto& stats = detail::stats;
+		stats.npcs.fetch_add(1, std::memory_order_relaxed);
+		stats.referenceNs.fetch_add(simulation.reference.ns, std::memory_order_relaxed);
+		stats.optimizedNs.fetch_add(simulation.optimized.ns, std::memory_order_relaxed);
+
+		if (auto& divergence = simulation.divergence) {
+			stats.divergentNPCs.fetch_add(1, std::memory_order_relaxed);
+			divergence->actorID = a_npcData.GetActor()->GetFormID();
+			divergence->actorName = a_npcData.GetActor()->GetName();
+		}
+
+		return std::move(simulation.divergence);
+	}
+
+	void Run(const NPCData& a_npcData, const PCLevelMult::Input& a_input, const Forms::DistributionSet& a_forms)
+	{
+		if (!IsEnabled()) {
+			return;
+		}
+
+		if (const auto divergence = Compare(a_npcData, a_input, a_forms)) {
+			logger::warn("[👥] {}", divergence->Describe());
+		}
+	}
+
+	void SetEnabled(bool a_enabled)
+	{
+		detail::enabled = a_enabled;
+	}
+
+	bool IsEnabled()
+	{
+		return detail::enabled;
+	}
+
+	Stats GetStats()
+	{
+		const auto& stats = detail::stats;
+		return {
+			.npcs = stats.npcs,
+			.divergentNPCs = stats.divergentNPCs,
+			.evaluations = stats.evaluations,
+			.referenceNs = stats.referenceNs,
+			.optimizedNs = stats.optimizedNs
+		};
+	}
+
+	void ResetStats()
+	{
+		auto& stats = detail::stats;
+		stats.npcs = 0;
+		stats.divergentNPCs = 0;
+		stats.evaluations = 0;
+		stats.referenceNs = 0;
+		stats.optimizedNs = 0;
+	}
+
+	void LogStats()
+	{
+		if (!IsEnabled()) {
+			return;
+		}
+
+		const auto stats = GetStats();
+		if (stats.npcs == 0) {
+			return;
+		}
+
+		const auto per_evaluation = [&](std::uint64_t a_ns) {
+			return static_cast<double>(a_ns) / static_cast<double>(std::max<std::uint64_t>(stats.evaluations, 1));
+		};
+
+		logger::info("[👥] Shadow evaluation: {} of {} NPCs diverged", stats.divergentNPCs, stats.npcs);
+		logger::info("[👥]\treference {:.1f} ns/entry, optimized {:.1f} ns/entry ({:.2f}x)", per_evaluation(stats.referenceNs), per_evaluation(stats.optimizedNs),
+			static_cast<double>(stats.referenceNs) / static_cast<double>(std::max<std::uint64_t>(stats.optimizedNs, 1)));
+	}
+}
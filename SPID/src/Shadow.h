@@ -0,0 +1,109 @@
+#pragma once
+
+#include "FormData.h"
+#include "LookupNPC.h"
+#include "PCLevelMultManager.h"
+
+namespace Distribute
+{
+	/// <summary>
+	/// Shadow evaluation checks that filters, as SPID evaluates them (Filter::Data::PassedFilters with interned strings and packed traits),
+	/// pick exactly the same forms as a reference evaluator that reads everything straight from the actor with plain case-insensitive comparisons.
+	///
+	/// Before an NPC is distributed to, every entry is evaluated by both evaluators and forms that each of them would pick are simulated
+	/// with the same rules as for_each_form and for_first_form, including keywords added by earlier entries, isFinal outfits and deterministic chance.
+	/// Simulation has no side effects: nothing is distributed, PCLevelMult caches are only read, and forms picked for one type
+	/// are not applied to the NPC before the next type is simulated (except for keywords).
+	/// Non-deterministic chance is rolled once per entry and shared by both evaluators.
+	/// Form and level filters have a single implementation, which the reference evaluator uses as is.
+	///
+	/// Shadow evaluation is disabled unless enabled in settings (see Settings::shadowEvaluation).
+	/// </summary>
+	namespace Shadow
+	{
+		using Stages = std::array<Filter::Result, std::to_underlying(Filter::Stage::kTotal)>;
+
+		/// Filters evaluated the way SPID did before they were optimized.
+		namespace Reference
+		{
+			/// Everything about an NPC that the reference evaluator reads, gathered from the actor and its NPC.
+			struct Context
+			{
+				explicit Context(const NPCData& a_npcData);
+
+				const NPCData& npcData;  // used by form and level filters
+
+				std::string              name{};
+				std::vector<std::string> editorIDs{};
+				std::vector<std::string> keywords{};  // NPC's and race's, followed by keywords that were picked so far
+
+				bool female{ false };
+				bool unique{ false };
+				bool summonable{ false };
+				bool child{ false };
+				bool leveled{ false };
+				bool teammate{ false };
+				bool dead{ false };
+			};
+
+			[[nodiscard]] Filter::Result PassedFilters(const FilterData& a_filters, const Context& a_context, double a_roll);
+
+			[[nodiscard]] Filter::Result EvaluateStage(Filter::Stage a_stage, const FilterData& a_filters, const Context& a_context, double a_roll);
+		}
+
+		/// First entry that evaluators disagreed on.
+		struct Divergence
+		{
+			RE::FormID  actorID{ 0 };
+			std::string actorName{};
+
+			RECORD::TYPE type{ RECORD::kSpell };
+			RE::FormID   formID{ 0 };
+			bool         isFinal{ false };
+			Path         path{};
+			std::size_t  position{ 0 };  // of the entry among entries of its type
+			double       roll{ 0 };
+
+			Filter::Result reference{ Filter::Result::kPass };
+			Filter::Result optimized{ Filter::Result::kPass };
+			Stages         referenceStages{};
+			Stages         optimizedStages{};
+
+			/// Forms of the entry's type that each evaluator picked, in the order they were picked.
+			std::vector<RE::FormID> referencePicks{};
+			std::vector<RE::FormID> optimizedPicks{};
+
+			/// Multi-line explanation of the divergence.
+			[[nodiscard]] std::string Describe() const;
+		};
+
+		struct Stats
+		{
+			std::uint64_t npcs{ 0 };
+			std::uint64_t divergentNPCs{ 0 };
+			std::uint64_t evaluations{ 0 };  // entries evaluated by each evaluator
+			std::uint64_t referenceNs{ 0 };
+			std::uint64_t optimizedNs{ 0 };
+		};
+
+		/// <summary>
+		/// Simulates distribution of a_forms to an NPC with both evaluators and returns the first entry they disagreed on, if any.
+		/// Time spent in each evaluator is added to stats.
+		/// </summary>
+		std::optional<Divergence> Compare(const NPCData& a_npcData, const PCLevelMult::Input& a_input, const Forms::DistributionSet& a_forms);
+
+		/// <summary>
+		/// Compares evaluators if shadow evaluation is enabled, logging the first divergence of each NPC.
+		/// </summary>
+		void Run(const NPCData& a_npcData, const PCLevelMult::Input& a_input, const Forms::DistributionSet& a_forms);
+
+		void               SetEnabled(bool a_enabled);
+		[[nodiscard]] bool IsEnabled();
+
+		[[nodiscard]] Stats GetStats();
+		void                ResetStats();
+
+		/// Logs how many NPCs diverged and how long each evaluator took.
+		void LogStats();
+	}
+}
@@ -0,0 +1,282 @@
+#include "StringKernels.h"
+
+#include <bit>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#	define SPID_X64
+#	ifdef _MSC_VER
+#		include <intrin.h>
+#	else
+#		include <cpuid.h>
+#	endif
+#	include <immintrin.h>
+#endif
+
+// MSVC allows using intrinsics of any instruction set without extra flags, while GCC and Clang need them enabled per function.
+#if defined(SPID_X64) && (defined(__GNUC__) || defined(__clang__))
+#	define SPID_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#	define SPID_TARGET_AVX2
+#endif
+
+namespace Strings
+{
+	namespace detail
+	{
+		constexpr char fold_char(char a_ch)
+		{
+			return a_ch >= 'A' && a_ch <= 'Z' ? static_cast<char>(a_ch + ('a' - 'A')) : a_ch;
+		}
+
+		ISA detect_isa()
+		{
+#ifdef SPID_X64
+#	ifdef _MSC_VER
+			int info[4]{};
+			__cpuid(info, 0);
+			const auto maxLeaf = info[0];
+
+			__cpuid(info, 1);
+			const bool osxsave = info[2] & (1 << 27);
+			const bool avx = info[2] & (1 << 28);
+
+			// AVX2 also requires OS to save YMM registers.
+			if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6) {
+				__cpuidex(info, 7, 0);
+				if (info[1] & (1 << 5)) {
+					return ISA::kAVX2;
+				}
+			}
+#	else
+			__builtin_cpu_init();
+			if (__builtin_cpu_supports("avx2")) {
+				return ISA::kAVX2;
+			}
+#	endif
+			// SSE2 is a baseline for x64.
+			return ISA::kSSE2;
+#else
+			return ISA::kScalar;
+#endif
+		}
+
+#pragma region Fold
+		void fold_scalar(char* a_data, std::size_t a_size)
+		{
+			for (std::size_t i = 0; i < a_size; ++i) {
+				a_data[i] = fold_char(a_data[i]);
+			}
+		}
+
+#ifdef SPID_X64
+		void fold_sse2(char* a_data, std::size_t a_size)
+		{
+			// Signed comparisons leave bytes >= 0x80 untouched, since they are negative.
+			const __m128i beforeA = _mm_set1_epi8('A' - 1);
+			const __m128i afterZ = _mm_set1_epi8('Z' + 1);
+			const __m128i offset = _mm_set1_epi8('a' - 'A');
+
+			std::size_t i = 0;
+			for (; i + 16 <= a_size; i += 16) {
+				const auto ptr = reinterpret_cast<__m128i*>(a_data + i);
+				const auto block = _mm_loadu_si128(ptr);
+				const auto isUpper = _mm_and_si128(_mm_cmpgt_epi8(block, beforeA), _mm_cmplt_epi8(block, afterZ));
+				_mm_storeu_si128(ptr, _mm_add_epi8(block, _mm_and_si128(isUpper, offset)));
+			}
+
+			fold_scalar(a_data + i, a_size - i);
+		}
+
+		SPID_TARGET_AVX2 void fold_avx2(char* a_data, std::size_t a_size)
+		{
+			const __m256i beforeA = _mm256_set1_epi8('A' - 1);
+			const __m256i afterZ = _mm256_set1_epi8('Z' + 1);
+			const __m256i offset = _mm256_set1_epi8('a' - 'A');
+
+			std::size_t i = 0;
+			for (; i + 32 <= a_size; i += 32) {
+				const auto ptr = reinterpret_cast<__m256i*>(a_data + i);
+				const auto block = _mm256_loadu_si256(ptr);
+				const auto isUpper = _mm256_and_si256(_mm256_cmpgt_epi8(block, beforeA), _mm256_cmpgt_epi8(afterZ, block));
+				_mm256_storeu_si256(ptr, _mm256_add_epi8(block, _mm256_and_si256(isUpper, offset)));
+			}
+
+			fold_sse2(a_data + i, a_size - i);
+		}
+#else
+		void fold_sse2(char* a_data, std::size_t a_size)
+		{
+			fold_scalar(a_data, a_size);
+		}
+
+		void fold_avx2(char* a_data, std::size_t a_size)
+		{
+			fold_scalar(a_data, a_size);
+		}
+#endif
+#pragma endregion
+
+#pragma region Contains
+		bool contains_scalar(std::string_view a_haystack, std::string_view a_needle)
+		{
+			if (a_needle.empty() || a_needle.size() > a_haystack.size()) {
+				return false;
+			}
+
+			const auto first = a_needle.front();
+			const auto rest = a_needle.substr(1);
+
+			auto       it = a_haystack.data();
+			const auto end = a_haystack.data() + (a_haystack.size() - a_needle.size()) + 1;  // last possible start + 1
+			while (it < end) {
+				it = static_cast<const char*>(std::memchr(it, first, end - it));
+				if (!it) {
+					return false;
+				}
+				if (std::memcmp(it + 1, rest.data(), rest.size()) == 0) {
+					return true;
+				}
+				++it;
+			}
+
+			return false;
+		}
+
+		// Both SIMD versions compare first and last characters of the needle against blocks of the haystack
+		// and only do a full comparison for positions where both of them match.
+#ifdef SPID_X64
+		bool contains_sse2(std::string_view a_haystack, std::string_view a_needle)
+		{
+			const auto size = a_haystack.size();
+			const auto needleSize = a_needle.size();
+
+			// Haystacks shorter than a single block are handled by a narrower kernel.
+			if (needleSize < 2 || needleSize - 1 + 16 > size) {
+				return contains_scalar(a_haystack, a_needle);
+			}
+
+			const auto data = a_haystack.data();
+			const auto first = _mm_set1_epi8(a_needle.front());
+			const auto last = _mm_set1_epi8(a_needle.back());
+
+			std::size_t i = 0;
+			for (; i + needleSize - 1 + 16 <= size; i += 16) {
+				const auto blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+				const auto blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + needleSize - 1));
+
+				auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, blockFirst), _mm_cmpeq_epi8(last, blockLast))));
+				while (mask) {
+					const auto offset = std::countr_zero(mask);
+					if (std::memcmp(data + i + offset + 1, a_needle.data() + 1, needleSize - 2) == 0) {
+						return true;
+					}
+					mask &= mask - 1;
+				}
+			}
+
+			return contains_scalar(a_haystack.substr(i), a_needle);
+		}
+
+		SPID_TARGET_AVX2 bool contains_avx2(std::string_view a_haystack, std::string_view a_needle)
+		{
+			const auto size = a_haystack.size();
+			const auto needleSize = a_needle.size();
+
+			// Haystacks shorter than a single block are handled by a narrower kernel.
+			if (needleSize < 2 || needleSize - 1 + 32 > size) {
+				return contains_sse2(a_haystack, a_needle);
+			}
+
+			const auto data = a_haystack.data();
+			const auto first = _mm256_set1_epi8(a_needle.front());
+			const auto last = _mm256_set1_epi8(a_needle.back());
+
+			std::size_t i = 0;
+			for (; i + needleSize - 1 + 32 <= size; i += 32) {
+				const auto blockFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+				const auto blockLast = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + needleSize - 1));
+
+				auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(first, blockFirst), _mm256_cmpeq_epi8(last, blockLast))));
+				while (mask) {
+					const auto offset = std::countr_zero(mask);
+					if (std::memcmp(data + i + offset + 1, a_needle.data() + 1, needleSize - 2) == 0) {
+						return true;
+					}
+					mask &= mask - 1;
+				}
+			}
+
+			return contains_sse2(a_haystack.substr(i), a_needle);
+		}
+#else
+		bool contains_sse2(std::string_view a_haystack, std::string_view a_needle)
+		{
+			return contains_scalar(a_haystack, a_needle);
+		}
+
+		bool contains_avx2(std::string_view a_haystack, std::string_view a_needle)
+		{
+			return contains_scalar(a_haystack, a_needle);
+		}
+#endif
+#pragma endregion
+	}
+
+	ISA GetSupportedISA()
+	{
+		static const ISA isa = detail::detect_isa();
+		return isa;
+	}
+
+	std::string_view GetISAName(ISA a_isa)
+	{
+		switch (a_isa) {
+		case ISA::kAVX2:
+			return "AVX2";
+		case ISA::kSSE2:
+			return "SSE2";
+		default:
+			return "Scalar";
+		}
+	}
+
+	void fold_in_place(std::string& a_str)
+	{
+		switch (GetSupportedISA()) {
+		case ISA::kAVX2:
+			detail::fold_avx2(a_str.data(), a_str.size());
+			break;
+		case ISA::kSSE2:
+			detail::fold_sse2(a_str.data(), a_str.size());
+			break;
+		default:
+			detail::fold_scalar(a_str.data(), a_str.size());
+			break;
+		}
+	}
+
+	std::string fold(std::string_view a_str)
+	{
+		std::string result{ a_str };
+		fold_in_place(result);
+		return result;
+	}
+
+	bool contains(std::string_view a_haystack, std::string_view a_needle)
+	{
+		// Most names and editorIDs are shorter than this, and for them memchr-based search is faster than setting up SIMD registers.
+		if (a_haystack.size() < 32) {
+			return detail::contains_scalar(a_haystack, a_needle);
+		}
+
+		switch (GetSupportedISA()) {
+		case ISA::kAVX2:
+			return detail::contains_avx2(a_haystack, a_needle);
+		case ISA::kSSE2:
+			return detail::contains_sse2(a_haystack, a_needle);
+		default:
+			return detail::contains_scalar(a_haystack, a_needle);
+		}
+	}
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+// String kernels used by string filters.
+// This header is intentionally self-contained (it doesn't rely on PCH), so that kernels can be tested and benchmarked outside of the game.
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace Strings
+{
+	/// Instruction set used by the kernels.
+	enum class ISA : std::uint8_t
+	{
+		kScalar = 0,
+		kSSE2,
+		kAVX2
+	};
+
+	/// Best instruction set supported by the current CPU. Detected once on first call.
+	ISA GetSupportedISA();
+
+	std::string_view GetISAName(ISA);
+
+	/// Casefolds ASCII letters of the string in place. Non-ASCII bytes are left untouched,
+	/// which matches case-insensitive comparisons done by string::iequals and string::icontains.
+	void fold_in_place(std::string& a_str);
+
+	[[nodiscard]] std::string fold(std::string_view a_str);
+
+	/// Checks whether a_haystack contains a_needle.
+	/// Both strings are expected to be already casefolded, so that comparison is a plain byte search.
+	/// Same as string::icontains an empty needle never matches.
+	[[nodiscard]] bool contains(std::string_view a_haystack, std::string_view a_needle);
+
+	/// Individual implementations of the kernels. These are exposed for testing and benchmarking only,
+	/// prefer using dispatching functions above.
+	namespace detail
+	{
+		void fold_scalar(char* a_data, std::size_t a_size);
+		void fold_sse2(char* a_data, std::size_t a_size);
+		void fold_avx2(char* a_data, std::size_t a_size);
+
+		bool contains_scalar(std::string_view a_haystack, std::string_view a_needle);
+		bool contains_sse2(std::string_view a_haystack, std::string_view a_needle);
+		bool contains_avx2(std::string_view a_haystack, std::string_view a_needle);
+	}
+}
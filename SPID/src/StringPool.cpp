@@ -0,0 +1,54 @@
+#include "StringPool.h"
+
+namespace Strings
+{
+	ID Pool::Intern(std::string_view a_str)
+	{
+		auto folded = fold(a_str);
+
+		if (const auto id = Find(folded); id != kInvalidID) {
+			return id;
+		}
+
+		WriteLocker locker(lock);
+
+		// Another thread might've interned the same string while we were waiting for the lock.
+		if (const auto it = ids.find(folded); it != ids.end()) {
+			return it->second;
+		}
+
+		const auto  id = static_cast<ID>(strings.size() + 1);
+		const auto& str = strings.emplace_back(std::move(folded));
+		ids.emplace(str, id);
+
+		return id;
+	}
+
+	ID Pool::Find(std::string_view a_folded) const
+	{
+		ReadLocker locker(lock);
+
+		if (const auto it = ids.find(a_folded); it != ids.end()) {
+			return it->second;
+		}
+
+		return kInvalidID;
+	}
+
+	std::string_view Pool::Get(ID a_id) const
+	{
+		ReadLocker locker(lock);
+
+		if (a_id == kInvalidID || a_id > strings.size()) {
+			return {};
+		}
+
+		return strings[a_id - 1];
+	}
+
+	std::size_t Pool::Size() const
+	{
+		ReadLocker locker(lock);
+		return strings.size();
+	}
+}
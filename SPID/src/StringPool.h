@@ -0,0 +1,46 @@
+#pragma once
+
+#include "StringKernels.h"
+
+namespace Strings
+{
+	/// Identifier of an interned casefolded string.
+	/// IDs are assigned in order of interning and are only valid within a single game session.
+	using ID = std::uint32_t;
+
+	inline constexpr ID kInvalidID = 0;
+
+	/// <summary>
+	/// Storage of unique casefolded strings.
+	///
+	/// Strings that are equal ignoring case share the same ID, so that equality of interned strings is a plain integer compare.
+	/// Interned strings are never removed, which keeps both IDs and string_views returned by the pool valid for the whole session.
+	/// </summary>
+	class Pool : public ISingleton<Pool>
+	{
+	public:
+		/// <summary>
+		/// Casefolds given string and returns its ID, adding it to the pool if it wasn't interned before.
+		/// </summary>
+		ID Intern(std::string_view a_str);
+
+		/// <summary>
+		/// Returns ID of an already casefolded string, or kInvalidID if such string was never interned.
+		///
+		/// This never modifies the pool, so strings that don't have IDs can't match any interned string.
+		/// </summary>
+		[[nodiscard]] ID Find(std::string_view a_folded) const;
+
+		/// <summary>
+		/// Returns casefolded string for given ID or an empty string for an invalid ID.
+		/// </summary>
+		[[nodiscard]] std::string_view Get(ID a_id) const;
+
+		[[nodiscard]] std::size_t Size() const;
+
+	private:
+		mutable Lock              lock;
+		std::deque<std::string>   strings{};  // deque doesn't move its elements when growing, so views in ids stay valid.
+		Map<std::string_view, ID> ids{};
+	};
+}
@@ -0,0 +1,115 @@
+#include "Trace.h"
+
+namespace Trace
+{
+	namespace detail
+	{
+		const clock::time_point epochTime = clock::now();
+		const std::uint64_t     epochTicks = Now();
+
+		struct ThreadBuffer
+		{
+			std::uint32_t              tid{ 0 };
+			bool                       named{ false };
+			std::uint64_t              reportedDrops{ 0 };
+			RingBuffer<Event, 1 << 13> events{};
+		};
+
+		Lock lock;
+
+		/// Buffers of all threads that ever recorded a zone. Buffers outlive their threads, so that zones of finished threads can still be flushed.
+		std::vector<std::unique_ptr<ThreadBuffer>> buffers{};
+
+		thread_local ThreadBuffer* threadBuffer{ nullptr };
+
+		ThreadBuffer* register_thread()
+		{
+			WriteLocker locker(lock);
+			auto& buffer = buffers.emplace_back(std::make_unique<ThreadBuffer>());
+			buffer->tid = static_cast<std::uint32_t>(buffers.size());
+			return buffer.get();
+		}
+
+		/// Measures how many ticks of Now() pass in a microsecond, by comparing them with steady_clock since tracing started.
+		double get_ticks_per_us()
+		{
+			const auto elapsedTicks = static_cast<double>(Now() - epochTicks);
+			const auto elapsedUs = std::chrono::duration<double, std::micro>(clock::now() - epochTime).count();
+			return elapsedUs > 0.0 && elapsedTicks > 0.0 ? elapsedTicks / elapsedUs : 1.0;
+		}
+	}
+
+	void Record(const char* a_name, std::uint64_t a_start, std::uint64_t a_end)
+	{
+		auto buffer = detail::threadBuffer;
+		if (!buffer) [[unlikely]] {
+			buffer = detail::threadBuffer = detail::register_thread();
+		}
+
+		buffer->events.TryPush({ a_name, a_start, a_end });
+	}
+
+	std::string Drain()
+	{
+		using namespace detail;
+
+		std::string result{};
+
+		const auto ticksPerUs = get_ticks_per_us();
+		const auto to_us = [&](std::uint64_t a_ticks) {
+			return static_cast<double>(a_ticks) / ticksPerUs;
+		};
+
+		WriteLocker locker(lock);
+		for (const auto& buffer : buffers) {
+			if (!buffer->named) {
+				result += fmt::format(R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":"Thread {}"}}}},)"
+									  "\n",
+					buffer->tid, buffer->tid);
+				buffer->named = true;
+			}
+
+			buffer->events.Drain([&](const Event& a_event) {
+				result += fmt::format(R"({{"name":"{}","ph":"X","ts":{:.3f},"dur":{:.3f},"pid":1,"tid":{}}},)"
+									  "\n",
+					a_event.name, to_us(a_event.start - epochTicks), to_us(a_event.end - a_event.start), buffer->tid);
+			});
+
+			if (const auto dropped = buffer->events.GetDropped(); dropped != buffer->reportedDrops) {
+				logger::warn("Trace buffer of thread {} was full, {} zones were dropped", buffer->tid, dropped - buffer->reportedDrops);
+				buffer->reportedDrops = dropped;
+			}
+		}
+
+		return result;
+	}
+
+	void Flush()
+	{
+		{
+			ReadLocker locker(detail::lock);
+			if (detail::buffers.empty()) {
+				return;
+			}
+		}
+
+		static std::ofstream file = [] {
+			std::ofstream result{};
+			if (auto path = SKSE::log::log_directory()) {
+				*path /= Version::PROJECT;
+				*path += ".trace.json"sv;
+
+				result.open(*path, std::ios::binary | std::ios::trunc);
+				// Array format of Chrome traces doesn't require closing bracket, so the trace stays valid between flushes.
+				result << "[\n";
+				logger::info("Tracing to {}", path->string());
+			}
+			return result;
+		}();
+
+		if (file.is_open()) {
+			file << Drain();
+			file.flush();
+		}
+	}
+}
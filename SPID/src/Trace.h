@@ -0,0 +1,131 @@
+#pragma once
+
+#if defined(_M_X64) || defined(__x86_64__)
+#	ifdef _MSC_VER
+#		include <intrin.h>
+#	else
+#		include <x86intrin.h>
+#	endif
+#endif
+
+/// <summary>
+/// Scoped zones that record how long hooks and phases of SPID take, to be viewed in chrome://tracing or Perfetto.
+///
+/// Zones are only compiled in when SPID_TRACE is defined (see SPID_TRACE option in CMake), otherwise TRACE_ZONE expands to nothing.
+/// Zones are timed with the CPU's timestamp counter, which is cheaper to read than steady_clock, and ticks are converted to time when they are drained.
+/// Every thread records finished zones into its own fixed-size ring buffer without locking, and Flush drains all buffers into
+/// po3_SpellPerkItemDistributor.trace.json next to the log. Zones that don't fit into a full buffer are dropped and counted.
+/// </summary>
+namespace Trace
+{
+	using clock = std::chrono::steady_clock;
+
+	/// Current value of timestamp counter, or ns of steady_clock on CPUs without one.
+	inline std::uint64_t Now()
+	{
+#if defined(_M_X64) || defined(__x86_64__)
+		return __rdtsc();
+#else
+		return static_cast<std::uint64_t>(clock::now().time_since_epoch().count());
+#endif
+	}
+
+	/// A finished zone. Times are in ticks of Now().
+	struct Event
+	{
+		const char*   name{ nullptr };  // must be a string literal
+		std::uint64_t start{ 0 };
+		std::uint64_t end{ 0 };
+	};
+
+	/// <summary>
+	/// Fixed-size queue with a single producer and a single consumer, neither of which ever blocks.
+	/// </summary>
+	template <class T, std::size_t N>
+	class RingBuffer
+	{
+		static_assert(std::has_single_bit(N), "capacity must be a power of two");
+
+	public:
+		/// Called by the producer. Returns false if the buffer is full.
+		bool TryPush(const T& a_value)
+		{
+			const auto head = this->head.load(std::memory_order_relaxed);
+			if (head - tail.load(std::memory_order_acquire) == N) {
+				dropped.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+			items[head & (N - 1)] = a_value;
+			this->head.store(head + 1, std::memory_order_release);
+			return true;
+		}
+
+		/// Called by the consumer. Invokes a_func for every item that was pushed so far, oldest first, and returns their number.
+		template <class Func>
+		std::size_t Drain(Func&& a_func)
+		{
+			const auto tail = this->tail.load(std::memory_order_relaxed);
+			const auto head = this->head.load(std::memory_order_acquire);
+			for (auto i = tail; i != head; ++i) {
+				a_func(items[i & (N - 1)]);
+			}
+			this->tail.store(head, std::memory_order_release);
+			return static_cast<std::size_t>(head - tail);
+		}
+
+		/// Number of items that were dropped because the buffer was full.
+		[[nodiscard]] std::uint64_t GetDropped() const { return dropped.load(std::memory_order_relaxed); }
+
+		static constexpr std::size_t capacity = N;
+
+	private:
+		std::array<T, N> items{};
+
+		// Producer and consumer update different cache lines.
+		alignas(64) std::atomic<std::uint64_t> head{ 0 };
+		alignas(64) std::atomic<std::uint64_t> tail{ 0 };
+		std::atomic<std::uint64_t>             dropped{ 0 };
+	};
+
+	/// Records a finished zone into the buffer of calling thread.
+	void Record(const char* a_name, std::uint64_t a_start, std::uint64_t a_end);
+
+	/// <summary>
+	/// Drains buffers of all threads and formats drained zones as events of Chrome trace format, one per line and each followed by a comma.
+	/// Threads that record for the first time are also named with metadata events.
+	/// </summary>
+	[[nodiscard]] std::string Drain();
+
+	/// <summary>
+	/// Appends drained zones to the trace next to the log, creating it on first flush. Does nothing if no zones were ever recorded.
+	/// </summary>
+	void Flush();
+
+	/// Records time between its construction and destruction as a zone.
+	class Zone
+	{
+	public:
+		explicit Zone(const char* a_name) :
+			name(a_name),
+			start(Now())
+		{}
+
+		~Zone() { Record(name, start, Now()); }
+
+		Zone(const Zone&) = delete;
+		Zone& operator=(const Zone&) = delete;
+
+	private:
+		const char*   name;
+		std::uint64_t start;
+	};
+}
+
+#define TRACE_CONCAT_IMPL(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_IMPL(a, b)
+
+#ifdef SPID_TRACE
+#	define TRACE_ZONE(name) const ::Trace::Zone TRACE_CONCAT(traceZone, __LINE__)(name)
+#else
+#	define TRACE_ZONE(name) ((void)0)
+#endif
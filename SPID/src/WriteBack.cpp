@@ -0,0 +1,197 @@
+#include "WriteBack.h"
+
+namespace Distribution::INI::WriteBack
+{
+	namespace detail
+	{
+		/// Thread that writes queued files. It is joined by Wait, or before the next one is started.
+		struct Writer
+		{
+			// Other threads are already terminated by the time statics are destroyed on exit, so there's nothing left to join.
+			~Writer()
+			{
+				if (thread.joinable()) {
+					thread.detach();
+				}
+			}
+
+			std::thread thread{};
+		};
+
+		Lock                            lock;
+		StringMap<std::vector<Rewrite>> queue{};
+		bool                            isWriting{ false };
+		Writer                          writer{};
+
+		/// Replaces a_path with a_contents, so that the file is either fully written or left untouched.
+		std::expected<void, std::string> write_atomically(const std::string& a_path, std::string_view a_contents)
+		{
+			const auto tempPath = a_path + ".tmp";
+
+			std::error_code ec;
+			{
+				std::ofstream output(tempPath, std::ios::binary | std::ios::trunc);
+				if (!output) {
+					return std::unexpected("couldn't create temporary file");
+				}
+
+				output.write(a_contents.data(), static_cast<std::streamsize>(a_contents.size()));
+
+				if (!output.flush()) {
+					output.close();
+					std::filesystem::remove(tempPath, ec);
+					return std::unexpected("couldn't write temporary file");
+				}
+			}
+
+			std::filesystem::rename(tempPath, a_path, ec);
+			if (ec) {
+				std::filesystem::remove(tempPath, ec);
+				return std::unexpected(fmt::format("couldn't replace file ({})", ec.message()));
+			}
+
+			return {};
+		}
+
+		/// <summary>
+		/// Replaces original values of given entries with sanitized ones. Returns number of replaced entries.
+		/// The file is loaded with CSimpleIniA, which keeps comments and the rest of the file intact.
+		/// </summary>
+		std::expected<std::size_t, std::string> write(const std::string& a_path, std::vector<Rewrite>& a_rewrites)
+		{
+			CSimpleIniA ini;
+			ini.SetUnicode();
+			ini.SetMultiKey();
+
+			if (const auto rc = ini.LoadFile(a_path.c_str()); rc < 0) {
+				return std::unexpected("couldn't read INI");
+			}
+
+			const auto values = ini.GetSection("");
+			if (!values) {
+				return 0;
+			}
+
+			std::vector<std::pair<CSimpleIniA::Entry, const char*>> entries(values->begin(), values->end());
+			std::ranges::sort(entries, CSimpleIniA::Entry::LoadOrder(), [](const auto& a_entry) { return a_entry.first; });
+			std::ranges::sort(a_rewrites, {}, &Rewrite::offset);
+
+			// Each rewrite is matched with CSimpleIniA's entry (and with it, the comment) that has the same key and original value.
+			// Both are walked in file order, so that identical entries are matched in the order they appear.
+			// Entries that were edited since they were parsed don't match and are left as they are, without affecting other rewrites.
+			std::vector<const Rewrite*> pending{};
+			pending.reserve(a_rewrites.size());
+			for (const auto& rewrite : a_rewrites) {
+				pending.push_back(&rewrite);
+			}
+
+			std::vector<std::pair<CSimpleIniA::Entry, const Rewrite*>> matched;
+			for (const auto& [key, value] : entries) {
+				if (pending.empty()) {
+					break;
+				}
+				const auto rewrite = std::ranges::find_if(pending, [&](const Rewrite* a_rewrite) {
+					return a_rewrite->key == key.pItem && a_rewrite->original == value;
+				});
+				if (rewrite != pending.end()) {
+					matched.emplace_back(key, *rewrite);
+					pending.erase(rewrite);
+				}
+			}
+
+			if (matched.empty()) {
+				return 0;
+			}
+
+			for (const auto& [key, match] : matched) {
+				ini.DeleteValue("", key.pItem, match->original.c_str());
+				ini.SetValue("", key.pItem, match->sanitized.c_str(), key.pComment, false);
+			}
+
+			std::string contents;
+			if (const auto rc = ini.Save(contents, true); rc < 0) {
+				return std::unexpected("couldn't serialize INI");
+			}
+
+			if (const auto written = write_atomically(a_path, contents); !written) {
+				return std::unexpected(written.error());
+			}
+
+			return matched.size();
+		}
+
+		/// Writes queued files until the queue is empty.
+		void write_all()
+		{
+			Timer timer;
+			timer.start();
+
+			std::size_t files = 0;
+			std::size_t entries = 0;
+
+			while (true) {
+				StringMap<std::vector<Rewrite>> batch;
+				{
+					WriteLocker locker(lock);
+					if (queue.empty()) {
+						isWriting = false;
+						break;
+					}
+					batch = std::exchange(queue, {});
+				}
+
+				for (auto& [path, rewrites] : batch) {
+					if (const auto written = write(path, rewrites); written) {
+						files += *written ? 1 : 0;
+						entries += *written;
+					} else {
+						logger::warn("Failed to sanitize {}: {}", path, written.error());
+					}
+				}
+			}
+
+			timer.end();
+
+			logger::info("Sanitized {} entries in {} inis, write-back took {}μs / {}ms", entries, files, timer.duration_μs(), timer.duration_ms());
+		}
+	}
+
+	void Enqueue(const std::string& a_path, std::vector<Rewrite> a_rewrites)
+	{
+		WriteLocker locker(detail::lock);
+		detail::queue.insert_or_assign(a_path, std::move(a_rewrites));
+	}
+
+	void Flush()
+	{
+		using namespace detail;
+
+		WriteLocker locker(lock);
+		if (queue.empty() || isWriting) {
+			return;
+		}
+
+		// The previous writer has finished by now, since it stops writing once the queue is empty.
+		if (writer.thread.joinable()) {
+			writer.thread.join();
+		}
+
+		isWriting = true;
+		writer.thread = std::thread(write_all);
+	}
+
+	void Wait()
+	{
+		using namespace detail;
+
+		// The thread is joined without holding the lock, since it needs the lock to finish.
+		std::thread thread;
+		{
+			WriteLocker locker(lock);
+			thread = std::move(writer.thread);
+		}
+		if (thread.joinable()) {
+			thread.join();
+		}
+	}
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+namespace Distribution::INI
+{
+	/// <summary>
+	/// Asynchronous write-back of sanitized entries into config files.
+	///
+	/// Parsing only queues entries whose values changed after sanitizing. Queued changes are grouped per file and written
+	/// on a background thread once parsing is done, so that slow file systems (e.g. MO2's VFS) don't delay startup.
+	/// Each file is written atomically: new contents go to a temporary file, which then replaces the original.
+	///
+	/// Write-back can be disabled in settings (see Settings::sanitizeConfigs), in which case entries are only reported in the log.
+	/// </summary>
+	namespace WriteBack
+	{
+		/// Entry whose sanitized value must be written back to its file.
+		struct Rewrite
+		{
+			std::size_t offset{ 0 };  // position of the entry in the file
+			std::string key{};
+			std::string original{};
+			std::string sanitized{};
+		};
+
+		/// <summary>
+		/// Queues rewrites of a single file. Thread-safe.
+		/// Rewrites replace those that are still queued for the same file, since they come from a newer read of it.
+		/// </summary>
+		void Enqueue(const std::string& a_path, std::vector<Rewrite> a_rewrites);
+
+		/// <summary>
+		/// Starts writing all queued files on a background thread, unless it's already running.
+		/// Logs how long writing took once the queue is empty.
+		/// </summary>
+		void Flush();
+
+		/// <summary>
+		/// Waits until the background thread started by Flush is done writing.
+		/// </summary>
+		void Wait();
+	}
+}
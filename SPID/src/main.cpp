@@ -1,9 +1,19 @@
+#include "AsyncLogSink.h"
 #include "DeathDistribution.h"
 #include "DistributeManager.h"
+#include "DistributionJournal.h"
+#include "HotReload.h"
+#include "Latency.h"
 #include "LookupConfigs.h"
 #include "LookupForms.h"
 #include "Outfits/OutfitManager.h"
 #include "PCLevelMultManager.h"
+#include "Profiler.h"
+#include "SessionCapture.h"
+#include "Settings.h"
+#include "Shadow.h"
+#include "Trace.h"
+#include "WriteBack.h"
 #ifndef NDEBUG
 #	include "Testing/OutfitManagerTests.h"
 #	include "Testing/DistributionTests.h"
@@ -57,8 +67,20 @@ void MessageHandler(SKSE::MessagingInterface::Message* a_message)
 		{
 			if (shouldDistribute = Lookup::LookupForms(); shouldDistribute) {
 				Distribute::Setup();
+				Distribution::HotReload::Start();
+				Distribution::Capture::Start();
+				Distribution::Journal::Start();
+				Distribute::Shadow::SetEnabled(Settings::GetSingleton()->shadowEvaluation);
+				Distribute::Profiler::SetEnabled(Settings::GetSingleton()->profileEntries);
+				Latency::SetEnabled(Settings::GetSingleton()->latencyStats);
 			}
 
+			// Sanitized configs are written back while game data loads, so this rarely waits.
+			Distribution::INI::WriteBack::Wait();
+
+			// Startup phases are done by now.
+			Trace::Flush();
+
 			if (shouldLogErrors) {
 				const auto error = std::format("[SPID] Errors found when reading configs. Check {}.log in {} for more info\n", Version::PROJECT, SKSE::log::log_directory()->string());
 				RE::ConsoleLog::GetSingleton()->Print(error.c_str());
@@ -80,6 +102,15 @@ void MessageHandler(SKSE::MessagingInterface::Message* a_message)
 			}
 		}
 		break;
+	case SKSE::MessagingInterface::kSaveGame:
+		Distribution::Capture::Flush();
+		Distribution::Journal::Flush();
+		Distribute::Shadow::LogStats();
+		Distribute::Profiler::Dump();
+		Latency::Dump();
+		Trace::Flush();
+		spdlog::default_logger_raw()->flush();
+		break;
 	default:
 		break;
 	}
@@ -139,6 +170,37 @@ extern "C" DLLEXPORT bool SKSEAPI SKSEPlugin_Query(const SKSE::QueryInterface* a
 }
 #endif
 
+namespace CrashLog
+{
+	std::shared_ptr<Log::AsyncFileSink> sink{};
+	LPTOP_LEVEL_EXCEPTION_FILTER        previousFilter{ nullptr };
+
+	// Writes queued log messages when the game crashes, so that the log shows everything SPID did up to the crash.
+	// It's a last-chance filter, so it only runs for exceptions that nothing else handled, and then passes them on to whoever was installed before.
+	// Stack overflow is skipped, since writing the log needs stack that isn't there. Locks are only awaited briefly, in case the crashed thread holds them.
+	LONG WINAPI DrainOnCrash(EXCEPTION_POINTERS* a_exception)
+	{
+		if (sink && a_exception->ExceptionRecord->ExceptionCode != EXCEPTION_STACK_OVERFLOW) {
+			(void)sink->Drain(std::chrono::milliseconds(200));
+		}
+		return previousFilter ? previousFilter(a_exception) : EXCEPTION_CONTINUE_SEARCH;
+	}
+
+	void Install(std::shared_ptr<Log::AsyncFileSink> a_sink)
+	{
+		sink = std::move(a_sink);
+		previousFilter = SetUnhandledExceptionFilter(DrainOnCrash);
+	}
+
+	void Uninstall()
+	{
+		// Filters installed after this one call it in turn, so those are left in place.
+		if (const auto current = SetUnhandledExceptionFilter(previousFilter); current != DrainOnCrash) {
+			SetUnhandledExceptionFilter(current);
+		}
+	}
+}
+
 void InitializeLog()
 {
 	auto path = SKSE::log::log_directory();
@@ -148,26 +210,22 @@ void InitializeLog()
 
 	*path /= Version::PROJECT;
 	*path += ".log"sv;
-	auto sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(path->string(), true);
+	// Lines are written by a background thread and flushed once a second, so that logging doesn't stall distribution on slow disks.
+	auto sink = std::make_shared<Log::AsyncFileSink>(*path, true, std::chrono::seconds(1));
+	CrashLog::Install(sink);
 
 	auto log = std::make_shared<spdlog::logger>("global log"s, std::move(sink));
 
-	constexpr auto settingsPath = "Data\\SKSE\\Plugins\\po3_SpellPerkItemDistributor.ini";
-	std::string    logLevelStr{ "info" };
+	const auto settings = Settings::GetSingleton();
+	settings->Load();
 
-	CSimpleIniA ini;
-	ini.SetUnicode();
-	ini.LoadFile(settingsPath);
-	clib_util::ini::get_value(ini, logLevelStr, "Log", "LogLevel", ";  Log level for SPID. Valid values: trace, debug, info, warn, error, critical.\n;  Use 'debug' to enable verbose per-NPC/outfit distribution logging.");
-	(void)ini.SaveFile(settingsPath);
-
-	auto logLevel = spdlog::level::from_str(logLevelStr);
-	if (logLevel == spdlog::level::off) {
-		logLevel = spdlog::level::info;
-	}
+	const auto logLevel = settings->logLevel;
 
 	log->set_level(logLevel);
-	log->flush_on(logLevel);
+	// Errors are flushed right away, in case they precede a crash.
+	log->flush_on(spdlog::level::err);
+
+	buffered_logger::SetCapacity(settings->maxBufferedMessages);
 
 	spdlog::set_default_logger(std::move(log));
 	spdlog::set_pattern("[%H:%M:%S:%e] %v"s);
@@ -191,5 +249,16 @@ extern "C" DLLEXPORT bool SKSEAPI SKSEPlugin_Load(const SKSE::LoadInterface* a_s
 
 	SKSE::GetMessagingInterface()->RegisterListener(MessageHandler);
 
+	// Configs don't depend on game data, so they're parsed while the game is starting up and collected at kPostLoad.
+	Distribution::INI::StartParsingConfigs();
+
 	return true;
 }
+
+BOOL APIENTRY DllMain(HMODULE, DWORD a_reason, LPVOID)
+{
+	if (a_reason == DLL_PROCESS_DETACH) {
+		CrashLog::Uninstall();
+	}
+	return TRUE;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+// A stand-in for the parts of CLibUtil's distribution helpers that SPID uses.
+
+#include "ClibUtil/string.hpp"
+
+namespace clib_util::distribution
+{
+	using formid_pair = std::pair<std::optional<RE::FormID>, std::optional<std::string>>;
+	using record = std::variant<formid_pair, std::string>;
+
+	inline bool is_valid_entry(const std::string& a_str)
+	{
+		return !a_str.empty() && !string::icontains(a_str, "NONE");
+	}
+
+	inline bool is_mod_name(std::string_view a_str)
+	{
+		const auto endsWith = [&](std::string_view a_extension) {
+			return a_str.size() >= a_extension.size() && string::iequals(a_str.substr(a_str.size() - a_extension.size()), a_extension);
+		};
+		return endsWith(".esp") || endsWith(".esl") || endsWith(".esm");
+	}
+
+	/// Splits a record into formID~modName, modName, 0xFormID or editorID.
+	inline record get_record(const std::string& a_str)
+	{
+		if (const auto tilde = a_str.find('~'); tilde != std::string::npos) {
+			return formid_pair{ string::to_num<RE::FormID>(a_str.substr(0, tilde), true), a_str.substr(tilde + 1) };
+		}
+		if (is_mod_name(a_str)) {
+			return formid_pair{ std::nullopt, a_str };
+		}
+		if (string::is_only_hex(a_str)) {
+			return formid_pair{ string::to_num<RE::FormID>(a_str, true), std::nullopt };
+		}
+		return a_str;
+	}
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+// A stand-in for CLibUtil's editorID helpers. Mock forms always keep their editorIDs, as if powerofthree's Tweaks were installed.
+
+namespace clib_util::editorID
+{
+	inline std::string get_editorID(const RE::TESForm* a_form)
+	{
+		if (!a_form) {
+			return {};
+		}
+		const auto editorID = a_form->GetFormEditorID();
+		return editorID ? editorID : std::string{};
+	}
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+// A stand-in for CLibUtil's RNG. Same seed gives the same sequence on every platform, which deterministic chance relies on.
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <type_traits>
+
+namespace clib_util
+{
+	/// xoshiro256** seeded with splitmix64.
+	class RNG
+	{
+	public:
+		using result_type = std::uint64_t;
+
+		explicit RNG(std::uint64_t a_seed) { seed(a_seed); }
+		RNG() :
+			RNG(static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count()))
+		{}
+
+		static constexpr result_type min() { return 0; }
+		static constexpr result_type max() { return UINT64_MAX; }
+
+		result_type operator()()
+		{
+			const auto result = rotl(state[1] * 5, 7) * 9;
+			const auto t = state[1] << 17;
+
+			state[2] ^= state[0];
+			state[3] ^= state[1];
+			state[1] ^= state[2];
+			state[0] ^= state[3];
+			state[2] ^= t;
+			state[3] = rotl(state[3], 45);
+
+			return result;
+		}
+
+		/// Uniformly distributed number in [a_min; a_max].
+		template <class T>
+		T generate(T a_min, T a_max)
+		{
+			if constexpr (std::is_floating_point_v<T>) {
+				return std::uniform_real_distribution<T>(a_min, a_max)(*this);
+			} else {
+				// uniform_int_distribution doesn't accept 1-byte integers.
+				using Wide = std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>;
+				return static_cast<T>(std::uniform_int_distribution<Wide>(a_min, a_max)(*this));
+			}
+		}
+
+		/// Uniformly distributed number in [0; 1).
+		double generate()
+		{
+			return static_cast<double>((*this)() >> 11) * 0x1.0p-53;
+		}
+
+	private:
+		static constexpr std::uint64_t rotl(std::uint64_t a_value, int a_shift)
+		{
+			return (a_value << a_shift) | (a_value >> (64 - a_shift));
+		}
+
+		void seed(std::uint64_t a_seed)
+		{
+			for (auto& value : state) {
+				a_seed += 0x9E3779B97F4A7C15;
+				auto z = a_seed;
+				z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+				z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+				value = z ^ (z >> 31);
+			}
+		}
+
+		std::uint64_t state[4]{};
+	};
+}
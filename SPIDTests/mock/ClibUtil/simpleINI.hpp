@@ -0,0 +1,3 @@
+#pragma once
+
+// INI settings aren't part of the core.
@@ -0,0 +1,24 @@
+#pragma once
+
+namespace clib_util::singleton
+{
+	template <class T>
+	class ISingleton
+	{
+	public:
+		static T* GetSingleton()
+		{
+			static T singleton;
+			return std::addressof(singleton);
+		}
+
+	protected:
+		ISingleton() = default;
+		~ISingleton() = default;
+
+		ISingleton(const ISingleton&) = delete;
+		ISingleton(ISingleton&&) = delete;
+		ISingleton& operator=(const ISingleton&) = delete;
+		ISingleton& operator=(ISingleton&&) = delete;
+	};
+}
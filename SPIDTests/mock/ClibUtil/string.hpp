@@ -0,0 +1,104 @@
+#pragma once
+
+// A stand-in for the parts of CLibUtil's string helpers that SPID uses.
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace clib_util::string
+{
+	namespace literals
+	{}
+
+	/// Throws std::invalid_argument or std::out_of_range if a_str isn't a number.
+	template <class T>
+	T to_num(const std::string& a_str, bool a_hex = false)
+	{
+		const int base = a_hex ? 16 : 10;
+
+		if constexpr (std::is_same_v<T, double>) {
+			return std::stod(a_str);
+		} else if constexpr (std::is_same_v<T, float>) {
+			return std::stof(a_str);
+		} else if constexpr (std::is_same_v<T, std::int64_t>) {
+			return static_cast<T>(std::stoll(a_str, nullptr, base));
+		} else if constexpr (std::is_same_v<T, std::uint64_t>) {
+			return static_cast<T>(std::stoull(a_str, nullptr, base));
+		} else if constexpr (std::is_signed_v<T>) {
+			return static_cast<T>(std::stoi(a_str, nullptr, base));
+		} else {
+			return static_cast<T>(std::stoul(a_str, nullptr, base));
+		}
+	}
+
+	inline std::vector<std::string> split(const std::string& a_str, std::string_view a_delimiter)
+	{
+		std::vector<std::string> result;
+		for (auto&& section : a_str | std::views::split(a_delimiter)) {
+			result.emplace_back(section.begin(), section.end());
+		}
+		return result;
+	}
+
+	inline std::string join(const std::vector<std::string>& a_vec, std::string_view a_delimiter)
+	{
+		std::string result;
+		for (std::size_t i = 0; i < a_vec.size(); ++i) {
+			if (i > 0) {
+				result += a_delimiter;
+			}
+			result += a_vec[i];
+		}
+		return result;
+	}
+
+	inline std::string trim_copy(std::string a_str)
+	{
+		const auto isSpace = [](unsigned char a_char) { return std::isspace(a_char) != 0; };
+		a_str.erase(std::ranges::find_if_not(a_str.rbegin(), a_str.rend(), isSpace).base(), a_str.end());
+		a_str.erase(a_str.begin(), std::ranges::find_if_not(a_str, isSpace));
+		return a_str;
+	}
+
+	/// Replaces everything but letters and digits with spaces and trims the result.
+	inline std::string remove_non_alphanumeric(std::string& a_str)
+	{
+		std::ranges::replace_if(a_str, [](unsigned char a_char) { return std::isalnum(a_char) == 0; }, ' ');
+		return trim_copy(a_str);
+	}
+
+	inline bool is_empty(const char* a_str)
+	{
+		return a_str == nullptr || a_str[0] == '\0';
+	}
+
+	inline bool iequals(std::string_view a_lhs, std::string_view a_rhs)
+	{
+		return std::ranges::equal(a_lhs, a_rhs, [](unsigned char a, unsigned char b) { return std::tolower(a) == std::tolower(b); });
+	}
+
+	inline bool icontains(std::string_view a_str, std::string_view a_substr)
+	{
+		if (a_substr.empty()) {
+			return false;
+		}
+		return !std::ranges::search(a_str, a_substr, [](unsigned char a, unsigned char b) { return std::tolower(a) == std::tolower(b); }).empty();
+	}
+
+	inline bool is_only_hex(std::string_view a_str, bool a_requirePrefix = true)
+	{
+		if (a_requirePrefix) {
+			if (!a_str.starts_with("0x") && !a_str.starts_with("0X")) {
+				return false;
+			}
+			a_str.remove_prefix(2);
+		}
+		return !a_str.empty() && std::ranges::all_of(a_str, [](unsigned char a_char) { return std::isxdigit(a_char) != 0; });
+	}
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+// Interface of Merge Mapper. Nothing is merged in tests, so g_mergeMapperInterface stays null (see Mock.cpp).
+
+#include <cstdint>
+#include <utility>
+
+namespace MergeMapperPluginAPI
+{
+	class IMergeMapperInterface001
+	{
+	public:
+		virtual ~IMergeMapperInterface001() = default;
+
+		virtual std::pair<const char*, std::uint32_t> GetOriginalFormID(const char* a_modName, std::uint32_t a_formID) = 0;
+		virtual std::pair<const char*, std::uint32_t> GetNewFormID(const char* a_oldName, std::uint32_t a_oldFormID) = 0;
+
+		virtual bool isMerge(const char* a_modName) = 0;
+		virtual bool wasMerged(const char* a_modName) = 0;
+
+		virtual std::uint32_t GetBuildNumber() = 0;
+	};
+}
+
+extern MergeMapperPluginAPI::IMergeMapperInterface001* g_mergeMapperInterface;
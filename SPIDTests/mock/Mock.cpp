@@ -0,0 +1,34 @@
+// Definitions for parts of SPID that the core depends on, but which only make sense in the game.
+
+#include "LookupConfigs.h"
+#include "Outfits/OutfitManager.h"
+
+MergeMapperPluginAPI::IMergeMapperInterface001* g_mergeMapperInterface = nullptr;
+
+namespace Distribution::INI
+{
+	// Sources are only tracked for hot reload.
+	std::uint64_t GetSourceID(const Data&)
+	{
+		return 0;
+	}
+}
+
+namespace Outfits
+{
+	// Mock actors don't wear anything, so there is nothing to unequip.
+	bool Manager::RevertOutfit(RE::Actor*, const OutfitReplacement&) const
+	{
+		return true;
+	}
+
+	RE::BSEventNotifyControl Manager::ProcessEvent(const RE::TESFormDeleteEvent*, RE::BSTEventSource<RE::TESFormDeleteEvent>*)
+	{
+		return RE::BSEventNotifyControl::kContinue;
+	}
+
+	RE::BSEventNotifyControl Manager::ProcessEvent(const RE::TESDeathEvent*, RE::BSTEventSource<RE::TESDeathEvent>*)
+	{
+		return RE::BSEventNotifyControl::kContinue;
+	}
+}
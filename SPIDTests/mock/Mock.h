@@ -0,0 +1,68 @@
+#pragma once
+
+// Helpers for building a game world out of mock forms (see RE/Skyrim.h).
+
+namespace Mock
+{
+	/// Removes all forms and plugins.
+	inline void Reset()
+	{
+		RE::TESDataHandler::GetSingleton()->Clear();
+	}
+
+	/// Adds a plugin. Plugins are loaded in the order they were added.
+	inline RE::TESFile* AddFile(std::string_view a_name)
+	{
+		return RE::TESDataHandler::GetSingleton()->AddFile(a_name);
+	}
+
+	/// Returns a plugin with given name, adding it if it wasn't loaded yet.
+	inline RE::TESFile* GetFile(std::string_view a_name)
+	{
+		const auto dataHandler = RE::TESDataHandler::GetSingleton();
+		if (const auto file = dataHandler->LookupModByName(a_name)) {
+			return const_cast<RE::TESFile*>(file);
+		}
+		return dataHandler->AddFile(a_name);
+	}
+
+	/// <summary>
+	/// Creates a form with exact formID, e.g. to rebuild forms that were recorded in the game. a_file can be null for dynamic forms.
+	/// </summary>
+	template <class Form>
+	Form* Create(RE::FormID a_formID, std::string_view a_editorID, RE::TESFile* a_file)
+	{
+		auto form = std::make_unique<Form>();
+		form->formID = a_formID;
+		form->file = a_file;
+		if (!a_editorID.empty()) {
+			form->SetFormEditorID(std::string(a_editorID).c_str());
+		}
+
+		const auto result = form.get();
+		RE::TESDataHandler::GetSingleton()->RegisterForm(std::move(form));
+		return result;
+	}
+
+	/// <summary>
+	/// Creates a form in a_file (Skyrim.esm by default). Local formIDs are assigned in creation order starting from 0x800.
+	/// </summary>
+	template <class Form>
+	Form* Create(std::string_view a_editorID = {}, RE::TESFile* a_file = nullptr)
+	{
+		const auto dataHandler = RE::TESDataHandler::GetSingleton();
+		const auto file = a_file ? a_file : GetFile("Skyrim.esm");
+
+		const auto localFormID = std::max<RE::FormID>(0x800, dataHandler->nextLocalFormIDs[file->compileIndex]);
+
+		return Create<Form>((file->compileIndex << 24) | localFormID, a_editorID, file);
+	}
+
+	/// Creates an actor of given NPC.
+	inline RE::Actor* CreateActor(RE::TESNPC* a_npc, std::string_view a_editorID = {})
+	{
+		const auto actor = Create<RE::Actor>(a_editorID);
+		actor->data.objectReference = a_npc;
+		return actor;
+	}
+}
@@ -0,0 +1,1281 @@
+#pragma once
+
+// A minimal stand-in for CommonLibSSE that lets game-independent parts of SPID build on any platform.
+//
+// Only the parts of forms that SPID reads or writes are modeled and they're plain data:
+// there is no game behind them, so forms are created and wired together by tests (see Mock.h).
+// Names, members and signatures follow CommonLibSSE, so that SPID sources compile unchanged.
+
+// Like CommonLib, this brings in most of the standard library.
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <queue>
+#include <random>
+#include <set>
+#include <shared_mutex>
+#include <source_location>
+#include <span>
+#include <sstream>
+#include <stack>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+namespace RE
+{
+	using FormID = std::uint32_t;
+
+	enum class FormType : std::uint8_t
+	{
+		None = 0,
+		Keyword = 4,
+		Class = 10,
+		Faction = 11,
+		Race = 14,
+		Spell = 22,
+		Armor = 26,
+		Book = 27,
+		Misc = 32,
+		Weapon = 41,
+		NPC = 43,
+		LeveledItem = 53,
+		Reference = 62,
+		ActorCharacter = 63,
+		Package = 75,
+		CombatStyle = 76,
+		LeveledSpell = 78,
+		FormList = 86,
+		Perk = 87,
+		VoiceType = 93,
+		Armature = 97,
+		Location = 99,
+		Shout = 114,
+		Outfit = 119,
+	};
+
+	inline std::string_view FormTypeToString(FormType a_type)
+	{
+		switch (a_type) {
+		case FormType::Keyword:
+			return "KYWD";
+		case FormType::Class:
+			return "CLAS";
+		case FormType::Faction:
+			return "FACT";
+		case FormType::Race:
+			return "RACE";
+		case FormType::Spell:
+			return "SPEL";
+		case FormType::Armor:
+			return "ARMO";
+		case FormType::Book:
+			return "BOOK";
+		case FormType::Misc:
+			return "MISC";
+		case FormType::Weapon:
+			return "WEAP";
+		case FormType::NPC:
+			return "NPC_";
+		case FormType::LeveledItem:
+			return "LVLI";
+		case FormType::Reference:
+			return "REFR";
+		case FormType::ActorCharacter:
+			return "ACHR";
+		case FormType::Package:
+			return "PACK";
+		case FormType::CombatStyle:
+			return "CSTY";
+		case FormType::LeveledSpell:
+			return "LVSP";
+		case FormType::FormList:
+			return "FLST";
+		case FormType::Perk:
+			return "PERK";
+		case FormType::VoiceType:
+			return "VTYP";
+		case FormType::Armature:
+			return "ARMA";
+		case FormType::Location:
+			return "LCTN";
+		case FormType::Shout:
+			return "SHOU";
+		case FormType::Outfit:
+			return "OTFT";
+		default:
+			return "NONE";
+		}
+	}
+
+	enum class SEX : std::uint32_t
+	{
+		kNone = static_cast<std::uint32_t>(-1),
+		kMale = 0,
+		kFemale = 1,
+	};
+
+	enum class BSEventNotifyControl : std::uint32_t
+	{
+		kContinue = 0,
+		kStop = 1,
+	};
+
+	namespace BSContainer
+	{
+		enum class ForEachResult
+		{
+			kStop = 0,
+			kContinue = 1,
+		};
+	}
+
+	using BSFixedString = std::string;
+
+	template <class T>
+	class BSTArray : public std::vector<T>
+	{
+	public:
+		using std::vector<T>::vector;
+	};
+
+	template <class T>
+	class BSScrapArray : public std::vector<T>
+	{
+	public:
+		using std::vector<T>::vector;
+	};
+
+	template <class T>
+	class BSSimpleList : public std::list<T>
+	{
+	public:
+		using std::list<T>::list;
+
+		/// Inserts a_value before element at a_index, or appends it if a_index is past the end.
+		void insert_at(std::size_t a_index, const T& a_value)
+		{
+			auto it = this->begin();
+			std::advance(it, std::min(a_index, this->size()));
+			this->insert(it, a_value);
+		}
+	};
+
+	/// Recursive for writers, like the game's lock: a thread that holds the write lock can lock it again.
+	class BSReadWriteLock
+	{
+	public:
+		void LockForRead() { mutex.lock_shared(); }
+		void UnlockForRead() { mutex.unlock_shared(); }
+
+		void LockForWrite()
+		{
+			const auto self = std::this_thread::get_id();
+			if (owner.load(std::memory_order_acquire) == self) {
+				++depth;
+				return;
+			}
+			mutex.lock();
+			owner.store(self, std::memory_order_release);
+			depth = 1;
+		}
+
+		void UnlockForWrite()
+		{
+			if (--depth == 0) {
+				owner.store({}, std::memory_order_release);
+				mutex.unlock();
+			}
+		}
+
+	private:
+		std::shared_mutex            mutex;
+		std::atomic<std::thread::id> owner{};
+		std::uint32_t                depth{ 0 };
+	};
+
+	class BSReadLockGuard
+	{
+	public:
+		explicit BSReadLockGuard(BSReadWriteLock& a_lock) :
+			lock(a_lock)
+		{
+			lock.LockForRead();
+		}
+		~BSReadLockGuard() { lock.UnlockForRead(); }
+
+		BSReadLockGuard(const BSReadLockGuard&) = delete;
+		BSReadLockGuard& operator=(const BSReadLockGuard&) = delete;
+
+	private:
+		BSReadWriteLock& lock;
+	};
+
+	class BSWriteLockGuard
+	{
+	public:
+		explicit BSWriteLockGuard(BSReadWriteLock& a_lock) :
+			lock(a_lock)
+		{
+			lock.LockForWrite();
+		}
+		~BSWriteLockGuard() { lock.UnlockForWrite(); }
+
+		BSWriteLockGuard(const BSWriteLockGuard&) = delete;
+		BSWriteLockGuard& operator=(const BSWriteLockGuard&) = delete;
+
+	private:
+		BSReadWriteLock& lock;
+	};
+
+	template <class T>
+	class NiPointer
+	{
+	public:
+		NiPointer() = default;
+		NiPointer(T* a_ptr) :
+			ptr(a_ptr)
+		{}
+
+		T* get() const { return ptr; }
+		T* operator->() const { return ptr; }
+		T& operator*() const { return *ptr; }
+		explicit operator bool() const { return ptr != nullptr; }
+
+	private:
+		T* ptr{ nullptr };
+	};
+
+	class NiAVObject
+	{};
+
+	template <class Event>
+	class BSTEventSource;
+
+	template <class Event>
+	class BSTEventSink
+	{
+	public:
+		virtual ~BSTEventSink() = default;
+		virtual BSEventNotifyControl ProcessEvent(const Event* a_event, BSTEventSource<Event>* a_eventSource) = 0;
+	};
+
+	template <class Event>
+	class BSTEventSource
+	{
+	public:
+		void AddEventSink(BSTEventSink<Event>* a_sink) { sinks.push_back(a_sink); }
+
+		void SendEvent(const Event* a_event)
+		{
+			for (const auto sink : sinks) {
+				if (sink->ProcessEvent(a_event, this) == BSEventNotifyControl::kStop) {
+					break;
+				}
+			}
+		}
+
+	private:
+		std::vector<BSTEventSink<Event>*> sinks;
+	};
+
+	class TESFile
+	{
+	public:
+		[[nodiscard]] std::string_view GetFilename() const { return fileName; }
+
+		[[nodiscard]] bool IsFormInMod(FormID a_formID) const { return (a_formID >> 24) == compileIndex; }
+
+		// members
+		char          fileName[260]{};
+		std::uint32_t compileIndex{ 0 };
+	};
+
+	class TESForm
+	{
+	public:
+		static constexpr auto FORMTYPE = FormType::None;
+
+		TESForm() = default;
+		explicit TESForm(FormType a_type) :
+			formType(a_type)
+		{}
+		virtual ~TESForm() = default;
+
+		[[nodiscard]] virtual const char* GetFormEditorID() const { return editorID.c_str(); }
+		virtual bool                      SetFormEditorID(const char* a_editorID)
+		{
+			editorID = a_editorID;
+			return true;
+		}
+		[[nodiscard]] virtual const char* GetName() const { return fullName.c_str(); }
+
+		[[nodiscard]] FormID   GetFormID() const { return formID; }
+		[[nodiscard]] FormType GetFormType() const { return formType; }
+		[[nodiscard]] bool     Is(FormType a_type) const { return formType == a_type; }
+		[[nodiscard]] bool     IsDynamicForm() const { return formID >= 0xFF000000; }
+
+		[[nodiscard]] TESFile* GetFile(std::int32_t = -1) const { return file; }
+		[[nodiscard]] FormID   GetLocalFormID() const { return formID & (IsDynamicForm() ? 0xFFFFFFFF : 0x00FFFFFF); }
+
+		template <class T>
+		T* As()
+		{
+			return dynamic_cast<T*>(this);
+		}
+
+		template <class T>
+		const T* As() const
+		{
+			return dynamic_cast<const T*>(this);
+		}
+
+		static TESForm* LookupByID(FormID a_formID);
+
+		template <class T>
+		static T* LookupByID(FormID a_formID)
+		{
+			const auto form = LookupByID(a_formID);
+			return form ? form->As<T>() : nullptr;
+		}
+
+		static std::pair<std::unordered_map<std::string, TESForm*>*, std::reference_wrapper<BSReadWriteLock>> GetAllFormsByEditorID();
+
+		// members
+		std::uint32_t formFlags{ 0 };
+		FormID        formID{ 0 };
+		FormType      formType{ FormType::None };
+		TESFile*      file{ nullptr };
+		std::string   fullName{};
+		std::string   editorID{};
+	};
+
+	class TESBoundObject : public TESForm
+	{
+	public:
+		using TESForm::TESForm;
+	};
+
+	class BGSKeyword : public TESForm
+	{
+	public:
+		static constexpr auto FORMTYPE = FormType::Keyword;
+
+		BGSKeyword() :
+			TESForm(FORMTYPE)
+		{}
+
+		[[nodiscard]] const char* GetFormEditorID() const override { return formEditorID.c_str(); }
+		bool                      SetFormEditorID(const char* a_editorID) override
+		{
+			formEditorID = a_editorID;
+			return true;
+		}
+
+		// members
+		BSFixedString formEditorID{};
+	};
+
+	/// Mixin of forms that have keywords.
+	class BGSKeywordForm
+	{
+	public:
+		template <class Func>
+		void ForEachKeyword(Func&& a_func) const
+		{
+			for (const auto keyword : keywords) {
+				if (a_func(keyword) == BSContainer::ForEachResult::kStop) {
+					return;
+				}
+			}
+		}
+
+		[[nodiscard]] bool HasKeyword(const BGSKeyword* a_keyword) const
+		{
+			return std::ranges::find(keywords, a_keyword) != keywords.end();
+		}
+
+		bool AddKeyword(BGSKeyword* a_keyword)
+		{
+			if (HasKeyword(a_keyword)) {
+				return false;
+			}
+			keywords.push_back(a_keyword);
+			return true;
+		}
+
+		void AddKeywords(const std::vector<BGSKeyword*>& a_keywords)
+		{
+			for (const auto keyword : a_keywords) {
+				AddKeyword(keyword);
+			}
+		}
+
+		bool RemoveKeyword(const BGSKeyword* a_keyword) { return std::erase(keywords, a_keyword) > 0; }
+
+		// members
+		std::vector<BGSKeyword*> keywords{};
+	};
+
+	class SpellItem : public TESBoundObject
+	{
+	public:
+		static constexpr auto FORMTYPE = FormType::Spell;
+
+		SpellItem() :
+			TESBoundObject(FORMTYPE)
+		{}
+	};
+
+	class TESLevSpell : public TESBoundObject
+	{
+	public:
+		static constexpr auto FORMTYPE = FormType::LeveledSpell;
+
+		TESLevSpell() :
+			TESBoundObject(FORMTYPE)
+		{}
+	};
+
+	class TESShout : public TESForm
+	{
+	public:
+		static constexpr auto FORMTYPE = FormType::Shout;
+
+		TESShout() :
+			TESForm(FORMTYPE)
+		{}
+	};
+
+	class BGSPerk : public TESForm
+	{
+	public:
+		static constexpr auto FORMTYPE = FormType::Perk;
+
+		BGSPerk() :
+			TESForm(FORMTYPE)
+		{}
+	};
+
+	class TESFaction : public TESForm
+	{
+	public:
+		static constexpr auto FORMTYPE = FormType::Faction;
+
+		TESFaction() :
+			TESForm(FORMTYPE)
+		{}
+	};
+
+	struct FACTION_RANK
+	{
+		TESFaction* faction{ nullptr };
+		std::int8_t rank{ 0 };
+	};
+
+	class TESPackage : public TESForm
+	{
+	public:
+		static constexpr auto FORMTYPE = FormType::Package;
+
+		TESPackage() :
+			TESForm(FORMTYPE)
+		{}
+	};
+
+	class BGSListForm : public TESForm
+	{
+	public:
+		static constexpr auto FORMTYPE = FormType::FormList;
+
+		BGSListForm() :
+			TESForm(FORMTYPE)
+		{}
+
+		template <class Func>
+		void ForEachForm(Func&& a_func) const
+		{
+			for (const auto form : forms) {
+				if (a_func(form) == BSContainer::ForEachResult::kStop) {
+					return;
+				}
+			}
+		}
+
+		// members
+		std::vector<TESForm*> forms{};
+	};
+
+	class TESClass : public TESForm
+	{
+	public:
+		static constexpr auto FORMTYPE = FormType::Class;
+
+		struct SkillWeights
+		{
+			std::uint8_t oneHanded{ 0 };
+			std::uint8_t twoHanded{ 0 };
+			std::uint8_t archery{ 0 };
+			std::uint8_t block{ 0 };
+			std::uint8_t smithing{ 0 };
+			std::uint8_t heavyArmor{ 0 };
+			std::uint8_t lightArmor{ 0 };
+			std::uint8_t pickpocket{ 0 };
+			std::uint8_t lockpicking{ 0 };
+			std::uint8_t sneak{ 0 };
+			std::uint8_t alchemy{ 0 };
+			std::uint8_t speech{ 0 };
+			std::uint8_t alteration{ 0 };
+			std::uint8_t conjuration{ 0 };
+			std::uint8_t destruction{ 0 };
+			std::uint8_t illusion{ 0 };
+			std::uint8_t restoration{ 0 };
+			std::uint8_t enchanting{ 0 };
+		};
+
+		struct CLASS_DATA
+		{
+			SkillWeights skillWeights{};
+		};
+
+		TESClass() :
+			TESForm(FORMTYPE)
+		{}
+
+		// members
+		CLASS_DATA data{};
+	};
+
+	class TESCombatStyle : public TESForm
+	{
+	public:
+		static constexpr auto FORMTYPE = FormType::CombatStyle;
+
+		TESCombatStyle() :
+			TESForm(FORMTYPE)
+		{}
+	};
+
+	class BGSVoiceType : public TESForm
+	{
+	public:
+		static constexpr auto FORMTYPE = FormType::VoiceType;
+
+		BGSVoiceType() :
+			TESForm(FORMTYPE)
+		{}
+	};
+
+	class BGSLocation : public TESForm
+	{
+	public:
+		static constexpr auto FORMTYPE = FormType::Location;
+
+		BGSLocation() :
+			TESForm(FORMTYPE)
+		{}
+	};
+
+	class TESRace :
+		public TESForm,
+		public BGSKeywordForm
+	{
+	public:
+		static constexpr auto FORMTYPE = FormType::Race;
+
+		struct RACE_DATA
+		{
+			enum Flag : std::uint32_t
+			{
+				kNone = 0,
+				kChild = 1 << 2,
+			};
+
+			std::uint32_t flags{ kNone };
+		};
+
+		TESRace() :
+			TESForm(FORMTYPE)
+		{}
+
+		[[nodiscard]] const char* GetFormEditorID() const override { return formEditorID.c_str(); }
+		bool                      SetFormEditorID(const char* a_editorID) override
+		{
+			formEditorID = a_editorID;
+			return true;
+		}
+
+		[[nodiscard]] bool IsChildRace() const { return (data.flags & RACE_DATA::kChild) != 0; }
+
+		// members
+		BSFixedString formEditorID{};
+		RACE_DATA     data{};
+	};
+
+	class TESObjectARMA : public TESForm
+	{
+	public:
+		static constexpr auto FORMTYPE = FormType::Armature;
+
+		TESObjectARMA() :
+			TESForm(FORMTYPE)
+		{}
+
+		/// Addons without a race fit every race.
+		[[nodiscard]] bool IsValidRace(const TESRace* a_race) const
+		{
+			return !race || race == a_race || std::ranges::find(additionalRaces, a_race) != additionalRaces.end();
+		}
+
+		// members
+		TESRace*              race{ nullptr };
+		std::vector<TESRace*> additionalRaces{};
+	};
+
+	class TESObjectARMO : public TESBoundObject
+	{
+	public:
+		static constexpr auto FORMTYPE = FormType::Armor;
+
+		TESObjectARMO() :
+			TESBoundObject(FORMTYPE)
+		{}
+
+		// members
+		std::vector<TESObjectARMA*> armorAddons{};
+	};
+
+	class TESObjectWEAP : public TESBoundObject
+	{
+	public:
+		static constexpr auto FORMTYPE = FormType::Weapon;
+
+		TESObjectWEAP() :
+			TESBoundObject(FORMTYPE)
+		{}
+	};
+
+	class TESObjectMISC : public TESBoundObject
+	{
+	public:
+		static constexpr auto FORMTYPE = FormType::Misc;
+
+		TESObjectMISC() :
+			TESBoundObject(FORMTYPE)
+		{}
+	};
+
+	class TESObjectBOOK : public TESBoundObject
+	{
+	public:
+		static constexpr auto FORMTYPE = FormType::Book;
+
+		TESObjectBOOK() :
+			TESBoundObject(FORMTYPE)
+		{}
+	};
+
+	class BGSOutfit : public TESForm
+	{
+	public:
+		static constexpr auto FORMTYPE = FormType::Outfit;
+
+		BGSOutfit() :
+			TESForm(FORMTYPE)
+		{}
+
+		// members
+		std::vector<TESForm*> outfitItems{};
+	};
+
+	struct CALCED_OBJECT
+	{
+		TESForm*      form{ nullptr };
+		std::uint16_t count{ 0 };
+	};
+
+	class TESLevItem : public TESBoundObject
+	{
+	public:
+		static constexpr auto FORMTYPE = FormType::LeveledItem;
+
+		struct Entry
+		{
+			TESForm*      form{ nullptr };
+			std::uint16_t count{ 1 };
+			std::uint16_t level{ 1 };
+		};
+
+		TESLevItem() :
+			TESBoundObject(FORMTYPE)
+		{}
+
+		/// Every entry up to a_level is added, there's no randomness involved.
+		void CalculateCurrentFormList(std::uint16_t a_level, std::int16_t a_count, BSScrapArray<CALCED_OBJECT>& a_calcedObjects, std::uint32_t, bool)
+		{
+			for (const auto& entry : entries) {
+				if (entry.level <= a_level) {
+					a_calcedObjects.push_back({ entry.form, static_cast<std::uint16_t>(entry.count * a_count) });
+				}
+			}
+		}
+
+		// members
+		std::vector<Entry> entries{};
+	};
+
+	class TESNPC :
+		public TESBoundObject,
+		public BGSKeywordForm
+	{
+	public:
+		static constexpr auto FORMTYPE = FormType::NPC;
+
+		enum Skills
+		{
+			kOneHanded = 0,
+			kTwoHanded,
+			kMarksman,
+			kBlock,
+			kSmithing,
+			kHeavyArmor,
+			kLightArmor,
+			kPickpocket,
+			kLockpicking,
+			kSneak,
+			kAlchemy,
+			kSpeechcraft,
+			kAlteration,
+			kConjuration,
+			kDestruction,
+			kIllusion,
+			kRestoration,
+			kEnchanting,
+			kTotal
+		};
+
+		struct ACTOR_BASE_DATA
+		{
+			enum Flag : std::uint32_t
+			{
+				kFemale = 1 << 0,
+				kUnique = 1 << 5,
+				kSummonable = 1 << 14,
+			};
+
+			std::uint32_t actorBaseFlags{ 0 };
+			std::uint16_t level{ 1 };
+			std::uint16_t calcLevelMin{ 0 };
+			std::uint16_t calcLevelMax{ 0 };
+		};
+
+		struct PerkRankData
+		{
+			BGSPerk*    perk{ nullptr };
+			std::int8_t currentRank{ 0 };
+		};
+
+		struct SpellData
+		{
+			template <class T>
+			static std::optional<std::uint32_t> index_of(const std::vector<T*>& a_forms, const T* a_form)
+			{
+				if (const auto it = std::ranges::find(a_forms, a_form); it != a_forms.end()) {
+					return static_cast<std::uint32_t>(it - a_forms.begin());
+				}
+				return std::nullopt;
+			}
+
+			template <class T>
+			static bool add(std::vector<T*>& a_forms, const std::vector<T*>& a_added)
+			{
+				bool added = false;
+				for (const auto form : a_added) {
+					if (!index_of(a_forms, form)) {
+						a_forms.push_back(form);
+						added = true;
+					}
+				}
+				return added;
+			}
+
+			bool AddSpells(const std::vector<SpellItem*>& a_spells) { return add(spells, a_spells); }
+			bool AddLevSpells(const std::vector<TESLevSpell*>& a_levSpells) { return add(levSpells, a_levSpells); }
+			bool AddShouts(const std::vector<TESShout*>& a_shouts) { return add(shouts, a_shouts); }
+
+			[[nodiscard]] std::optional<std::uint32_t> GetIndex(const SpellItem* a_spell) const { return index_of(spells, a_spell); }
+			[[nodiscard]] std::optional<std::uint32_t> GetIndex(const TESLevSpell* a_levSpell) const { return index_of(levSpells, a_levSpell); }
+			[[nodiscard]] std::optional<std::uint32_t> GetIndex(const TESShout* a_shout) const { return index_of(shouts, a_shout); }
+
+			// members
+			std::vector<SpellItem*>   spells{};
+			std::vector<TESLevSpell*> levSpells{};
+			std::vector<TESShout*>    shouts{};
+		};
+
+		struct AIPackages
+		{
+			BSSimpleList<TESPackage*> packages{};
+		};
+
+		struct PlayerSkills
+		{
+			std::uint8_t values[Skills::kTotal]{};
+		};
+
+		TESNPC() :
+			TESBoundObject(FORMTYPE)
+		{}
+
+		[[nodiscard]] std::uint16_t   GetLevel() const { return actorData.level; }
+		[[nodiscard]] SEX             GetSex() const { return (actorData.actorBaseFlags & ACTOR_BASE_DATA::kFemale) ? SEX::kFemale : SEX::kMale; }
+		[[nodiscard]] bool            IsUnique() const { return (actorData.actorBaseFlags & ACTOR_BASE_DATA::kUnique) != 0; }
+		[[nodiscard]] bool            IsSummonable() const { return (actorData.actorBaseFlags & ACTOR_BASE_DATA::kSummonable) != 0; }
+		[[nodiscard]] TESCombatStyle* GetCombatStyle() const { return combatStyle; }
+		[[nodiscard]] TESRace*        GetRace() const { return race; }
+		[[nodiscard]] SpellData*      GetSpellList() { return &actorEffects; }
+
+		[[nodiscard]] bool IsInFaction(const TESFaction* a_faction) const
+		{
+			return std::ranges::any_of(factions, [&](const auto& a_rank) { return a_rank.faction == a_faction && a_rank.rank > -1; });
+		}
+
+		bool AddPerks(const std::vector<BGSPerk*>& a_perks, std::int8_t a_rank)
+		{
+			bool added = false;
+			for (const auto perk : a_perks) {
+				if (!GetPerkIndex(perk)) {
+					perks.push_back({ perk, a_rank });
+					added = true;
+				}
+			}
+			return added;
+		}
+
+		[[nodiscard]] std::optional<std::uint32_t> GetPerkIndex(const BGSPerk* a_perk) const
+		{
+			if (const auto it = std::ranges::find(perks, a_perk, &PerkRankData::perk); it != perks.end()) {
+				return static_cast<std::uint32_t>(it - perks.begin());
+			}
+			return std::nullopt;
+		}
+
+		/// Adds objects to NPC's base container. Returns whether anything was added.
+		bool AddObjectsToContainer(std::map<TESBoundObject*, std::int32_t>& a_objects, TESForm*)
+		{
+			bool added = false;
+			for (const auto& [object, count] : a_objects) {
+				if (object && count > 0) {
+					container[object] += count;
+					added = true;
+				}
+			}
+			return added;
+		}
+
+		[[nodiscard]] std::int32_t CountObjectsInContainer(const TESBoundObject* a_object) const
+		{
+			const auto it = container.find(const_cast<TESBoundObject*>(a_object));
+			return it != container.end() ? it->second : 0;
+		}
+
+		// members
+		ACTOR_BASE_DATA                         actorData{};
+		std::vector<FACTION_RANK>               factions{};
+		std::vector<PerkRankData>               perks{};
+		SpellData                               actorEffects{};
+		AIPackages                              aiPackages{};
+		BGSListForm*                            defaultPackList{ nullptr };
+		BGSListForm*                            spectatorOverRidePackList{ nullptr };
+		BGSListForm*                            observeCorpseOverRidePackList{ nullptr };
+		BGSListForm*                            guardWarnOverRidePackList{ nullptr };
+		BGSListForm*                            enterCombatOverRidePackList{ nullptr };
+		TESObjectARMO*                          skin{ nullptr };
+		BGSOutfit*                              defaultOutfit{ nullptr };
+		BGSOutfit*                              sleepOutfit{ nullptr };
+		TESCombatStyle*                         combatStyle{ nullptr };
+		TESClass*                               npcClass{ nullptr };
+		BGSVoiceType*                           voiceType{ nullptr };
+		TESRace*                                race{ nullptr };
+		TESNPC*                                 baseTemplateForm{ nullptr };
+		PlayerSkills                            playerSkills{};
+		std::map<TESBoundObject*, std::int32_t> container{};
+	};
+
+	class BSExtraData
+	{
+	public:
+		virtual ~BSExtraData() = default;
+	};
+
+	class ExtraLeveledCreature : public BSExtraData
+	{
+	public:
+		// members
+		TESNPC* originalBase{ nullptr };
+		TESNPC* templateBase{ nullptr };
+	};
+
+	class ExtraDataList
+	{
+	public:
+		template <class T>
+		[[nodiscard]] T* GetByType() const
+		{
+			for (const auto& data : extraData) {
+				if (const auto result = dynamic_cast<T*>(data.get())) {
+					return result;
+				}
+			}
+			return nullptr;
+		}
+
+		template <class T>
+		T* Add()
+		{
+			return static_cast<T*>(extraData.emplace_back(std::make_unique<T>()).get());
+		}
+
+	private:
+		std::vector<std::unique_ptr<BSExtraData>> extraData{};
+	};
+
+	class TESObjectREFR : public TESForm
+	{
+	public:
+		static constexpr auto FORMTYPE = FormType::Reference;
+
+		struct OBJ_REFR
+		{
+			TESBoundObject* objectReference{ nullptr };
+		};
+
+		TESObjectREFR() :
+			TESForm(FORMTYPE)
+		{}
+		explicit TESObjectREFR(FormType a_type) :
+			TESForm(a_type)
+		{}
+
+		[[nodiscard]] TESBoundObject* GetBaseObject() const { return data.objectReference; }
+
+		[[nodiscard]] const char* GetName() const override
+		{
+			return data.objectReference ? data.objectReference->GetName() : TESForm::GetName();
+		}
+
+		// members
+		OBJ_REFR      data{};
+		ExtraDataList extraList{};
+	};
+
+	class Actor : public TESObjectREFR
+	{
+	public:
+		static constexpr auto FORMTYPE = FormType::ActorCharacter;
+
+		struct RecordFlags
+		{
+			enum RecordFlag : std::uint32_t
+			{
+				kStartsDead = 1 << 9,
+			};
+		};
+
+		Actor() :
+			TESObjectREFR(FORMTYPE)
+		{}
+
+		[[nodiscard]] TESNPC* GetActorBase() const { return static_cast<TESNPC*>(data.objectReference); }
+
+		[[nodiscard]] TESRace* GetRace() const
+		{
+			if (race) {
+				return race;
+			}
+			const auto npc = GetActorBase();
+			return npc ? npc->race : nullptr;
+		}
+
+		[[nodiscard]] bool IsChild() const
+		{
+			const auto race = GetRace();
+			return race && race->IsChildRace();
+		}
+
+		[[nodiscard]] bool         IsLeveled() const { return extraList.GetByType<ExtraLeveledCreature>() != nullptr; }
+		[[nodiscard]] bool         IsPlayerTeammate() const { return playerTeammate; }
+		[[nodiscard]] BGSLocation* GetEditorLocation() const { return editorLocation; }
+		[[nodiscard]] bool         IsDead(bool = true) const { return dead; }
+
+		[[nodiscard]] bool HasPerk(const BGSPerk* a_perk) const
+		{
+			const auto npc = GetActorBase();
+			return npc && npc->GetPerkIndex(a_perk).has_value();
+		}
+
+		[[nodiscard]] bool HasSpell(const SpellItem* a_spell) const
+		{
+			const auto npc = GetActorBase();
+			return npc && npc->actorEffects.GetIndex(a_spell).has_value();
+		}
+
+		/// Whether actor still wears items of given outfit.
+		[[nodiscard]] bool HasOutfitItems(const BGSOutfit*) const { return !outfitLooted; }
+
+		void CastPermanentMagic(bool, bool, bool, bool) {}
+
+		void KillImmediate() { dead = true; }
+		void Resurrect(bool, bool) { dead = false; }
+
+		// members
+		TESRace*     race{ nullptr };
+		BGSLocation* editorLocation{ nullptr };
+		bool         dead{ false };
+		bool         playerTeammate{ false };
+		bool         outfitLooted{ false };
+	};
+
+	class Character : public Actor
+	{};
+
+	template <class Form>
+	class ConcreteFormFactory
+	{
+	public:
+		/// Creates a dynamic form.
+		Form* Create();
+	};
+
+	class IFormFactory
+	{
+	public:
+		template <class Form>
+		static ConcreteFormFactory<Form>* GetConcreteFormFactoryByType()
+		{
+			static ConcreteFormFactory<Form> factory;
+			return &factory;
+		}
+	};
+
+	/// Owns all forms and plugins of the mock world.
+	class TESDataHandler
+	{
+	public:
+		static TESDataHandler* GetSingleton()
+		{
+			static TESDataHandler singleton;
+			return &singleton;
+		}
+
+		[[nodiscard]] const TESFile* LookupModByName(std::string_view a_modName) const
+		{
+			for (const auto file : files) {
+				const std::string_view name = file->fileName;
+				if (std::ranges::equal(name, a_modName, [](char a, char b) { return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b)); })) {
+					return file;
+				}
+			}
+			return nullptr;
+		}
+
+		[[nodiscard]] TESForm* LookupForm(FormID a_localFormID, std::string_view a_modName) const
+		{
+			const auto file = LookupModByName(a_modName);
+			if (!file) {
+				return nullptr;
+			}
+			return TESForm::LookupByID((file->compileIndex << 24) | (a_localFormID & 0x00FFFFFF));
+		}
+
+		template <class T>
+		BSTArray<T*>& GetFormArray();
+
+		TESFile* AddFile(std::string_view a_name)
+		{
+			const auto file = fileStorage.emplace_back(std::make_unique<TESFile>()).get();
+			a_name.copy(file->fileName, sizeof(file->fileName) - 1);
+			file->compileIndex = static_cast<std::uint32_t>(files.size());
+			files.push_back(file);
+			return file;
+		}
+
+		/// Takes ownership of the form and makes it visible to lookups.
+		void RegisterForm(std::unique_ptr<TESForm> a_form)
+		{
+			const auto form = a_form.get();
+			formsByID.insert_or_assign(form->formID, form);
+			if (!form->IsDynamicForm()) {
+				auto& next = nextLocalFormIDs[form->formID >> 24];
+				next = std::max(next, form->GetLocalFormID() + 1);
+			}
+			if (const auto keyword = form->As<BGSKeyword>()) {
+				keywords.push_back(keyword);
+			} else if (const auto editorID = form->GetFormEditorID(); editorID && *editorID) {
+				BSWriteLockGuard locker(editorIDsLock);
+				formsByEditorID.insert_or_assign(editorID, form);
+			}
+			forms.push_back(std::move(a_form));
+		}
+
+		void Clear()
+		{
+			BSWriteLockGuard locker(editorIDsLock);
+			formsByEditorID.clear();
+			formsByID.clear();
+			keywords.clear();
+			forms.clear();
+			files.clear();
+			fileStorage.clear();
+			nextLocalFormIDs.clear();
+			nextDynamicFormID = 0xFF000800;
+		}
+
+		// members
+		std::vector<TESFile*>                      files{};
+		std::vector<std::unique_ptr<TESFile>>      fileStorage{};
+		std::vector<std::unique_ptr<TESForm>>      forms{};
+		std::unordered_map<FormID, TESForm*>       formsByID{};
+		std::unordered_map<std::string, TESForm*>  formsByEditorID{};
+		BSReadWriteLock                            editorIDsLock{};
+		BSTArray<BGSKeyword*>                      keywords{};
+		std::unordered_map<std::uint32_t, FormID>  nextLocalFormIDs{};  // compile index -> next free local formID
+		FormID                                     nextDynamicFormID{ 0xFF000800 };
+	};
+
+	template <>
+	inline BSTArray<BGSKeyword*>& TESDataHandler::GetFormArray<BGSKeyword>()
+	{
+		return keywords;
+	}
+
+	inline TESForm* TESForm::LookupByID(FormID a_formID)
+	{
+		const auto& forms = TESDataHandler::GetSingleton()->formsByID;
+		const auto  it = forms.find(a_formID);
+		return it != forms.end() ? it->second : nullptr;
+	}
+
+	inline std::pair<std::unordered_map<std::string, TESForm*>*, std::reference_wrapper<BSReadWriteLock>> TESForm::GetAllFormsByEditorID()
+	{
+		const auto dataHandler = TESDataHandler::GetSingleton();
+		return { &dataHandler->formsByEditorID, std::ref(dataHandler->editorIDsLock) };
+	}
+
+	template <class Form>
+	Form* ConcreteFormFactory<Form>::Create()
+	{
+		const auto dataHandler = TESDataHandler::GetSingleton();
+
+		auto form = std::make_unique<Form>();
+		form->formID = dataHandler->nextDynamicFormID++;
+
+		const auto result = form.get();
+		dataHandler->forms.push_back(std::move(form));
+		dataHandler->formsByID.insert_or_assign(result->formID, result);
+		return result;
+	}
+
+	struct TESDeathEvent
+	{
+		NiPointer<TESObjectREFR> actorDying{};
+		NiPointer<TESObjectREFR> actorKiller{};
+		bool                     dead{ false };
+	};
+
+	struct TESFormDeleteEvent
+	{
+		FormID formID{ 0 };
+	};
+
+	struct MenuOpenCloseEvent
+	{
+		BSFixedString menuName{};
+		bool          opening{ false };
+	};
+
+	class RaceSexMenu
+	{
+	public:
+		static constexpr std::string_view MENU_NAME = "RaceSex Menu";
+	};
+
+	class UI
+	{
+	public:
+		static UI* GetSingleton()
+		{
+			static UI singleton;
+			return &singleton;
+		}
+
+		template <class Event>
+		void AddEventSink(BSTEventSink<Event>*)
+		{}
+	};
+
+	class BGSSaveLoadManager
+	{
+	public:
+		static BGSSaveLoadManager* GetSingleton()
+		{
+			static BGSSaveLoadManager singleton;
+			return &singleton;
+		}
+
+		// members
+		std::uint64_t currentCharacterID{ 0 };
+	};
+}
+
+namespace std
+{
+	inline std::string to_string(RE::FormType a_type)
+	{
+		return std::string(RE::FormTypeToString(a_type));
+	}
+}
+
+template <>
+struct fmt::formatter<RE::FormType> : fmt::formatter<std::string_view>
+{
+	template <class FormatContext>
+	auto format(RE::FormType a_type, FormatContext& a_ctx) const
+	{
+		return fmt::formatter<std::string_view>::format(RE::FormTypeToString(a_type), a_ctx);
+	}
+};
@@ -0,0 +1,58 @@
+#pragma once
+
+// A minimal stand-in for SKSE's part of CommonLibSSE. Logging goes straight to spdlog's default logger.
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+
+#include <spdlog/spdlog.h>
+
+namespace SKSE
+{
+	namespace log
+	{
+		using spdlog::critical;
+		using spdlog::debug;
+		using spdlog::error;
+		using spdlog::info;
+		using spdlog::trace;
+		using spdlog::warn;
+
+		/// Files that SPID writes next to its log end up in the temporary directory.
+		inline std::optional<std::filesystem::path> log_directory()
+		{
+			return std::filesystem::temp_directory_path();
+		}
+	}
+
+	namespace stl
+	{}
+
+	class MessagingInterface
+	{
+	public:
+		enum : std::uint32_t
+		{
+			kPostLoad,
+			kPostPostLoad,
+			kPreLoadGame,
+			kPostLoadGame,
+			kSaveGame,
+			kDeleteGame,
+			kInputLoaded,
+			kNewGame,
+			kDataLoaded
+		};
+
+		struct Message
+		{
+			std::uint32_t type{ 0 };
+			std::uint32_t dataLen{ 0 };
+			void*         data{ nullptr };
+			const char*   sender{ nullptr };
+		};
+	};
+
+	class SerializationInterface;
+}
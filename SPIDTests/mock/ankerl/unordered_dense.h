@@ -0,0 +1,43 @@
+#pragma once
+
+// A stand-in for ankerl::unordered_dense that forwards to standard containers.
+// Unlike the real maps, standard ones don't keep insertion order, so code under test must not depend on iteration order.
+
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace ankerl::unordered_dense
+{
+	template <class T, class Enable = void>
+	struct hash
+	{
+		[[nodiscard]] std::uint64_t operator()(const T& a_value) const noexcept
+		{
+			return static_cast<std::uint64_t>(std::hash<T>{}(a_value));
+		}
+	};
+
+	namespace detail::wyhash
+	{
+		[[nodiscard]] inline std::uint64_t hash(const void* a_data, std::size_t a_size) noexcept
+		{
+			return static_cast<std::uint64_t>(std::hash<std::string_view>{}(std::string_view(static_cast<const char*>(a_data), a_size)));
+		}
+	}
+
+	template <class K, class V, class Hash = hash<K>, class KeyEqual = std::equal_to<K>>
+	using map = std::unordered_map<K, V, Hash, KeyEqual>;
+
+	template <class K, class Hash = hash<K>, class KeyEqual = std::equal_to<K>>
+	using set = std::unordered_set<K, Hash, KeyEqual>;
+
+	template <class K, class V, class Hash = hash<K>, class KeyEqual = std::equal_to<K>>
+	using segmented_map = std::unordered_map<K, V, Hash, KeyEqual>;
+
+	template <class K, class Hash = hash<K>, class KeyEqual = std::equal_to<K>>
+	using segmented_set = std::unordered_set<K, Hash, KeyEqual>;
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+// SRELL is only used by config sanitizing, which isn't part of the core.
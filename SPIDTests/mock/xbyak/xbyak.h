@@ -0,0 +1,3 @@
+#pragma once
+
+// Xbyak is only used by hooks, which aren't part of the core.
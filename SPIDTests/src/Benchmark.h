@@ -0,0 +1,167 @@
+#pragma once
+
+// Minimal micro-benchmarking helpers.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace Benchmark
+{
+	/// Prevents compiler from optimizing away computations whose result is otherwise unused.
+	template <class T>
+	inline void DoNotOptimize(const T& a_value)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(a_value) : "memory");
+#else
+		static volatile const T* sink;
+		sink = &a_value;
+#endif
+	}
+
+	struct Result
+	{
+		std::string name;
+		double      nsPerOp;
+	};
+
+	/// <summary>
+	/// Runs a_func for a_iterations (one op per call) in several samples and returns the fastest sample.
+	/// </summary>
+	inline Result Run(std::string a_name, std::uint64_t a_iterations, const std::function<void()>& a_func, int a_samples = 5)
+	{
+		using clock = std::chrono::steady_clock;
+
+		// warm up
+		for (std::uint64_t i = 0; i < std::max<std::uint64_t>(a_iterations / 10, 1); ++i) {
+			a_func();
+		}
+
+		double best = std::numeric_limits<double>::max();
+		for (int sample = 0; sample < a_samples; ++sample) {
+			const auto start = clock::now();
+			for (std::uint64_t i = 0; i < a_iterations; ++i) {
+				a_func();
+			}
+			const auto elapsed = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+			best = std::min(best, elapsed / static_cast<double>(a_iterations));
+		}
+
+		std::printf("\t%-48s %14.2f ns/op\n", a_name.c_str(), best);
+		return { std::move(a_name), best };
+	}
+
+	/// <summary>
+	/// Number of heap allocations made so far.
+	/// Allocations are only counted by executables that replace global operator new to increment it (see coreBenchmarks.cpp).
+	/// </summary>
+	inline std::atomic<std::uint64_t> allocations{ 0 };
+
+	/// <summary>
+	/// Resets peak resident set size of the process to its current RSS, so that GetPeakRSS only reports what happens afterwards. Only supported on Linux.
+	///
+	/// Memory that is still resident (or kept by the allocator) after earlier benchmarks counts towards the peak,
+	/// so peaks are only comparable between runs that measure the same benchmarks in the same order, ideally each scenario in its own process.
+	/// </summary>
+	inline void ResetPeakRSS()
+	{
+#if defined(__linux__)
+		std::ofstream("/proc/self/clear_refs") << "5";
+#endif
+	}
+
+	/// Peak resident set size of the process in bytes since the last ResetPeakRSS, or 0 where it's not supported.
+	inline std::uint64_t GetPeakRSS()
+	{
+#if defined(__linux__)
+		std::ifstream status("/proc/self/status");
+		for (std::string line; std::getline(status, line);) {
+			if (line.starts_with("VmHWM:")) {
+				std::uint64_t kilobytes = 0;
+				std::istringstream(line.substr(6)) >> kilobytes;
+				return kilobytes * 1024;
+			}
+		}
+#endif
+		return 0;
+	}
+
+	struct Sample
+	{
+		double        ns{ 0 };
+		std::uint64_t allocations{ 0 };
+	};
+
+	/// <summary>
+	/// Runs a_func once per sample and returns the fastest sample.
+	/// Meant for operations that change state: a_setup restores it before each sample and isn't measured.
+	/// </summary>
+	inline Sample Measure(const std::function<void()>& a_setup, const std::function<void()>& a_func, int a_samples = 5)
+	{
+		using clock = std::chrono::steady_clock;
+
+		Sample best{ .ns = std::numeric_limits<double>::max() };
+		for (int sample = 0; sample < a_samples; ++sample) {
+			if (a_setup) {
+				a_setup();
+			}
+			const auto allocationsBefore = allocations.load(std::memory_order_relaxed);
+			const auto start = clock::now();
+			a_func();
+			const auto elapsed = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+			if (elapsed < best.ns) {
+				best = { elapsed, allocations.load(std::memory_order_relaxed) - allocationsBefore };
+			}
+		}
+
+		return best;
+	}
+
+	/// Registry of benchmark suites. Each suite runs its own benchmarks and prints results.
+	class Registry
+	{
+	public:
+		using Suite = std::function<void()>;
+
+		static Registry* GetSingleton()
+		{
+			static Registry singleton;
+			return &singleton;
+		}
+
+		static bool Register(const char* a_moduleName, const char* a_name, Suite a_suite)
+		{
+			auto& module = GetSingleton()->suites[a_moduleName];
+			return module.try_emplace(a_name, std::move(a_suite)).second;
+		}
+
+		static void Run()
+		{
+			for (auto& [moduleName, suites] : GetSingleton()->suites) {
+				std::printf("Running %s benchmarks:\n", moduleName.c_str());
+				for (auto& [name, suite] : suites) {
+					std::printf("  %s\n", name.c_str());
+					suite();
+				}
+			}
+		}
+
+	private:
+		std::map<std::string, std::map<std::string, Suite>> suites;
+	};
+}
+
+#define BENCHMARK(name)                                                                                             \
+	inline void benchmark##name();                                                                                  \
+	static bool benchmark##name##_registered = ::Benchmark::Registry::Register(moduleName, #name, benchmark##name); \
+	inline void benchmark##name()
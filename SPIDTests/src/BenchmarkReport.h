@@ -0,0 +1,447 @@
+#pragma once
+
+// Machine-readable benchmark results and their comparison against a stored baseline.
+// This header only depends on the standard library, so that the comparison tool can be built without SPID's dependencies.
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+namespace Benchmark::Report
+{
+	/// Allowed relative increase of each metric before it's considered a regression, e.g. 0.1 allows results to be 10% worse than the baseline.
+	struct Tolerance
+	{
+		double time{ 0.25 };
+		double allocations{ 0.05 };
+		double rss{ 0.15 };
+	};
+
+	struct Entry
+	{
+		std::string   name{};  // "<scenario>/<stage>"
+		std::string   unit{};  // what time and allocations are measured per, e.g. "NPC" or "entry"
+		double        nsPerUnit{ 0 };
+		double        allocationsPerUnit{ 0 };
+		std::uint64_t peakRSS{ 0 };  // bytes, 0 if it couldn't be measured
+		Tolerance     tolerance{};   // only meaningful in baselines
+	};
+
+	/// Results collected during the current run.
+	inline std::vector<Entry>& GetResults()
+	{
+		static std::vector<Entry> results;
+		return results;
+	}
+
+	namespace detail
+	{
+		inline void write_string(std::string& a_out, std::string_view a_str)
+		{
+			a_out += '"';
+			for (const auto ch : a_str) {
+				if (ch == '"' || ch == '\\') {
+					a_out += '\\';
+				}
+				a_out += ch;
+			}
+			a_out += '"';
+		}
+
+		inline std::string to_string(double a_value)
+		{
+			char buffer[64];
+			const auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), a_value, std::chars_format::fixed, 3);
+			return ec == std::errc{} ? std::string(buffer, end) : "0";
+		}
+
+		/// Minimal JSON value, which is enough to read reports back.
+		struct Value
+		{
+			using Object = std::map<std::string, Value>;
+			using Array = std::vector<Value>;
+
+			std::variant<std::nullptr_t, bool, double, std::string, std::shared_ptr<Array>, std::shared_ptr<Object>> data{ nullptr };
+
+			[[nodiscard]] const Value* Find(const std::string& a_key) const
+			{
+				if (const auto object = std::get_if<std::shared_ptr<Object>>(&data)) {
+					if (const auto it = (*object)->find(a_key); it != (*object)->end()) {
+						return &it->second;
+					}
+				}
+				return nullptr;
+			}
+
+			[[nodiscard]] double GetNumber(const std::string& a_key, double a_default = 0) const
+			{
+				const auto value = Find(a_key);
+				const auto number = value ? std::get_if<double>(&value->data) : nullptr;
+				return number ? *number : a_default;
+			}
+
+			[[nodiscard]] std::string GetString(const std::string& a_key) const
+			{
+				const auto value = Find(a_key);
+				const auto str = value ? std::get_if<std::string>(&value->data) : nullptr;
+				return str ? *str : std::string{};
+			}
+		};
+
+		class Parser
+		{
+		public:
+			explicit Parser(std::string_view a_json) :
+				json(a_json)
+			{}
+
+			std::optional<Value> Parse()
+			{
+				auto value = ParseValue();
+				SkipWhitespace();
+				if (!value || pos != json.size()) {
+					return std::nullopt;
+				}
+				return value;
+			}
+
+		private:
+			void SkipWhitespace()
+			{
+				while (pos < json.size() && std::isspace(static_cast<unsigned char>(json[pos]))) {
+					++pos;
+				}
+			}
+
+			bool Consume(char a_ch)
+			{
+				SkipWhitespace();
+				if (pos < json.size() && json[pos] == a_ch) {
+					++pos;
+					return true;
+				}
+				return false;
+			}
+
+			bool ConsumeLiteral(std::string_view a_literal)
+			{
+				if (json.substr(pos, a_literal.size()) == a_literal) {
+					pos += a_literal.size();
+					return true;
+				}
+				return false;
+			}
+
+			std::optional<std::string> ParseString()
+			{
+				if (!Consume('"')) {
+					return std::nullopt;
+				}
+				std::string result;
+				while (pos < json.size() && json[pos] != '"') {
+					if (json[pos] == '\\' && pos + 1 < json.size()) {
+						++pos;
+					}
+					result += json[pos++];
+				}
+				if (pos == json.size()) {
+					return std::nullopt;
+				}
+				++pos;
+				return result;
+			}
+
+			std::optional<Value> ParseValue()
+			{
+				SkipWhitespace();
+				if (pos == json.size()) {
+					return std::nullopt;
+				}
+
+				switch (json[pos]) {
+				case '{':
+					{
+						++pos;
+						auto object = std::make_shared<Value::Object>();
+						if (!Consume('}')) {
+							do {
+								auto key = ParseString();
+								if (!key || !Consume(':')) {
+									return std::nullopt;
+								}
+								auto value = ParseValue();
+								if (!value) {
+									return std::nullopt;
+								}
+								object->insert_or_assign(std::move(*key), std::move(*value));
+							} while (Consume(','));
+							if (!Consume('}')) {
+								return std::nullopt;
+							}
+						}
+						return Value{ object };
+					}
+				case '[':
+					{
+						++pos;
+						auto array = std::make_shared<Value::Array>();
+						if (!Consume(']')) {
+							do {
+								auto value = ParseValue();
+								if (!value) {
+									return std::nullopt;
+								}
+								array->push_back(std::move(*value));
+							} while (Consume(','));
+							if (!Consume(']')) {
+								return std::nullopt;
+							}
+						}
+						return Value{ array };
+					}
+				case '"':
+					if (auto str = ParseString()) {
+						return Value{ std::move(*str) };
+					}
+					return std::nullopt;
+				default:
+					if (ConsumeLiteral("true")) {
+						return Value{ true };
+					}
+					if (ConsumeLiteral("false")) {
+						return Value{ false };
+					}
+					if (ConsumeLiteral("null")) {
+						return Value{};
+					}
+
+					double number = 0;
+					const auto [end, ec] = std::from_chars(json.data() + pos, json.data() + json.size(), number);
+					if (ec != std::errc{}) {
+						return std::nullopt;
+					}
+					pos = end - json.data();
+					return Value{ number };
+				}
+			}
+
+			std::string_view json;
+			std::size_t      pos{ 0 };
+		};
+	}
+
+	/// Serializes entries into JSON.
+	inline std::string Write(const std::vector<Entry>& a_entries)
+	{
+		using namespace detail;
+
+		std::string out = "{\n\t\"benchmarks\": [";
+		for (std::size_t i = 0; i < a_entries.size(); ++i) {
+			const auto& entry = a_entries[i];
+
+			out += i > 0 ? ",\n\t\t{ " : "\n\t\t{ ";
+			out += "\"name\": ";
+			write_string(out, entry.name);
+			out += ", \"unit\": ";
+			write_string(out, entry.unit);
+			out += ", \"nsPerUnit\": " + to_string(entry.nsPerUnit);
+			out += ", \"allocationsPerUnit\": " + to_string(entry.allocationsPerUnit);
+			out += ", \"peakRSS\": " + std::to_string(entry.peakRSS);
+			out += ", \"tolerance\": { \"time\": " + to_string(entry.tolerance.time);
+			out += ", \"allocations\": " + to_string(entry.tolerance.allocations);
+			out += ", \"rss\": " + to_string(entry.tolerance.rss) + " } }";
+		}
+		out += "\n\t]\n}\n";
+		return out;
+	}
+
+	/// Parses entries that were serialized with Write. Returns nothing if a_json isn't a valid report.
+	inline std::optional<std::vector<Entry>> Read(std::string_view a_json)
+	{
+		const auto root = detail::Parser(a_json).Parse();
+		if (!root) {
+			return std::nullopt;
+		}
+
+		const auto benchmarks = root->Find("benchmarks");
+		const auto array = benchmarks ? std::get_if<std::shared_ptr<detail::Value::Array>>(&benchmarks->data) : nullptr;
+		if (!array) {
+			return std::nullopt;
+		}
+
+		const Tolerance defaults{};
+
+		std::vector<Entry> entries;
+		for (const auto& value : **array) {
+			Entry entry{
+				.name = value.GetString("name"),
+				.unit = value.GetString("unit"),
+				.nsPerUnit = value.GetNumber("nsPerUnit"),
+				.allocationsPerUnit = value.GetNumber("allocationsPerUnit"),
+				.peakRSS = static_cast<std::uint64_t>(value.GetNumber("peakRSS"))
+			};
+			if (const auto tolerance = value.Find("tolerance")) {
+				entry.tolerance = {
+					.time = tolerance->GetNumber("time", defaults.time),
+					.allocations = tolerance->GetNumber("allocations", defaults.allocations),
+					.rss = tolerance->GetNumber("rss", defaults.rss)
+				};
+			}
+			if (entry.name.empty()) {
+				return std::nullopt;
+			}
+			entries.push_back(std::move(entry));
+		}
+		return entries;
+	}
+
+	/// Comparison of a single benchmark with its baseline.
+	struct Row
+	{
+		std::string              name{};
+		const Entry*             baseline{ nullptr };  // nullptr if benchmark is new
+		const Entry*             result{ nullptr };    // nullptr if benchmark is missing from results
+		std::vector<std::string> regressions{};        // names of metrics that exceeded their tolerance
+
+		[[nodiscard]] bool IsRegression() const { return !regressions.empty() || !result; }
+	};
+
+	namespace detail
+	{
+		/// Relative change of a_result compared to a_baseline, 0 when there's no baseline value.
+		inline double change(double a_baseline, double a_result)
+		{
+			return a_baseline > 0 ? (a_result - a_baseline) / a_baseline : 0;
+		}
+
+		inline std::string format_change(double a_baseline, double a_result)
+		{
+			if (a_baseline <= 0) {
+				return "";
+			}
+			char buffer[32];
+			std::snprintf(buffer, sizeof(buffer), "%+.1f%%", change(a_baseline, a_result) * 100);
+			return buffer;
+		}
+
+		inline std::string format(const char* a_format, double a_value)
+		{
+			char buffer[64];
+			std::snprintf(buffer, sizeof(buffer), a_format, a_value);
+			return buffer;
+		}
+	}
+
+	/// <summary>
+	/// Compares results with baseline, benchmark by benchmark. Benchmarks that are missing from results count as regressions,
+	/// new benchmarks that have no baseline don't.
+	/// </summary>
+	inline std::vector<Row> Compare(const std::vector<Entry>& a_baseline, const std::vector<Entry>& a_results)
+	{
+		std::vector<Row> rows;
+
+		for (const auto& baseline : a_baseline) {
+			Row row{ .name = baseline.name, .baseline = &baseline };
+			for (const auto& result : a_results) {
+				if (result.name == baseline.name) {
+					row.result = &result;
+					break;
+				}
+			}
+
+			if (row.result) {
+				const auto& tolerance = baseline.tolerance;
+				if (detail::change(baseline.nsPerUnit, row.result->nsPerUnit) > tolerance.time) {
+					row.regressions.emplace_back("time");
+				}
+				if (detail::change(baseline.allocationsPerUnit, row.result->allocationsPerUnit) > tolerance.allocations ||
+					(baseline.allocationsPerUnit == 0 && row.result->allocationsPerUnit > 0)) {
+					row.regressions.emplace_back("allocations");
+				}
+				// Peak RSS can't be measured everywhere, so it's only compared when both have it.
+				if (baseline.peakRSS > 0 && row.result->peakRSS > 0 && detail::change(static_cast<double>(baseline.peakRSS), static_cast<double>(row.result->peakRSS)) > tolerance.rss) {
+					row.regressions.emplace_back("rss");
+				}
+			}
+
+			rows.push_back(std::move(row));
+		}
+
+		for (const auto& result : a_results) {
+			if (std::none_of(a_baseline.begin(), a_baseline.end(), [&](const auto& a_entry) { return a_entry.name == result.name; })) {
+				rows.push_back({ .name = result.name, .result = &result });
+			}
+		}
+
+		return rows;
+	}
+
+	/// Formats comparison as a table with baseline and current values of each metric and their relative change.
+	inline std::string FormatTable(const std::vector<Row>& a_rows)
+	{
+		using namespace detail;
+
+		std::string table;
+
+		char line[512];
+		std::snprintf(line, sizeof(line), "%-40s %-6s %14s %14s %9s %14s %14s %9s %14s %14s %9s  %s\n",
+			"Benchmark", "Unit", "ns (base)", "ns", "change", "allocs (base)", "allocs", "change", "RSS MB (base)", "RSS MB", "change", "Status");
+		table += line;
+
+		for (const auto& row : a_rows) {
+			const auto& base = row.baseline;
+			const auto& result = row.result;
+
+			const auto value = [](const Entry* a_entry, auto a_member, const char* a_format) {
+				return a_entry ? format(a_format, static_cast<double>(a_entry->*a_member)) : std::string("-");
+			};
+			const auto changeOf = [&](auto a_member) {
+				return base && result ? format_change(static_cast<double>(base->*a_member), static_cast<double>(result->*a_member)) : std::string{};
+			};
+			const auto mb = [](const Entry* a_entry) {
+				return a_entry && a_entry->peakRSS > 0 ? format("%.1f", static_cast<double>(a_entry->peakRSS) / (1024 * 1024)) : std::string("-");
+			};
+
+			std::string status;
+			if (!result) {
+				status = "MISSING";
+			} else if (!base) {
+				status = "new";
+			} else if (row.regressions.empty()) {
+				status = "ok";
+			} else {
+				status = "REGRESSION:";
+				for (const auto& metric : row.regressions) {
+					status += " " + metric;
+				}
+			}
+
+			std::snprintf(line, sizeof(line), "%-40s %-6s %14s %14s %9s %14s %14s %9s %14s %14s %9s  %s\n",
+				row.name.c_str(),
+				(result ? result->unit : base->unit).c_str(),
+				value(base, &Entry::nsPerUnit, "%.2f").c_str(),
+				value(result, &Entry::nsPerUnit, "%.2f").c_str(),
+				changeOf(&Entry::nsPerUnit).c_str(),
+				value(base, &Entry::allocationsPerUnit, "%.2f").c_str(),
+				value(result, &Entry::allocationsPerUnit, "%.2f").c_str(),
+				changeOf(&Entry::allocationsPerUnit).c_str(),
+				mb(base).c_str(),
+				mb(result).c_str(),
+				base && result && base->peakRSS > 0 && result->peakRSS > 0 ? changeOf(&Entry::peakRSS).c_str() : "",
+				status.c_str());
+			table += line;
+		}
+
+		return table;
+	}
+}
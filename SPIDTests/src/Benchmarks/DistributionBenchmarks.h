@@ -0,0 +1,190 @@
+#pragma once
+#include "Benchmark.h"
+#include "BenchmarkReport.h"
+
+#include "Distribute.h"
+#include "Outfits/OutfitManager.h"
+#include "Workload.h"
+
+// Parsing, lookup and distribution of synthetic load orders (see Workload.h).
+// Entries/s is the number of processed entries for parsing and lookup, and the number of evaluated NPC-entry pairs for distribution.
+// Results are also collected into Benchmark::Report, so that they can be compared against a baseline.
+namespace Distribute::Benchmarks
+{
+	constexpr static const char* moduleName = "Distribution";
+
+	constexpr static int samples = 3;
+
+	namespace detail
+	{
+		struct Measurement
+		{
+			::Benchmark::Sample sample{};
+			std::uint64_t       peakRSS{ 0 };  // peak of the whole process while the stage ran
+		};
+
+		/// Prints result of a stage and adds it to the report. a_units is the number of NPCs or entries that time and allocations are divided by,
+		/// a_entries is the number of entries that were processed (or NPC-entry pairs that were evaluated).
+		inline void report(const Workload::Shape& a_shape, const char* a_stage, const char* a_unit, const Measurement& a_measurement, std::size_t a_units, std::size_t a_entries)
+		{
+			const auto units = static_cast<double>(std::max<std::size_t>(a_units, 1));
+			const auto& [sample, peakRSS] = a_measurement;
+
+			::Benchmark::Report::Entry entry{
+				.name = a_shape.name + "/" + a_stage,
+				.unit = a_unit,
+				.nsPerUnit = sample.ns / units,
+				.allocationsPerUnit = static_cast<double>(sample.allocations) / units,
+				.peakRSS = peakRSS
+			};
+
+			std::printf("\t%-24s %14.2f ns/%-6s %12.2f allocs/%-6s %16.0f entries/s %10.1f MB peak\n",
+				a_stage, entry.nsPerUnit, a_unit, entry.allocationsPerUnit, a_unit,
+				static_cast<double>(a_entries) / (sample.ns / 1e9),
+				static_cast<double>(peakRSS) / (1024 * 1024));
+
+			::Benchmark::Report::GetResults().push_back(std::move(entry));
+		}
+
+		/// Measures a stage, tracking peak memory used while it runs.
+		/// Peak is read right away, since other stages are measured before this one is reported.
+		inline Measurement measure(const std::function<void()>& a_setup, const std::function<void()>& a_func)
+		{
+			::Benchmark::ResetPeakRSS();
+			const auto sample = ::Benchmark::Measure(a_setup, a_func, samples);
+			return { sample, ::Benchmark::GetPeakRSS() };
+		}
+
+		/// Entries of the first distribution pass, same as the ones Distribute(NPCData&, bool) uses.
+		inline Forms::DistributionSet get_regular_entries()
+		{
+			return {
+				Forms::spells.GetForms(),
+				Forms::perks.GetForms(),
+				Forms::items.GetForms(),
+				Forms::shouts.GetForms(),
+				Forms::levSpells.GetForms(),
+				Forms::packages.GetForms(),
+				Forms::DistributionSet::empty<RE::BGSOutfit>(),
+				Forms::keywords.GetForms(),
+				Forms::factions.GetForms(),
+				Forms::sleepOutfits.GetForms(),
+				Forms::skins.GetForms()
+			};
+		}
+	}
+
+	inline void RunScenario(const Workload::Shape& a_shape)
+	{
+		auto world = Workload::Generate(a_shape);
+
+		std::size_t linkedEntries = 0;
+		for (const auto& [type, entries] : world.linkedConfigs) {
+			linkedEntries += entries.size();
+		}
+
+		const auto lines = world.lines.size();
+		const auto npcs = world.actors.size();
+
+		Workload::World parsed{};
+		const auto      parse = detail::measure([&] { parsed = {}; }, [&] { Workload::Parse(world.lines, parsed); });
+
+		const auto dataHandler = RE::TESDataHandler::GetSingleton();
+
+		// Keyword dependencies are resolved right after entries are looked up, before anything else.
+		const auto keywordDependencies = detail::measure([&] {
+			Workload::LoadConfigs(world);
+			::Lookup::LookupEntries(dataHandler, Distribution::INI::configs);
+		},
+			Dependencies::ResolveKeywords);
+		const auto keywordEntries = Forms::keywords.GetSize();
+
+		const auto lookup = detail::measure([&] { Workload::LoadConfigs(world); }, Workload::LookupConfigs);
+
+		const auto entries = Forms::GetTotalEntries();
+
+		std::printf("\t%zu NPCs, %zu entries (%zu valid), %zu linked, %zu exclusive groups\n", npcs, lines, entries, linkedEntries, world.exclusiveGroups.size());
+
+		detail::report(a_shape, "Parse", "entry", parse, lines, lines);
+		detail::report(a_shape, "Lookup", "entry", lookup, lines, lines);
+		detail::report(a_shape, "KeywordDependencies", "entry", keywordDependencies, keywordEntries, keywordEntries);
+
+		std::vector<std::unique_ptr<NPCData>> npcData;
+		npcData.reserve(npcs);
+		for (const auto actor : world.actors) {
+			npcData.push_back(std::make_unique<NPCData>(actor));
+		}
+
+		const auto evaluateFilters = [&] {
+			std::size_t passed = 0;
+			for (const auto& data : npcData) {
+				Forms::ForEachDistributable([&]<class Form>(Forms::Distributables<Form>& a_distributable) {
+					for (const auto& formData : a_distributable.GetForms()) {
+						passed += formData.filters.PassedFilters(*data) == Filter::Result::kPass;
+					}
+				});
+			}
+			::Benchmark::DoNotOptimize(passed);
+		};
+
+		detail::report(a_shape, "PassedFilters", "NPC", detail::measure({}, evaluateFilters), npcs, npcs * entries);
+
+		// Same as what happens when an actor is loaded: regular distribution with linked forms, followed by outfits.
+		const auto distributeAll = [&] {
+			for (const auto actor : world.actors) {
+				auto data = NPCData(actor);
+				Distribute(data, false);
+				DistributeOutfits(data, false);
+			}
+		};
+
+		detail::report(a_shape, "Distribute", "NPC", detail::measure([&] { Workload::Restore(world); }, distributeAll), npcs, npcs * entries);
+
+		if (linkedEntries == 0) {
+			return;
+		}
+
+		// Only the linked pass is measured, forms of the first pass are distributed during setup.
+		std::vector<PCLevelMult::Input>      inputs;
+		std::vector<Forms::DistributedForms> distributedForms(npcs);
+		for (const auto actor : world.actors) {
+			inputs.emplace_back(actor, actor->GetActorBase(), false);
+		}
+
+		const auto distributeFirstPass = [&] {
+			Workload::Restore(world);
+			auto regularEntries = detail::get_regular_entries();
+			for (std::size_t i = 0; i < npcs; ++i) {
+				npcData[i] = std::make_unique<NPCData>(world.actors[i]);
+				distributedForms[i].clear();
+				Distribute(*npcData[i], inputs[i], regularEntries, &distributedForms[i], Outfits::SetDefaultOutfit);
+			}
+		};
+
+		const auto distributeLinked = [&] {
+			const auto manager = LinkedDistribution::Manager::GetSingleton();
+			for (std::size_t i = 0; i < npcs; ++i) {
+				manager->ForEachLinkedDistributionSet(LinkedDistribution::kRegular, distributedForms[i], [&](Forms::DistributionSet& a_set) {
+					Distribute(*npcData[i], inputs[i], a_set, nullptr, Outfits::SetDefaultOutfit);
+				});
+			}
+		};
+
+		detail::report(a_shape, "LinkedDistribution", "NPC", detail::measure(distributeFirstPass, distributeLinked), npcs, npcs * linkedEntries);
+	}
+
+	BENCHMARK(Vanilla)
+	{
+		RunScenario(Workload::Scenarios::Vanilla());
+	}
+
+	BENCHMARK(HeavyOutfitPack)
+	{
+		RunScenario(Workload::Scenarios::HeavyOutfitPack());
+	}
+
+	BENCHMARK(Entries100k)
+	{
+		RunScenario(Workload::Scenarios::Entries100k());
+	}
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include "Benchmark.h"
+#include "EntrySanitizer.h"
+#include "Legacy/RegexSanitizer.h"
+#include "Resources.h"
+
+namespace Sanitizer::Benchmarks
+{
+	constexpr static const char* moduleName = "EntrySanitizer";
+
+	/// Entries in the shape they're usually written by hand, which need most of the rules applied.
+	inline const std::vector<std::string>& GetMessyEntries()
+	{
+		static const std::vector<std::string> entries{
+			"0x00012345 - Skyrim.esm | ActorTypeNPC , Guard | 0x000A1B2C - Skyrim.esm , -0x0013746 | 5 | NONE | 1 | 50",
+			"Spell = 00012FCD | Bandit , Necromancer | NONE | 20/ , OneHanded(15) | M | NONE | 100",
+			"MyVerySpecialKeyword | *Guard , -Balgruuf | WhiterunLocation , CrimeFactionWhiterun | NONE | F/U",
+		};
+		return entries;
+	}
+
+	inline void Run(const std::vector<std::string>& a_entries)
+	{
+		Benchmark::Run("regex (legacy)", 2000, [&] {
+			for (const auto& entry : a_entries) {
+				Benchmark::DoNotOptimize(Legacy::sanitize(entry));
+			}
+		});
+
+		Benchmark::Run("single pass", 2000, [&] {
+			for (const auto& entry : a_entries) {
+				Benchmark::DoNotOptimize(sanitize(entry));
+			}
+		});
+
+		std::string buffer;
+		Benchmark::Run("single pass (reused buffer)", 2000, [&] {
+			for (const auto& entry : a_entries) {
+				sanitize(entry, buffer);
+				Benchmark::DoNotOptimize(buffer);
+			}
+		});
+	}
+
+	BENCHMARK(ReferenceEntries)
+	{
+		Run(Resources::LoadReferenceEntries());
+	}
+
+	BENCHMARK(MessyEntries)
+	{
+		Run(GetMessyEntries());
+	}
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include "Benchmark.h"
+#include "IniReader.h"
+#include "Resources.h"
+
+#include <map>
+
+namespace Ini::Benchmarks
+{
+	constexpr static const char* moduleName = "IniReader";
+
+	/// A config file the size of a large _DISTR collection, built from all reference entries with comments in between.
+	inline std::string GetConfigText()
+	{
+		std::string text = "; Generated config\r\n\r\n";
+		const auto  entries = Resources::LoadReferenceEntries();
+		for (int copy = 0; copy < 10; ++copy) {
+			for (const auto& entry : entries) {
+				text += "; entry\r\nSpell = " + entry + "\r\n\r\n";
+			}
+		}
+		return text;
+	}
+
+	BENCHMARK(ReferenceConfig)
+	{
+		const auto text = GetConfigText();
+
+		// Roughly what CSimpleIniA does: every key and value is copied into a multimap before they can be read.
+		Benchmark::Run("copy into multimap", 200, [&] {
+			std::multimap<std::string, std::string, bool (*)(std::string_view, std::string_view)> values(KeyLess);
+			Scanner scanner(text);
+			for (Entry entry; scanner.Next(entry);) {
+				values.emplace(entry.key, entry.value);
+			}
+			Benchmark::DoNotOptimize(values);
+		});
+
+		Benchmark::Run("scan", 200, [&] {
+			Scanner     scanner(text);
+			std::size_t count = 0;
+			for (Entry entry; scanner.Next(entry);) {
+				count += entry.value.size();
+			}
+			Benchmark::DoNotOptimize(count);
+		});
+	}
+}
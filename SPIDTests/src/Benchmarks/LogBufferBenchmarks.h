@@ -0,0 +1,119 @@
+#pragma once
+#include "Benchmark.h"
+
+#include <spdlog/sinks/null_sink.h>
+
+// Compares deduplication of lookup errors by formatted messages (as LogBuffer used to do)
+// against deduplication by keys built from their arguments (as it does now).
+// Errors are logged to a null sink, so only formatting and deduplication are measured.
+namespace LogBuffer::Benchmarks
+{
+	constexpr static const char* moduleName = "LogBuffer";
+
+	constexpr static std::uint32_t errorsCount = 10000;
+
+	namespace Legacy
+	{
+		struct Entry
+		{
+			std::source_location loc;
+			std::string          message;
+
+			bool operator==(const Entry& other) const
+			{
+				return std::strcmp(loc.file_name(), other.loc.file_name()) == 0 && loc.line() == other.loc.line() && message == other.message;
+			}
+		};
+
+		struct EntryHash
+		{
+			std::uint64_t operator()(const Entry& entry) const noexcept
+			{
+				return ankerl::unordered_dense::detail::wyhash::hash(entry.message.c_str(), entry.message.size());
+			}
+		};
+
+		inline ankerl::unordered_dense::set<Entry, EntryHash> buffer{};
+
+		template <class... Args>
+		struct error
+		{
+			explicit error(
+				fmt::format_string<Args...> a_fmt,
+				Args&&... a_args,
+				std::source_location a_loc = std::source_location::current())
+			{
+				if (buffer.insert({ a_loc, fmt::format(a_fmt, std::forward<Args>(a_args)...) }).second) {
+					spdlog::log(spdlog::source_loc{ a_loc.file_name(), static_cast<int>(a_loc.line()), a_loc.function_name() }, spdlog::level::err, a_fmt, std::forward<Args>(a_args)...);
+				}
+			}
+		};
+		template <class... Args>
+		error(fmt::format_string<Args...>, Args&&...) -> error<Args...>;
+
+		inline std::size_t GetRetainedBytes()
+		{
+			std::size_t bytes = 0;
+			for (const auto& entry : buffer) {
+				bytes += sizeof(Entry) + (entry.message.size() > 15 ? entry.message.capacity() + 1 : 0);
+			}
+			return bytes;
+		}
+	}
+
+	/// Same arguments that Forms::Distributables log when a plugin of a filter is missing. Every error is reported twice, as lookup and linked lookup do.
+	struct Reference
+	{
+		std::string   path;
+		std::uint32_t formID;
+		std::string   modName;
+	};
+
+	inline const std::vector<Reference>& GetMissingReferences()
+	{
+		static const std::vector<Reference> references = [] {
+			std::vector<Reference> result;
+			for (std::uint32_t i = 0; i < errorsCount; ++i) {
+				const auto reference = i / 2;
+				result.push_back({ fmt::format("Data\\ModName_Compatibility_Patch_{}_DISTR.ini", reference % 200), 0x800 + reference, fmt::format("OptionalPatch_{}.esp", reference % 50) });
+			}
+			return result;
+		}();
+		return references;
+	}
+
+	BENCHMARK(LookupErrors)
+	{
+		const auto previous = spdlog::default_logger();
+		auto       log = std::make_shared<spdlog::logger>("null", std::make_shared<spdlog::sinks::null_sink_st>());
+		log->set_level(spdlog::level::err);
+		spdlog::set_default_logger(log);
+
+		const auto& references = GetMissingReferences();
+
+		const auto legacy = ::Benchmark::Measure([] { Legacy::buffer.clear(); }, [&] {
+			for (const auto& e : references) {
+				Legacy::error("\t\t[{}] Filter [0x{:X}] ({}) SKIP - formID doesn't exist", e.path, e.formID, e.modName);
+			}
+		});
+		const auto legacyBytes = Legacy::GetRetainedBytes();
+
+		const auto keyed = ::Benchmark::Measure([] { clear(); }, [&] {
+			for (const auto& e : references) {
+				error("\t\t[{}] Filter [0x{:X}] ({}) SKIP - formID doesn't exist", e.path, e.formID, e.modName);
+			}
+		});
+		std::size_t keyedBytes = 0;
+		for (const auto& key : detail::buffer) {
+			keyedBytes += sizeof(std::string) + (key.size() > 15 ? key.capacity() + 1 : 0);
+		}
+
+		std::printf("\t(%u lookup errors, %zu distinct)\n", errorsCount, detail::buffer.size());
+		std::printf("\t%-24s %14.2f ns/error %8.2f allocs/error %10zu bytes retained\n", "formatted (legacy)", legacy.ns / errorsCount, static_cast<double>(legacy.allocations) / errorsCount, legacyBytes);
+		std::printf("\t%-24s %14.2f ns/error %8.2f allocs/error %10zu bytes retained\n", "keyed", keyed.ns / errorsCount, static_cast<double>(keyed.allocations) / errorsCount, keyedBytes);
+
+		Legacy::buffer.clear();
+		clear();
+		spdlog::set_default_logger(previous);
+	}
+}
@@ -0,0 +1,138 @@
+#pragma once
+#include "Benchmark.h"
+
+#include <expected>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Compares reporting of failed form lookups with exceptions (as Forms::detail::get_form_or_mod used to do)
+// against returning std::expected with a typed error (as it does now).
+// The game's data handler is modelled by a plain map of plugin names, since only the failure path is measured.
+namespace Lookup::Benchmarks
+{
+	constexpr static const char* moduleName = "LookupErrors";
+
+	constexpr static int lookupsCount = 10000;
+
+	struct FormModPair
+	{
+		std::optional<std::uint32_t> formID;
+		std::optional<std::string>   modName;
+	};
+
+	inline const std::unordered_map<std::string, int>& GetLoadedPlugins()
+	{
+		static const std::unordered_map<std::string, int> plugins{
+			{ "Skyrim.esm", 0 },
+			{ "Update.esm", 1 },
+			{ "Dawnguard.esm", 2 },
+			{ "HearthFires.esm", 3 },
+			{ "Dragonborn.esm", 4 }
+		};
+		return plugins;
+	}
+
+	/// References to plugins that are not installed, which is what optional patches typically produce.
+	inline const std::vector<FormModPair>& GetMissingReferences()
+	{
+		static const std::vector<FormModPair> references = [] {
+			std::vector<FormModPair> result;
+			for (int i = 0; i < lookupsCount; ++i) {
+				result.push_back({ 0x800 + i, "OptionalPatch_" + std::to_string(i % 50) + ".esp" });
+			}
+			return result;
+		}();
+		return references;
+	}
+
+	inline const std::string& GetPath()
+	{
+		static const std::string path = "Data\\ModName_Compatibility_Patch_DISTR.ini";
+		return path;
+	}
+
+	namespace Legacy
+	{
+		struct UnknownPluginException : std::exception
+		{
+			const std::string modName;
+			const std::string path;
+
+			UnknownPluginException(const std::string& modName, const std::string& path) :
+				modName(modName),
+				path(path)
+			{}
+		};
+
+		[[gnu::noinline]] inline int get_form(const FormModPair& a_formMod, const std::string& a_path)
+		{
+			const auto& plugins = GetLoadedPlugins();
+			if (const auto it = plugins.find(*a_formMod.modName); it != plugins.end()) {
+				return it->second;
+			}
+			throw UnknownPluginException(*a_formMod.modName, a_path);
+		}
+
+		inline std::size_t LookupAll()
+		{
+			std::size_t failed = 0;
+			for (const auto& reference : GetMissingReferences()) {
+				try {
+					Benchmark::DoNotOptimize(get_form(reference, GetPath()));
+				} catch (const UnknownPluginException& e) {
+					failed += e.modName.size();
+				}
+			}
+			return failed;
+		}
+	}
+
+	namespace Expected
+	{
+		enum class ErrorType : std::uint8_t
+		{
+			kUnknownPlugin = 0
+		};
+
+		struct Error
+		{
+			ErrorType                       type;
+			std::string_view                path{};
+			std::optional<std::string_view> modName{};
+		};
+
+		[[gnu::noinline]] inline std::expected<int, Error> get_form(const FormModPair& a_formMod, const std::string& a_path)
+		{
+			const auto& plugins = GetLoadedPlugins();
+			if (const auto it = plugins.find(*a_formMod.modName); it != plugins.end()) {
+				return it->second;
+			}
+			return std::unexpected(Error{ .type = ErrorType::kUnknownPlugin, .path = a_path, .modName = *a_formMod.modName });
+		}
+
+		inline std::size_t LookupAll()
+		{
+			std::size_t failed = 0;
+			for (const auto& reference : GetMissingReferences()) {
+				const auto form = get_form(reference, GetPath());
+				if (form) {
+					Benchmark::DoNotOptimize(*form);
+				} else if (form.error().type == ErrorType::kUnknownPlugin) {
+					failed += form.error().modName->size();
+				}
+			}
+			return failed;
+		}
+	}
+
+	BENCHMARK(FailingLookups)
+	{
+		std::printf("\t(time per %d failing lookups)\n", lookupsCount);
+		Benchmark::Run("exceptions (legacy)", 20, [] { Benchmark::DoNotOptimize(Legacy::LookupAll()); });
+		Benchmark::Run("std::expected", 20, [] { Benchmark::DoNotOptimize(Expected::LookupAll()); });
+	}
+}
@@ -0,0 +1,163 @@
+#pragma once
+#include "Benchmark.h"
+#include "StringKernels.h"
+
+#include <algorithm>
+#include <cctype>
+#include <vector>
+
+namespace Strings::Benchmarks
+{
+	constexpr static const char* moduleName = "StringKernels";
+
+	// Previous implementation of string filters, which casefolded both strings on every comparison.
+	namespace Legacy
+	{
+		inline bool iequals(std::string_view a_str1, std::string_view a_str2)
+		{
+			return std::ranges::equal(a_str1, a_str2, [](unsigned char ch1, unsigned char ch2) {
+				return std::toupper(ch1) == std::toupper(ch2);
+			});
+		}
+
+		inline bool icontains(std::string_view a_str1, std::string_view a_str2)
+		{
+			if (a_str2.length() > a_str1.length()) {
+				return false;
+			}
+			const auto subrange = std::ranges::search(a_str1, a_str2, [](unsigned char ch1, unsigned char ch2) {
+				return std::toupper(ch1) == std::toupper(ch2);
+			});
+			return !subrange.empty();
+		}
+	}
+
+	/// Strings that a typical NPC is matched against: name, editorIDs and keywords.
+	inline const std::vector<std::string>& GetNPCStrings()
+	{
+		static const std::vector<std::string> strings{
+			"Bandit Marauder",
+			"EncBanditMissile06Template",
+			"LvlBanditMissile",
+			"ActorTypeNPC",
+			"IsBeastRace",
+			"ImmuneParalysis",
+			"Vampire",
+			"ActorTypeUndead",
+			"RaceToScale",
+			"PlayableRace",
+			"ImmuneStrongUnarmed",
+			"OblivionRace",
+			"ArmorHeavy",
+			"ClothingRich",
+			"WeapTypeGreatsword"
+		};
+		return strings;
+	}
+
+	/// Substrings used by ANY (*) filters, most of which fail to match, which is the common case.
+	inline const std::vector<std::string>& GetFilterStrings()
+	{
+		static const std::vector<std::string> strings{ "Guard", "Dragon", "Necromancer", "bandit" };
+		return strings;
+	}
+
+	inline std::vector<std::string> FoldAll(const std::vector<std::string>& a_strings)
+	{
+		std::vector<std::string> result;
+		for (const auto& str : a_strings) {
+			result.push_back(fold(str));
+		}
+		return result;
+	}
+
+	BENCHMARK(ContainsStringFilter)
+	{
+		const auto& npcStrings = GetNPCStrings();
+		const auto& filterStrings = GetFilterStrings();
+
+		const auto foldedNPCStrings = FoldAll(npcStrings);
+		const auto foldedFilterStrings = FoldAll(filterStrings);
+
+		const auto run = [&](const auto& a_npcStrings, const auto& a_filterStrings, auto&& a_contains) {
+			return [&, a_contains] {
+				for (const auto& filter : a_filterStrings) {
+					for (const auto& str : a_npcStrings) {
+						Benchmark::DoNotOptimize(a_contains(str, filter));
+					}
+				}
+			};
+		};
+
+		Benchmark::Run("icontains (legacy)", 20000, run(npcStrings, filterStrings, Legacy::icontains));
+		Benchmark::Run("contains scalar (casefolded)", 20000, run(foldedNPCStrings, foldedFilterStrings, detail::contains_scalar));
+		if (GetSupportedISA() >= ISA::kSSE2) {
+			Benchmark::Run("contains SSE2 (casefolded)", 20000, run(foldedNPCStrings, foldedFilterStrings, detail::contains_sse2));
+		}
+		if (GetSupportedISA() >= ISA::kAVX2) {
+			Benchmark::Run("contains AVX2 (casefolded)", 20000, run(foldedNPCStrings, foldedFilterStrings, detail::contains_avx2));
+		}
+	}
+
+	BENCHMARK(ContainsLongHaystack)
+	{
+		// Long names (e.g. from translation mods) where candidate filtering pays off.
+		std::string haystack;
+		while (haystack.size() < 256) {
+			haystack += "enc bandit missile template ";
+		}
+		const std::string needle = "necromancer";
+
+		Benchmark::Run("icontains (legacy)", 100000, [&] { Benchmark::DoNotOptimize(Legacy::icontains(haystack, needle)); });
+		Benchmark::Run("contains scalar (casefolded)", 100000, [&] { Benchmark::DoNotOptimize(detail::contains_scalar(haystack, needle)); });
+		if (GetSupportedISA() >= ISA::kSSE2) {
+			Benchmark::Run("contains SSE2 (casefolded)", 100000, [&] { Benchmark::DoNotOptimize(detail::contains_sse2(haystack, needle)); });
+		}
+		if (GetSupportedISA() >= ISA::kAVX2) {
+			Benchmark::Run("contains AVX2 (casefolded)", 100000, [&] { Benchmark::DoNotOptimize(detail::contains_avx2(haystack, needle)); });
+		}
+	}
+
+	BENCHMARK(HasStringFilter)
+	{
+		const auto& npcStrings = GetNPCStrings();
+		const auto  filter = std::string("WEAPTYPEGREATSWORD");
+
+		// What used to be done for each string filter: compare with every keyword ignoring case.
+		Benchmark::Run("iequals (legacy)", 100000, [&] {
+			Benchmark::DoNotOptimize(std::ranges::any_of(npcStrings, [&](const auto& str) { return Legacy::iequals(str, filter); }));
+		});
+
+		// Interned strings are compared by ID, so this is bounded by the cost of integer comparisons.
+		std::vector<std::uint32_t> ids(npcStrings.size());
+		for (std::uint32_t i = 0; i < ids.size(); ++i) {
+			ids[i] = i + 1;
+		}
+		const std::uint32_t filterID = static_cast<std::uint32_t>(ids.size());
+
+		Benchmark::Run("ID compare (interned)", 100000, [&] {
+			Benchmark::DoNotOptimize(std::ranges::find(ids, filterID) != ids.end());
+		});
+	}
+
+	BENCHMARK(Fold)
+	{
+		const std::string input = "EncBanditMissile06Template ClothingRich WeapTypeGreatsword ImmuneParalysis";
+
+		const auto run = [&](auto&& a_fold) {
+			return [&, a_fold] {
+				std::string copy = input;
+				a_fold(copy.data(), copy.size());
+				Benchmark::DoNotOptimize(copy);
+			};
+		};
+
+		Benchmark::Run("fold scalar", 200000, run(detail::fold_scalar));
+		if (GetSupportedISA() >= ISA::kSSE2) {
+			Benchmark::Run("fold SSE2", 200000, run(detail::fold_sse2));
+		}
+		if (GetSupportedISA() >= ISA::kAVX2) {
+			Benchmark::Run("fold AVX2", 200000, run(detail::fold_avx2));
+		}
+	}
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+// Regex-based sanitizer that Distribution::INI::detail::sanitize used before it was replaced with Sanitizer::sanitize.
+// The plugin used srell, which isn't available here, so the same patterns are run with std::regex (both implement ECMAScript syntax).
+// Serves as a reference for differential tests and as a baseline for benchmarks.
+
+#include <regex>
+#include <string>
+
+namespace Legacy
+{
+	inline std::string sanitize(const std::string& a_value, bool a_swapVRMasters = false)
+	{
+		auto newValue = a_value;
+
+		//formID hypen
+		if (!newValue.contains('~')) {
+			if (const auto pos = newValue.find(" - "); pos != std::string::npos) {
+				newValue.replace(pos, 3, "~");
+			}
+		}
+
+		if (a_swapVRMasters) {
+			static const std::regex re_dawnguard(R"((0x0*2)([0-9a-f]{6}))", std::regex_constants::optimize | std::regex::icase);
+			newValue = std::regex_replace(newValue, re_dawnguard, "0x$2~Dawnguard.esm");
+
+			static const std::regex re_dragonborn(R"((0x0*4)([0-9a-f]{6}))", std::regex_constants::optimize | std::regex::icase);
+			newValue = std::regex_replace(newValue, re_dragonborn, "0x$2~Dragonborn.esm");
+		}
+
+		//strip spaces between " | "
+		static const std::regex re_bar(R"(\s*\|\s*)", std::regex_constants::optimize);
+		newValue = std::regex_replace(newValue, re_bar, "|");
+
+		//strip spaces between " , "
+		static const std::regex re_comma(R"(\s*,\s*)", std::regex_constants::optimize);
+		newValue = std::regex_replace(newValue, re_comma, ",");
+
+		//convert 00012345 formIDs to 0x12345
+		static const std::regex re_formID(R"(\b00+([0-9a-fA-F]{1,6})\b)", std::regex_constants::optimize);
+		newValue = std::regex_replace(newValue, re_formID, "0x$1");
+
+		//strip leading zeros
+		static const std::regex re_zeros(R"((0x00+)([0-9a-fA-F]+))", std::regex_constants::optimize);
+		newValue = std::regex_replace(newValue, re_zeros, "0x$2");
+
+		return newValue;
+	}
+}
@@ -0,0 +1,371 @@
+#pragma once
+
+// Rebuilds distribution sessions recorded in the game (see SPID/src/SessionCapture.h) out of mock forms,
+// so that they can be profiled and compared between builds without running the game.
+
+#include "Distribute.h"
+#include "EditorIDIndex.h"
+#include "FormData.h"
+#include "Mock.h"
+#include "PCLevelMultManager.h"
+#include "SessionCapture.h"
+
+namespace Replay
+{
+	using Session = Distribution::Capture::Session;
+	using Snapshot = Distribution::Capture::Actor;
+
+	/// Mock world built from a capture.
+	struct World
+	{
+		/// Actor of each snapshot, in the order they were recorded. Snapshots of the same actor share it.
+		std::vector<RE::Actor*> actors{};
+
+		/// Forms whose type has no mock counterpart. They are rebuilt as generic bound objects of the same type.
+		std::size_t genericForms{ 0 };
+		/// Entries that were skipped because their form wasn't captured.
+		std::size_t skippedEntries{ 0 };
+	};
+
+	namespace detail
+	{
+		inline RE::TESForm* create_form(const Distribution::Capture::Form& a_form, RE::TESFile* a_file, World& a_world)
+		{
+			const auto create = [&]<class Form>() -> RE::TESForm* {
+				return Mock::Create<Form>(a_form.formID, a_form.editorID, a_file);
+			};
+
+			switch (a_form.formType) {
+			case RE::FormType::Keyword:
+				return create.template operator()<RE::BGSKeyword>();
+			case RE::FormType::Class:
+				return create.template operator()<RE::TESClass>();
+			case RE::FormType::Faction:
+				return create.template operator()<RE::TESFaction>();
+			case RE::FormType::Race:
+				return create.template operator()<RE::TESRace>();
+			case RE::FormType::Spell:
+				return create.template operator()<RE::SpellItem>();
+			case RE::FormType::Armor:
+				return create.template operator()<RE::TESObjectARMO>();
+			case RE::FormType::Book:
+				return create.template operator()<RE::TESObjectBOOK>();
+			case RE::FormType::Misc:
+				return create.template operator()<RE::TESObjectMISC>();
+			case RE::FormType::Weapon:
+				return create.template operator()<RE::TESObjectWEAP>();
+			case RE::FormType::NPC:
+				return create.template operator()<RE::TESNPC>();
+			case RE::FormType::LeveledItem:
+				return create.template operator()<RE::TESLevItem>();
+			case RE::FormType::Package:
+				return create.template operator()<RE::TESPackage>();
+			case RE::FormType::CombatStyle:
+				return create.template operator()<RE::TESCombatStyle>();
+			case RE::FormType::LeveledSpell:
+				return create.template operator()<RE::TESLevSpell>();
+			case RE::FormType::FormList:
+				return create.template operator()<RE::BGSListForm>();
+			case RE::FormType::Perk:
+				return create.template operator()<RE::BGSPerk>();
+			case RE::FormType::VoiceType:
+				return create.template operator()<RE::BGSVoiceType>();
+			case RE::FormType::Location:
+				return create.template operator()<RE::BGSLocation>();
+			case RE::FormType::Shout:
+				return create.template operator()<RE::TESShout>();
+			case RE::FormType::Outfit:
+				return create.template operator()<RE::BGSOutfit>();
+			default:
+				{
+					// Potions, ammo, scrolls and other items are only ever distributed as items.
+					const auto form = create.template operator()<RE::TESObjectMISC>();
+					form->formType = a_form.formType;
+					++a_world.genericForms;
+					return form;
+				}
+			}
+		}
+
+		/// Links forms to forms that they reference once all of them exist.
+		inline void link_form(const Distribution::Capture::Form& a_form, RE::TESForm* a_created)
+		{
+			if (const auto race = a_created->As<RE::TESRace>()) {
+				if (a_form.flags & Distribution::Capture::Form::kChildRace) {
+					race->data.flags |= RE::TESRace::RACE_DATA::kChild;
+				}
+				for (const auto keyword : a_form.keywords) {
+					race->AddKeyword(RE::TESForm::LookupByID<RE::BGSKeyword>(keyword));
+				}
+			} else if (const auto list = a_created->As<RE::BGSListForm>()) {
+				for (const auto formID : a_form.forms) {
+					if (const auto form = RE::TESForm::LookupByID(formID)) {
+						list->forms.push_back(form);
+					}
+				}
+			} else if (const auto npcClass = a_created->As<RE::TESClass>(); npcClass && a_form.skillWeights.size() == RE::TESNPC::Skills::kTotal) {
+				auto&       weights = npcClass->data.skillWeights;
+				const auto& captured = a_form.skillWeights;
+				std::tie(weights.oneHanded, weights.twoHanded, weights.archery, weights.block, weights.smithing, weights.heavyArmor,
+					weights.lightArmor, weights.pickpocket, weights.lockpicking, weights.sneak, weights.alchemy, weights.speech,
+					weights.alteration, weights.conjuration, weights.destruction, weights.illusion, weights.restoration, weights.enchanting) =
+					std::tie(captured[0], captured[1], captured[2], captured[3], captured[4], captured[5],
+						captured[6], captured[7], captured[8], captured[9], captured[10], captured[11],
+						captured[12], captured[13], captured[14], captured[15], captured[16], captured[17]);
+			}
+		}
+
+		template <class Form>
+		Form* find(RE::FormID a_formID)
+		{
+			return a_formID ? RE::TESForm::LookupByID<Form>(a_formID) : nullptr;
+		}
+
+		template <class Form>
+		Form* as(RE::TESForm* a_form)
+		{
+			if constexpr (std::is_same_v<Form, RE::TESForm>) {
+				return a_form;
+			} else if constexpr (std::is_same_v<Form, RE::TESBoundObject>) {
+				return static_cast<Form*>(a_form);
+			} else {
+				return a_form ? a_form->As<Form>() : nullptr;
+			}
+		}
+
+		inline void install_entries(const Session& a_session, World& a_world)
+		{
+			const auto dataHandler = RE::TESDataHandler::GetSingleton();
+
+			const auto to_forms = [&](const std::vector<Distribution::Capture::FormRef>& a_refs) {
+				FormVec forms{};
+				for (const auto& ref : a_refs) {
+					std::visit(overload{
+								   [&](RE::FormID a_formID) {
+									   if (const auto form = RE::TESForm::LookupByID(a_formID)) {
+										   forms.emplace_back(form);
+									   }
+								   },
+								   [&](Distribution::Capture::PluginIndex a_plugin) {
+									   if (a_plugin.value < dataHandler->files.size()) {
+										   forms.emplace_back(dataHandler->files[a_plugin.value]);
+									   }
+								   } },
+						ref);
+				}
+				return forms;
+			};
+
+			Forms::ForEachDistributable([&]<class Form>(Forms::Distributables<Form>& a_distributable) {
+				a_distributable.GetForms().clear();
+
+				for (const auto& entry : a_session.entries) {
+					if (entry.type != a_distributable.GetType()) {
+						continue;
+					}
+
+					const auto form = as<Form>(RE::TESForm::LookupByID(entry.form));
+					if (!form) {
+						++a_world.skippedEntries;
+						continue;
+					}
+
+					FormFilters forms{ to_forms(entry.forms.ALL), to_forms(entry.forms.NOT), to_forms(entry.forms.MATCH) };
+					FilterData  filters{ entry.strings, std::move(forms), entry.levels, entry.traits, entry.chance };
+					a_distributable.EmplaceForm(true, form, entry.isFinal, entry.idxOrCount, filters, entry.path, entry.source);
+				}
+
+				a_distributable.FinishLookupForms();
+			});
+		}
+	}
+
+	/// <summary>
+	/// Destroys forms of the previous world and rebuilds plugins, forms and entries of a capture along with an actor for every snapshot.
+	/// Snapshots are applied to their actors later, right before they are distributed to (see Apply).
+	/// </summary>
+	inline World Load(const Session& a_session)
+	{
+		World world{};
+
+		Mock::Reset();
+
+		const auto dataHandler = RE::TESDataHandler::GetSingleton();
+		for (const auto& [name, compileIndex] : a_session.plugins) {
+			Mock::AddFile(name)->compileIndex = compileIndex;
+		}
+
+		std::vector<RE::TESForm*> created{};
+		created.reserve(a_session.forms.size());
+		for (const auto& form : a_session.forms) {
+			const auto file = form.plugin < dataHandler->files.size() ? dataHandler->files[form.plugin] : nullptr;
+			const auto result = detail::create_form(form, file, world);
+			result->fullName = form.name;
+			created.push_back(result);
+		}
+		for (std::size_t i = 0; i < created.size(); ++i) {
+			detail::link_form(a_session.forms[i], created[i]);
+		}
+
+		Forms::EditorIDIndex::GetSingleton()->Build();
+
+		detail::install_entries(a_session, world);
+
+		Map<RE::FormID, RE::Actor*> actors{};
+		for (const auto& snapshot : a_session.actors) {
+			auto& actor = actors[snapshot.actorID];
+			if (!actor) {
+				actor = Mock::Create<RE::Actor>(snapshot.actorID, {}, nullptr);
+			}
+			world.actors.push_back(actor);
+		}
+
+		return world;
+	}
+
+	/// <summary>
+	/// Puts an actor and its NPC into the state they were in when a_snapshot was taken, discarding everything that was distributed since then.
+	/// </summary>
+	inline void Apply(const Snapshot& a_snapshot, RE::Actor* a_actor)
+	{
+		using detail::find;
+
+		const auto npc = find<RE::TESNPC>(a_snapshot.npcID);
+
+		a_actor->data.objectReference = npc;
+		a_actor->race = a_snapshot.race != a_snapshot.npcRace ? find<RE::TESRace>(a_snapshot.race) : nullptr;
+		a_actor->editorLocation = find<RE::BGSLocation>(a_snapshot.location);
+		a_actor->playerTeammate = a_snapshot.teammate;
+		a_actor->dead = a_snapshot.dead;
+		a_actor->outfitLooted = false;
+		a_actor->formFlags = a_snapshot.startsDead ? RE::Actor::RecordFlags::kStartsDead : 0;
+		a_actor->extraList = {};
+		if (a_snapshot.leveled) {
+			const auto leveled = a_actor->extraList.Add<RE::ExtraLeveledCreature>();
+			leveled->originalBase = find<RE::TESNPC>(a_snapshot.originalBase);
+			leveled->templateBase = find<RE::TESNPC>(a_snapshot.templateBase);
+		}
+
+		if (!npc) {
+			return;
+		}
+
+		if (!a_snapshot.name.empty()) {
+			npc->fullName = a_snapshot.name;
+		}
+
+		npc->race = find<RE::TESRace>(a_snapshot.npcRace);
+		npc->npcClass = find<RE::TESClass>(a_snapshot.npcClass);
+		npc->combatStyle = find<RE::TESCombatStyle>(a_snapshot.combatStyle);
+		npc->voiceType = find<RE::BGSVoiceType>(a_snapshot.voiceType);
+		npc->skin = find<RE::TESObjectARMO>(a_snapshot.skin);
+		npc->defaultOutfit = find<RE::BGSOutfit>(a_snapshot.defaultOutfit);
+		npc->sleepOutfit = find<RE::BGSOutfit>(a_snapshot.sleepOutfit);
+		npc->baseTemplateForm = find<RE::TESNPC>(a_snapshot.baseTemplate);
+
+		npc->actorData.level = a_snapshot.level;
+		npc->actorData.actorBaseFlags = (a_snapshot.female ? RE::TESNPC::ACTOR_BASE_DATA::kFemale : 0) |
+		                                (a_snapshot.unique ? RE::TESNPC::ACTOR_BASE_DATA::kUnique : 0) |
+		                                (a_snapshot.summonable ? RE::TESNPC::ACTOR_BASE_DATA::kSummonable : 0);
+		std::ranges::copy(a_snapshot.skills, npc->playerSkills.values);
+
+		npc->keywords.clear();
+		for (const auto keyword : a_snapshot.keywords) {
+			if (const auto form = find<RE::BGSKeyword>(keyword)) {
+				npc->AddKeyword(form);
+			}
+		}
+
+		npc->factions.clear();
+		for (const auto& [faction, rank] : a_snapshot.factions) {
+			npc->factions.push_back({ find<RE::TESFaction>(faction), rank });
+		}
+
+		// Everything else is only ever changed by distribution.
+		npc->perks.clear();
+		npc->actorEffects = {};
+		npc->aiPackages = {};
+		npc->container.clear();
+
+		PCLevelMult::Manager::GetSingleton()->DeleteNPC(npc->GetFormID());
+	}
+
+	/// <summary>
+	/// Distributes to an actor the same way the game did when a_snapshot was recorded. Returns how long it took in ns.
+	/// </summary>
+	inline std::uint64_t Distribute(const Snapshot& a_snapshot, RE::Actor* a_actor)
+	{
+		using clock = std::chrono::steady_clock;
+
+		const auto start = clock::now();
+		auto       npcData = NPCData(a_actor, a_actor->GetActorBase());
+		Distribute::Distribute(npcData, a_snapshot.onlyPlayerLevelEntries);
+
+		return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count());
+	}
+
+	/// <summary>
+	/// Lists everything that an NPC has, one line per kind, sorted by formID. Output of two builds can be diffed to find differences in distribution.
+	/// </summary>
+	inline std::string Describe(const RE::Actor* a_actor)
+	{
+		const auto npc = a_actor->GetActorBase();
+		if (!npc) {
+			return {};
+		}
+
+		std::string result;
+
+		const auto describe = [&](std::string_view a_kind, std::vector<RE::FormID> a_formIDs) {
+			std::ranges::sort(a_formIDs);
+			result += fmt::format("\t{}: {:08X}\n", a_kind, fmt::join(a_formIDs, " "));
+		};
+
+		const auto formIDs = [](const auto& a_forms) {
+			std::vector<RE::FormID> ids{};
+			for (const auto form : a_forms) {
+				if (form) {
+					ids.push_back(form->GetFormID());
+				}
+			}
+			return ids;
+		};
+
+		describe("keywords", formIDs(npc->keywords));
+
+		std::vector<RE::FormID> factions{};
+		for (const auto& [faction, rank] : npc->factions) {
+			if (faction && rank > -1) {
+				factions.push_back(faction->GetFormID());
+			}
+		}
+		describe("factions", factions);
+
+		describe("spells", formIDs(npc->actorEffects.spells));
+		describe("levSpells", formIDs(npc->actorEffects.levSpells));
+		describe("shouts", formIDs(npc->actorEffects.shouts));
+
+		std::vector<RE::FormID> perks{};
+		for (const auto& [perk, rank] : npc->perks) {
+			if (perk) {
+				perks.push_back(perk->GetFormID());
+			}
+		}
+		describe("perks", perks);
+
+		std::map<RE::FormID, std::int32_t> items{};
+		for (const auto& [item, count] : npc->container) {
+			items[item->GetFormID()] += count;
+		}
+		result += "\titems:";
+		for (const auto& [item, count] : items) {
+			result += fmt::format(" {:08X}x{}", item, count);
+		}
+		result += '\n';
+
+		describe("packages", formIDs(npc->aiPackages.packages));
+		describe("outfits", formIDs(std::vector<RE::TESForm*>{ npc->defaultOutfit, npc->sleepOutfit, npc->skin }));
+
+		return result;
+	}
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+// Access to files in the repository's resources folder. SPID_RESOURCES_DIR is defined by CMakeLists.txt.
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace Resources
+{
+	/// <summary>
+	/// Values of all config entries ("Key = Value") used as examples in "SPID Complete Reference.txt" with BBCode markup removed.
+	/// </summary>
+	inline std::vector<std::string> LoadReferenceEntries()
+	{
+		std::vector<std::string> entries;
+
+		std::ifstream file(SPID_RESOURCES_DIR "/SPID Complete Reference.txt");
+		std::string   line;
+		while (std::getline(file, line)) {
+			const auto separator = line.find(" = ");
+			if (separator == std::string::npos) {
+				continue;
+			}
+
+			auto value = line.substr(separator + 3);
+			if (const auto markup = value.find("[/"); markup != std::string::npos) {
+				value.erase(markup);
+			}
+			if (!value.empty() && value.back() == '\r') {
+				value.pop_back();
+			}
+			entries.push_back(std::move(value));
+		}
+
+		return entries;
+	}
+}
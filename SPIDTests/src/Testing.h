@@ -0,0 +1,86 @@
+#pragma once
+
+// A standalone counterpart of SPID/src/Testing/Testing.h that runs outside of the game.
+// Macros mirror those of in-game tests, so that test suites look the same in both places.
+
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <string>
+
+namespace Testing
+{
+	class TestResult
+	{
+	public:
+		static TestResult Success(std::string testName = __builtin_FUNCTION()) { return { true, "passed", testName }; }
+		static TestResult Fail(std::string message = "", std::string testName = __builtin_FUNCTION()) { return { false, message, testName }; }
+
+		bool        success;
+		std::string message;
+		std::string testName;
+	};
+
+	class Runner
+	{
+	private:
+		using Test = std::function<TestResult()>;
+		using TestSuite = std::map<std::string, Test>;
+		using TestModule = std::map<std::string, TestSuite>;
+
+		TestModule tests;
+
+	public:
+		static Runner* GetSingleton()
+		{
+			static Runner singleton;
+			return &singleton;
+		}
+
+		static bool RegisterTest(const char* moduleName, const char* testName, Test test)
+		{
+			auto& module = GetSingleton()->tests[moduleName];
+			return module.try_emplace(testName, test).second;
+		}
+
+		/// Runs all registered tests and returns number of failed tests.
+		static int Run()
+		{
+			int total = 0;
+			int success = 0;
+
+			for (auto& [moduleName, tests] : GetSingleton()->tests) {
+				std::printf("Running %s tests:\n", moduleName.c_str());
+				for (auto& [testName, test] : tests) {
+					const auto result = test();
+					if (result.success) {
+						std::printf("\t[PASS] %s\n", testName.c_str());
+						success++;
+					} else {
+						std::printf("\t[FAIL] %s: %s\n", testName.c_str(), result.message.c_str());
+					}
+					total++;
+				}
+			}
+
+			std::printf("Completed all tests: %d/%d tests passed\n", success, total);
+			return total - success;
+		}
+	};
+}
+
+#define TEST(name)                                                                                                         \
+	inline ::Testing::TestResult test##name();                                                                             \
+	static bool                  test##name##_registered = ::Testing::Runner::RegisterTest(moduleName, #name, test##name); \
+	inline ::Testing::TestResult test##name()
+
+#define PASS return ::Testing::TestResult::Success();
+
+#define FAIL(msg) return ::Testing::TestResult::Fail(msg);
+
+#define ASSERT(expr, msg) \
+	if (!(expr))          \
+		return ::Testing::TestResult::Fail(msg);
+
+#define EXPECT(expr, msg) \
+	return (expr) ? ::Testing::TestResult::Success() : ::Testing::TestResult::Fail(msg);
@@ -0,0 +1,83 @@
+#pragma once
+#include "AsyncLogSink.h"
+#include "Testing.h"
+
+namespace Log::Testing
+{
+	constexpr static const char* moduleName = "AsyncLog";
+
+	namespace detail
+	{
+		inline std::filesystem::path get_path(std::string_view a_name)
+		{
+			return std::filesystem::temp_directory_path() / fmt::format("SPIDTests_{}.log", a_name);
+		}
+
+		inline std::vector<std::string> read_lines(const std::filesystem::path& a_path)
+		{
+			std::ifstream            file(a_path);
+			std::vector<std::string> lines{};
+			for (std::string line; std::getline(file, line);) {
+				lines.push_back(line);
+			}
+			return lines;
+		}
+	}
+
+	TEST(KeepsMessagesOfAllThreadsInOrder)
+	{
+		const auto path = detail::get_path("ordered");
+
+		// Small queue makes logging threads wait for the writer.
+		const auto sink = std::make_shared<AsyncFileSink>(path, true, std::chrono::seconds(1), 16);
+		spdlog::logger log("test", sink);
+		log.set_pattern("%v");
+
+		std::vector<std::thread> threads{};
+		for (int t = 0; t < 4; ++t) {
+			threads.emplace_back([&log, t] {
+				for (int i = 0; i < 500; ++i) {
+					log.info("{} {}", t, i);
+				}
+			});
+		}
+		for (auto& thread : threads) {
+			thread.join();
+		}
+
+		ASSERT(sink->Drain(), "drain should succeed");
+		const auto lines = detail::read_lines(path);
+		ASSERT(lines.size() == 2000, fmt::format("expected 2000 lines, got {}", lines.size()));
+
+		std::array<int, 4> next{};
+		for (const auto& line : lines) {
+			int t = 0;
+			int i = 0;
+			ASSERT(std::sscanf(line.c_str(), "%d %d", &t, &i) == 2 && t >= 0 && t < 4, fmt::format("unexpected line '{}'", line));
+			ASSERT(i == next[t]++, fmt::format("messages of thread {} are out of order", t));
+		}
+		PASS;
+	}
+
+	TEST(FlushesWithoutDrain)
+	{
+		const auto path = detail::get_path("interval");
+
+		{
+			const auto sink = std::make_shared<AsyncFileSink>(path, true, std::chrono::milliseconds(20));
+			spdlog::logger log("test", sink);
+			log.set_pattern("%v");
+			log.info("flushed by writer");
+
+			const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+			while (detail::read_lines(path).empty() && std::chrono::steady_clock::now() < deadline) {
+				std::this_thread::sleep_for(std::chrono::milliseconds(5));
+			}
+			ASSERT(detail::read_lines(path) == std::vector<std::string>{ "flushed by writer" }, "writer should flush on its own");
+
+			log.info("written on destruction");
+		}
+
+		EXPECT(detail::read_lines(path).size() == 2, "destroying the sink should drain the queue");
+	}
+}
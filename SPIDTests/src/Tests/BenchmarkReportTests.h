@@ -0,0 +1,65 @@
+#pragma once
+#include "BenchmarkReport.h"
+#include "Testing.h"
+
+namespace Benchmark::Report::Testing
+{
+	constexpr static const char* moduleName = "BenchmarkReport";
+
+	inline Entry MakeEntry(std::string a_name, double a_ns, double a_allocations, std::uint64_t a_rss)
+	{
+		return { .name = std::move(a_name), .unit = "NPC", .nsPerUnit = a_ns, .allocationsPerUnit = a_allocations, .peakRSS = a_rss };
+	}
+
+	TEST(RoundTripsEntries)
+	{
+		auto entry = MakeEntry("vanilla/\"Distribute\"", 1234.5, 12.25, 1 << 20);
+		entry.tolerance = { .time = 0.5, .allocations = 0, .rss = 0.1 };
+
+		const auto read = Read(Write({ entry, MakeEntry("vanilla/Lookup", 0, 0, 0) }));
+		if (!read || read->size() != 2) {
+			FAIL("written report couldn't be read back");
+		}
+
+		const auto& first = read->front();
+		if (first.name != entry.name || first.unit != entry.unit || first.nsPerUnit != entry.nsPerUnit || first.allocationsPerUnit != entry.allocationsPerUnit || first.peakRSS != entry.peakRSS) {
+			FAIL("metrics didn't round trip");
+		}
+		if (first.tolerance.time != 0.5 || first.tolerance.allocations != 0 || first.tolerance.rss != 0.1) {
+			FAIL("tolerance didn't round trip");
+		}
+		PASS;
+	}
+
+	TEST(RejectsMalformedReports)
+	{
+		for (const auto json : { "", "{", "[]", R"({"benchmarks": [{"name": 1}]})", R"({"benchmarks": []} trailing)" }) {
+			if (Read(json)) {
+				FAIL(std::string("accepted '") + json + "'");
+			}
+		}
+		PASS;
+	}
+
+	TEST(FlagsMetricsOverTolerance)
+	{
+		const std::vector baseline{ MakeEntry("a", 100, 10, 100), MakeEntry("b", 100, 10, 100) };
+		const std::vector results{ MakeEntry("a", 120, 10.4, 114), MakeEntry("b", 130, 11, 200) };
+
+		const auto rows = Compare(baseline, results);
+		ASSERT(rows.size() == 2, "every benchmark should have a row");
+		ASSERT(!rows[0].IsRegression(), "changes within tolerance aren't regressions");
+		EXPECT((rows[1].regressions == std::vector<std::string>{ "time", "allocations", "rss" }), "all three metrics should regress");
+	}
+
+	TEST(FlagsMissingAndIgnoresNewBenchmarks)
+	{
+		const auto rows = Compare({ MakeEntry("removed", 1, 1, 1) }, { MakeEntry("added", 1000, 1000, 1000) });
+
+		const auto removed = std::ranges::find(rows, "removed", &Row::name);
+		const auto added = std::ranges::find(rows, "added", &Row::name);
+		ASSERT(removed != rows.end() && added != rows.end(), "both benchmarks should have rows");
+		ASSERT(removed->IsRegression(), "benchmark missing from results should fail the gate");
+		EXPECT(!added->IsRegression() && !added->baseline, "benchmark without baseline should be reported as new");
+	}
+}
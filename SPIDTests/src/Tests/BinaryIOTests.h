@@ -0,0 +1,250 @@
+#pragma once
+#include "BinaryIO.h"
+#include "MappedFile.h"
+#include "Testing.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <random>
+
+namespace Binary::Testing
+{
+	using namespace std::literals;
+
+	constexpr static const char* moduleName = "BinaryIO";
+
+	constexpr static std::uint32_t seed = 0xB10C;
+
+	inline std::filesystem::path TempPath(std::string_view a_name)
+	{
+		return std::filesystem::temp_directory_path() / ("SPIDTests_" + std::string(a_name));
+	}
+
+	/// Error of a failed operation, or nullopt if it succeeded.
+	template <class T>
+	std::optional<FileError> ErrorOf(const std::expected<T, FileError>& a_result)
+	{
+		return a_result ? std::nullopt : std::optional(a_result.error());
+	}
+
+	enum class Color : std::uint8_t
+	{
+		kRed,
+		kGreen,
+		kTotal
+	};
+
+	TEST(RoundTripsValues)
+	{
+		Writer writer;
+		writer.write(std::uint32_t{ 0xDEADBEEF });
+		writer.write(std::int16_t{ -42 });
+		writer.write(0.25);
+		writer.write(true);
+		writer.write(Color::kGreen);
+		writer.write("editorID"sv);
+		writer.write(std::string{});
+
+		Reader reader(writer.bytes());
+		if (reader.read<std::uint32_t>() != 0xDEADBEEF || reader.read<std::int16_t>() != -42 || reader.read<double>() != 0.25 || !reader.read<bool>()) {
+			FAIL("scalars didn't round trip");
+		}
+		if (reader.read_enum(Color::kTotal) != Color::kGreen) {
+			FAIL("enum didn't round trip");
+		}
+		if (reader.read_string() != "editorID" || !reader.read_string().empty()) {
+			FAIL("strings didn't round trip");
+		}
+		if (!reader.empty()) {
+			FAIL("reader didn't consume everything that was written");
+		}
+		PASS;
+	}
+
+	TEST(SkipsBlocks)
+	{
+		Writer writer;
+		const auto block = writer.begin_block();
+		writer.write(std::uint64_t{ 1 });
+		writer.write("skipped"sv);
+		writer.end_block(block);
+		writer.write(std::uint8_t{ 7 });
+
+		Reader reader(writer.bytes());
+		const auto skipped = reader.read_block();
+		if (skipped.size() != sizeof(std::uint64_t) + sizeof(std::uint32_t) + 7) {
+			FAIL("block has unexpected size " + std::to_string(skipped.size()));
+		}
+		if (reader.read<std::uint8_t>() != 7) {
+			FAIL("value after the block wasn't read");
+		}
+
+		Reader blockReader(skipped);
+		if (blockReader.read<std::uint64_t>() != 1 || blockReader.read_string() != "skipped") {
+			FAIL("block contents didn't round trip");
+		}
+		PASS;
+	}
+
+	TEST(RejectsTruncatedData)
+	{
+		Writer writer;
+		writer.write("truncated string"sv);
+
+		const auto bytes = writer.bytes();
+		for (std::size_t size = 0; size < bytes.size(); ++size) {
+			try {
+				Reader reader(bytes.first(size));
+				(void)reader.read_string();
+				FAIL("reading " + std::to_string(size) + " of " + std::to_string(bytes.size()) + " bytes didn't throw");
+			} catch (const ReadError&) {
+			}
+		}
+		PASS;
+	}
+
+	TEST(RejectsInvalidValues)
+	{
+		Writer writer;
+		writer.write(Color::kTotal);
+		writer.write(std::uint32_t{ 1000 });
+
+		Reader reader(writer.bytes());
+		try {
+			(void)reader.read_enum(Color::kTotal);
+			FAIL("out of range enum was accepted");
+		} catch (const ReadError&) {
+		}
+		try {
+			(void)reader.read_count();
+			FAIL("count larger than remaining data was accepted");
+		} catch (const ReadError&) {
+		}
+		PASS;
+	}
+
+	TEST(HashDetectsChanges)
+	{
+		std::mt19937                       rng(seed);
+		std::uniform_int_distribution<int> byte(0, 255);
+
+		// Sizes around 8 byte boundaries cover both word loop and the tail.
+		for (std::size_t size = 1; size < 40; ++size) {
+			std::vector<std::byte> data(size);
+			for (auto& value : data) {
+				value = static_cast<std::byte>(byte(rng));
+			}
+
+			const auto original = hash(data);
+			if (original != hash(data)) {
+				FAIL("hash isn't deterministic");
+			}
+			if (hash(std::span(data).first(size - 1)) == original) {
+				FAIL("hash didn't change when data was truncated to " + std::to_string(size - 1) + " bytes");
+			}
+
+			for (std::size_t i = 0; i < size; ++i) {
+				auto changed = data;
+				changed[i] ^= std::byte{ 1 };
+				if (hash(changed) == original) {
+					FAIL("hash didn't change when byte " + std::to_string(i) + " of " + std::to_string(size) + " was flipped");
+				}
+			}
+		}
+		PASS;
+	}
+
+	TEST(MapsFiles)
+	{
+		const auto path = TempPath("MapsFiles.bin");
+		{
+			std::ofstream file(path, std::ios::binary);
+			file << "Spell = 0x12345~Skyrim.esm";
+		}
+
+		{
+			const MappedFile file(path);
+			if (!file || file.text() != "Spell = 0x12345~Skyrim.esm") {
+				std::filesystem::remove(path);
+				FAIL("mapped file doesn't match its contents");
+			}
+		}
+
+		std::filesystem::remove(path);
+		PASS;
+	}
+
+	TEST(MapsEmptyAndMissingFiles)
+	{
+		const auto path = TempPath("MapsEmptyAndMissingFiles.bin");
+		{
+			std::ofstream file(path, std::ios::binary);
+		}
+
+		const auto isEmptyOpen = [&] {
+			const MappedFile file(path);
+			return file.IsOpen() && file.size() == 0;
+		}();
+		std::filesystem::remove(path);
+
+		if (!isEmptyOpen) {
+			FAIL("empty file wasn't opened");
+		}
+		if (MappedFile(path).IsOpen()) {
+			FAIL("missing file was opened");
+		}
+		PASS;
+	}
+
+	TEST(SavesAndValidatesFiles)
+	{
+		constexpr FileHeader header{ .magic = 0x54534554, .formatVersion = 2, .build = "1.0" };
+
+		const auto path = TempPath("SavesAndValidatesFiles.bin");
+
+		Writer payload;
+		payload.write("payload"sv);
+		if (!save_file(path, header, payload)) {
+			FAIL("file wasn't saved");
+		}
+
+		const auto result = [&]() -> std::string {
+			const MappedFile file(path);
+			auto             bytes = std::vector(file.bytes().begin(), file.bytes().end());
+
+			const auto opened = open_payload(bytes, header);
+			if (!opened || !std::ranges::equal(*opened, payload.bytes())) {
+				return "saved payload didn't round trip";
+			}
+			if (ErrorOf(open_payload(bytes, { header.magic, header.formatVersion + 1, header.build })) != FileError::kWrongVersion) {
+				return "different format version was accepted";
+			}
+			if (ErrorOf(open_payload(bytes, { header.magic, header.formatVersion, "1.1" })) != FileError::kWrongVersion) {
+				return "different build was accepted";
+			}
+			if (ErrorOf(open_payload(bytes, { header.magic + 1, header.formatVersion, header.build })) != FileError::kWrongMagic) {
+				return "different magic was accepted";
+			}
+
+			bytes.back() ^= std::byte{ 1 };
+			if (ErrorOf(open_payload(bytes, header)) != FileError::kCorrupted) {
+				return "corrupted payload was accepted";
+			}
+
+			bytes.pop_back();
+			if (ErrorOf(open_payload(bytes, header)) != FileError::kCorrupted) {
+				return "truncated payload was accepted";
+			}
+			return {};
+		}();
+
+		std::filesystem::remove(path);
+
+		if (!result.empty()) {
+			FAIL(result);
+		}
+		PASS;
+	}
+}
@@ -0,0 +1,137 @@
+#pragma once
+#include "Replay.h"
+#include "SessionCapture.h"
+#include "Testing.h"
+#include "TestsHelpers.h"
+
+#include <fstream>
+
+namespace Distribution::Capture::Testing
+{
+	namespace Helper = ::Testing::Helper;
+
+	constexpr static const char* moduleName = "SessionCapture";
+
+	namespace detail
+	{
+		inline std::filesystem::path get_path()
+		{
+			return std::filesystem::temp_directory_path() / "SPIDCoreTests.capture";
+		}
+
+		inline std::vector<std::byte> read_file(const std::filesystem::path& a_path)
+		{
+			std::ifstream          input(a_path, std::ios::binary);
+			std::vector<std::byte> bytes{};
+			for (char c; input.get(c);) {
+				bytes.push_back(static_cast<std::byte>(c));
+			}
+			return bytes;
+		}
+
+		/// Distributes a keyword to every Bandit and a spell to actors in a location, recording both actors.
+		inline std::vector<std::byte> capture(Helper::World& a_world, RE::BGSKeyword*& a_keyword)
+		{
+			a_world = Helper::Setup();
+
+			const auto location = Mock::Create<RE::BGSLocation>("BleakFallsBarrowLocation");
+			a_world.actor->editorLocation = location;
+			a_world.actor->GetActorBase()->actorData.level = 12;
+
+			a_keyword = Mock::Create<RE::BGSKeyword>("SPID_Bandit");
+			Forms::EditorIDIndex::GetSingleton()->Build();
+
+			StringFilters strings{};
+			strings.ALL = { "Bandit" };
+			Helper::Distribution::GetKeywords().EmplaceForm(true, a_keyword, false, RandomCount(1, 1), FilterData{ strings, {}, {}, {}, 100 }, "Keyword = SPID_Bandit|Bandit");
+
+			FormFilters forms{};
+			forms.ALL = { location };
+			Helper::Distribution::GetSpells().EmplaceForm(true, a_world.spell, false, RandomCount(1, 1), FilterData{ {}, forms, {}, {}, 100 }, "Spell = IceSpear|BleakFallsBarrowLocation");
+
+			const auto path = get_path();
+			if (!Start(path)) {
+				return {};
+			}
+			for (const auto actor : { a_world.actor, a_world.anotherActor }) {
+				Scope scope(actor, actor->GetActorBase(), false);
+				Helper::Distribution::Distribute(actor);
+			}
+			Stop();
+
+			auto bytes = read_file(path);
+			std::filesystem::remove(path);
+			return bytes;
+		}
+	}
+
+	TEST(RecordsEntriesAndActors)
+	{
+		Helper::World   world{};
+		RE::BGSKeyword* keyword = nullptr;
+
+		const auto session = Read(detail::capture(world, keyword));
+		ASSERT(session.has_value(), "capture should be readable");
+		ASSERT(!session->truncated, "capture should be complete after Stop");
+		ASSERT(session->entries.size() == 2, fmt::format("expected 2 entries, got {}", session->entries.size()));
+		ASSERT(session->actors.size() == 2, fmt::format("expected 2 actors, got {}", session->actors.size()));
+
+		const auto& snapshot = session->actors.front();
+		ASSERT(snapshot.actorID == world.actor->GetFormID() && snapshot.npcID == world.actor->GetActorBase()->GetFormID(), "snapshot should identify the actor and its NPC");
+		ASSERT(snapshot.level == 12 && snapshot.location == world.actor->editorLocation->GetFormID(), "snapshot should record level and location");
+		ASSERT(snapshot.keywords.empty(), "snapshot should be taken before distribution");
+
+		const auto recorded = std::ranges::find(session->forms, keyword->GetFormID(), &Form::formID);
+		EXPECT(recorded != session->forms.end() && recorded->editorID == "SPID_Bandit" && recorded->formType == RE::FormType::Keyword, "distributed keyword should be in the form table");
+	}
+
+	TEST(RejectsCorruptedCaptures)
+	{
+		Helper::World   world{};
+		RE::BGSKeyword* keyword = nullptr;
+
+		auto bytes = detail::capture(world, keyword);
+		ASSERT(!bytes.empty(), "capture should be written");
+
+		auto truncated = bytes;
+		truncated.resize(truncated.size() - 3);
+		const auto session = Read(truncated);
+		ASSERT(session && session->truncated && session->actors.size() == 1, "capture cut mid-record should keep complete records");
+
+		bytes[0] = std::byte{ 0 };
+		EXPECT(!Read(bytes), "capture with a wrong header should be rejected");
+	}
+
+	TEST(ReplayMatchesRecordedDistribution)
+	{
+		Helper::World   world{};
+		RE::BGSKeyword* keyword = nullptr;
+
+		const auto session = Read(detail::capture(world, keyword));
+		ASSERT(session && session->actors.size() == 2, "capture should be readable");
+
+		std::vector<std::string> expected{};
+		for (const auto actor : { world.actor, world.anotherActor }) {
+			expected.push_back(Replay::Describe(actor));
+		}
+
+		Helper::Distribution::ClearConfigs();
+		const auto replayed = Replay::Load(*session);
+		ASSERT(replayed.skippedEntries == 0 && replayed.actors.size() == 2, "every entry and actor should be rebuilt");
+
+		for (std::size_t i = 0; i < replayed.actors.size(); ++i) {
+			Replay::Apply(session->actors[i], replayed.actors[i]);
+			Replay::Distribute(session->actors[i], replayed.actors[i]);
+		}
+
+		// Packages that NPCs had before distribution aren't recorded, so only distributed ones can be compared.
+		for (std::size_t i = 0; i < expected.size(); ++i) {
+			const auto got = Replay::Describe(replayed.actors[i]);
+			const auto without_packages = [](const std::string& a_description) {
+				return a_description.substr(0, a_description.find("\tpackages:"));
+			};
+			ASSERT(without_packages(got) == without_packages(expected[i]), fmt::format("replay of actor {} differs:\n{}expected:\n{}", i, got, expected[i]));
+		}
+		PASS;
+	}
+}
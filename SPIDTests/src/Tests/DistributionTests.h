@@ -0,0 +1,195 @@
+#pragma once
+#include "Distribute.h"
+#include "Testing.h"
+#include "TestsHelpers.h"
+
+// Port of SPID/src/Testing/DistributionTests.h.
+namespace Distribute::Testing
+{
+	namespace Helper = ::Testing::Helper;
+
+	namespace Items
+	{
+		constexpr static const char* moduleName = "Distribute.Items";
+
+		TEST(AddItemToActor)
+		{
+			const auto  world = Helper::Setup();
+			FilterData  filterData{ {}, {}, {}, {}, 100 };
+			RandomCount idxOrCount{ 1, 1 };
+			bool        isFinal{ false };
+			Path        path{ "" };
+
+			Helper::Distribution::GetItems().EmplaceForm(true, world.item, isFinal, idxOrCount, filterData, path);
+
+			Helper::Distribution::Distribute(world.actor);
+			auto got = world.actor->GetActorBase()->CountObjectsInContainer(world.item);
+			EXPECT(got == 1, fmt::format("Expected actor to have 1 item, but they have {}", got));
+		}
+	}
+
+	namespace Spells
+	{
+		constexpr static const char* moduleName = "Distribute.Spells";
+
+		TEST(AddSpellToAliveActor)
+		{
+			const auto  world = Helper::Setup();
+			FilterData  filterData{ {}, {}, {}, {}, 100 };
+			RandomCount idxOrCount{ 1, 1 };
+			bool        isFinal{ false };
+			Path        path{ "" };
+
+			world.actor->Resurrect(true, true);
+			Helper::Distribution::GetSpells().EmplaceForm(true, world.spell, isFinal, idxOrCount, filterData, path);
+			Helper::Distribution::Distribute(world.actor);
+			EXPECT(world.actor->HasSpell(world.spell), "Expected actor to have the spell");
+		}
+
+		TEST(AddSpellToDeadActor)
+		{
+			const auto  world = Helper::Setup();
+			FilterData  filterData{ {}, {}, {}, {}, 100 };
+			RandomCount idxOrCount{ 1, 1 };
+			bool        isFinal{ false };
+			Path        path{ "" };
+
+			world.actor->KillImmediate();
+			Helper::Distribution::GetSpells().EmplaceForm(true, world.spell, isFinal, idxOrCount, filterData, path);
+			Helper::Distribution::Distribute(world.actor);
+			EXPECT(world.actor->HasSpell(world.spell), "Expected actor to have the spell");
+		}
+	}
+
+	namespace Packages
+	{
+		constexpr static const char* moduleName = "Distribute.Packages";
+
+		TEST(InsertPackagesAt0)
+		{
+			const auto world = Helper::Setup();
+			FilterData filterData{ {}, {}, {}, {}, 100 };
+			Index      idxOrCount{ 0 };
+			bool       isFinal{ false };
+			Path       path{ "" };
+
+			auto oldPackages = world.actor->GetActorBase()->aiPackages.packages;
+			Helper::Distribution::GetPackages().EmplaceForm(true, world.package, isFinal, idxOrCount, filterData, path);
+			Helper::Distribution::Distribute(world.actor);
+
+			auto oldVec = Helper::ToVector(oldPackages);
+			oldVec.insert(oldVec.begin() + idxOrCount, world.package);
+			auto newVec = Helper::ToVector(world.actor->GetActorBase()->aiPackages.packages);
+			EXPECT(oldVec == newVec, "Expected package to be inserted at the front");
+		}
+
+		TEST(InsertPackageInTheMiddle)
+		{
+			const auto world = Helper::Setup();
+			FilterData filterData{ {}, {}, {}, {}, 100 };
+			Index      idxOrCount{ 2 };
+			bool       isFinal{ false };
+			Path       path{ "" };
+
+			auto oldPackages = world.actor->GetActorBase()->aiPackages.packages;
+			Helper::Distribution::GetPackages().EmplaceForm(true, world.package, isFinal, idxOrCount, filterData, path);
+			Helper::Distribution::Distribute(world.actor);
+
+			auto oldVec = Helper::ToVector(oldPackages);
+			oldVec.insert(oldVec.begin() + idxOrCount, world.package);
+			auto newVec = Helper::ToVector(world.actor->GetActorBase()->aiPackages.packages);
+			EXPECT(oldVec == newVec, fmt::format("Expected package to be inserted at index {}", idxOrCount));
+		}
+
+		TEST(AppendPackageWhenIndexExceedsSize)
+		{
+			const auto world = Helper::Setup();
+			FilterData filterData{ {}, {}, {}, {}, 100 };
+			Index      idxOrCount{ 100 };
+			bool       isFinal{ false };
+			Path       path{ "" };
+
+			auto oldPackages = world.actor->GetActorBase()->aiPackages.packages;
+			Helper::Distribution::GetPackages().EmplaceForm(true, world.package, isFinal, idxOrCount, filterData, path);
+			Helper::Distribution::Distribute(world.actor);
+
+			auto oldVec = Helper::ToVector(oldPackages);
+			oldVec.push_back(world.package);
+			auto newVec = Helper::ToVector(world.actor->GetActorBase()->aiPackages.packages);
+			EXPECT(oldVec == newVec, "Expected package to be appended to the back");
+		}
+
+		TEST(PlacePackageAtTheFrontWhenListIsEmpty)
+		{
+			const auto world = Helper::Setup();
+			FilterData filterData{ {}, {}, {}, {}, 100 };
+			Index      idxOrCount{ 1 };
+			bool       isFinal{ false };
+			Path       path{ "" };
+
+			world.actor->GetActorBase()->aiPackages.packages.clear();
+			Helper::Distribution::GetPackages().EmplaceForm(true, world.package, isFinal, idxOrCount, filterData, path);
+			Helper::Distribution::Distribute(world.actor);
+
+			std::vector<RE::TESPackage*> oldVec{ world.package };
+			auto                         newVec = Helper::ToVector(world.actor->GetActorBase()->aiPackages.packages);
+			EXPECT(oldVec == newVec, "Expected package to be inserted at the front");
+		}
+
+		TEST(SkipPackageIfItIsAlreadyInTheList)
+		{
+			const auto      world = Helper::Setup();
+			RE::TESPackage* package{ world.actor->GetActorBase()->aiPackages.packages.front() };
+			FilterData      filterData{ {}, {}, {}, {}, 100 };
+			Index           idxOrCount{ 1 };
+			bool            isFinal{ false };
+			Path            path{ "" };
+
+			auto oldPackages = world.actor->GetActorBase()->aiPackages.packages;
+			Helper::Distribution::GetPackages().EmplaceForm(true, package, isFinal, idxOrCount, filterData, path);
+			Helper::Distribution::Distribute(world.actor);
+
+			auto oldVec = Helper::ToVector(oldPackages);
+			auto newVec = Helper::ToVector(world.actor->GetActorBase()->aiPackages.packages);
+			EXPECT(oldVec == newVec, "Expected package list to stay the same");
+		}
+	}
+
+	namespace Reload
+	{
+		constexpr static const char* moduleName = "Distribute.Reload";
+
+		TEST(DistributeOnlyReloadedEntries)
+		{
+			const auto  world = Helper::Setup();
+			FilterData  filterData{ {}, {}, {}, {}, 100 };
+			RandomCount idxOrCount{ 1, 1 };
+			bool        isFinal{ false };
+			Path        path{ "" };
+
+			Helper::Distribution::GetSpells().EmplaceForm(true, world.spell, isFinal, idxOrCount, filterData, path);
+			Helper::Distribution::GetItems().EmplaceForm(true, world.item, isFinal, idxOrCount, filterData, path);
+			Helper::Distribution::GetItems().GetForms().back().generation = 1;
+
+			auto npcData = NPCData(world.actor);
+			DistributeReloaded(npcData, 0);
+
+			ASSERT(!world.actor->HasSpell(world.spell), "Expected entries that weren't reloaded to be skipped");
+			ASSERT(world.actor->GetActorBase()->CountObjectsInContainer(world.item) == 1, "Expected actor to have 1 reloaded item");
+			const auto npcCount = Helper::Distribution::GetItems().GetForms().back().npcCount;
+			EXPECT(npcCount == 1, fmt::format("Expected reloaded entry to count 1 NPC, but it counts {}", npcCount));
+		}
+
+		TEST(ReturnDistributedGeneration)
+		{
+			const auto world = Helper::Setup();
+			Forms::distributablesGeneration = 2;
+
+			auto       npcData = NPCData(world.actor);
+			const auto generation = Distribute(npcData, false);
+			Forms::distributablesGeneration = 0;
+
+			EXPECT(generation == 2, fmt::format("Expected distribution to return generation 2, but it returned {}", generation));
+		}
+	}
+}
@@ -0,0 +1,155 @@
+#pragma once
+#include "EntrySanitizer.h"
+#include "Legacy/RegexSanitizer.h"
+#include "Resources.h"
+#include "Testing.h"
+
+#include <random>
+
+namespace Sanitizer::Testing
+{
+	constexpr static const char* moduleName = "EntrySanitizer";
+
+	constexpr static std::uint32_t seed = 0x5A21;
+	constexpr static int           iterations = 20000;
+
+	inline std::string Describe(const std::string& a_input, const std::string& a_actual, const std::string& a_expected)
+	{
+		return "sanitize(\"" + a_input + "\") = \"" + a_actual + "\", expected \"" + a_expected + "\"";
+	}
+
+	/// Randomly pads separators with whitespace and formIDs with zeros, the way hand-written configs often look.
+	inline std::string Mangle(std::mt19937& a_rng, std::string_view a_entry)
+	{
+		std::uniform_int_distribution<int> padding(0, 3);
+		std::bernoulli_distribution        tab(0.2);
+
+		const auto spaces = [&] {
+			std::string result(padding(a_rng), ' ');
+			if (!result.empty() && tab(a_rng)) {
+				result.front() = '\t';
+			}
+			return result;
+		};
+
+		std::string result;
+		for (std::size_t i = 0; i < a_entry.size(); ++i) {
+			const auto ch = a_entry[i];
+			if (ch == '|' || ch == ',' || ch == '~') {
+				result += spaces();
+				result += ch == '~' ? std::string(" - ") : std::string(1, ch);
+				result += spaces();
+			} else if (ch == '0' && i + 1 < a_entry.size() && a_entry[i + 1] == 'x') {
+				result += "0x" + std::string(padding(a_rng), '0');
+				++i;
+			} else {
+				result += ch;
+			}
+		}
+		return result;
+	}
+
+	inline void AssertSame(const std::string& a_input, bool a_swapVRMasters, bool& a_failed, std::string& a_message)
+	{
+		if (a_failed) {
+			return;
+		}
+		const auto expected = Legacy::sanitize(a_input, a_swapVRMasters);
+		const auto actual = sanitize(a_input, a_swapVRMasters);
+		if (actual != expected) {
+			a_failed = true;
+			a_message = (a_swapVRMasters ? "[VR] " : "") + Describe(a_input, actual, expected);
+		}
+	}
+
+	TEST(KnownEntries)
+	{
+		const std::pair<std::string, std::string> cases[]{
+			{ "0x12345 - Skyrim.esm | ActorTypeNPC , Guard", "0x12345~Skyrim.esm|ActorTypeNPC,Guard" },
+			{ "0x12345~Skyrim.esm|A - B", "0x12345~Skyrim.esm|A - B" },
+			{ "00012345|NONE", "0x12345|NONE" },
+			{ "0x00012345~MyMod.esp", "0x12345~MyMod.esp" },
+			{ "0000", "0x0" },
+			{ "00", "00" },
+			{ "0x0000", "0x0" },
+			{ "0x00", "0x00" },
+			{ "00012345678", "00012345678" },
+			{ "Whiterun Guard", "Whiterun Guard" },
+		};
+
+		for (const auto& [input, expected] : cases) {
+			const auto actual = sanitize(input);
+			ASSERT(actual == expected, Describe(input, actual, expected));
+		}
+		PASS;
+	}
+
+	TEST(SwapsVRMasters)
+	{
+		const auto actual = sanitize("0x2001234|0x04005678", true);
+		const std::string expected = "0x1234~Dawnguard.esm|0x5678~Dragonborn.esm";
+		ASSERT(actual == expected, Describe("0x2001234|0x04005678", actual, expected));
+		PASS;
+	}
+
+	TEST(MatchesRegexOnReferenceEntries)
+	{
+		const auto entries = Resources::LoadReferenceEntries();
+		ASSERT(!entries.empty(), "no entries were found in SPID Complete Reference.txt");
+
+		std::mt19937 rng(seed);
+		bool         failed = false;
+		std::string  message;
+
+		for (const auto& entry : entries) {
+			for (const bool vr : { false, true }) {
+				AssertSame(entry, vr, failed, message);
+				for (int i = 0; i < 20; ++i) {
+					AssertSame(Mangle(rng, entry), vr, failed, message);
+				}
+			}
+		}
+
+		ASSERT(!failed, message);
+		PASS;
+	}
+
+	TEST(MatchesRegexOnRandomInputs)
+	{
+		std::mt19937                               rng(seed);
+		std::uniform_int_distribution<std::size_t> length(0, 48);
+
+		// Alphabet is skewed towards characters that take part in sanitizing rules.
+		constexpr std::string_view alphabet = "   \t|||,,,-~00000000xxX12244aAfFgz_.";
+
+		bool        failed = false;
+		std::string message;
+
+		std::uniform_int_distribution<std::size_t> index(0, alphabet.size() - 1);
+
+		for (int i = 0; i < iterations && !failed; ++i) {
+			std::string input(length(rng), '\0');
+			for (auto& ch : input) {
+				ch = alphabet[index(rng)];
+			}
+
+			AssertSame(input, false, failed, message);
+			AssertSame(input, true, failed, message);
+		}
+
+		ASSERT(!failed, message);
+		PASS;
+	}
+
+	TEST(ReusesBuffer)
+	{
+		std::string buffer;
+
+		sanitize("0x00012345 - Skyrim.esm | ActorTypeNPC , Guard | 0x00000ABC", buffer);
+		ASSERT(buffer == "0x12345~Skyrim.esm|ActorTypeNPC,Guard|0xABC", "unexpected output: " + buffer);
+
+		sanitize("Item", buffer);
+		ASSERT(buffer == "Item", "previous output leaked into the buffer: " + buffer);
+		PASS;
+	}
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include "FormResolver.h"
+#include "Testing.h"
+#include "TestsHelpers.h"
+
+namespace Forms::Testing
+{
+	namespace Helper = ::Testing::Helper;
+
+	constexpr static const char* moduleName = "FormResolver";
+
+	TEST(TellsPluginApartFromFormIDZero)
+	{
+		Helper::Setup();
+		const auto dataHandler = RE::TESDataHandler::GetSingleton();
+		const auto resolver = Resolver::GetSingleton();
+		resolver->Clear();
+
+		const auto& formZero = resolver->Resolve(dataHandler, FormModPair{ 0, "Skyrim.esm" });
+		const auto& plugin = resolver->Resolve(dataHandler, FormModPair{ std::nullopt, "Skyrim.esm" });
+		const auto  formZeroStatus = formZero.status;
+		const auto  pluginStatus = plugin.status;
+		resolver->Clear();
+
+		ASSERT(formZeroStatus == Resolver::Status::kUnknownFormID, "explicit 0x0 should be an unknown formID");
+		EXPECT(pluginStatus == Resolver::Status::kResolved, "plugin alone shouldn't reuse resolution of 0x0 in that plugin");
+	}
+
+	TEST(CountsPrefetchedFormsAsResolved)
+	{
+		Helper::Setup();
+		const auto dataHandler = RE::TESDataHandler::GetSingleton();
+		const auto resolver = Resolver::GetSingleton();
+		resolver->Clear();
+
+		const FormOrEditorID identifier{ FormModPair{ std::nullopt, "Skyrim.esm" } };
+		resolver->Prefetch(dataHandler, { &identifier });
+		resolver->Resolve(dataHandler, std::get<FormModPair>(identifier));
+		const auto resolvedCount = resolver->GetResolvedCount();
+		resolver->Clear();
+
+		EXPECT(resolvedCount == 1, fmt::format("Expected 1 resolved form, but there are {}", resolvedCount));
+	}
+}
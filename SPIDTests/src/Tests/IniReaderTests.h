@@ -0,0 +1,133 @@
+#pragma once
+#include "IniReader.h"
+#include "Resources.h"
+#include "Testing.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Ini::Testing
+{
+	using namespace std::literals;
+
+	constexpr static const char* moduleName = "IniReader";
+
+	using Entries = std::vector<std::pair<std::string, std::string>>;
+
+	inline Entries Read(std::string_view a_text)
+	{
+		Entries result;
+		Scanner scanner(a_text);
+		for (Entry entry; scanner.Next(entry);) {
+			result.emplace_back(entry.key, entry.value);
+		}
+		return result;
+	}
+
+	inline std::string Describe(const Entries& a_entries)
+	{
+		std::string result;
+		for (const auto& [key, value] : a_entries) {
+			result += "[" + key + " = " + value + "]";
+		}
+		return result.empty() ? "no entries" : result;
+	}
+
+	TEST(ReadsEntriesInOrder)
+	{
+		const auto actual = Read(
+			"Spell = 0x12345~Skyrim.esm|ActorTypeNPC\n"
+			"Perk=0x1\n"
+			"Spell = 0x12345~Skyrim.esm|ActorTypeNPC\n"
+			"Item = 0xF|NONE|NONE|NONE|NONE|5\n"sv);
+
+		const Entries expected{
+			{ "Spell", "0x12345~Skyrim.esm|ActorTypeNPC" },
+			{ "Perk", "0x1" },
+			{ "Spell", "0x12345~Skyrim.esm|ActorTypeNPC" },
+			{ "Item", "0xF|NONE|NONE|NONE|NONE|5" },
+		};
+		ASSERT(actual == expected, "read " + Describe(actual) + ", expected " + Describe(expected));
+		PASS;
+	}
+
+	TEST(SkipsCommentsAndInvalidLines)
+	{
+		const auto actual = Read(
+			"\xEF\xBB\xBF; comment = not an entry\r\n"
+			"\r\n"
+			"   # another comment\r\n"
+			"not an entry\r\n"
+			" = no key\r\n"
+			"\tSpell \t=\t 0x1 | NONE \t\r\n"
+			"Empty =\r\n"
+			"Keyword = A = B ; not a comment\r"
+			"Last = value"sv);
+
+		const Entries expected{
+			{ "Spell", "0x1 | NONE" },
+			{ "Empty", "" },
+			{ "Keyword", "A = B ; not a comment" },
+			{ "Last", "value" },
+		};
+		ASSERT(actual == expected, "read " + Describe(actual) + ", expected " + Describe(expected));
+		PASS;
+	}
+
+	TEST(ReadsOnlyRootSection)
+	{
+		const auto actual = Read(
+			"Spell = 0x1\n"
+			"[Section]\n"
+			"Spell = 0x2\n"
+			"[Unterminated\n"
+			"Spell = 0x3\n"
+			"[ ]\n"
+			"Spell = 0x4\n"
+			"\0Spell = 0x5\n"sv);
+
+		const Entries expected{
+			{ "Spell", "0x1" },
+			{ "Spell", "0x4" },
+		};
+		ASSERT(actual == expected, "read " + Describe(actual) + ", expected " + Describe(expected));
+		PASS;
+	}
+
+	TEST(ReadsReferenceEntries)
+	{
+		const auto entries = Resources::LoadReferenceEntries();
+		ASSERT(!entries.empty(), "no entries were found in SPID Complete Reference.txt");
+
+		std::string text;
+		for (const auto& entry : entries) {
+			text += "Spell = " + entry + "\r\n";
+		}
+
+		const auto actual = Read(text);
+		ASSERT(actual.size() == entries.size(), "read " + std::to_string(actual.size()) + " of " + std::to_string(entries.size()) + " entries");
+		for (std::size_t i = 0; i < entries.size(); ++i) {
+			ASSERT(actual[i].second == entries[i], "entry #" + std::to_string(i) + " was read as \"" + actual[i].second + "\"");
+		}
+		PASS;
+	}
+
+	TEST(OrdersKeysLikeSimpleIni)
+	{
+		std::vector<std::pair<std::string_view, int>> keys{
+			{ "spell", 0 }, { "Item", 1 }, { "Spell", 2 }, { "item", 3 }, { "Items", 4 }, { "_Perk", 5 }, { "\xC3\xA9", 6 }, { "A", 7 }
+		};
+		std::ranges::stable_sort(keys, KeyLess, [](const auto& a_key) { return a_key.first; });
+
+		std::vector<int> order;
+		for (const auto& [key, index] : keys) {
+			order.push_back(index);
+		}
+
+		// Non-ASCII bytes are negative as signed chars, so they come first. Letters are compared lowercased, so '_' comes before them.
+		ASSERT((order == std::vector{ 6, 5, 7, 1, 3, 4, 0, 2 }), "keys were sorted in unexpected order");
+		PASS;
+	}
+}
@@ -0,0 +1,127 @@
+#pragma once
+#include "DistributionJournal.h"
+#include "MappedFile.h"
+#include "Testing.h"
+#include "TestsHelpers.h"
+
+namespace Distribution::Journal::Testing
+{
+	namespace Helper = ::Testing::Helper;
+
+	constexpr static const char* moduleName = "DistributionJournal";
+
+	namespace detail
+	{
+		inline std::filesystem::path get_path()
+		{
+			return std::filesystem::temp_directory_path() / "SPIDCoreTests.journal";
+		}
+	}
+
+	TEST(AppendedFileGrowsAndShrinks)
+	{
+		const auto path = std::filesystem::temp_directory_path() / "SPIDCoreTests.append";
+
+		std::vector<std::byte> expected{};
+		{
+			AppendMappedFile file{};
+			ASSERT(file.Open(path, 1), "file should be created");
+
+			// A page at a time, so the file has to grow several times.
+			for (std::size_t i = 0; i < 10000; ++i) {
+				const auto chunk = std::array{ static_cast<std::byte>(i), static_cast<std::byte>(i >> 8), std::byte{ 0xAB } };
+				ASSERT(file.Append(chunk), "append should succeed");
+				expected.insert(expected.end(), chunk.begin(), chunk.end());
+			}
+			ASSERT(std::filesystem::file_size(path) > file.size(), "open file should have space to grow into");
+		}
+
+		const auto bytes = [&] {
+			const MappedFile file(path);
+			return std::vector<std::byte>(file.bytes().begin(), file.bytes().end());
+		}();
+		std::filesystem::remove(path);
+		EXPECT(bytes == expected, fmt::format("closed file should contain exactly what was appended, has {} of {} bytes", bytes.size(), expected.size()));
+	}
+
+	TEST(RecordsDistributedForms)
+	{
+		auto world = Helper::Setup();
+
+		const auto keyword = Mock::Create<RE::BGSKeyword>("SPID_Bandit");
+		Forms::EditorIDIndex::GetSingleton()->Build();
+
+		StringFilters strings{};
+		strings.ALL = { "Bandit" };
+		Helper::Distribution::GetKeywords().EmplaceForm(true, keyword, false, RandomCount(1, 1), FilterData{ strings, {}, {}, {}, 100 }, "Bandits_DISTR.ini");
+		Helper::Distribution::GetSpells().EmplaceForm(true, world.spell, false, RandomCount(1, 1), FilterData{ {}, {}, {}, {}, 100 }, "Spells_DISTR.ini");
+
+		const auto path = detail::get_path();
+		ASSERT(Start(path), "journal should start");
+		for (const auto actor : { world.actor, world.anotherActor }) {
+			Helper::Distribution::Distribute(actor);
+		}
+
+		// Until the journal is stopped it ends with zeroed space, which must not be read as records.
+		Flush();
+		{
+			const MappedFile file(path);
+			const auto       journal = Read(file.bytes());
+			ASSERT(journal && !journal->truncated, "open journal should be readable");
+			ASSERT(journal->records.size() == 4, fmt::format("expected 4 records, got {}", journal->records.size()));
+		}
+		Stop();
+
+		const auto journalSize = std::filesystem::file_size(path);
+		const auto [journal, table] = [&] {
+			const MappedFile journalFile(path);
+			const MappedFile entriesFile(GetEntriesPath(path));
+			return std::pair{ Read(journalFile.bytes()), ReadEntries(entriesFile.bytes()) };
+		}();
+		std::filesystem::remove(path);
+		std::filesystem::remove(GetEntriesPath(path));
+
+		ASSERT(journal && table, "journal and entry table should be readable");
+		ASSERT(table->session == journal->header.session, "entry table should belong to the journal");
+		ASSERT(journalSize == sizeof(Header) + 4 * sizeof(Record), "stopped journal shouldn't have any space left");
+		ASSERT(table->entries.size() == 2, fmt::format("expected an entry per distributed form, got {}", table->entries.size()));
+
+		std::set<std::tuple<RE::FormID, RE::FormID, std::string>> received{};
+		for (const auto& record : journal->records) {
+			ASSERT(record.phase == Phase::kRegular && record.entry < table->entries.size(), "records should refer to entries of regular distribution");
+			const auto& entry = table->entries[record.entry];
+			ASSERT(entry.formID == record.formID && entry.formType == record.formType, "entry should describe distributed form");
+			received.emplace(record.actorID, record.formID, entry.path);
+		}
+
+		const auto actor = world.actor->GetFormID();
+		const auto anotherActor = world.anotherActor->GetFormID();
+		EXPECT((received == std::set<std::tuple<RE::FormID, RE::FormID, std::string>>{
+								{ actor, keyword->GetFormID(), "Bandits_DISTR.ini" },
+								{ actor, world.spell->GetFormID(), "Spells_DISTR.ini" },
+								{ anotherActor, keyword->GetFormID(), "Bandits_DISTR.ini" },
+								{ anotherActor, world.spell->GetFormID(), "Spells_DISTR.ini" } }),
+			"journal should record forms that each actor received and the files they came from");
+	}
+
+	TEST(RejectsCorruptedJournals)
+	{
+		std::vector<std::byte> bytes(sizeof(Header) + 2 * sizeof(Record) + 5);
+		const Header           header{};
+		std::memcpy(bytes.data(), &header, sizeof(Header));
+
+		Record record{ .actorID = 0x14, .phase = Phase::kDeath };
+		std::memcpy(bytes.data() + sizeof(Header), &record, sizeof(Record));
+		std::memcpy(bytes.data() + sizeof(Header) + sizeof(Record), &record, sizeof(Record));
+		bytes.back() = std::byte{ 1 };
+
+		const auto journal = Read(bytes);
+		ASSERT(journal && journal->records.size() == 2 && journal->truncated, "journal cut mid-record should keep complete records");
+
+		bytes[sizeof(Header) + offsetof(Record, phase)] = std::byte{ 0xFF };
+		ASSERT(!Read(bytes), "record with unknown phase should be rejected");
+
+		bytes[0] = std::byte{ 0 };
+		EXPECT(!Read(bytes), "journal with a wrong header should be rejected");
+	}
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include "Latency.h"
+#include "Testing.h"
+
+namespace Latency::Testing
+{
+	constexpr static const char* moduleName = "Latency";
+
+	TEST(BucketsKeepPrecision)
+	{
+		for (const std::uint64_t value : std::array<std::uint64_t, 7>{ 0, 31, 32, 1'000, 123'456, 10'000'000'000, std::numeric_limits<std::uint64_t>::max() }) {
+			const auto bucket = Histogram::GetBucket(value);
+			ASSERT(bucket < Histogram::bucketCount, fmt::format("{} is out of range", value));
+
+			const auto highest = Histogram::GetHighestValue(bucket);
+			ASSERT(highest >= value && static_cast<double>(highest - value) <= static_cast<double>(value) / Histogram::subBuckets, fmt::format("{} is reported as {}", value, highest));
+		}
+		PASS;
+	}
+
+	TEST(ReportsPercentiles)
+	{
+		Histogram histogram{};
+
+		// 990 fast calls, 9 slower ones and a single hitch.
+		for (int i = 0; i < 990; ++i) {
+			histogram.Record(10'000);
+		}
+		for (int i = 0; i < 9; ++i) {
+			histogram.Record(100'000);
+		}
+		histogram.Record(5'000'000);
+
+		const auto summary = histogram.Collect();
+		ASSERT(summary.count == 1000, fmt::format("expected 1000 recorded durations, got {}", summary.count));
+
+		const auto near = [](std::uint64_t a_reported, std::uint64_t a_expected) {
+			return a_reported >= a_expected && a_reported - a_expected <= a_expected / Histogram::subBuckets;
+		};
+		ASSERT(near(summary.p50Ns, 10'000) && near(summary.p99Ns, 10'000), fmt::format("p50 and p99 should be ~10us, got {} and {}", summary.p50Ns, summary.p99Ns));
+		ASSERT(near(summary.p999Ns, 100'000) && near(summary.maxNs, 5'000'000), fmt::format("p99.9 should be ~100us and max ~5ms, got {} and {}", summary.p999Ns, summary.maxNs));
+		ASSERT(summary.meanNs == (990ull * 10'000 + 9ull * 100'000 + 5'000'000) / 1000, "mean should be exact");
+
+		EXPECT(histogram.Collect().count == 0, "collecting should start over");
+	}
+
+	TEST(CountsConcurrentRecords)
+	{
+		Histogram histogram{};
+
+		std::vector<std::thread> threads{};
+		for (int t = 0; t < 4; ++t) {
+			threads.emplace_back([&histogram, t] {
+				for (int i = 0; i < 10'000; ++i) {
+					histogram.Record(static_cast<std::uint64_t>(t * 1'000 + i));
+				}
+			});
+		}
+		for (auto& thread : threads) {
+			thread.join();
+		}
+
+		const auto summary = histogram.Collect();
+		EXPECT(summary.count == 40'000, fmt::format("expected 40000 recorded durations, got {}", summary.count));
+	}
+}
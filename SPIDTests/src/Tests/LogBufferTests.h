@@ -0,0 +1,132 @@
+#pragma once
+#include "Testing.h"
+
+#include <spdlog/sinks/ostream_sink.h>
+
+namespace LogBuffer::Testing::detail
+{
+	/// Argument that is only logged as formatted text, e.g. like forms are.
+	struct Named
+	{
+		std::string name;
+	};
+}
+
+template <>
+struct fmt::formatter<LogBuffer::Testing::detail::Named> : fmt::formatter<std::string_view>
+{
+	template <class FormatContext>
+	auto format(const LogBuffer::Testing::detail::Named& a_named, FormatContext& a_ctx) const
+	{
+		return fmt::formatter<std::string_view>::format(a_named.name, a_ctx);
+	}
+};
+
+namespace LogBuffer::Testing
+{
+	constexpr static const char* moduleName = "LogBuffer";
+
+	namespace detail
+	{
+		/// Redirects default logger into a stream for as long as it lives.
+		struct CapturedLog
+		{
+			CapturedLog(spdlog::level::level_enum a_level) :
+				previous(spdlog::default_logger())
+			{
+				auto log = std::make_shared<spdlog::logger>("test", std::make_shared<spdlog::sinks::ostream_sink_st>(stream));
+				log->set_pattern("%v");
+				log->set_level(a_level);
+				spdlog::set_default_logger(std::move(log));
+				clear();
+			}
+
+			~CapturedLog()
+			{
+				clear();
+				SetCapacity(1 << 16);
+				spdlog::set_default_logger(previous);
+			}
+
+			[[nodiscard]] std::size_t GetLines() const
+			{
+				return static_cast<std::size_t>(std::ranges::count(stream.str(), '\n'));
+			}
+
+			std::ostringstream              stream{};
+			std::shared_ptr<spdlog::logger> previous;
+		};
+	}
+
+	TEST(LogsEachMessageOnce)
+	{
+		const detail::CapturedLog log(spdlog::level::info);
+
+		for (int i = 0; i < 3; ++i) {
+			for (const auto modName : { "A.esp"s, "B.esp"s }) {
+				error("[{}] [0x{:X}] ({}) FAIL - formID doesn't exist", "Test_DISTR.ini"sv, 0x800u, modName);
+			}
+			warn("{} is referencing {}", "Keyword"sv, i < 2 ? "itself" : "another keyword");
+		}
+		ASSERT(log.stream.str() == "[Test_DISTR.ini] [0x800] (A.esp) FAIL - formID doesn't exist\n"
+								   "[Test_DISTR.ini] [0x800] (B.esp) FAIL - formID doesn't exist\n"
+								   "Keyword is referencing itself\n"
+								   "Keyword is referencing another keyword\n"s,
+			fmt::format("each distinct message should be logged once, got:\n{}", log.stream.str()));
+
+		clear();
+		error("[{}] [0x{:X}] ({}) FAIL - formID doesn't exist", "Test_DISTR.ini"sv, 0x800u, "A.esp"s);
+		EXPECT(log.GetLines() == 5, "cleared messages should be logged again");
+	}
+
+	TEST(IdentifiesMessagesByArguments)
+	{
+		const detail::CapturedLog log(spdlog::level::info);
+
+		for (const auto& [first, second] : { std::pair{ "ab"sv, "c"sv }, std::pair{ "a"sv, "bc"sv }, std::pair{ "ab"sv, "c"sv } }) {
+			info("{}{}", first, second);
+		}
+		ASSERT(log.GetLines() == 2, "messages with different arguments should be logged even if their text is the same");
+
+		// Different objects with the same text are the same message.
+		for (const auto& named : { detail::Named{ "Bandit" }, detail::Named{ "Bandit" }, detail::Named{ "Guard" } }) {
+			info("{}", named);
+		}
+		ASSERT(log.GetLines() == 4, "arguments that aren't strings or numbers should be identified by their text");
+
+		const auto loc = std::source_location::current();
+		const auto nullKey = LogBuffer::detail::make_key(loc, static_cast<const char*>(nullptr));
+		const auto emptyKey = LogBuffer::detail::make_key(loc, "");
+		EXPECT(nullKey != emptyKey, "null C strings should be told apart from empty ones without being read");
+	}
+
+	TEST(SkipsDisabledLevels)
+	{
+		const detail::CapturedLog log(spdlog::level::warn);
+
+		info("{}", "hidden"sv);
+		ASSERT(log.GetLines() == 0, "messages below log level shouldn't be logged");
+
+		spdlog::set_level(spdlog::level::info);
+		info("{}", "hidden"sv);
+		EXPECT(log.GetLines() == 1, "messages below log level shouldn't be remembered");
+	}
+
+	TEST(ForgetsMessagesOverCapacity)
+	{
+		const detail::CapturedLog log(spdlog::level::info);
+		SetCapacity(4);
+
+		// Messages are identified by their call site too, so all of them are logged by the same line.
+		for (const int i : { 0, 1, 2, 3, 0 }) {
+			info("{}", i);
+		}
+		ASSERT(log.GetLines() == 4, "messages within capacity should be remembered");
+
+		for (const int i : { 4, 0 }) {
+			info("{}", i);
+		}
+		ASSERT(LogBuffer::detail::buffer.size() == 2, fmt::format("buffer should start over once full, has {} messages", LogBuffer::detail::buffer.size()));
+		EXPECT(log.GetLines() == 6, "forgotten messages should be logged again");
+	}
+}
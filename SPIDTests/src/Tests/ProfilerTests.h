@@ -0,0 +1,49 @@
+#pragma once
+#include "Distribute.h"
+#include "Profiler.h"
+#include "Testing.h"
+#include "TestsHelpers.h"
+
+namespace Distribute::Profiler::Testing
+{
+	namespace Helper = ::Testing::Helper;
+
+	constexpr static const char* moduleName = "Profiler";
+
+	TEST(AttributesRejections)
+	{
+		const auto world = Helper::Setup();
+
+		// Only BanditMelee passes name filter, and a female-only entry rejects both actors by traits.
+		StringFilters name{};
+		name.ALL = { "banditmelee" };
+		Helper::Distribution::GetSpells().EmplaceForm(true, world.spell, false, RandomCount(1, 1), FilterData{ name, {}, {}, {}, 100 }, "Bandits_DISTR.ini");
+
+		Traits traits{};
+		traits.Set(Traits::kFemale, true);
+		Helper::Distribution::GetItems().EmplaceForm(true, world.item, false, RandomCount(1, 1), FilterData{ {}, {}, {}, traits, 100 }, "Females_DISTR.ini");
+
+		Reset();
+		SetEnabled(true);
+		Helper::Distribution::Distribute(world.actor);
+		Helper::Distribution::Distribute(world.anotherActor);
+		SetEnabled(false);
+
+		const auto entries = GetEntries();
+		ASSERT(entries.size() == 2, fmt::format("expected 2 profiled entries, got {}", entries.size()));
+
+		const auto spell = std::ranges::find(entries, world.spell->GetFormID(), &EntryProfile::formID);
+		const auto item = std::ranges::find(entries, world.item->GetFormID(), &EntryProfile::formID);
+		ASSERT(spell != entries.end() && item != entries.end(), "both entries should be profiled");
+
+		ASSERT(spell->path == "Bandits_DISTR.ini" && spell->counters.evaluations == 2 && spell->counters.passes == 1, "spell should pass for one of two actors");
+		ASSERT(spell->counters.rejections[std::to_underlying(Rejection::kStrings)] == 1, "spell should be rejected by string filters");
+		ASSERT(item->counters.passes == 0 && item->counters.rejections[std::to_underlying(Rejection::kTraits)] == 2, "item should be rejected by traits for both actors");
+
+		const auto files = GetFiles();
+		ASSERT(files.size() == 2, fmt::format("expected 2 profiled files, got {}", files.size()));
+
+		const auto csv = FormatCSV();
+		EXPECT(std::ranges::count(csv, '\n') == 3 && csv.contains("Bandits_DISTR.ini"), "CSV should have a header and a line per entry");
+	}
+}
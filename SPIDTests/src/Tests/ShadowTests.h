@@ -0,0 +1,87 @@
+#pragma once
+#include "Shadow.h"
+#include "Testing.h"
+#include "TestsHelpers.h"
+
+namespace Distribute::Shadow::Testing
+{
+	namespace Helper = ::Testing::Helper;
+
+	constexpr static const char* moduleName = "Shadow";
+
+	namespace detail
+	{
+		inline Forms::DistributionSet get_entries()
+		{
+			return {
+				Forms::spells.GetForms(),
+				Forms::perks.GetForms(),
+				Forms::items.GetForms(),
+				Forms::shouts.GetForms(),
+				Forms::levSpells.GetForms(),
+				Forms::packages.GetForms(),
+				Forms::outfits.GetForms(),
+				Forms::keywords.GetForms(),
+				Forms::factions.GetForms(),
+				Forms::sleepOutfits.GetForms(),
+				Forms::skins.GetForms()
+			};
+		}
+
+		/// Keyword for every Bandit, and a spell that relies on that keyword.
+		inline RE::BGSKeyword* add_entries(const Helper::World& a_world)
+		{
+			const auto keyword = Mock::Create<RE::BGSKeyword>("SPID_Bandit");
+			Forms::EditorIDIndex::GetSingleton()->Build();
+
+			StringFilters name{};
+			name.ALL = { "banditmelee" };
+			Helper::Distribution::GetKeywords().EmplaceForm(true, keyword, false, RandomCount(1, 1), FilterData{ name, {}, {}, {}, 100 }, "Keyword = SPID_Bandit|BanditMelee");
+
+			StringFilters keywords{};
+			keywords.ANY = { "_band" };
+			Traits traits{};
+			traits.Set(Traits::kFemale, false);
+			Chance chance{ 0.5, true };
+			chance.lineSeed = 42;
+			Helper::Distribution::GetSpells().EmplaceForm(true, a_world.spell, false, RandomCount(1, 1), FilterData{ keywords, {}, {}, traits, chance }, "Spell = IceSpear|*_Band|NONE|NONE|M|NONE|50!");
+
+			return keyword;
+		}
+	}
+
+	TEST(EvaluatorsAgree)
+	{
+		const auto world = Helper::Setup();
+		detail::add_entries(world);
+
+		ResetStats();
+		for (const auto actor : { world.actor, world.anotherActor }) {
+			const auto npcData = NPCData(actor);
+			const auto divergence = Compare(npcData, PCLevelMult::Input{ actor, actor->GetActorBase(), false }, detail::get_entries());
+			ASSERT(!divergence, divergence ? divergence->Describe() : "");
+		}
+
+		const auto stats = GetStats();
+		EXPECT(stats.npcs == 2 && stats.evaluations == 4 && stats.divergentNPCs == 0, fmt::format("expected 4 evaluations of 2 NPCs, got {} of {}", stats.evaluations, stats.npcs));
+	}
+
+	TEST(ExplainsDivergence)
+	{
+		const auto world = Helper::Setup();
+		const auto keyword = detail::add_entries(world);
+
+		// NPC::Data keeps editorIDs it was created with, while the reference evaluator reads the renamed one.
+		const auto npcData = NPCData(world.actor);
+		world.actor->GetActorBase()->SetFormEditorID("BanditBoss");
+
+		const auto divergence = Compare(npcData, PCLevelMult::Input{ world.actor, world.actor->GetActorBase(), false }, detail::get_entries());
+		ASSERT(divergence.has_value(), "renamed NPC should diverge");
+		ASSERT(divergence->type == RECORD::kKeyword && divergence->formID == keyword->GetFormID(), "divergence should point at the keyword entry");
+		ASSERT(divergence->reference == Filter::Result::kFail && divergence->optimized == Filter::Result::kPass, "only the optimized evaluator should pass");
+
+		const auto strings = std::to_underlying(Filter::Stage::kStrings);
+		ASSERT(divergence->referenceStages[strings] != divergence->optimizedStages[strings], "string filters should be reported as the divergent stage");
+		EXPECT(divergence->referencePicks.empty() && divergence->optimizedPicks == std::vector{ keyword->GetFormID() }, "picks of both evaluators should be reported");
+	}
+}
@@ -0,0 +1,212 @@
+#pragma once
+#include "StringKernels.h"
+#include "Testing.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace Strings::Testing
+{
+	constexpr static const char* moduleName = "StringKernels";
+
+	constexpr static std::uint32_t seed = 0x5B1D;
+	constexpr static int           iterations = 20000;
+
+	/// Kernels that can be run on the current CPU.
+	inline std::vector<ISA> GetTestedISAs()
+	{
+		std::vector<ISA> result{ ISA::kScalar };
+		if (GetSupportedISA() >= ISA::kSSE2) {
+			result.push_back(ISA::kSSE2);
+		}
+		if (GetSupportedISA() >= ISA::kAVX2) {
+			result.push_back(ISA::kAVX2);
+		}
+		return result;
+	}
+
+	inline void Fold(ISA a_isa, char* a_data, std::size_t a_size)
+	{
+		switch (a_isa) {
+		case ISA::kAVX2:
+			return detail::fold_avx2(a_data, a_size);
+		case ISA::kSSE2:
+			return detail::fold_sse2(a_data, a_size);
+		default:
+			return detail::fold_scalar(a_data, a_size);
+		}
+	}
+
+	inline bool Contains(ISA a_isa, std::string_view a_haystack, std::string_view a_needle)
+	{
+		switch (a_isa) {
+		case ISA::kAVX2:
+			return detail::contains_avx2(a_haystack, a_needle);
+		case ISA::kSSE2:
+			return detail::contains_sse2(a_haystack, a_needle);
+		default:
+			return detail::contains_scalar(a_haystack, a_needle);
+		}
+	}
+
+	/// Reference casefolding, the same that string::iequals and string::icontains do per character.
+	inline std::string ReferenceFold(std::string_view a_str)
+	{
+		std::string result{ a_str };
+		std::ranges::transform(result, result.begin(), [](char ch) {
+			return ch >= 'A' && ch <= 'Z' ? static_cast<char>(ch - 'A' + 'a') : ch;
+		});
+		return result;
+	}
+
+	/// Reference case-insensitive substring search, modelled after string::icontains.
+	inline bool ReferenceIContains(std::string_view a_haystack, std::string_view a_needle)
+	{
+		if (a_needle.empty()) {
+			return false;
+		}
+		const auto it = std::search(a_haystack.begin(), a_haystack.end(), a_needle.begin(), a_needle.end(), [](char a, char b) {
+			return ReferenceFold({ &a, 1 }) == ReferenceFold({ &b, 1 });
+		});
+		return it != a_haystack.end();
+	}
+
+	inline std::string RandomString(std::mt19937& a_rng, std::size_t a_size, std::string_view a_alphabet = {})
+	{
+		std::string result(a_size, '\0');
+		if (a_alphabet.empty()) {
+			std::uniform_int_distribution<int> byte(0, 255);
+			std::ranges::generate(result, [&] { return static_cast<char>(byte(a_rng)); });
+		} else {
+			std::uniform_int_distribution<std::size_t> index(0, a_alphabet.size() - 1);
+			std::ranges::generate(result, [&] { return a_alphabet[index(a_rng)]; });
+		}
+		return result;
+	}
+
+	/// Copies string into a buffer of the exact size, so that sanitizers can catch out of bounds reads.
+	inline std::unique_ptr<char[]> ExactCopy(std::string_view a_str)
+	{
+		auto buffer = std::make_unique<char[]>(std::max<std::size_t>(a_str.size(), 1));
+		std::ranges::copy(a_str, buffer.get());
+		return buffer;
+	}
+
+	TEST(FoldMatchesReference)
+	{
+		std::mt19937                               rng(seed);
+		std::uniform_int_distribution<std::size_t> length(0, 300);
+
+		for (int i = 0; i < iterations; ++i) {
+			const auto input = RandomString(rng, length(rng));
+			const auto expected = ReferenceFold(input);
+
+			for (const auto isa : GetTestedISAs()) {
+				auto buffer = ExactCopy(input);
+				Fold(isa, buffer.get(), input.size());
+				ASSERT(std::string_view(buffer.get(), input.size()) == expected, std::string(GetISAName(isa)) + " fold differs from reference for input of length " + std::to_string(input.size()));
+			}
+		}
+		PASS;
+	}
+
+	TEST(FoldLeavesNonASCIIUntouched)
+	{
+		std::string input;
+		for (int ch = 0; ch < 256; ++ch) {
+			input.push_back(static_cast<char>(ch));
+		}
+
+		for (const auto isa : GetTestedISAs()) {
+			auto buffer = input;
+			Fold(isa, buffer.data(), buffer.size());
+			for (int ch = 0; ch < 256; ++ch) {
+				const auto expected = ch >= 'A' && ch <= 'Z' ? ch + ('a' - 'A') : ch;
+				ASSERT(static_cast<unsigned char>(buffer[ch]) == expected, std::string(GetISAName(isa)) + " folded byte " + std::to_string(ch) + " incorrectly");
+			}
+		}
+		PASS;
+	}
+
+	TEST(ContainsMatchesReference)
+	{
+		std::mt19937                               rng(seed);
+		std::uniform_int_distribution<std::size_t> haystackLength(0, 200);
+		std::uniform_int_distribution<std::size_t> needleLength(0, 12);
+		std::bernoulli_distribution                fromHaystack(0.5);
+
+		// Small alphabet produces many partial matches, which is what stresses candidate filtering in SIMD kernels.
+		constexpr std::string_view alphabet = "aab_c";
+
+		for (int i = 0; i < iterations; ++i) {
+			const auto haystack = RandomString(rng, haystackLength(rng), alphabet);
+
+			std::string needle;
+			if (fromHaystack(rng) && !haystack.empty()) {
+				std::uniform_int_distribution<std::size_t> pos(0, haystack.size() - 1);
+				const auto                                 start = pos(rng);
+				needle = haystack.substr(start, needleLength(rng));
+			} else {
+				needle = RandomString(rng, needleLength(rng), alphabet);
+			}
+
+			const bool expected = !needle.empty() && haystack.find(needle) != std::string::npos;
+
+			const auto haystackBuffer = ExactCopy(haystack);
+			const auto needleBuffer = ExactCopy(needle);
+			const auto haystackView = std::string_view(haystackBuffer.get(), haystack.size());
+			const auto needleView = std::string_view(needleBuffer.get(), needle.size());
+
+			for (const auto isa : GetTestedISAs()) {
+				ASSERT(Contains(isa, haystackView, needleView) == expected, std::string(GetISAName(isa)) + " contains(\"" + haystack + "\", \"" + needle + "\") should be " + (expected ? "true" : "false"));
+			}
+		}
+		PASS;
+	}
+
+	TEST(ContainsFindsNeedleAtEveryPosition)
+	{
+		constexpr std::string_view needle = "xyz";
+
+		for (std::size_t size = needle.size(); size < 100; ++size) {
+			for (std::size_t pos = 0; pos + needle.size() <= size; ++pos) {
+				std::string haystack(size, 'x');
+				haystack.replace(pos, needle.size(), needle);
+
+				const auto buffer = ExactCopy(haystack);
+				for (const auto isa : GetTestedISAs()) {
+					ASSERT(Contains(isa, { buffer.get(), size }, needle), std::string(GetISAName(isa)) + " didn't find needle at " + std::to_string(pos) + " in string of length " + std::to_string(size));
+				}
+			}
+		}
+		PASS;
+	}
+
+	TEST(EmptyNeedleNeverMatches)
+	{
+		for (const auto isa : GetTestedISAs()) {
+			ASSERT(!Contains(isa, "", ""), std::string(GetISAName(isa)) + " matched empty needle in empty string");
+			ASSERT(!Contains(isa, "haystack", ""), std::string(GetISAName(isa)) + " matched empty needle");
+		}
+		PASS;
+	}
+
+	TEST(FoldedContainsMatchesIContains)
+	{
+		std::mt19937                               rng(seed);
+		std::uniform_int_distribution<std::size_t> haystackLength(0, 64);
+		std::uniform_int_distribution<std::size_t> needleLength(0, 6);
+
+		constexpr std::string_view alphabet = "aAbB_\xC4\xE4";
+
+		for (int i = 0; i < iterations; ++i) {
+			const auto haystack = RandomString(rng, haystackLength(rng), alphabet);
+			const auto needle = RandomString(rng, needleLength(rng), alphabet);
+
+			ASSERT(contains(fold(haystack), fold(needle)) == ReferenceIContains(haystack, needle), "folded contains differs from icontains for \"" + haystack + "\" and \"" + needle + "\"");
+		}
+		PASS;
+	}
+}
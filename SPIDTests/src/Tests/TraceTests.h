@@ -0,0 +1,50 @@
+#pragma once
+#include "Testing.h"
+#include "Trace.h"
+
+namespace Trace::Testing
+{
+	constexpr static const char* moduleName = "Trace";
+
+	TEST(RingBufferDropsWhenFull)
+	{
+		RingBuffer<int, 4> buffer{};
+		for (int i = 0; i < 6; ++i) {
+			buffer.TryPush(i);
+		}
+		ASSERT(buffer.GetDropped() == 2, fmt::format("expected 2 dropped items, got {}", buffer.GetDropped()));
+
+		std::vector<int> drained{};
+		buffer.Drain([&](int a_value) { drained.push_back(a_value); });
+		ASSERT((drained == std::vector{ 0, 1, 2, 3 }), "oldest items should be kept");
+
+		// Drained space is reused.
+		ASSERT(buffer.TryPush(4) && buffer.TryPush(5), "drained buffer should accept new items");
+		drained.clear();
+		EXPECT(buffer.Drain([&](int a_value) { drained.push_back(a_value); }) == 2 && (drained == std::vector{ 4, 5 }), "items pushed after drain should be drained next");
+	}
+
+	TEST(DrainsZonesOfAllThreads)
+	{
+		(void)Drain();
+
+		{
+			const Zone zone("TestZone");
+		}
+		std::thread([] {
+			const Zone zone("WorkerZone");
+			std::this_thread::sleep_for(std::chrono::milliseconds(2));
+		}).join();
+
+		const auto trace = Drain();
+		ASSERT(trace.contains(R"("name":"TestZone","ph":"X")"), "zone of this thread should be drained");
+
+		const auto worker = trace.find(R"("name":"WorkerZone","ph":"X")");
+		ASSERT(worker != std::string::npos, "zone of a finished thread should be drained");
+
+		// Ticks are converted to microseconds.
+		const auto duration = std::strtod(trace.c_str() + trace.find(R"("dur":)", worker) + 6, nullptr);
+		ASSERT(duration >= 1000.0 && duration < 1e6, fmt::format("worker zone should last about 2ms, got {}us", duration));
+		EXPECT(Drain().empty(), "zones should only be drained once");
+	}
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+// Standalone counterpart of SPID/src/Testing/TestsHelpers.h.
+// Instead of vanilla forms, tests get a small mock world that is rebuilt from scratch for each test,
+// so there is nothing to snapshot or revert.
+
+#include "Distribute.h"
+#include "EditorIDIndex.h"
+#include "FormData.h"
+#include "LookupConfigs.h"
+#include "Mock.h"
+
+namespace Testing::Helper
+{
+	template <class T>
+	std::vector<T> ToVector(const RE::BSSimpleList<T>& list)
+	{
+		return { list.begin(), list.end() };
+	}
+
+	/// Forms that tests distribute and NPCs that they distribute to.
+	struct World
+	{
+		RE::Actor*          actor{ nullptr };
+		RE::Actor*          anotherActor{ nullptr };
+		RE::TESBoundObject* item{ nullptr };
+		RE::SpellItem*      spell{ nullptr };
+		RE::TESPackage*     package{ nullptr };
+	};
+
+	namespace Distribution
+	{
+		inline Forms::Distributables<RE::SpellItem>&      GetSpells() { return Forms::spells; }
+		inline Forms::Distributables<RE::BGSPerk>&        GetPerks() { return Forms::perks; }
+		inline Forms::Distributables<RE::TESBoundObject>& GetItems() { return Forms::items; }
+		inline Forms::Distributables<RE::TESShout>&       GetShouts() { return Forms::shouts; }
+		inline Forms::Distributables<RE::TESLevSpell>&    GetLevSpells() { return Forms::levSpells; }
+		inline Forms::Distributables<RE::TESForm>&        GetPackages() { return Forms::packages; }
+		inline Forms::Distributables<RE::BGSOutfit>&      GetOutfits() { return Forms::outfits; }
+		inline Forms::Distributables<RE::BGSKeyword>&     GetKeywords() { return Forms::keywords; }
+		inline Forms::Distributables<RE::TESFaction>&     GetFactions() { return Forms::factions; }
+		inline Forms::Distributables<RE::BGSOutfit>&      GetSleepOutfits() { return Forms::sleepOutfits; }
+		inline Forms::Distributables<RE::TESObjectARMO>&  GetSkins() { return Forms::skins; }
+
+		inline void ClearConfigs()
+		{
+			Forms::ForEachDistributable([]<class Form>(Forms::Distributables<Form>& a_distributable) {
+				a_distributable.GetForms().clear();
+			});
+			::Distribution::INI::configs.clear();
+		}
+
+		/// Performs the same distribution as the one done when NPC is loaded.
+		inline void Distribute(RE::Actor* actor)
+		{
+			auto npcData = NPCData(actor);
+			::Distribute::Distribute(npcData, false);
+		}
+	}
+
+	/// <summary>
+	/// Clears all configs and creates a new world. Forms of the previous world are destroyed.
+	/// </summary>
+	inline World Setup()
+	{
+		Distribution::ClearConfigs();
+		Mock::Reset();
+
+		World world;
+
+		const auto race = Mock::Create<RE::TESRace>("NordRace");
+
+		const auto npc = Mock::Create<RE::TESNPC>("BanditMelee");
+		npc->fullName = "Bandit";
+		npc->race = race;
+		for (const auto editorID : { "DefaultSandbox", "DefaultPatrol", "DefaultSleep" }) {
+			npc->aiPackages.packages.push_back(Mock::Create<RE::TESPackage>(editorID));
+		}
+
+		const auto anotherNPC = Mock::Create<RE::TESNPC>("BanditMissile");
+		anotherNPC->fullName = "Bandit";
+		anotherNPC->race = race;
+
+		world.actor = Mock::CreateActor(npc);
+		world.anotherActor = Mock::CreateActor(anotherNPC);
+		world.item = Mock::Create<RE::TESObjectWEAP>("DaedricMace");
+		world.spell = Mock::Create<RE::SpellItem>("IceSpear");
+		world.package = Mock::Create<RE::TESPackage>("FollowPlayer");
+
+		Forms::EditorIDIndex::GetSingleton()->Build();
+
+		return world;
+	}
+}
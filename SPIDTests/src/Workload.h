@@ -0,0 +1,650 @@
+#pragma once
+
+// Synthetic load orders for benchmarking the core.
+// A Shape describes how big a load order is and what its configs look like, Generate builds a mock world
+// and configs of that shape. Everything is derived from the shape's seed, so the same shape always produces the same workload.
+
+#include "EntrySanitizer.h"
+#include "ExclusiveGroups.h"
+#include "FormData.h"
+#include "KeywordDependencies.h"
+#include "LinkedDistribution.h"
+#include "LookupConfigs.h"
+#include "LookupForms.h"
+#include "Mock.h"
+#include "PCLevelMultManager.h"
+
+namespace Workload
+{
+	/// Percentages of entries that use each kind of filter. An entry can use any number of them.
+	struct FilterMix
+	{
+		std::uint32_t keyword{ 40 };   // keyword/editorID string filters
+		std::uint32_t partial{ 15 };   // "*" partial string filters
+		std::uint32_t faction{ 30 };   // faction form filters
+		std::uint32_t formList{ 10 };  // FormList form filters, when shape has FormLists
+		std::uint32_t level{ 20 };     // actor or skill level filters
+		std::uint32_t traits{ 15 };
+		std::uint32_t chance{ 25 };
+	};
+
+	struct Shape
+	{
+		std::string   name{};
+		std::uint64_t seed{ 0 };
+
+		std::size_t npcs{ 1000 };
+		std::size_t plugins{ 8 };
+		std::size_t configFiles{ 16 };
+
+		/// Number of regular entries of each type. Generic Form entries are not generated.
+		std::array<std::size_t, RECORD::kTotal> entries{};
+
+		/// Number of distributable forms of each type that entries pick from.
+		std::size_t formsPerType{ 100 };
+
+		std::size_t races{ 12 };
+		std::size_t classes{ 24 };
+		std::size_t keywords{ 200 };  // keywords that NPCs and races have
+		std::size_t factions{ 150 };
+
+		std::size_t formLists{ 0 };
+		std::size_t formListSize{ 0 };
+
+		std::size_t exclusiveGroups{ 0 };
+		std::size_t linkedEntries{ 0 };
+
+		FilterMix mix{};
+
+		/// Sets the same number of entries for every type.
+		Shape& SetEntriesPerType(std::size_t a_count)
+		{
+			entries.fill(a_count);
+			entries[RECORD::kForm] = 0;
+			return *this;
+		}
+
+		[[nodiscard]] std::size_t GetTotalEntries() const
+		{
+			return std::accumulate(entries.begin(), entries.end(), std::size_t{ 0 });
+		}
+	};
+
+	/// A config entry as it's read from a _DISTR file.
+	struct Line
+	{
+		std::string key{};
+		std::string value{};
+		Path        path{};
+	};
+
+	/// Mock world and configs generated for a Shape.
+	struct World
+	{
+		Shape shape{};
+
+		std::vector<RE::Actor*> actors{};
+		std::vector<RE::TESNPC> npcs{};  // NPCs of actors as they were generated, see Restore
+
+		std::vector<Line> lines{};  // configs before they're parsed
+
+		Distribution::INI::Configs                 configs{};
+		LinkedDistribution::INI::LinkedFormsConfig linkedConfigs{};
+		ExclusiveGroups::INI::ExclusiveGroupsVec   exclusiveGroups{};
+	};
+
+	namespace detail
+	{
+		/// Generates numbers from a fixed seed.
+		/// std distributions aren't used, since their results differ between standard libraries.
+		class Random
+		{
+		public:
+			explicit Random(std::uint64_t a_seed) :
+				engine(a_seed)
+			{}
+
+			/// Uniformly distributed number in [a_min, a_max].
+			std::size_t Next(std::size_t a_min, std::size_t a_max)
+			{
+				return a_min + static_cast<std::size_t>(engine() % (a_max - a_min + 1));
+			}
+
+			bool Percent(std::uint32_t a_percent)
+			{
+				return Next(0, 99) < a_percent;
+			}
+
+			template <class T>
+			const T& Pick(const std::vector<T>& a_values)
+			{
+				return a_values[Next(0, a_values.size() - 1)];
+			}
+
+		private:
+			std::mt19937_64 engine;
+		};
+
+		inline const std::vector<std::string> names{
+			"Bandit", "Bandit Chief", "Bandit Marauder", "Guard", "Vampire", "Master Vampire", "Necromancer",
+			"Farmer", "Hunter", "Soldier", "Mage", "Merchant", "Draugr", "Forsworn", "Thalmor Justiciar"
+		};
+
+		/// Fragments for partial string filters, which match names and keywords above (and many that don't match anything).
+		inline const std::vector<std::string> fragments{
+			"bandit", "guard", "vamp", "mage", "chief", "soldier", "WLKeyword00", "WLKeyword01", "WLKeyword1", "Thalmor", "Dwemer", "Giant"
+		};
+
+		inline const std::vector<std::string> traits{
+			"F", "M", "-U", "-C", "U/F", "-S", "-D", "M/-U"
+		};
+
+		class Generator
+		{
+		public:
+			explicit Generator(const Shape& a_shape) :
+				shape(a_shape),
+				random(a_shape.seed)
+			{}
+
+			World Generate()
+			{
+				World world{ .shape = shape };
+
+				Mock::Reset();
+
+				GeneratePlugins();
+				GenerateForms();
+				GenerateNPCs(world);
+
+				Forms::EditorIDIndex::GetSingleton()->Build();
+
+				GenerateEntries(world);
+				GenerateLinkedEntries(world);
+				GenerateExclusiveGroups(world);
+
+				return world;
+			}
+
+		private:
+			template <class Form>
+			Form* Create(std::string_view a_prefix, std::size_t a_index)
+			{
+				return Mock::Create<Form>(fmt::format("{}{:04}", a_prefix, a_index), random.Pick(plugins));
+			}
+
+			/// Mostly editorIDs, but some entries reference forms by formID as configs do.
+			std::string GetIdentifier(const RE::TESForm* a_form)
+			{
+				if (random.Percent(20)) {
+					return fmt::format("0x{:X}~{}", a_form->GetLocalFormID(), a_form->GetFile()->GetFilename());
+				}
+				return a_form->GetFormEditorID();
+			}
+
+			/// Armor that can be worn by any race.
+			RE::TESObjectARMO* CreateArmor(std::string_view a_prefix, std::size_t a_index)
+			{
+				const auto armor = Create<RE::TESObjectARMO>(a_prefix, a_index);
+				armor->armorAddons.push_back(Mock::Create<RE::TESObjectARMA>({}, armor->GetFile()));
+				return armor;
+			}
+
+			RE::BGSOutfit* CreateOutfit(std::string_view a_prefix, std::size_t a_index)
+			{
+				const auto outfit = Create<RE::BGSOutfit>(a_prefix, a_index);
+				for (std::size_t i = 0; i < 3; ++i) {
+					outfit->outfitItems.push_back(CreateArmor(fmt::format("{}Armor{:04}_", a_prefix, a_index), i));
+				}
+				return outfit;
+			}
+
+			void GeneratePlugins()
+			{
+				static constexpr std::array masters{ "Skyrim.esm"sv, "Update.esm"sv, "Dawnguard.esm"sv, "HearthFires.esm"sv, "Dragonborn.esm"sv };
+
+				for (std::size_t i = 0; i < std::max<std::size_t>(shape.plugins, 1); ++i) {
+					plugins.push_back(i < masters.size() ? Mock::AddFile(masters[i]) : Mock::AddFile(fmt::format("WLPlugin{:02}.esp", i)));
+				}
+			}
+
+			void GenerateForms()
+			{
+				for (std::size_t i = 0; i < shape.keywords; ++i) {
+					keywords.push_back(Create<RE::BGSKeyword>("WLKeyword", i));
+				}
+				for (std::size_t i = 0; i < shape.factions; ++i) {
+					factions.push_back(Create<RE::TESFaction>("WLFaction", i));
+				}
+				for (std::size_t i = 0; i < shape.classes; ++i) {
+					classes.push_back(Create<RE::TESClass>("WLClass", i));
+				}
+				for (std::size_t i = 0; i < std::max<std::size_t>(shape.races, 2); ++i) {
+					const auto race = Create<RE::TESRace>(i == 0 ? "WLChildRace" : "WLRace", i);
+					if (i == 0) {
+						race->data.flags = RE::TESRace::RACE_DATA::kChild;
+					}
+					if (!keywords.empty()) {
+						race->AddKeyword(random.Pick(keywords));
+					}
+					races.push_back(race);
+				}
+				for (std::size_t i = 0; i < 16; ++i) {
+					defaultOutfits.push_back(CreateOutfit("WLDefaultOutfit", i));
+				}
+
+				auto& pool = distributables;
+				for (std::size_t i = 0; i < shape.formsPerType; ++i) {
+					pool[RECORD::kSpell].push_back(Create<RE::SpellItem>("WLSpell", i));
+					pool[RECORD::kLevSpell].push_back(Create<RE::TESLevSpell>("WLLevSpell", i));
+					pool[RECORD::kPerk].push_back(Create<RE::BGSPerk>("WLPerk", i));
+					pool[RECORD::kShout].push_back(Create<RE::TESShout>("WLShout", i));
+					pool[RECORD::kPackage].push_back(Create<RE::TESPackage>("WLPackage", i));
+					pool[RECORD::kKeyword].push_back(Create<RE::BGSKeyword>("WLDistKeyword", i));
+					pool[RECORD::kOutfit].push_back(CreateOutfit("WLOutfit", i));
+					pool[RECORD::kSleepOutfit].push_back(CreateOutfit("WLSleepOutfit", i));
+					pool[RECORD::kSkin].push_back(CreateArmor("WLSkin", i));
+
+					switch (i % 3) {
+					case 0:
+						pool[RECORD::kItem].push_back(Create<RE::TESObjectWEAP>("WLWeapon", i));
+						break;
+					case 1:
+						pool[RECORD::kItem].push_back(Create<RE::TESObjectMISC>("WLMisc", i));
+						break;
+					default:
+						{
+							const auto levItem = Create<RE::TESLevItem>("WLLevItem", i);
+							for (std::uint16_t level = 1; level <= 40; level += 10) {
+								levItem->entries.push_back({ Create<RE::TESObjectMISC>(fmt::format("WLLevItem{:04}_", i), level), 1, level });
+							}
+							pool[RECORD::kItem].push_back(levItem);
+						}
+						break;
+					}
+				}
+				pool[RECORD::kFaction].assign(factions.begin(), factions.end());
+
+				if (shape.formListSize > 0) {
+					for (std::size_t i = 0; i < shape.formLists; ++i) {
+						const auto list = Create<RE::BGSListForm>("WLFormList", i);
+						for (std::size_t j = 0; j < shape.formListSize; ++j) {
+							switch (random.Next(0, 2)) {
+							case 0:
+								list->forms.push_back(random.Pick(factions));
+								break;
+							case 1:
+								list->forms.push_back(random.Pick(races));
+								break;
+							default:
+								list->forms.push_back(random.Pick(classes));
+								break;
+							}
+						}
+						formLists.push_back(list);
+					}
+				}
+			}
+
+			void GenerateNPCs(World& a_world)
+			{
+				a_world.actors.reserve(shape.npcs);
+				a_world.npcs.reserve(shape.npcs);
+
+				for (std::size_t i = 0; i < shape.npcs; ++i) {
+					const auto npc = Create<RE::TESNPC>("WLNPC", i);
+					npc->fullName = random.Pick(names);
+					npc->race = random.Percent(5) ? races.front() : races[random.Next(1, races.size() - 1)];
+					npc->npcClass = classes.empty() ? nullptr : random.Pick(classes);
+					npc->defaultOutfit = random.Pick(defaultOutfits);
+
+					auto& data = npc->actorData;
+					data.level = static_cast<std::uint16_t>(random.Next(1, 60));
+					data.calcLevelMax = static_cast<std::uint16_t>(data.level + random.Next(0, 20));
+					if (random.Percent(50)) {
+						data.actorBaseFlags |= RE::TESNPC::ACTOR_BASE_DATA::kFemale;
+					}
+					if (random.Percent(10)) {
+						data.actorBaseFlags |= RE::TESNPC::ACTOR_BASE_DATA::kUnique;
+					}
+					if (random.Percent(2)) {
+						data.actorBaseFlags |= RE::TESNPC::ACTOR_BASE_DATA::kSummonable;
+					}
+
+					for (auto& skill : npc->playerSkills.values) {
+						skill = static_cast<std::uint8_t>(random.Next(5, 100));
+					}
+
+					if (!keywords.empty()) {
+						for (std::size_t k = random.Next(0, 5); k > 0; --k) {
+							npc->AddKeyword(random.Pick(keywords));
+						}
+					}
+					if (!factions.empty()) {
+						for (std::size_t f = random.Next(0, 3); f > 0; --f) {
+							npc->factions.push_back({ random.Pick(factions), static_cast<std::int8_t>(random.Percent(5) ? -1 : random.Next(0, 3)) });
+						}
+					}
+					for (std::size_t s = random.Next(0, 3); s > 0; --s) {
+						npc->actorEffects.spells.push_back(static_cast<RE::SpellItem*>(random.Pick(distributables[RECORD::kSpell])));
+					}
+					for (std::size_t p = random.Next(0, 3); p > 0; --p) {
+						npc->aiPackages.packages.push_back(static_cast<RE::TESPackage*>(random.Pick(distributables[RECORD::kPackage])));
+					}
+
+					const auto actor = Mock::CreateActor(npc, fmt::format("WLActor{:04}", i));
+					actor->dead = random.Percent(3);
+					actor->playerTeammate = random.Percent(1);
+
+					a_world.actors.push_back(actor);
+					a_world.npcs.push_back(*npc);
+				}
+			}
+
+			std::string GenerateStringFilters()
+			{
+				const auto& mix = shape.mix;
+
+				std::vector<std::string> filters;
+
+				const auto pickKeyword = [&]() -> std::string {
+					// Some filters reference distributed keywords, which makes keyword entries depend on each other.
+					if (keywords.empty() || random.Percent(20)) {
+						return random.Pick(distributables[RECORD::kKeyword])->GetFormEditorID();
+					}
+					return random.Pick(keywords)->GetFormEditorID();
+				};
+
+				if (random.Percent(mix.keyword)) {
+					for (std::size_t i = random.Next(1, 3); i > 0; --i) {
+						filters.push_back(pickKeyword());
+					}
+					if (random.Percent(15)) {
+						filters.push_back(pickKeyword() + "+" + pickKeyword());
+					}
+					if (random.Percent(10)) {
+						filters.push_back("-" + pickKeyword());
+					}
+				}
+				if (random.Percent(mix.partial)) {
+					filters.push_back("*" + random.Pick(fragments));
+				}
+				if (random.Percent(5)) {
+					filters.push_back(random.Pick(names));
+				}
+
+				return filters.empty() ? "NONE" : string::join(filters, ",");
+			}
+
+			std::string GenerateFormFilters()
+			{
+				const auto& mix = shape.mix;
+
+				std::vector<std::string> filters;
+
+				if (!factions.empty() && random.Percent(mix.faction)) {
+					for (std::size_t i = random.Next(1, 2); i > 0; --i) {
+						filters.push_back(GetIdentifier(random.Pick(factions)));
+					}
+				}
+				if (!formLists.empty() && random.Percent(mix.formList)) {
+					filters.push_back(GetIdentifier(random.Pick(formLists)));
+				}
+				if (random.Percent(10)) {
+					filters.push_back(GetIdentifier(random.Pick(races)));
+				}
+				if (!classes.empty() && random.Percent(5)) {
+					filters.push_back(GetIdentifier(random.Pick(classes)));
+				}
+				if (!factions.empty() && random.Percent(5)) {
+					filters.push_back("-" + GetIdentifier(random.Pick(factions)));
+				}
+
+				return filters.empty() ? "NONE" : string::join(filters, ",");
+			}
+
+			std::string GenerateLevelFilters()
+			{
+				if (!random.Percent(shape.mix.level)) {
+					return "NONE";
+				}
+
+				if (random.Percent(25)) {
+					const auto min = random.Next(10, 70);
+					return fmt::format("{}({}/{})", random.Next(0, 17), min, min + random.Next(10, 30));
+				}
+
+				const auto min = random.Next(1, 40);
+				return fmt::format("{}/{}", min, min + random.Next(5, 40));
+			}
+
+			std::string GenerateChance()
+			{
+				if (!random.Percent(shape.mix.chance)) {
+					return "NONE";
+				}
+				return fmt::format("{}{}", random.Next(5, 95), random.Percent(20) ? "!" : "");
+			}
+
+			void GenerateEntries(World& a_world)
+			{
+				for (std::size_t type = RECORD::kSpell; type < RECORD::kTotal; ++type) {
+					const auto  recordType = static_cast<RECORD::TYPE>(type);
+					const auto& pool = distributables[type];
+
+					for (std::size_t i = 0; i < shape.entries[type]; ++i) {
+						const auto form = GetIdentifier(random.Pick(pool));
+						const auto path = fmt::format("WLMod{:02}_DISTR.ini", random.Next(0, std::max<std::size_t>(shape.configFiles, 1) - 1));
+
+						const auto count = recordType == RECORD::kItem && random.Percent(30) ? "1-3"s : "NONE"s;
+						const auto traits = random.Percent(shape.mix.traits) ? random.Pick(detail::traits) : "NONE"s;
+
+						const auto value = fmt::format("{}|{}|{}|{}|{}|{}|{}", form, GenerateStringFilters(), GenerateFormFilters(), GenerateLevelFilters(), traits, count, GenerateChance());
+
+						a_world.lines.push_back({ std::string(RECORD::GetTypeName(recordType)), value, path });
+
+						parents.emplace_back(form, path);
+					}
+				}
+			}
+
+			void GenerateLinkedEntries(World& a_world)
+			{
+				static constexpr std::array types{ RECORD::kSpell, RECORD::kPerk, RECORD::kItem, RECORD::kKeyword, RECORD::kFaction };
+
+				if (parents.empty()) {
+					return;
+				}
+
+				for (std::size_t i = 0; i < shape.linkedEntries; ++i) {
+					const auto type = types[random.Next(0, types.size() - 1)];
+
+					// Linked forms are linked to forms of regular entries, so that they're actually distributed.
+					const auto& [parent, path] = random.Pick(parents);
+
+					auto linkedParents = parent;
+					if (random.Percent(30)) {
+						linkedParents += "," + random.Pick(parents).first;
+					}
+
+					const auto key = fmt::format("{}Linked{}", random.Percent(50) ? "Global" : "", RECORD::GetTypeName(type));
+					const auto value = fmt::format("{}|{}|NONE|{}", GetIdentifier(random.Pick(distributables[type])), linkedParents, GenerateChance());
+
+					a_world.lines.push_back({ key, value, path });
+				}
+			}
+
+			void GenerateExclusiveGroups(World& a_world)
+			{
+				static constexpr std::array types{ RECORD::kSpell, RECORD::kPerk, RECORD::kKeyword, RECORD::kOutfit };
+
+				for (std::size_t i = 0; i < shape.exclusiveGroups; ++i) {
+					const auto& pool = distributables[types[random.Next(0, types.size() - 1)]];
+
+					std::vector<std::string> forms;
+					for (std::size_t j = random.Next(3, 6); j > 0; --j) {
+						forms.push_back(GetIdentifier(random.Pick(pool)));
+					}
+
+					a_world.lines.push_back({ "ExclusiveGroup", fmt::format("WLGroup{:03}|{}", i, string::join(forms, ",")), "WLGroups_DISTR.ini" });
+				}
+			}
+
+			// members
+			const Shape& shape;
+			Random       random;
+
+			std::vector<RE::TESFile*>     plugins{};
+			std::vector<RE::BGSKeyword*>  keywords{};
+			std::vector<RE::TESFaction*>  factions{};
+			std::vector<RE::TESClass*>    classes{};
+			std::vector<RE::TESRace*>     races{};
+			std::vector<RE::BGSListForm*> formLists{};
+			std::vector<RE::BGSOutfit*>   defaultOutfits{};
+
+			std::array<std::vector<RE::TESForm*>, RECORD::kTotal> distributables{};  // forms that entries of each type distribute
+
+			std::vector<std::pair<std::string, Path>> parents{};  // distributed forms of regular entries and their configs
+		};
+	}
+
+	/// <summary>
+	/// Parses lines the same way Distribution::INI::ParseConfig parses entries of a file.
+	/// </summary>
+	inline void Parse(const std::vector<Line>& a_lines, World& a_world)
+	{
+		std::string sanitized;
+		for (const auto& [key, value, path] : a_lines) {
+			Sanitizer::sanitize(value, sanitized);
+
+			if (ExclusiveGroups::INI::TryParse(key, sanitized, path, a_world.exclusiveGroups)) {
+				continue;
+			}
+			if (LinkedDistribution::INI::TryParse(key, sanitized, path, a_world.linkedConfigs)) {
+				continue;
+			}
+			Distribution::INI::TryParse(key, sanitized, path, a_world.configs);
+		}
+	}
+
+	/// <summary>
+	/// Builds a mock world of given shape and generates its configs. Forms of the previous world are destroyed.
+	/// </summary>
+	inline World Generate(const Shape& a_shape)
+	{
+		auto world = detail::Generator(a_shape).Generate();
+		Parse(world.lines, world);
+		return world;
+	}
+
+	/// <summary>
+	/// Discards forms that were looked up for previous configs and installs configs of a_world, as if they were just read from INIs.
+	/// </summary>
+	inline void LoadConfigs(const World& a_world)
+	{
+		Forms::ForEachDistributable([]<class Form>(Forms::Distributables<Form>& a_distributable) {
+			a_distributable.GetForms().clear();
+			a_distributable.FinishLookupForms();
+		});
+		Forms::Resolver::GetSingleton()->Clear();
+
+		Distribution::INI::configs = a_world.configs;
+		LinkedDistribution::INI::linkedConfigs = a_world.linkedConfigs;
+		ExclusiveGroups::INI::exclusiveGroups = a_world.exclusiveGroups;
+	}
+
+	/// <summary>
+	/// Looks up loaded configs the same way Lookup::LookupForms does, minus caching and logging.
+	/// </summary>
+	inline void LookupConfigs()
+	{
+		const auto dataHandler = RE::TESDataHandler::GetSingleton();
+
+		RawFormRefs refs;
+		for (const auto& [type, entries] : Distribution::INI::configs) {
+			Distribution::INI::CollectRawForms(entries, refs);
+		}
+		LinkedDistribution::INI::CollectRawForms(refs);
+		for (const auto& group : ExclusiveGroups::INI::exclusiveGroups) {
+			Distribution::INI::CollectRawForms(group.formFilters, refs);
+		}
+		Forms::Resolver::GetSingleton()->Prefetch(dataHandler, refs);
+
+		Lookup::LookupEntries(dataHandler, Distribution::INI::configs);
+		Dependencies::ResolveKeywords();
+		Forms::ForEachDistributable([]<class Form>(Forms::Distributables<Form>& a_distributable) {
+			a_distributable.FinishLookupForms();
+		});
+
+		LinkedDistribution::Manager::GetSingleton()->LookupLinkedForms(dataHandler);
+		ExclusiveGroups::Manager::GetSingleton()->LookupExclusiveGroups(dataHandler);
+
+		Forms::Resolver::GetSingleton()->Clear();
+	}
+
+	/// <summary>
+	/// Reverts all changes that distribution made to NPCs of a_world, so that it can be distributed again.
+	/// </summary>
+	inline void Restore(World& a_world)
+	{
+		const auto pcLevelMultManager = PCLevelMult::Manager::GetSingleton();
+
+		for (std::size_t i = 0; i < a_world.actors.size(); ++i) {
+			const auto npc = a_world.actors[i]->GetActorBase();
+			*npc = a_world.npcs[i];
+			pcLevelMultManager->DeleteNPC(npc->GetFormID());
+		}
+	}
+
+	/// Fixed-seed scenarios that benchmarks run by default.
+	namespace Scenarios
+	{
+		/// A vanilla-sized load order with a handful of small distribution mods.
+		inline Shape Vanilla()
+		{
+			Shape shape{ .name = "vanilla", .seed = 0x5350'4944'0001, .npcs = 3000 };
+			shape.SetEntriesPerType(10);
+			shape.formLists = 8;
+			shape.formListSize = 10;
+			shape.exclusiveGroups = 2;
+			shape.linkedEntries = 10;
+			return shape;
+		}
+
+		/// Outfit overhaul that gives outfits, sleep outfits and skins to nearly every NPC, on top of a typical modlist.
+		inline Shape HeavyOutfitPack()
+		{
+			Shape shape{ .name = "heavy outfit pack", .seed = 0x5350'4944'0002, .npcs = 3000, .formsPerType = 400 };
+			shape.SetEntriesPerType(50);
+			shape.entries[RECORD::kOutfit] = 2000;
+			shape.entries[RECORD::kSleepOutfit] = 600;
+			shape.entries[RECORD::kSkin] = 300;
+			shape.formLists = 32;
+			shape.formListSize = 25;
+			shape.exclusiveGroups = 20;
+			shape.linkedEntries = 100;
+			shape.mix.keyword = 60;
+			shape.mix.faction = 50;
+			return shape;
+		}
+
+		/// Extremely large load order with 100k entries in total. NPCs are limited to keep the run short.
+		inline Shape Entries100k()
+		{
+			Shape shape{ .name = "100k entries", .seed = 0x5350'4944'0003, .npcs = 50, .plugins = 64, .configFiles = 400, .formsPerType = 2000 };
+			shape.SetEntriesPerType(100'000 / (RECORD::kTotal - 1));
+			shape.keywords = 2000;
+			shape.factions = 1000;
+			shape.formLists = 200;
+			shape.formListSize = 50;
+			shape.exclusiveGroups = 200;
+			shape.linkedEntries = 2000;
+			return shape;
+		}
+
+		inline std::vector<Shape> GetAll()
+		{
+			return { Vanilla(), HeavyOutfitPack(), Entries100k() };
+		}
+	}
+}
@@ -0,0 +1,14 @@
+#include "Benchmark.h"
+#include "StringKernels.h"
+
+#include "Benchmarks/EntrySanitizerBenchmarks.h"
+#include "Benchmarks/IniReaderBenchmarks.h"
+#include "Benchmarks/LookupErrorsBenchmarks.h"
+#include "Benchmarks/StringKernelsBenchmarks.h"
+
+int main()
+{
+	std::printf("String kernels: %s\n", Strings::GetISAName(Strings::GetSupportedISA()).data());
+	::Benchmark::Registry::Run();
+	return 0;
+}
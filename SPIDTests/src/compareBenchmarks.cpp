@@ -0,0 +1,90 @@
+#include "BenchmarkReport.h"
+
+#include <fstream>
+#include <sstream>
+
+// Compares results of SPIDCoreBenchmarks (written with --json) against a baseline.
+//
+// Usage: SPIDBenchmarkCompare <baseline.json> <results.json>... [--update]
+// Results of several runs (e.g. one per scenario) are merged before they're compared.
+// Prints a table with changes of every benchmark and exits with 1 if any of them regressed beyond its tolerance.
+// With --update the baseline is replaced with results instead, keeping tolerances of existing benchmarks.
+namespace
+{
+	std::optional<std::vector<Benchmark::Report::Entry>> read_report(const char* a_path)
+	{
+		std::ifstream input(a_path, std::ios::binary);
+		if (!input) {
+			std::printf("Couldn't open %s\n", a_path);
+			return std::nullopt;
+		}
+
+		std::stringstream json;
+		json << input.rdbuf();
+
+		auto report = Benchmark::Report::Read(json.str());
+		if (!report) {
+			std::printf("%s is not a valid benchmark report\n", a_path);
+		}
+		return report;
+	}
+
+	int update(const char* a_path, const std::vector<Benchmark::Report::Entry>& a_baseline, std::vector<Benchmark::Report::Entry> a_results)
+	{
+		for (auto& result : a_results) {
+			const auto baseline = std::ranges::find(a_baseline, result.name, &Benchmark::Report::Entry::name);
+			result.tolerance = baseline != a_baseline.end() ? baseline->tolerance : Benchmark::Report::Tolerance{};
+		}
+
+		std::ofstream output(a_path, std::ios::binary | std::ios::trunc);
+		output << Benchmark::Report::Write(a_results);
+		if (!output) {
+			std::printf("Couldn't write %s\n", a_path);
+			return 2;
+		}
+
+		std::printf("Updated %s with %zu benchmarks\n", a_path, a_results.size());
+		return 0;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	const bool shouldUpdate = argc > 3 && std::string_view(argv[argc - 1]) == "--update";
+	const int  resultsEnd = shouldUpdate ? argc - 1 : argc;
+
+	if (resultsEnd < 3) {
+		std::printf("Usage: %s <baseline.json> <results.json>... [--update]\n", argv[0]);
+		return 2;
+	}
+
+	const auto baseline = read_report(argv[1]);
+	if (!baseline) {
+		return 2;
+	}
+
+	std::vector<Benchmark::Report::Entry> results{};
+	for (int i = 2; i < resultsEnd; ++i) {
+		auto report = read_report(argv[i]);
+		if (!report) {
+			return 2;
+		}
+		results.insert(results.end(), std::make_move_iterator(report->begin()), std::make_move_iterator(report->end()));
+	}
+
+	if (shouldUpdate) {
+		return update(argv[1], *baseline, std::move(results));
+	}
+
+	const auto rows = Benchmark::Report::Compare(*baseline, results);
+	std::printf("%s", Benchmark::Report::FormatTable(rows).c_str());
+
+	const auto regressions = std::ranges::count_if(rows, &Benchmark::Report::Row::IsRegression);
+	if (regressions > 0) {
+		std::printf("\n%td of %zu benchmarks regressed\n", regressions, rows.size());
+		return 1;
+	}
+
+	std::printf("\nNo regressions in %zu benchmarks\n", rows.size());
+	return 0;
+}
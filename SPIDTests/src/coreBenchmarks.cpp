@@ -0,0 +1,102 @@
+#include "Benchmark.h"
+#include "BenchmarkReport.h"
+
+#include "Benchmarks/DistributionBenchmarks.h"
+#include "Benchmarks/LogBufferBenchmarks.h"
+
+// Counts allocations for Benchmark::allocations. Array and sized forms of new and delete call these by default.
+void* operator new(std::size_t a_size)
+{
+	::Benchmark::allocations.fetch_add(1, std::memory_order_relaxed);
+	if (const auto ptr = std::malloc(a_size > 0 ? a_size : 1)) {
+		return ptr;
+	}
+	throw std::bad_alloc();
+}
+
+void operator delete(void* a_ptr) noexcept
+{
+	std::free(a_ptr);
+}
+
+void operator delete(void* a_ptr, std::size_t) noexcept
+{
+	std::free(a_ptr);
+}
+
+// Usage: SPIDCoreBenchmarks [<scenario> [--npcs <N>] [--entries <M>] [--seed <S>]] [--json <path>]
+// Without a scenario all scenarios are run. Otherwise a single scenario is run, with parts of its shape overridden.
+// With --json results are also written to a file, which can be compared against a baseline with SPIDBenchmarkCompare.
+int main(int argc, char* argv[])
+{
+	// Lookup and distribution log every entry and every distributed form.
+	spdlog::set_level(spdlog::level::err);
+
+	std::optional<Workload::Shape> shape;
+	std::string                    jsonPath;
+
+	const auto scenarios = Workload::Scenarios::GetAll();
+
+	for (int i = 1; i < argc; ++i) {
+		const std::string_view arg = argv[i];
+
+		if (!arg.starts_with("--")) {
+			const auto scenario = std::ranges::find(scenarios, arg, &Workload::Shape::name);
+			if (scenario == scenarios.end()) {
+				std::printf("Unknown scenario '%s', available scenarios:\n", argv[i]);
+				for (const auto& available : scenarios) {
+					std::printf("\t%s\n", available.name.c_str());
+				}
+				return 1;
+			}
+			shape = *scenario;
+			continue;
+		}
+
+		if (i + 1 >= argc) {
+			std::printf("Missing value of '%s'\n", argv[i]);
+			return 1;
+		}
+
+		const std::string_view value = argv[++i];
+		if (arg == "--json") {
+			jsonPath = value;
+			continue;
+		}
+
+		if (!shape) {
+			std::printf("'%s' must follow a scenario\n", argv[i - 1]);
+			return 1;
+		}
+
+		const auto number = std::strtoull(value.data(), nullptr, 10);
+		if (arg == "--npcs") {
+			shape->npcs = number;
+		} else if (arg == "--entries") {
+			shape->SetEntriesPerType(number);
+		} else if (arg == "--seed") {
+			shape->seed = number;
+		} else {
+			std::printf("Unknown option '%s'\n", argv[i - 1]);
+			return 1;
+		}
+	}
+
+	if (shape) {
+		std::printf("  %s\n", shape->name.c_str());
+		Distribute::Benchmarks::RunScenario(*shape);
+	} else {
+		::Benchmark::Registry::Run();
+	}
+
+	if (!jsonPath.empty()) {
+		std::ofstream output(jsonPath, std::ios::binary | std::ios::trunc);
+		output << ::Benchmark::Report::Write(::Benchmark::Report::GetResults());
+		if (!output) {
+			std::printf("Failed to write results to %s\n", jsonPath.c_str());
+			return 1;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,21 @@
+#include "Testing.h"
+
+#include "Tests/AsyncLogTests.h"
+#include "Tests/CaptureTests.h"
+#include "Tests/DeterministicChanceTests.h"
+#include "Tests/DistributionTests.h"
+#include "Tests/FormResolverTests.h"
+#include "Tests/JournalTests.h"
+#include "Tests/LatencyTests.h"
+#include "Tests/LogBufferTests.h"
+#include "Tests/ProfilerTests.h"
+#include "Tests/ShadowTests.h"
+#include "Tests/TraceTests.h"
+
+int main()
+{
+	// Distribution logs every distributed form, which would bury test results.
+	spdlog::set_level(spdlog::level::warn);
+
+	return ::Testing::Runner::Run() == 0 ? 0 : 1;
+}
@@ -0,0 +1,249 @@
+#include "JournalFormat.h"
+#include "MappedFile.h"
+
+#include <cctype>
+#include <cstdio>
+
+// Decodes a distribution journal recorded in the game (see Settings::distributionJournal). Doesn't depend on the game or on the core.
+//
+// Usage: SPIDJournal <journal> [--entries <path>] [--format text|csv|json] [--actor <formID>] [--base <formID>] [--form <formID|editorID>] [--file <name>] [--phase <phase>]
+// Records are printed in the order they were written, as text (default), CSV or JSON.
+// Entry table is read from <journal>.entries unless --entries is given.
+// Filters can be combined, e.g. "--form 0001A2B3 --file MyMod_DISTR.ini" lists actors that received form 0001A2B3 from files whose path contains MyMod_DISTR.ini.
+// --form matches either the distributed form or editorID of an entry's form, --file matches any part of the path, ignoring case.
+// Phase is one of regular, levelup, outfits, death, reload.
+namespace
+{
+	using namespace Distribution::Journal;
+
+	enum class Format
+	{
+		kText,
+		kCSV,
+		kJSON
+	};
+
+	struct Filters
+	{
+		std::optional<std::uint32_t> actor{};
+		std::optional<std::uint32_t> base{};
+		std::optional<std::uint32_t> formID{};
+		std::string                  form{};
+		std::string                  file{};
+		std::optional<Phase>         phase{};
+	};
+
+	std::string to_lower(std::string_view a_str)
+	{
+		std::string result(a_str);
+		std::ranges::transform(result, result.begin(), [](unsigned char a_ch) { return static_cast<char>(std::tolower(a_ch)); });
+		return result;
+	}
+
+	std::optional<std::uint32_t> parse_formID(std::string_view a_value)
+	{
+		const std::string value(a_value);
+		char*             end = nullptr;
+		const auto        formID = std::strtoul(value.c_str(), &end, 16);
+		if (value.empty() || *end != '\0' || formID > 0xFFFFFFFF) {
+			return std::nullopt;
+		}
+		return static_cast<std::uint32_t>(formID);
+	}
+
+	bool matches(const Filters& a_filters, const Record& a_record, const Entry* a_entry)
+	{
+		if ((a_filters.actor && a_record.actorID != *a_filters.actor) ||
+			(a_filters.base && a_record.baseID != *a_filters.base) ||
+			(a_filters.phase && a_record.phase != *a_filters.phase)) {
+			return false;
+		}
+		if (!a_filters.form.empty()) {
+			const bool sameForm = a_filters.formID && (a_record.formID == *a_filters.formID || (a_entry && a_entry->formID == *a_filters.formID));
+			const bool sameEditorID = a_entry && to_lower(a_entry->editorID) == a_filters.form;
+			if (!sameForm && !sameEditorID) {
+				return false;
+			}
+		}
+		return a_filters.file.empty() || (a_entry && to_lower(a_entry->path).contains(a_filters.file));
+	}
+
+	std::string escape_csv(std::string_view a_str)
+	{
+		if (a_str.find_first_of(",\"\n") == std::string_view::npos) {
+			return std::string(a_str);
+		}
+		std::string result = "\"";
+		for (const auto ch : a_str) {
+			if (ch == '"') {
+				result += '"';
+			}
+			result += ch;
+		}
+		return result + '"';
+	}
+
+	std::string escape_json(std::string_view a_str)
+	{
+		std::string result = "\"";
+		for (const auto ch : a_str) {
+			switch (ch) {
+			case '"':
+				result += "\\\"";
+				break;
+			case '\\':
+				result += "\\\\";
+				break;
+			case '\n':
+				result += "\\n";
+				break;
+			case '\t':
+				result += "\\t";
+				break;
+			default:
+				if (static_cast<unsigned char>(ch) < 0x20) {
+					char escaped[8];
+					std::snprintf(escaped, sizeof(escaped), "\\u%04x", ch);
+					result += escaped;
+				} else {
+					result += ch;
+				}
+			}
+		}
+		return result + '"';
+	}
+
+	void print(Format a_format, const Header& a_header, const Record& a_record, const Entry* a_entry, bool a_first)
+	{
+		const auto phase = std::string(GetPhaseName(a_record.phase));
+		const auto formType = a_entry ? a_entry->formTypeName : std::to_string(a_record.formType);
+		const auto editorID = a_entry ? a_entry->editorID : std::string();
+		const auto path = a_entry ? a_entry->path : std::string("<unknown entry " + std::to_string(a_record.entry) + ">");
+		const auto unixMs = a_header.startTime + a_record.timestamp / 1'000'000;
+
+		switch (a_format) {
+		case Format::kText:
+			std::printf("%12.3fs  %-8s actor %08X base %08X  %s %s [%08X] @ %s\n",
+				static_cast<double>(a_record.timestamp) / 1e9, phase.c_str(), a_record.actorID, a_record.baseID,
+				formType.c_str(), editorID.c_str(), a_record.formID, path.c_str());
+			break;
+		case Format::kCSV:
+			std::printf("%llu,%llu,%s,%08X,%08X,%08X,%s,%s,%s\n",
+				static_cast<unsigned long long>(a_record.timestamp), static_cast<unsigned long long>(unixMs), phase.c_str(),
+				a_record.actorID, a_record.baseID, a_record.formID, escape_csv(formType).c_str(), escape_csv(editorID).c_str(), escape_csv(path).c_str());
+			break;
+		case Format::kJSON:
+			std::printf("%s\n  {\"time_ns\":%llu,\"unix_ms\":%llu,\"phase\":\"%s\",\"actor\":\"%08X\",\"base\":\"%08X\",\"form\":\"%08X\",\"form_type\":%s,\"editor_id\":%s,\"file\":%s}",
+				a_first ? "" : ",", static_cast<unsigned long long>(a_record.timestamp), static_cast<unsigned long long>(unixMs), phase.c_str(),
+				a_record.actorID, a_record.baseID, a_record.formID, escape_json(formType).c_str(), escape_json(editorID).c_str(), escape_json(path).c_str());
+			break;
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2) {
+		std::printf("Usage: %s <journal> [--entries <path>] [--format text|csv|json] [--actor <formID>] [--base <formID>] [--form <formID|editorID>] [--file <name>] [--phase <phase>]\n", argv[0]);
+		return 2;
+	}
+
+	const std::filesystem::path journalPath = argv[1];
+	auto                        entriesPath = GetEntriesPath(journalPath);
+	auto                        format = Format::kText;
+	Filters                     filters{};
+
+	for (int i = 2; i < argc; ++i) {
+		if (i + 1 >= argc) {
+			std::printf("Missing value of '%s'\n", argv[i]);
+			return 2;
+		}
+
+		const std::string_view arg = argv[i];
+		const std::string_view value = argv[++i];
+		if (arg == "--entries") {
+			entriesPath = value;
+		} else if (arg == "--format") {
+			if (value == "text") {
+				format = Format::kText;
+			} else if (value == "csv") {
+				format = Format::kCSV;
+			} else if (value == "json") {
+				format = Format::kJSON;
+			} else {
+				std::printf("Unknown format '%s'\n", argv[i]);
+				return 2;
+			}
+		} else if (arg == "--actor" || arg == "--base") {
+			const auto formID = parse_formID(value);
+			if (!formID) {
+				std::printf("'%s' is not a formID\n", argv[i]);
+				return 2;
+			}
+			(arg == "--actor" ? filters.actor : filters.base) = formID;
+		} else if (arg == "--form") {
+			filters.formID = parse_formID(value);
+			filters.form = to_lower(value);
+		} else if (arg == "--file") {
+			filters.file = to_lower(value);
+		} else if (arg == "--phase") {
+			filters.phase = ParsePhase(value);
+			if (!filters.phase) {
+				std::printf("Unknown phase '%s'\n", argv[i]);
+				return 2;
+			}
+		} else {
+			std::printf("Unknown option '%s'\n", argv[i - 1]);
+			return 2;
+		}
+	}
+
+	const MappedFile journalFile(journalPath);
+	if (!journalFile) {
+		std::printf("Couldn't open %s\n", journalPath.string().c_str());
+		return 2;
+	}
+	const auto journal = Read(journalFile.bytes());
+	if (!journal) {
+		std::printf("Couldn't read %s: %s\n", journalPath.string().c_str(), journal.error().c_str());
+		return 2;
+	}
+
+	const MappedFile entriesFile(entriesPath);
+	if (!entriesFile) {
+		std::printf("Couldn't open %s\n", entriesPath.string().c_str());
+		return 2;
+	}
+	const auto table = ReadEntries(entriesFile.bytes());
+	if (!table) {
+		std::printf("Couldn't read %s: %s\n", entriesPath.string().c_str(), table.error().c_str());
+		return 2;
+	}
+	if (table->session != journal->header.session) {
+		std::printf("%s belongs to a different journal\n", entriesPath.string().c_str());
+		return 2;
+	}
+
+	if (format == Format::kCSV) {
+		std::printf("time_ns,unix_ms,phase,actor,base,form,form_type,editor_id,file\n");
+	} else if (format == Format::kJSON) {
+		std::printf("[");
+	}
+
+	std::size_t printed = 0;
+	for (const auto& record : journal->records) {
+		const auto entry = record.entry < table->entries.size() ? &table->entries[record.entry] : nullptr;
+		if (matches(filters, record, entry)) {
+			print(format, journal->header, record, entry, printed++ == 0);
+		}
+	}
+
+	if (format == Format::kJSON) {
+		std::printf("\n]\n");
+	}
+
+	// Summary goes to stderr, so that output can be redirected to a file as is.
+	std::fprintf(stderr, "%zu of %zu records%s\n", printed, journal->records.size(), journal->truncated ? " (journal is truncated)" : "");
+
+	return 0;
+}
@@ -0,0 +1,203 @@
+#include "Profiler.h"
+#include "Replay.h"
+#include "Shadow.h"
+
+#include <fstream>
+
+// Replays a session recorded in the game (see Settings::captureSession) against the mock core.
+//
+// Usage: SPIDReplay <capture> [--repeat <N>] [--top <K>] [--dump <path>] [--shadow] [--profile <csv>]
+// Prints how long distribution took in the game and in the replay, per burst of actors that were loaded together and for the slowest actors.
+// With --repeat the session is replayed N times and the fastest run of every actor is reported.
+// With --dump everything that every actor ended up with is written to a file, so that dumps of two builds can be diffed.
+// With --shadow filters are also evaluated by the reference evaluator (see Distribute::Shadow), and divergences are printed.
+// Replayed times then include shadow evaluation.
+// With --profile time spent on every entry is measured (see Distribute::Profiler), the most expensive files and entries are printed and all entries are written to a CSV file.
+// Replayed times then include profiling.
+namespace
+{
+	/// Actors that were distributed to less than this apart belong to the same burst, e.g. a cell that was loaded.
+	constexpr std::uint64_t burstGapNs = 500'000'000;
+
+	std::optional<std::vector<std::byte>> read_file(const char* a_path)
+	{
+		std::ifstream input(a_path, std::ios::binary | std::ios::ate);
+		if (!input) {
+			std::printf("Couldn't open %s\n", a_path);
+			return std::nullopt;
+		}
+
+		std::vector<std::byte> bytes(static_cast<std::size_t>(input.tellg()));
+		input.seekg(0);
+		input.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+		if (!input) {
+			std::printf("Couldn't read %s\n", a_path);
+			return std::nullopt;
+		}
+		return bytes;
+	}
+
+	double to_ms(std::uint64_t a_ns)
+	{
+		return static_cast<double>(a_ns) / 1e6;
+	}
+
+	void print_bursts(const Replay::Session& a_session, const std::vector<std::uint64_t>& a_replayed)
+	{
+		std::printf("\n%-8s %8s %14s %12s %12s\n", "Burst", "Actors", "Start (s)", "Game (ms)", "Replay (ms)");
+
+		std::size_t burst = 0;
+		for (std::size_t first = 0; first < a_session.actors.size();) {
+			std::size_t   last = first;
+			std::uint64_t game = 0;
+			std::uint64_t replayed = 0;
+			do {
+				game += a_session.actors[last].durationNs;
+				replayed += a_replayed[last];
+				++last;
+			} while (last < a_session.actors.size() && a_session.actors[last].timestamp - a_session.actors[last - 1].timestamp < burstGapNs);
+
+			std::printf("%-8zu %8zu %14.3f %12.3f %12.3f\n", burst++, last - first, static_cast<double>(a_session.actors[first].timestamp) / 1e9, to_ms(game), to_ms(replayed));
+			first = last;
+		}
+	}
+
+	void print_slowest(const Replay::Session& a_session, const std::vector<std::uint64_t>& a_replayed, std::size_t a_count)
+	{
+		std::vector<std::size_t> order(a_session.actors.size());
+		std::iota(order.begin(), order.end(), 0);
+		std::ranges::sort(order, std::greater{}, [&](std::size_t i) { return a_replayed[i]; });
+		order.resize(std::min(order.size(), a_count));
+
+		std::printf("\n%-10s %-10s %-32s %12s %12s\n", "Actor", "NPC", "Name", "Game (us)", "Replay (us)");
+		for (const auto i : order) {
+			const auto& actor = a_session.actors[i];
+			std::printf("%08X   %08X   %-32s %12.1f %12.1f\n", actor.actorID, actor.npcID, actor.name.c_str(), static_cast<double>(actor.durationNs) / 1e3, static_cast<double>(a_replayed[i]) / 1e3);
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2) {
+		std::printf("Usage: %s <capture> [--repeat <N>] [--top <K>] [--dump <path>] [--shadow] [--profile <csv>]\n", argv[0]);
+		return 2;
+	}
+
+	// Distribution logs every distributed form.
+	spdlog::set_level(spdlog::level::err);
+
+	std::size_t repeat = 1;
+	std::size_t top = 10;
+	std::string dumpPath;
+	std::string profilePath;
+
+	for (int i = 2; i < argc; ++i) {
+		const std::string_view arg = argv[i];
+		if (arg == "--shadow") {
+			// Divergences are logged as warnings.
+			spdlog::set_level(spdlog::level::warn);
+			Distribute::Shadow::SetEnabled(true);
+			continue;
+		}
+
+		if (i + 1 >= argc) {
+			std::printf("Missing value of '%s'\n", argv[i]);
+			return 2;
+		}
+
+		const std::string_view value = argv[++i];
+		if (arg == "--repeat") {
+			repeat = std::max<std::size_t>(std::strtoull(value.data(), nullptr, 10), 1);
+		} else if (arg == "--top") {
+			top = std::strtoull(value.data(), nullptr, 10);
+		} else if (arg == "--dump") {
+			dumpPath = value;
+		} else if (arg == "--profile") {
+			profilePath = value;
+			Distribute::Profiler::SetEnabled(true);
+		} else {
+			std::printf("Unknown option '%s'\n", argv[i - 1]);
+			return 2;
+		}
+	}
+
+	const auto bytes = read_file(argv[1]);
+	if (!bytes) {
+		return 2;
+	}
+
+	const auto session = Distribution::Capture::Read(*bytes);
+	if (!session) {
+		std::printf("Couldn't read %s: %s\n", argv[1], session.error().c_str());
+		return 2;
+	}
+
+	std::vector<std::uint64_t> replayed(session->actors.size(), std::numeric_limits<std::uint64_t>::max());
+
+	Replay::World world{};
+	for (std::size_t run = 0; run < repeat; ++run) {
+		// Only the last run is profiled, so that counts match a single session.
+		Distribute::Profiler::Reset();
+		world = Replay::Load(*session);
+		for (std::size_t i = 0; i < session->actors.size(); ++i) {
+			Replay::Apply(session->actors[i], world.actors[i]);
+			replayed[i] = std::min(replayed[i], Replay::Distribute(session->actors[i], world.actors[i]));
+		}
+	}
+
+	std::uint64_t gameTotal = 0;
+	std::uint64_t replayTotal = 0;
+	for (std::size_t i = 0; i < session->actors.size(); ++i) {
+		gameTotal += session->actors[i].durationNs;
+		replayTotal += replayed[i];
+	}
+
+	std::printf("Session recorded by SPID %s%s\n", session->build.c_str(), session->truncated ? " (truncated)" : "");
+	std::printf("\t%zu plugins, %zu forms, %zu entries, %zu actors\n", session->plugins.size(), session->forms.size(), session->entries.size(), session->actors.size());
+	if (world.genericForms > 0 || world.skippedEntries > 0) {
+		std::printf("\t%zu forms rebuilt as generic objects, %zu entries skipped\n", world.genericForms, world.skippedEntries);
+	}
+	std::printf("\tGame: %.3f ms, replay: %.3f ms (best of %zu)\n", to_ms(gameTotal), to_ms(replayTotal), repeat);
+
+	if (Distribute::Shadow::IsEnabled()) {
+		const auto stats = Distribute::Shadow::GetStats();
+		const auto evaluations = static_cast<double>(std::max<std::uint64_t>(stats.evaluations, 1));
+		std::printf("\tShadow evaluation: %llu of %llu NPCs diverged, reference %.1f ns/entry, optimized %.1f ns/entry\n",
+			static_cast<unsigned long long>(stats.divergentNPCs), static_cast<unsigned long long>(stats.npcs),
+			static_cast<double>(stats.referenceNs) / evaluations, static_cast<double>(stats.optimizedNs) / evaluations);
+	}
+
+	if (!session->actors.empty()) {
+		print_bursts(*session, replayed);
+		print_slowest(*session, replayed, top);
+	}
+
+	if (!profilePath.empty()) {
+		std::printf("\n%s", Distribute::Profiler::FormatTable(top).c_str());
+
+		std::ofstream output(profilePath, std::ios::binary | std::ios::trunc);
+		output << Distribute::Profiler::FormatCSV();
+		if (!output) {
+			std::printf("Couldn't write %s\n", profilePath.c_str());
+			return 2;
+		}
+	}
+
+	if (!dumpPath.empty()) {
+		// Actors that were distributed to more than once are dumped in their final state.
+		std::ofstream output(dumpPath, std::ios::binary | std::ios::trunc);
+		std::set<RE::FormID> dumped{};
+		for (std::size_t i = session->actors.size(); i-- > 0;) {
+			if (dumped.insert(session->actors[i].actorID).second) {
+				output << fmt::format("{:08X} {}\n", session->actors[i].actorID, session->actors[i].name) << Replay::Describe(world.actors[i]);
+			}
+		}
+		if (!output) {
+			std::printf("Couldn't write %s\n", dumpPath.c_str());
+			return 2;
+		}
+	}
+
+	return 0;
+}
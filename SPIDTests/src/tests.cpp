@@ -0,0 +1,12 @@
+#include "Testing.h"
+
+#include "Tests/BenchmarkReportTests.h"
+#include "Tests/BinaryIOTests.h"
+#include "Tests/EntrySanitizerTests.h"
+#include "Tests/IniReaderTests.h"
+#include "Tests/StringKernelsTests.h"
+
+int main()
+{
+	return ::Testing::Runner::Run() == 0 ? 0 : 1;
+}